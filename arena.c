@@ -0,0 +1,111 @@
+/*
+ * Memory arena for the modem states
+ *
+ * Copyright (c) 2000 Fabrice Bellard.
+ *
+ * This code is released under the GNU General Public License version
+ * 2. Please read the file COPYING to know the exact terms of the
+ * license.
+ */
+#include "lm.h"
+
+/*
+ * An arena is a preallocated memory block in which the modem
+ * instances, the line models and the per call protocol states are
+ * carved. Allocation is a pointer increment and all the allocations
+ * done after a mark can be released at once, so that no malloc() is
+ * done on the call path. A modem bank uses one arena per worker, and
+ * each modem reserves its own sub arena for the per call states.
+ */
+
+#define ARENA_ALIGN 16
+
+/* allocate 'size' bytes for the arena. Return -1 if no memory */
+int sm_arena_init(struct sm_arena *a, int size)
+{
+    memset(a, 0, sizeof(*a));
+    a->base = malloc(size);
+    if (!a->base)
+        return -1;
+    a->size = size;
+    a->allocated = 1;
+    return 0;
+}
+
+/* carve a sub arena of 'size' bytes in 'parent'. If 'parent' is
+   NULL, the memory is taken from the heap. */
+int sm_arena_init_sub(struct sm_arena *a, struct sm_arena *parent, int size)
+{
+    u8 *base;
+
+    if (!parent)
+        return sm_arena_init(a, size);
+
+    base = sm_arena_alloc(parent, size);
+    if (!base)
+        return -1;
+    memset(a, 0, sizeof(*a));
+    a->base = base;
+    a->size = size;
+    return 0;
+}
+
+void sm_arena_free(struct sm_arena *a)
+{
+    if (a->allocated)
+        free(a->base);
+    a->base = NULL;
+    a->size = 0;
+    a->ptr = 0;
+}
+
+/* return 'size' bytes of zeroed memory, or NULL if the arena is
+   full. If 'a' is NULL, the memory is taken from the heap: the caller
+   owns it and must free() it (lm_close() frees the driver state and
+   lm_delete() the modem state allocated without arena). */
+void *sm_arena_alloc(struct sm_arena *a, int size)
+{
+    void *ptr;
+    int p;
+
+    if (!a)
+        return calloc(1, size);
+
+    p = (a->ptr + ARENA_ALIGN - 1) & ~(ARENA_ALIGN - 1);
+    if (size < 0 || p + size > a->size) {
+        a->nb_failed++;
+        return NULL;
+    }
+    ptr = a->base + p;
+    a->ptr = p + size;
+    if (a->ptr > a->high_water)
+        a->high_water = a->ptr;
+    a->nb_allocs++;
+    memset(ptr, 0, size);
+    return ptr;
+}
+
+/* return the current allocation point */
+int sm_arena_mark(struct sm_arena *a)
+{
+    return a->ptr;
+}
+
+/* free everything allocated after 'mark' */
+void sm_arena_release(struct sm_arena *a, int mark)
+{
+    a->ptr = mark;
+    a->nb_resets++;
+}
+
+void sm_arena_reset(struct sm_arena *a)
+{
+    sm_arena_release(a, 0);
+}
+
+void sm_arena_dump(struct sm_arena *a, const char *name)
+{
+    printf("%s: arena: size=%d used=%d high_water=%d allocs=%d failed=%d resets=%d\n",
+           name, a->size, a->ptr, a->high_water,
+           a->nb_allocs, a->nb_failed, a->nb_resets);
+}
@@ -0,0 +1,511 @@
+/*
+ * Benchmark suite
+ *
+ * Copyright (c) 2000 Fabrice Bellard.
+ *
+ * This code is released under the GNU General Public License version
+ * 2. Please read the file COPYING to know the exact terms of the
+ * license.
+ */
+#include <sys/time.h>
+#include <pthread.h>
+
+#include "lm.h"
+
+/* current time in microseconds */
+s64 bench_time(void)
+{
+    struct timeval tv;
+
+    gettimeofday(&tv, NULL);
+    return (s64)tv.tv_sec * 1000000 + tv.tv_usec;
+}
+
+/* idle channels: cost of a modem bank where no line is active */
+
+#define IDLE_CHANNELS 64
+#define IDLE_SECONDS  20
+#define IDLE_NB_SAMPLES 40
+
+extern struct sm_hw_info sm_hw_null;
+
+/* return the CPU time (in us) needed to process IDLE_SECONDS of
+   audio on IDLE_CHANNELS channels in state 'state'. */
+static s64 bench_idle_run(int state, int fast_path, int skip_sleeping)
+{
+    struct sm_arena arena;
+    struct sm_state *sm[IDLE_CHANNELS];
+    s16 input[IDLE_NB_SAMPLES], output[IDLE_NB_SAMPLES];
+    int i, j, n;
+    s64 t;
+
+    if (sm_arena_init(&arena, IDLE_CHANNELS *
+                      (sizeof(struct sm_state) + SM_CALL_ARENA_SIZE + 64)) < 0) {
+        fprintf(stderr, "bench: no memory\n");
+        exit(1);
+    }
+
+    for(i=0;i<IDLE_CHANNELS;i++) {
+        sm[i] = lm_new(&arena, &sm_hw_null, "idle");
+        if (!sm[i]) {
+            fprintf(stderr, "bench: arena too small\n");
+            exit(1);
+        }
+        sm[i]->state = state;
+        sm[i]->calling = 0;
+        sm_set_timer(&sm[i]->ring_timer, 1000 * 1000);
+        if (!fast_path) {
+            /* never quiet, never sleeping */
+            sm[i]->wake_threshold = -1;
+        }
+    }
+
+    /* line noise at about -60 dB */
+    for(j=0;j<IDLE_NB_SAMPLES;j++)
+        input[j] = (random() % 65) - 32;
+
+    n = (IDLE_SECONDS * 8000) / IDLE_NB_SAMPLES;
+    t = bench_time();
+    for(j=0;j<n;j++) {
+        for(i=0;i<IDLE_CHANNELS;i++) {
+            if (skip_sleeping && lm_is_sleeping(sm[i]))
+                continue;
+            sm_process(sm[i], output, input, IDLE_NB_SAMPLES);
+        }
+    }
+    t = bench_time() - t;
+
+    for(i=0;i<IDLE_CHANNELS;i++)
+        lm_delete(sm[i]);
+    sm_arena_free(&arena);
+    return t;
+}
+
+static void bench_idle(void)
+{
+    static const struct {
+        int state;
+        const char *name;
+    } tests[] = {
+        { SM_IDLE, "idle" },
+        { SM_TEST_RING2, "ring wait (DTMF rx)" },
+    };
+    int i;
+    s64 t0, t1, t2;
+    float scale;
+
+    /* us of CPU per second of audio & per channel */
+    scale = 1.0 / (IDLE_SECONDS * IDLE_CHANNELS);
+
+    printf("idle: %d channels, %d s\n", IDLE_CHANNELS, IDLE_SECONDS);
+    for(i=0;i<sizeof(tests)/sizeof(tests[0]);i++) {
+        t0 = bench_idle_run(tests[i].state, 0, 0);
+        t1 = bench_idle_run(tests[i].state, 1, 0);
+        t2 = bench_idle_run(tests[i].state, 1, 1);
+        printf("%-20s: full DSP=%7.2f us/s  energy gated=%7.2f us/s  "
+               "not scheduled=%7.2f us/s  saved=%7.2f us/s per channel\n",
+               tests[i].name, t0 * scale, t1 * scale, t2 * scale,
+               (t0 - t2) * scale);
+    }
+}
+
+/* data link goodput: async vs LAPM over the simulated phone line */
+
+#define LINK_NB_SAMPLES 40
+#define LINK_SECONDS    120  /* simulated time after the connection */
+#define LINK_TIMEOUT    60   /* maximum connection time (s) */
+
+static int bench_open(struct lm_interface_state *s)
+{
+    return 0;
+}
+
+static void bench_close(struct lm_interface_state *s)
+{
+}
+
+static void bench_set_offhook(struct lm_interface_state *s, int v)
+{
+}
+
+static void bench_set_ring(struct lm_interface_state *s, int v)
+{
+}
+
+static void bench_main_loop(struct lm_interface_state *s)
+{
+}
+
+/* driver without messages */
+static struct sm_hw_info bench_hw = {
+    bench_open,
+    bench_close,
+    bench_set_offhook,
+    bench_set_ring,
+    bench_main_loop,
+};
+
+typedef struct {
+    int connected; /* true if the data mode was reached */
+    int nb_good;   /* bytes received in sequence */
+    int nb_bad;    /* bytes received out of sequence */
+    int nb_retrans, nb_fcs_errors;
+} LinkResult;
+
+/* send a counter from the answer modem to the calling modem during
+   'seconds' at 'snr' dB and count the received bytes. 'v42bis_n2'
+   is the V42bis dictionary size (0 = no compression) */
+static void bench_link_run(LinkResult *r, float snr, int seconds,
+                           int modulations, int n401, int v42bis_n2)
+{
+    struct sm_arena arena;
+    struct LineModelState *line;
+    struct sm_state *cal, *ans;
+    LinModemConfig config;
+    s16 cal_out[LINK_NB_SAMPLES], cal_in[LINK_NB_SAMPLES];
+    s16 ans_out[LINK_NB_SAMPLES], ans_in[LINK_NB_SAMPLES];
+    int c, tx_count, rx_count, n, n_end;
+
+    memset(r, 0, sizeof(*r));
+    if (sm_arena_init(&arena, 2 * (sizeof(struct sm_state) + SM_CALL_ARENA_SIZE) +
+                      64 * 1024) < 0) {
+        fprintf(stderr, "bench: no memory\n");
+        exit(1);
+    }
+    line = line_model_init(&arena);
+    cal = lm_new(&arena, &bench_hw, "cal");
+    ans = lm_new(&arena, &bench_hw, "ans");
+    if (!line || !cal || !ans) {
+        fprintf(stderr, "bench: arena too small\n");
+        exit(1);
+    }
+    line_model_set_snr(line, snr);
+
+    config = *cal->lm_config;
+    config.available_modulations = modulations;
+    config.lapm_n401 = n401;
+    config.v42bis_n2 = v42bis_n2;
+    config.sleep_delay = -1;
+    cal->lm_config = &config;
+    ans->lm_config = &config;
+    serial_init(cal, 8, 'N');
+    serial_init(ans, 8, 'N');
+
+    /* the answer modem is started when the dialing is over */
+    lm_start_dial(cal, 0, "1");
+
+    memset(cal_in, 0, sizeof(cal_in));
+    memset(ans_in, 0, sizeof(ans_in));
+    tx_count = 0;
+    rx_count = 0;
+    n_end = (LINK_TIMEOUT * 8000) / LINK_NB_SAMPLES;
+    for(n = 0; n < n_end; n++) {
+        if (cal->state == SM_V8 && ans->state == SM_IDLE)
+            lm_start_receive(ans);
+        if (!r->connected && 
+            (cal->state == SM_V21 || cal->state == SM_V23) &&
+            (ans->state == SM_V21 || ans->state == SM_V23)) {
+            r->connected = 1;
+            n_end = n + (seconds * 8000) / LINK_NB_SAMPLES;
+        }
+        if (lm_get_state(cal) == LM_STATE_IDLE ||
+            (r->connected && lm_get_state(ans) == LM_STATE_IDLE))
+            break;
+
+        /* the data is only counted in the connected state */
+        if (r->connected) {
+            while (sm_size(&ans->tx_fifo) < SM_FIFO_SIZE - 1) {
+                sm_put_bit(&ans->tx_fifo, tx_count & 0xff);
+                tx_count++;
+            }
+            while ((c = sm_get_bit(&cal->rx_fifo)) != -1) {
+                if (c == (rx_count & 0xff)) {
+                    r->nb_good++;
+                } else {
+                    r->nb_bad++;
+                    /* resynchronize on the received byte */
+                    rx_count = c;
+                }
+                rx_count++;
+            }
+        }
+
+        sm_process(cal, cal_out, cal_in, LINK_NB_SAMPLES);
+        sm_process(ans, ans_out, ans_in, LINK_NB_SAMPLES);
+        line_model(line, ans_in, cal_out, cal_in, ans_out, LINK_NB_SAMPLES);
+    }
+    if (cal->v42)
+        r->nb_fcs_errors = cal->v42->nb_fcs_errors;
+    if (ans->v42)
+        r->nb_retrans = ans->v42->nb_retrans;
+    lm_delete(cal);
+    lm_delete(ans);
+    sm_arena_free(&arena);
+}
+
+static void bench_link(void)
+{
+    static const struct {
+        int modulation;
+        const char *name;
+        float snr[4];
+    } tests[] = {
+        { V8_MOD_V21, "V21 300 bit/s", { 0, 3, 6, 20 } },
+        { V8_MOD_V23, "V23 1200 bit/s", { 8, 10, 12, 20 } },
+    };
+    LinkResult r;
+    int i, j, nb_bad;
+    float snr;
+
+    printf("link: goodput in bytes/s during %d s, with (out of sequence bytes)\n"
+           "      for async and (FCS errors, retransmissions) for LAPM\n", 
+           LINK_SECONDS);
+    for(i=0;i<sizeof(tests)/sizeof(tests[0]);i++) {
+        printf("%-15s async 8N1          LAPM N401=128        LAPM N401=32"
+               "         LAPM+V42bis\n", tests[i].name);
+        for(j=0;j<4;j++) {
+            snr = tests[i].snr[j];
+            printf("  SNR=%2.0f dB", snr);
+            bench_link_run(&r, snr, LINK_SECONDS, tests[i].modulation,
+                           128, 0);
+            printf("  %6.1f (%5d)     ", 
+                   (float)r.nb_good / LINK_SECONDS, r.nb_bad);
+            bench_link_run(&r, snr, LINK_SECONDS, 
+                           tests[i].modulation | V8_PROT_LAPM, 128, 0);
+            printf("  %6.1f (%4d,%4d)", (float)r.nb_good / LINK_SECONDS, 
+                   r.nb_fcs_errors, r.nb_retrans);
+            nb_bad = r.nb_bad;
+            bench_link_run(&r, snr, LINK_SECONDS, 
+                           tests[i].modulation | V8_PROT_LAPM, 32, 0);
+            printf("  %6.1f (%4d,%4d)", (float)r.nb_good / LINK_SECONDS, 
+                   r.nb_fcs_errors, r.nb_retrans);
+            nb_bad += r.nb_bad;
+            /* the counter is very compressible */
+            bench_link_run(&r, snr, LINK_SECONDS, 
+                           tests[i].modulation | V8_PROT_LAPM, 128, 2048);
+            printf("  %6.1f (%4d,%4d)", (float)r.nb_good / LINK_SECONDS, 
+                   r.nb_fcs_errors, r.nb_retrans);
+            nb_bad += r.nb_bad;
+            if (nb_bad)
+                printf(" undetected errors=%d", nb_bad);
+            printf("\n");
+            fflush(stdout);
+        }
+    }
+}
+
+/* threads: several copies of each data pump run at the same time in
+   different threads. Each copy must give the same result as the pump
+   running alone, otherwise some state is shared. 'make tsan' runs it
+   with the thread sanitizer, which also finds the races which do not
+   change the results. */
+
+#define THREADS_COPIES       4   /* copies of each job */
+#define THREADS_LINK_SECONDS 10
+#define THREADS_V22_SECONDS  10
+
+enum {
+    JOB_LINK, /* two modems connected by the line model */
+    JOB_V34,  /* one test of the V34 receiver regression test */
+    JOB_V22,  /* V22bis modulator looped to the demodulator */
+};
+
+static const struct {
+    int type;
+    const char *name;
+    int arg, n401, v42bis_n2;
+    float snr;
+} thread_jobs[] = {
+    { JOB_LINK, "V21 async", V8_MOD_V21, 128, 0, 20 },
+    { JOB_LINK, "V21 LAPM+V42bis", V8_MOD_V21 | V8_PROT_LAPM, 128, 2048, 20 },
+    { JOB_LINK, "V23 LAPM", V8_MOD_V23 | V8_PROT_LAPM, 32, 0, 30 },
+    { JOB_V34, "V34 S=2400 low", 0 },
+    { JOB_V34, "V34 S=3000 64 states", 4 },
+    { JOB_V34, "V34 S=2743 aux", 5 },
+    { JOB_V22, "V22bis 2400", V22_MOD_2400 },
+};
+
+#define NB_JOBS (sizeof(thread_jobs) / sizeof(thread_jobs[0]))
+
+typedef struct {
+    int job;
+    int ret;  /* < 0 if the job failed */
+    u32 sum;  /* checksum of its results */
+    pthread_t thread;
+} ThreadRun;
+
+static inline u32 job_sum(u32 sum, int v)
+{
+    return (sum ^ v) * 16777619;
+}
+
+/* pseudo random bits: the state is in 'opaque' */
+static int job_get_bit(void *opaque)
+{
+    u32 *seed = opaque;
+
+    *seed = *seed * 1103515245 + 12345;
+    return (*seed >> 16) & 1;
+}
+
+static void job_put_bit(void *opaque, int bit)
+{
+    ThreadRun *t = opaque;
+
+    t->sum = job_sum(t->sum, bit);
+}
+
+static void *thread_job(void *opaque)
+{
+    ThreadRun *t = opaque;
+    LinkResult r;
+    V22ModState tx;
+    V22DemodState rx;
+    s16 buf[LINK_NB_SAMPLES];
+    u32 seed;
+    int j, n, i;
+
+    j = t->job;
+    t->ret = 0;
+    t->sum = V34_TABLE_SUM_INIT;
+    switch(thread_jobs[j].type) {
+    case JOB_LINK:
+        bench_link_run(&r, thread_jobs[j].snr, THREADS_LINK_SECONDS,
+                       thread_jobs[j].arg, thread_jobs[j].n401,
+                       thread_jobs[j].v42bis_n2);
+        if (!r.connected || r.nb_good == 0)
+            t->ret = -1;
+        t->sum = job_sum(t->sum, r.nb_good);
+        t->sum = job_sum(t->sum, r.nb_bad);
+        t->sum = job_sum(t->sum, r.nb_fcs_errors);
+        t->sum = job_sum(t->sum, r.nb_retrans);
+        break;
+    case JOB_V34:
+        t->ret = V34_rx_check_run(thread_jobs[j].arg, &t->sum);
+        break;
+    case JOB_V22:
+        memset(&tx, 0, sizeof(tx));
+        seed = 0;
+        tx.calling = 1;
+        tx.mod_type = thread_jobs[j].arg;
+        tx.get_bit = job_get_bit;
+        tx.opaque = &seed;
+        V22_mod_init(&tx);
+        memset(&rx, 0, sizeof(rx));
+        rx.calling = 0;
+        rx.mod_type = thread_jobs[j].arg;
+        rx.put_bit = job_put_bit;
+        rx.opaque = t;
+        V22_demod_init(&rx);
+        for(n = 0; n < (THREADS_V22_SECONDS * 8000) / LINK_NB_SAMPLES; n++) {
+            V22_mod(&tx, buf, LINK_NB_SAMPLES);
+            for(i=0;i<LINK_NB_SAMPLES;i++)
+                t->sum = job_sum(t->sum, buf[i]);
+            V22_demod(&rx, buf, LINK_NB_SAMPLES);
+        }
+        if (rx.sym_count == 0)
+            t->ret = -1;
+        break;
+    }
+    return NULL;
+}
+
+static void bench_threads(void)
+{
+    ThreadRun ref[NB_JOBS], runs[NB_JOBS * THREADS_COPIES];
+    int i, j, nb_fail;
+    s64 t;
+
+    printf("threads: %d copies of %d jobs at the same time\n",
+           THREADS_COPIES, (int)NB_JOBS);
+
+    /* reference: each job alone */
+    t = bench_time();
+    for(j=0;j<NB_JOBS;j++) {
+        ref[j].job = j;
+        thread_job(&ref[j]);
+    }
+    t = bench_time() - t;
+    printf("alone:      %0.2f s\n", t / 1e6);
+
+    t = bench_time();
+    for(i=0;i<NB_JOBS * THREADS_COPIES;i++) {
+        runs[i].job = i % NB_JOBS;
+        if (pthread_create(&runs[i].thread, NULL, thread_job, &runs[i])) {
+            fprintf(stderr, "threads: could not create thread\n");
+            exit(1);
+        }
+    }
+    for(i=0;i<NB_JOBS * THREADS_COPIES;i++)
+        pthread_join(runs[i].thread, NULL);
+    t = bench_time() - t;
+    printf("concurrent: %0.2f s\n", t / 1e6);
+
+    nb_fail = 0;
+    for(j=0;j<NB_JOBS;j++) {
+        printf("%-20s: 0x%08x ", thread_jobs[j].name, ref[j].sum);
+        if (ref[j].ret < 0) {
+            printf("FAILED (alone)\n");
+            nb_fail++;
+            continue;
+        }
+        for(i=j;i<NB_JOBS * THREADS_COPIES;i+=NB_JOBS) {
+            if (runs[i].ret != ref[j].ret || runs[i].sum != ref[j].sum) {
+                printf(" copy %d: FAILED (0x%08x)", i / (int)NB_JOBS,
+                       runs[i].sum);
+                nb_fail++;
+            }
+        }
+        printf("\n");
+    }
+    if (nb_fail) {
+        printf("threads: %d jobs FAILED\n", nb_fail);
+        exit(1);
+    }
+    printf("threads: ok\n");
+}
+
+typedef struct {
+    const char *name;
+    void (*func)(void);
+} LMBench;
+
+static LMBench bench_list[] = {
+    { "idle", bench_idle },
+    { "serial", serial_bench },
+    { "scrambler", scrambler_bench },
+    { "echo", echo_cancel_bench },
+    { "link", bench_link },
+    { "v42bis", v42bis_bench },
+    { "viterbi", V34_bench },
+    { "shell", V34_shell_bench },
+    { "mapping", V34_mapping_bench },
+    { "setup", V34_setup_bench },
+    { "equalizer", V34_eq_bench },
+    { "pipeline", V34_pipeline_bench },
+    { "rxcheck", V34_rx_check },
+    { "threads", bench_threads },
+    { NULL, NULL },
+};
+
+/* run the benchmark 'name', or all of them if 'name' is "all" */
+void lm_bench(const char *name)
+{
+    LMBench *b;
+    int found;
+
+    found = 0;
+    for(b = bench_list; b->name != NULL; b++) {
+        if (!strcmp(name, "all") || !strcmp(name, b->name)) {
+            b->func();
+            found = 1;
+        }
+    }
+    if (!found) {
+        fprintf(stderr, "unknown benchmark '%s'. Available:", name);
+        for(b = bench_list; b->name != NULL; b++)
+            fprintf(stderr, " %s", b->name);
+        fprintf(stderr, "\n");
+        exit(1);
+    }
+}
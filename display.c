@@ -10,6 +10,7 @@
 
 #include <stdarg.h>
 #include <stdlib.h>
+#include <pthread.h>
 #include <string.h>
 #include <X11/Xlib.h>
 #include <X11/Xutil.h>
@@ -56,6 +57,16 @@ int minx, miny;
 
 int font_xsize, font_ysize;
 
+/* the display shows the signals of a single modem: the lm_dump_xxx()
+   functions do nothing if they are not called by the thread which
+   opened the display */
+static pthread_t display_thread;
+
+static int display_owner(void)
+{
+    return display != NULL && pthread_equal(pthread_self(), display_thread);
+}
+
 int lm_display_init(void)
 {
     XSizeHints hint;
@@ -131,6 +142,7 @@ int lm_display_init(void)
     font_ysize = xfont->max_bounds.ascent + xfont->max_bounds.descent;
 
     set_state(DISP_MODE_SAMPLE);
+    display_thread = pthread_self();
 
     return 0;
 }
@@ -138,6 +150,7 @@ int lm_display_init(void)
 void lm_display_close(void)
 {
     XCloseDisplay(display);
+    display = NULL;
 }
 
 void printf_at(int x, int y, char *fmt, ...)
@@ -262,6 +275,8 @@ void lm_dump_qam(float si, float sq)
 {
     int x, y;
 
+    if (!display_owner())
+        return;
     if (disp_state != DISP_MODE_QAM)
         return;
 
@@ -331,7 +346,8 @@ void draw_samples(int channel)
 
 void lm_dump_sample(int channel, float val)
 {
-
+    if (!display_owner())
+        return;
     sample_mem[channel][sample_pos[channel]] = val;
     if (++sample_pos[channel] == NB_SAMPLES) {
         sample_pos[channel] = 0;
@@ -386,6 +402,7 @@ void lm_dump_eye(int channel, float time, float val)
 
 #define EQ_FFT_SIZE 144
 
+/* only modified by the display owner (see display.h) */
 static int eq_count = 0;
 static s32 (*eq_filter)[2];
 static int eq_norm;
@@ -417,6 +434,8 @@ void lm_dump_equalizer(s32 eq_filter1[][2], int norm, int size)
 {
     int i;
     
+    if (!display_owner())
+        return;
     if (disp_state != DISP_MODE_EQUALIZER)
         return;
     
@@ -474,11 +493,15 @@ void lm_dump_equalizer(s32 eq_filter1[][2], int norm, int size)
 
 void lm_dump_agc(float gain)
 {
+    if (!display_owner())
+        return;
     printf_at(minx, 2, "AGC: %10.5f", gain);
 }
 
 void lm_dump_linesim_power(float tx_db, float rx_db, float noise_db)
 {
+    if (!display_owner())
+        return;
     printf_at(minx, 3, "TX: %6.2f dB SNR: %6.2f dB", tx_db, rx_db - noise_db);
     printf_at(minx, 4, "RX: %6.2f dB  N0: %6.2f dB", rx_db, noise_db);
 }
@@ -554,4 +577,33 @@ int lm_display_poll_event(void)
     return 0;
 }
 
+/* print echo canceller */
 
+/* only modified by the display owner (see display.h) */
+static int ec_count = 0;
+static s32 *ec_filter;
+static int ec_norm;
+
+float calc_ec(float x)
+{
+    return (float)ec_filter[(int)rint(x)] / (float)ec_norm;
+}
+
+void lm_dump_echocancel(s32 *ec_filter1, int norm, int size)
+{
+    if (!display_owner())
+        return;
+    if (disp_state != DISP_MODE_ECHOCANCEL)
+        return;
+    
+    if (++ec_count == 50) {
+        ec_count = 0;
+        ec_filter = ec_filter1;
+        ec_norm = norm;
+
+        draw_graph("Near echo",
+                   0, 0, QAM_SIZE, QAM_SIZE/2,  
+                   0.0, size - 1, 0.0, 0.0, 
+                   DG_AUTOSCALE_YMIN | DG_AUTOSCALE_YMAX, calc_ec);
+    }
+}
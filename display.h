@@ -1,4 +1,9 @@
-/* display.c */
+/* display.c: X11 debug display. There is only one display and it
+   belongs to one modem: the thread which called lm_display_init().
+   All its state (window, sample history, equalizer & echo canceller
+   snapshots and decimation counters) is global in display.c and is
+   only modified by that thread, so the lm_dump_xxx() calls of the
+   other modems are ignored. */
 
 int lm_display_init(void);
 void lm_display_close(void);
@@ -15,5 +20,5 @@ enum {
 void lm_dump_sample(int channel, float val);
 void lm_dump_agc(float gain);
 void lm_dump_equalizer(s32 eq_filter1[][2], int norm, int size);
-void lm_dump_echocancel(s32 eq_filter1[][2], int norm, int size);
+void lm_dump_echocancel(s32 *ec_filter1, int norm, int size);
 void lm_dump_linesim_power(float tx_db, float rx_db, float noise_db);
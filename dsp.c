@@ -11,6 +11,55 @@ void dsp_init(void)
     }
 }
 
+/* adaptive equalizers: LMS update (V22 & V34) */
+void dsp_eq_update(s32 (*filter)[2], s16 *coef0, s16 *coef1, 
+                   const s16 *x, int n, int e0, int e1, int shift)
+{
+    int i, f0, f1;
+
+    i = 0;
+#ifdef __SSE2__
+    {
+        __m128i e, xx, lo, hi, f, g, c;
+        __m128i sh = _mm_cvtsi32_si128(shift);
+
+        /* 4 taps per iteration: the products are computed in the
+           interleaved order of filter */
+        e = _mm_set_epi16(e1, e0, e1, e0, e1, e0, e1, e0);
+        for(;i<=n-4;i+=4) {
+            xx = _mm_loadl_epi64((const __m128i *)(x + i));
+            xx = _mm_unpacklo_epi16(xx, xx);
+            lo = _mm_mullo_epi16(xx, e);
+            hi = _mm_mulhi_epi16(xx, e);
+            f = _mm_add_epi32(_mm_loadu_si128((__m128i *)filter[i]),
+                    _mm_slli_epi32(_mm_sra_epi32(_mm_unpacklo_epi16(lo, hi), 
+                                                 sh), 4));
+            g = _mm_add_epi32(_mm_loadu_si128((__m128i *)filter[i + 2]),
+                    _mm_slli_epi32(_mm_sra_epi32(_mm_unpackhi_epi16(lo, hi),
+                                                 sh), 4));
+            _mm_storeu_si128((__m128i *)filter[i], f);
+            _mm_storeu_si128((__m128i *)filter[i + 2], g);
+            /* deinterleave the working coefficients */
+            c = _mm_packs_epi32(_mm_srai_epi32(f, 16), _mm_srai_epi32(g, 16));
+            c = _mm_shufflelo_epi16(c, 0xd8);
+            c = _mm_shufflehi_epi16(c, 0xd8);
+            c = _mm_shuffle_epi32(c, 0xd8);
+            _mm_storel_epi64((__m128i *)(coef0 + i), c);
+            _mm_storel_epi64((__m128i *)(coef1 + i), 
+                             _mm_srli_si128(c, 8));
+        }
+    }
+#endif
+    for(;i<n;i++) {
+        f0 = filter[i][0] + (((e0 * x[i]) >> shift) * 16);
+        f1 = filter[i][1] + (((e1 * x[i]) >> shift) * 16);
+        filter[i][0] = f0;
+        filter[i][1] = f1;
+        coef0[i] = f0 >> 16;
+        coef1[i] = f1 >> 16;
+    }
+}
+
 /* DFT computation with Goertzel algorithm */
 
 int compute_DFT(s16 *cos_tab, s16 *sin_tab, s16 *x, int k,int n)
@@ -51,56 +100,56 @@ int compute_DFT(s16 *cos_tab, s16 *sin_tab, s16 *x, int k,int n)
 
 #define FFT_MAX_SIZE 2048
 
-static float norm;
-static float wfft[FFT_MAX_SIZE];
-static short tinv[FFT_MAX_SIZE];
-static int nf = 0, nf2, nf4;
+/* the tables are computed at each call: they are on the stack so
+   that fft_calc() can be used by several threads */
+typedef struct {
+    float norm;
+    float wfft[FFT_MAX_SIZE];
+    short tinv[FFT_MAX_SIZE];
+    int nf, nf2, nf4;
+} FFTTables;
 
-int fft_init(int n)
+static void fft_init(FFTTables *t, int n)
 {
     float p,k;
     int i,j,a,c, nk;
     
-    nf=n;
-    nf2=nf/2;
-    nf4=nf/4;
+    t->nf=n;
+    t->nf2=t->nf/2;
+    t->nf4=t->nf/4;
     nk=0;
     while (n>>=1) nk++;
-    norm=1/sqrt(nf);
+    t->norm=1/sqrt(t->nf);
     
     k=0;
-    p=(2*M_PI)/nf;
-    for(i=0;i<=nf4;i++) {
-        wfft[i]=cos(k);
+    p=(2*M_PI)/t->nf;
+    for(i=0;i<=t->nf4;i++) {
+        t->wfft[i]=cos(k);
         k+=p;
     }
     
-    for(i=0;i<nf;i++) {
+    for(i=0;i<t->nf;i++) {
         a=i;
         c=0;
         for(j=0;j<nk;j++) {
             c=(c<<1)|(a&1);
             a>>=1;
         }
-        tinv[i]= c<=i ? -1 : c;
+        t->tinv[i]= c<=i ? -1 : c;
     }
-    
-    return 0;
 }
 
 /* r = TRUE : reverse FFT */
 void fft_calc(complex *x,int n, int r)
 {
+    FFTTables tables, *t = &tables;
     int i,j,k,l;
     complex a,b,c;
     complex *p,*q;	
 
-    /* auto init of coefficients */
-    if (n != nf) {
-        fft_init(n);
-    }
+    fft_init(t, n);
 
-    k=nf2;
+    k=t->nf2;
     l=1;
     do {
         p=x;
@@ -117,7 +166,7 @@ void fft_calc(complex *x,int n, int r)
                 b.im=a.im-b.im;
                 if (j==0) {
                     *q=b;
-                } else if (j==nf4) {
+                } else if (j==t->nf4) {
                     if (r) {
                         q->re=b.im;
                         q->im=-b.re;
@@ -127,15 +176,15 @@ void fft_calc(complex *x,int n, int r)
                     }
                     q->re=-b.im;
                     q->im=b.re;
-                } else if (j<nf4) {
-                    c.re=wfft[j];
-                    c.im=wfft[nf4-j];
+                } else if (j<t->nf4) {
+                    c.re=t->wfft[j];
+                    c.im=t->wfft[t->nf4-j];
                     if (r) c.im=-c.im;
                     q->re=b.re*c.re-b.im*c.im;
                     q->im=b.im*c.re+b.re*c.im;
                 } else {
-                    c.re=-wfft[nf2-j];
-                    c.im=wfft[j-nf4];
+                    c.re=-t->wfft[t->nf2-j];
+                    c.im=t->wfft[j-t->nf4];
                     if (r) c.im=-c.im;
                     q->re=b.re*c.re-b.im*c.im;
                     q->im=b.im*c.re+b.re*c.im;
@@ -143,7 +192,7 @@ void fft_calc(complex *x,int n, int r)
                 p++;
                 q++;
                 j+=l;
-            } while (j<nf2);
+            } while (j<t->nf2);
             p+=k;
             q+=k;
         } while (--i);
@@ -151,18 +200,85 @@ void fft_calc(complex *x,int n, int r)
         l<<=1;
     } while (k);
     
-    for(i=0,p=x;i<nf;i++,p++) {
-        p->re*=norm;
-        p->im*=norm;
+    for(i=0,p=x;i<t->nf;i++,p++) {
+        p->re*=t->norm;
+        p->im*=t->norm;
     }
     
-    for(i=0,p=x;i<nf;i++,p++) if ((j=tinv[i])!=-1) {
+    for(i=0,p=x;i<t->nf;i++,p++) if ((j=t->tinv[i])!=-1) {
         a=*p;
         *p=x[j];
         x[j]=a;
     }
 }
 
+/* FFT with its own tables (decimation in frequency, radix 2) */
+int fft_plan_init(FFTPlan *p, struct sm_arena *arena, int n)
+{
+    int i, j, k, nbits;
+
+    nbits = 0;
+    while ((1 << nbits) < n)
+        nbits++;
+    if (n < 2 || (1 << nbits) != n || nbits > 16)
+        return -1;
+    p->n = n;
+    p->w = sm_arena_alloc(arena, (n / 2) * sizeof(complex));
+    p->rev = sm_arena_alloc(arena, n * sizeof(u16));
+    if (!p->w || !p->rev)
+        return -1;
+    for(i=0;i<n/2;i++) {
+        p->w[i].re = cos(2 * M_PI * i / n);
+        p->w[i].im = -sin(2 * M_PI * i / n);
+    }
+    for(i=0;i<n;i++) {
+        k = 0;
+        for(j=0;j<nbits;j++) {
+            if (i & (1 << j))
+                k |= 1 << (nbits - 1 - j);
+        }
+        p->rev[i] = k;
+    }
+    return 0;
+}
+
+void fft_plan_calc(const FFTPlan *p, complex *x, int inverse)
+{
+    int n, half, step, i, j;
+    float sgn;
+    complex a, b, w, *q;
+
+    n = p->n;
+    sgn = inverse ? -1.0 : 1.0;
+    step = 1;
+    for(half = n / 2; half >= 1; half >>= 1) {
+        for(q = x; q < x + n; q += 2 * half) {
+            for(j=0;j<half;j++) {
+                a = q[j];
+                b = q[j + half];
+                q[j].re = a.re + b.re;
+                q[j].im = a.im + b.im;
+                a.re -= b.re;
+                a.im -= b.im;
+                w.re = p->w[j * step].re;
+                w.im = p->w[j * step].im * sgn;
+                q[j + half].re = a.re * w.re - a.im * w.im;
+                q[j + half].im = a.im * w.re + a.re * w.im;
+            }
+        }
+        step <<= 1;
+    }
+
+    for(i=0;i<n;i++) {
+        j = p->rev[i];
+        if (j > i) {
+            a = x[i];
+            x[i] = x[j];
+            x[j] = a;
+        }
+    }
+}
+
 /* hamming window */
 
 void calc_hamming(float *ham, int NF)
@@ -31,6 +31,37 @@ static inline int dsp_cos(int phase)
     return cos_tab[(phase >> (PHASE_BITS - COS_TABLE_BITS)) & (COS_TABLE_SIZE-1)];
 }
 
+/* NCO: sin(phase) is computed from the cosine table */
+static inline int dsp_sin(int phase) 
+{
+    return dsp_cos((PHASE_BASE/4) - phase);
+}
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+
+static inline int dsp_dot_prod(const s16 *tab1, const s16 *tab2, 
+                               int n, int sum)
+{
+    __m128i acc;
+    int i;
+
+    acc = _mm_setzero_si128();
+    for(i=0;i<=n-8;i+=8) {
+        acc = _mm_add_epi32(acc, 
+                  _mm_madd_epi16(_mm_loadu_si128((const __m128i *)(tab1 + i)),
+                                 _mm_loadu_si128((const __m128i *)(tab2 + i))));
+    }
+    acc = _mm_add_epi32(acc, _mm_shuffle_epi32(acc, 0x4e));
+    acc = _mm_add_epi32(acc, _mm_shuffle_epi32(acc, 0xb1));
+    sum += _mm_cvtsi128_si32(acc);
+    for(;i<n;i++) {
+        sum += tab1[i] * tab2[i];
+    }
+
+    return sum;
+}
+#else
 static inline int dsp_dot_prod(const s16 *tab1, const s16 *tab2, 
                                int n, int sum)
 {
@@ -42,6 +73,64 @@ static inline int dsp_dot_prod(const s16 *tab1, const s16 *tab2,
 
     return sum;
 }
+#endif
+
+/* the bit order of the block bit I/O is MSB first, LSB first on
+   the HDLC & V34 frames */
+static inline u32 dsp_bit_reverse32(u32 v)
+{
+    v = ((v >> 1) & 0x55555555) | ((v & 0x55555555) << 1);
+    v = ((v >> 2) & 0x33333333) | ((v & 0x33333333) << 2);
+    v = ((v >> 4) & 0x0f0f0f0f) | ((v & 0x0f0f0f0f) << 4);
+    v = ((v >> 8) & 0x00ff00ff) | ((v & 0x00ff00ff) << 8);
+    return (v >> 16) | (v << 16);
+}
+
+/* index of the smallest of the 'n' values of 'tab' (the first one on
+   equal values) */
+static inline int dsp_argmin(const int *tab, int n)
+{
+    int i, imin;
+
+    imin = 0;
+    for(i=1;i<n;i++) {
+        if (tab[i] < tab[imin])
+            imin = i;
+    }
+    return imin;
+}
+
+/* history of the input samples of a FIR filter: each sample is
+   written twice in 'buf' (2 * size samples, size is a power of two)
+   so that the last 'size' samples are always contiguous */
+static inline void dsp_hist_put(s16 *buf, int *ptr, int size, int v)
+{
+    buf[*ptr] = v;
+    buf[*ptr + size] = v;
+    *ptr = (*ptr + 1) & (size - 1);
+}
+
+/* the last 'n' samples, the oldest first */
+static inline const s16 *dsp_hist_last(const s16 *buf, int ptr, int size, 
+                                       int n)
+{
+    return buf + ptr + size - n;
+}
+
+/* polyphase filters (layout described in v34table.h): compute in
+   'coefs' the 'n' coefficients at the position 'frac' (0 to 0x10000)
+   between the rows 'f0' and 'f1' with a linear interpolation. The
+   filter output is then computed with dsp_dot_prod() */
+static inline void dsp_poly_coefs(s16 *coefs, const s16 *f0, const s16 *f1,
+                                  int frac, int n)
+{
+    int j;
+
+    for(j=0;j<n;j++) {
+        /* XXX: verify that there is no overflow */
+        coefs[j] = f0[j] + ((frac * (f1[j] - f0[j])) >> 16);
+    }
+}
 
 static inline int dsp_norm2(s16 *tab, int n, int sum)
 {
@@ -52,6 +141,17 @@ static inline int dsp_norm2(s16 *tab, int n, int sum)
     return sum;
 }
 
+/* sum of absolute values: cheap energy estimate */
+static inline int dsp_sum_abs(const s16 *tab, int n)
+{
+    int i, sum;
+    sum = 0;
+    for(i=0;i<n;i++) {
+        sum += abs(tab[i]);
+    }
+    return sum;
+}
+
 static inline void dsp_sar_tab(s16 *tab, int n, int shift)
 {
     int i;
@@ -82,15 +182,38 @@ static inline int dsp_sqr(int n)
     return n*n;
 }
 
+/* LMS update of an adaptive equalizer with the error (e0, e1): 'n'
+   taps of 'filter' (pairs of 16.16 fixed point coefficients) and of
+   their working copy (coef0, coef1) used with dsp_dot_prod(). 'x'
+   are the last n samples */
+void dsp_eq_update(s32 (*filter)[2], s16 *coef0, s16 *coef1, 
+                   const s16 *x, int n, int e0, int e1, int shift);
+
 int compute_DFT(s16 *cos_tab, s16 *sin_tab, s16 *x, int k,int n);
 
 typedef struct {
 	float re,im;
 } complex;
 
-/* medium speed FFT */
+/* medium speed FFT: its tables are recomputed at each call (use an
+   FFTPlan for repeated transforms) */
 void fft_calc(complex *x,int n, int r);
 
+/* FFT plan for a power of two size: the tables are owned by the
+   plan, so several sizes can be used at the same time */
+typedef struct {
+    int n;
+    complex *w;   /* exp(-2.i.pi.k/n), k < n/2 */
+    u16 *rev;     /* bit reversal permutation */
+} FFTPlan;
+
+struct sm_arena;
+
+int fft_plan_init(FFTPlan *p, struct sm_arena *arena, int n);
+/* in place & not normalized: the inverse transform of the transform
+   is multiplied by n */
+void fft_plan_calc(const FFTPlan *p, complex *x, int inverse);
+
 /* slow FFT for any size */
 void slow_fft(complex *output, complex *input, int n, int r);
 
@@ -0,0 +1,347 @@
+/*
+ * Line echo canceller
+ *
+ * Copyright (c) 2000 Fabrice Bellard.
+ *
+ * This code is released under the GNU General Public License version
+ * 2. Please read the file COPYING to know the exact terms of the
+ * license.
+ *
+ */
+
+#include "lm.h"
+
+/*
+ * The echo of the transmitted signal is the sum of the near echo (the
+ * local hybrid, a few ms long) and of the far echo (the central site
+ * hybrid), which comes back after the round trip delay of the local
+ * loop. Instead of a single FIR covering the whole delay, the far echo
+ * has its own short FIR placed at the bulk delay. The delay is
+ * estimated during the training by correlating the residual of the
+ * near echo canceller with the transmitted samples.
+ *
+ * Each FIR is adapted with NLMS, normalized by the energy of its own
+ * samples. The coefficients have 14 fractional bits, and are stored in
+ * 16.16 with a 16 bit working copy for the SIMD dot product.
+ */
+
+#define EC_TRAIN_SHIFT 2   /* NLMS step 1/4 during the training */
+#define EC_TRACK_SHIFT 12  /* NLMS step 1/4096 in data mode */
+#define EC_POW_MIN     (1 << 16)
+/* minimum ratio between the correlation energy at the bulk delay and
+   its mean over all the delays */
+#define EC_DELAY_THRESHOLD 4
+
+void echo_cancel_init(EchoCancelState *s)
+{
+    memset(s, 0, sizeof(EchoCancelState));
+    s->far_delay = -1;
+    echo_cancel_set_mode(s, EC_OFF);
+}
+
+void echo_cancel_set_mode(EchoCancelState *s, int mode)
+{
+    s->mode = mode;
+    if (mode == EC_TRAIN) {
+        s->mu_shift = EC_TRAIN_SHIFT;
+        s->train_count = 0;
+    } else {
+        s->mu_shift = EC_TRACK_SHIFT;
+    }
+}
+
+/* add g * x[i] >> sh to the 'n' taps of 'filter' and update their
+   working copy */
+static void ec_update(s32 *filter, s16 *coef, const s16 *x, int n,
+                      int g, int sh)
+{
+    int i;
+
+    i = 0;
+#ifdef __SSE2__
+    {
+        __m128i gg, shift, xx, lo, hi, f0, f1;
+
+        gg = _mm_set1_epi16(g);
+        shift = _mm_cvtsi32_si128(sh);
+        for(;i<=n-8;i+=8) {
+            xx = _mm_loadu_si128((const __m128i *)(x + i));
+            lo = _mm_mullo_epi16(xx, gg);
+            hi = _mm_mulhi_epi16(xx, gg);
+            f0 = _mm_add_epi32(_mm_loadu_si128((__m128i *)(filter + i)),
+                     _mm_sra_epi32(_mm_unpacklo_epi16(lo, hi), shift));
+            f1 = _mm_add_epi32(_mm_loadu_si128((__m128i *)(filter + i + 4)),
+                     _mm_sra_epi32(_mm_unpackhi_epi16(lo, hi), shift));
+            _mm_storeu_si128((__m128i *)(filter + i), f0);
+            _mm_storeu_si128((__m128i *)(filter + i + 4), f1);
+            _mm_storeu_si128((__m128i *)(coef + i),
+                             _mm_packs_epi32(_mm_srai_epi32(f0, 16),
+                                             _mm_srai_epi32(f1, 16)));
+        }
+    }
+#endif
+    for(;i<n;i++) {
+        filter[i] += (g * x[i]) >> sh;
+        coef[i] = filter[i] >> 16;
+    }
+}
+
+/* NLMS update with the residual 'res'. 'pow' is the energy of x[] */
+static void ec_adapt(s32 *filter, s16 *coef, const s16 *x, int n,
+                     int res, s64 pow, int mu_shift)
+{
+    s64 g;
+    int sh;
+
+    /* the update is (g * x[i]) >> sh with g = mu * res / pow in 30.16 */
+    g = ((s64)res << (46 - mu_shift)) / (pow + EC_POW_MIN);
+    sh = 16;
+    while (sh > 0 && (g > 32767 || g < -32767)) {
+        g >>= 1;
+        sh--;
+    }
+    if (g > 32767)
+        g = 32767;
+    else if (g < -32767)
+        g = -32767;
+    ec_update(filter, coef, x, n, g, sh);
+}
+
+/* find the bulk delay from the samples stored during the training */
+static void ec_estimate_delay(EchoCancelState *s)
+{
+    float c2[EC_MAX_DELAY];
+    const s16 *h;
+    float e, best, mean;
+    int d, c, best_d, k, nb;
+
+    for(d=0;d<EC_MAX_DELAY;d++) {
+        c = dsp_dot_prod(s->est_res, s->est_tx + EC_MAX_DELAY - d,
+                         EC_DELAY_WIN, 0);
+        c2[d] = (float)c * (float)c;
+    }
+
+    /* energy in the far filter for each delay beyond the near filter */
+    e = 0;
+    for(d=EC_NEAR_SIZE;d<EC_NEAR_SIZE+EC_FAR_SIZE;d++)
+        e += c2[d];
+    best = e;
+    best_d = EC_NEAR_SIZE;
+    mean = e;
+    nb = 1;
+    for(d=EC_NEAR_SIZE+1;d<=EC_MAX_DELAY-EC_FAR_SIZE;d++) {
+        e += c2[d + EC_FAR_SIZE - 1] - c2[d - 1];
+        if (e > best) {
+            best = e;
+            best_d = d;
+        }
+        mean += e;
+        nb++;
+    }
+    mean /= nb;
+    if (best < mean * EC_DELAY_THRESHOLD)
+        return;
+
+    /* all the windows containing the main peak have about the same
+       energy: the peak is placed at the first quarter of the filter */
+    d = best_d;
+    for(k=best_d;k<best_d+EC_FAR_SIZE;k++) {
+        if (c2[k] > c2[d])
+            d = k;
+    }
+    best_d = d - EC_FAR_SIZE / 4;
+    if (best_d < EC_NEAR_SIZE)
+        best_d = EC_NEAR_SIZE;
+    else if (best_d > EC_MAX_DELAY - EC_FAR_SIZE)
+        best_d = EC_MAX_DELAY - EC_FAR_SIZE;
+
+    s->far_delay = best_d;
+    memset(s->far_filter, 0, sizeof(s->far_filter));
+    memset(s->far_coef, 0, sizeof(s->far_coef));
+    h = s->tx_buf + s->tx_ptr + EC_HIST_SIZE - 1;
+    s->far_pow = 0;
+    for(k=0;k<EC_FAR_SIZE;k++)
+        s->far_pow += h[-best_d - k] * h[-best_d - k];
+}
+
+void echo_cancel(EchoCancelState *s, s16 *rx, const s16 *tx, int nb)
+{
+    const s16 *h, *xn, *xf;
+    int i, p, x, d, est, res;
+
+    for(i=0;i<nb;i++) {
+        x = tx[i];
+        p = s->tx_ptr;
+        s->tx_buf[p] = x;
+        s->tx_buf[p + EC_HIST_SIZE] = x;
+        if (++p == EC_HIST_SIZE)
+            p = 0;
+        s->tx_ptr = p;
+        /* h[-k] is the k-th previous transmitted sample */
+        h = s->tx_buf + p + EC_HIST_SIZE - 1;
+        s->near_pow += x * x - h[-EC_NEAR_SIZE] * h[-EC_NEAR_SIZE];
+        d = s->far_delay;
+        if (d >= 0) {
+            s->far_pow += h[-d] * h[-d] -
+                h[-d - EC_FAR_SIZE] * h[-d - EC_FAR_SIZE];
+        }
+        if (s->mode == EC_OFF)
+            continue;
+
+        xn = h - (EC_NEAR_SIZE - 1);
+        xf = h - d - (EC_FAR_SIZE - 1);
+        est = dsp_dot_prod(s->near_coef, xn, EC_NEAR_SIZE, 0);
+        if (d >= 0)
+            est = dsp_dot_prod(s->far_coef, xf, EC_FAR_SIZE, est);
+        res = rx[i] - (est >> 14);
+        if (res > 32767)
+            res = 32767;
+        else if (res < -32768)
+            res = -32768;
+        rx[i] = res;
+
+        ec_adapt(s->near_filter, s->near_coef, xn, EC_NEAR_SIZE,
+                 res, s->near_pow, s->mu_shift);
+        if (d >= 0) {
+            ec_adapt(s->far_filter, s->far_coef, xf, EC_FAR_SIZE,
+                     res, s->far_pow, s->mu_shift);
+        } else if (s->mode == EC_TRAIN &&
+                   s->train_count < EC_MAX_DELAY + EC_DELAY_WIN) {
+            /* the values are divided by 32 so that the correlation
+               cannot overflow */
+            s->est_tx[s->train_count] = x >> 5;
+            if (s->train_count >= EC_MAX_DELAY)
+                s->est_res[s->train_count - EC_MAX_DELAY] = res >> 5;
+            if (++s->train_count == EC_MAX_DELAY + EC_DELAY_WIN)
+                ec_estimate_delay(s);
+        }
+    }
+    lm_dump_echocancel(s->near_filter, 1 << 30, EC_NEAR_SIZE);
+}
+
+/* benchmark: echo return loss enhancement through the line model
+   (near echo of the modem hybrid, far echo of the central site
+   hybrid), first with the remote modem silent (training), then with
+   the remote modem transmitting (tracking). The echo is measured by
+   running a second line model without the local signal. */
+
+#define EC_BENCH_NB_SAMPLES 40
+#define EC_BENCH_TRAIN  8000   /* samples of training */
+#define EC_BENCH_TRACK  32000  /* samples of tracking */
+#define EC_BENCH_WINDOW 2000   /* samples per ERLE measure */
+
+/* wideband test signal */
+static int ec_bench_signal(int *mem)
+{
+    int r, v;
+
+    r = (random() % 16384) - 8192;
+    v = (r + *mem) >> 1;
+    *mem = r;
+    return v;
+}
+
+void echo_cancel_bench(void)
+{
+    struct sm_arena arena;
+    struct LineModelState *line, *line_ref;
+    EchoCancelState *s;
+    s16 loc[EC_BENCH_NB_SAMPLES], rem[EC_BENCH_NB_SAMPLES];
+    s16 zero[EC_BENCH_NB_SAMPLES], rx[EC_BENCH_NB_SAMPLES];
+    s16 rx_ref[EC_BENCH_NB_SAMPLES], out[EC_BENCH_NB_SAMPLES];
+    s16 out_ref[EC_BENCH_NB_SAMPLES];
+    int i, j, n, mem_loc, mem_rem, echo;
+    double echo_pow, res_pow;
+    s64 t, t_train, t_track;
+    s32 *filter;
+    s16 *coef;
+    s64 pow;
+
+    srandom(0);
+    s = malloc(sizeof(*s));
+    if (!s || sm_arena_init(&arena, 128 * 1024) < 0) {
+        fprintf(stderr, "echo_cancel_bench: no memory\n");
+        exit(1);
+    }
+    line = line_model_init(&arena);
+    line_ref = line_model_init(&arena);
+    line_model_set_snr(line, 50);
+    line_model_set_snr(line_ref, 50);
+
+    echo_cancel_init(s);
+    echo_cancel_set_mode(s, EC_TRAIN);
+    memset(zero, 0, sizeof(zero));
+    mem_loc = mem_rem = 0;
+    echo_pow = res_pow = 0;
+    t_train = t_track = 0;
+
+    printf("echo: near FIR of %d taps, far FIR of %d taps at the bulk delay "
+           "(max %d)\n", EC_NEAR_SIZE, EC_FAR_SIZE, EC_MAX_DELAY);
+    printf("ERLE (dB every %d samples) training:", EC_BENCH_WINDOW);
+    for(n=0;n<EC_BENCH_TRAIN + EC_BENCH_TRACK;n+=EC_BENCH_NB_SAMPLES) {
+        if (n == EC_BENCH_TRAIN) {
+            echo_cancel_set_mode(s, EC_TRACK);
+            printf("\n  bulk delay=%d, tracking (remote modem active):",
+                   s->far_delay);
+        }
+        for(j=0;j<EC_BENCH_NB_SAMPLES;j++) {
+            loc[j] = ec_bench_signal(&mem_loc);
+            rem[j] = 0;
+            if (n >= EC_BENCH_TRAIN)
+                rem[j] = ec_bench_signal(&mem_rem);
+        }
+        /* the local modem is the answer modem */
+        line_model(line, rx, rem, out, loc, EC_BENCH_NB_SAMPLES);
+        line_model(line_ref, rx_ref, rem, out_ref, zero, EC_BENCH_NB_SAMPLES);
+
+        for(j=0;j<EC_BENCH_NB_SAMPLES;j++) {
+            echo = rx[j] - rx_ref[j];
+            echo_pow += echo * echo;
+        }
+        t = bench_time();
+        echo_cancel(s, rx, loc, EC_BENCH_NB_SAMPLES);
+        t = bench_time() - t;
+        if (n < EC_BENCH_TRAIN)
+            t_train += t;
+        else
+            t_track += t;
+        for(j=0;j<EC_BENCH_NB_SAMPLES;j++) {
+            echo = rx[j] - rx_ref[j];
+            res_pow += echo * echo;
+        }
+        if (((n + EC_BENCH_NB_SAMPLES) % EC_BENCH_WINDOW) == 0) {
+            printf(" %5.1f", 10 * log10(echo_pow / (res_pow + 1)));
+            echo_pow = res_pow = 0;
+        }
+    }
+    printf("\n");
+
+    /* a single NLMS FIR covering the same delay */
+    filter = calloc(EC_HIST_SIZE, sizeof(s32));
+    coef = calloc(EC_HIST_SIZE, sizeof(s16));
+    if (!filter || !coef) {
+        fprintf(stderr, "echo_cancel_bench: no memory\n");
+        exit(1);
+    }
+    pow = 0;
+    for(i=0;i<EC_HIST_SIZE;i++)
+        pow += s->tx_buf[i] * s->tx_buf[i];
+    t = bench_time();
+    for(i=0;i<EC_BENCH_TRACK;i++) {
+        echo = dsp_dot_prod(coef, s->tx_buf, EC_HIST_SIZE, 0) >> 14;
+        ec_adapt(filter, coef, s->tx_buf, EC_HIST_SIZE,
+                 (i & 63) - echo, pow, EC_TRACK_SHIFT);
+    }
+    t = bench_time() - t;
+
+    printf("cost per channel: training %.1f us/s, tracking %.1f us/s "
+           "(single %d tap FIR: %.1f us/s)\n",
+           t_train * 8000.0 / EC_BENCH_TRAIN,
+           t_track * 8000.0 / EC_BENCH_TRACK,
+           EC_HIST_SIZE, t * 8000.0 / EC_BENCH_TRACK);
+
+    free(coef);
+    free(filter);
+    sm_arena_free(&arena);
+    free(s);
+}
@@ -0,0 +1,46 @@
+#ifndef ECHOCANCEL_H
+#define ECHOCANCEL_H
+
+/* line echo canceller: a FIR for the echo of the local hybrid and a
+   FIR placed at the bulk delay of the far (central site) echo. Both
+   are adapted with NLMS. */
+
+#define EC_NEAR_SIZE 64    /* taps of the near echo filter (8 ms) */
+#define EC_FAR_SIZE  64    /* taps of the far echo filter */
+#define EC_MAX_DELAY 1024  /* maximum bulk delay of the far echo (128 ms) */
+#define EC_DELAY_WIN 1024  /* samples used to estimate the bulk delay */
+#define EC_HIST_SIZE (EC_MAX_DELAY + EC_FAR_SIZE)
+
+enum {
+    EC_OFF,   /* no cancellation */
+    EC_TRAIN, /* the remote modem is silent: fast adaptation and bulk
+                 delay estimation */
+    EC_TRACK, /* data mode: slow adaptation */
+};
+
+typedef struct EchoCancelState {
+    int mode;
+    int mu_shift;                   /* NLMS step = 2^-mu_shift */
+    s32 near_filter[EC_NEAR_SIZE];  /* 16.16, 14 bits fractional part */
+    s16 near_coef[EC_NEAR_SIZE];    /* near_filter >> 16 */
+    s32 far_filter[EC_FAR_SIZE];
+    s16 far_coef[EC_FAR_SIZE];
+    int far_delay;                  /* bulk delay of the far echo, -1 if none */
+    /* transmitted samples: each one is stored twice so that the last
+       EC_HIST_SIZE ones are always at tx_buf[tx_ptr] */
+    s16 tx_buf[2 * EC_HIST_SIZE];
+    int tx_ptr;
+    s64 near_pow, far_pow;          /* energy of the samples in each filter */
+    /* bulk delay estimation (samples divided by 32) */
+    int train_count;
+    s16 est_tx[EC_MAX_DELAY + EC_DELAY_WIN];
+    s16 est_res[EC_DELAY_WIN];
+} EchoCancelState;
+
+void echo_cancel_init(EchoCancelState *s);
+void echo_cancel_set_mode(EchoCancelState *s, int mode);
+/* remove from rx[] the echo of the transmitted samples tx[] */
+void echo_cancel(EchoCancelState *s, s16 *rx, const s16 *tx, int nb);
+void echo_cancel_bench(void);
+
+#endif
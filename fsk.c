@@ -58,6 +58,7 @@ void FSK_demod_init(FSK_demod_state *s)
     memset(s->filter_buf, 0, sizeof(s->filter_buf));
     s->buf_ptr = s->filter_size;
     s->lastsample = 0;
+    memset(s->hp_buf, 0, sizeof(s->hp_buf));
 
     /* compute the filters */
     for(i=0;i<s->filter_size;i++) {
@@ -76,12 +77,13 @@ void FSK_demod_init(FSK_demod_state *s)
         s->shift++;
         a /= 2;
     }
-    printf("shift=%d\n", s->shift);
+    if (lm_debug)
+        printf("shift=%d\n", s->shift);
 }
 
 void FSK_demod(FSK_demod_state *s, const s16 *samples, unsigned int nb)
 {
-    int buf_ptr, corr, newsample, baud_pll, i;
+    int buf_ptr, corr, newsample, baud_pll, i, x;
     int sum;
 
     baud_pll = s->baud_pll;
@@ -89,7 +91,16 @@ void FSK_demod(FSK_demod_state *s, const s16 *samples, unsigned int nb)
 
     for(i=0;i<nb;i++) {
         /* add a new sample in the demodulation filter */
-        s->filter_buf[buf_ptr++] = samples[i] >> s->shift;
+        x = samples[i];
+        if (s->high_pass) {
+            /* (1 - z^-1) * (1 - z^-2): zeros at DC and at 4000 Hz,
+               gain of at most 4 */
+            x = (x - s->hp_buf[0] - s->hp_buf[1] + s->hp_buf[2]) >> 2;
+            s->hp_buf[2] = s->hp_buf[1];
+            s->hp_buf[1] = s->hp_buf[0];
+            s->hp_buf[0] = samples[i];
+        }
+        s->filter_buf[buf_ptr++] = x >> s->shift;
         if (buf_ptr == FSK_FILTER_BUF_SIZE) {
             memmove(s->filter_buf, 
                     s->filter_buf + FSK_FILTER_BUF_SIZE - s->filter_size, 
@@ -154,50 +165,53 @@ void FSK_demod(FSK_demod_state *s, const s16 *samples, unsigned int nb)
 
 #define MAXDELAY 32
 
-static int tx_bits[MAXDELAY], tx_ptr = 0, rx_ptr = 0;
-static int tx_blank = 32;
+typedef struct {
+    int tx_bits[MAXDELAY], tx_ptr, rx_ptr;
+    int tx_blank;
+    int nb_bits, errors, sync_count, got_sync;
+} TestState;
 
 /* transmit random bits with a sync header (31 ones, 1 zero) */
 static int test_get_bit(void *opaque)
 {
+    TestState *t = opaque;
     int bit;
 
-    if (tx_blank != 0) {
+    if (t->tx_blank != 0) {
         /* send 1 at the beginning for synchronization */
-        bit = (tx_blank > 1);
-        tx_blank--;
+        bit = (t->tx_blank > 1);
+        t->tx_blank--;
     } else {
         bit = random() % 2;
-        tx_bits[tx_ptr] = bit;
-        if (++tx_ptr == MAXDELAY)
-            tx_ptr = 0;
+        t->tx_bits[t->tx_ptr] = bit;
+        if (++t->tx_ptr == MAXDELAY)
+            t->tx_ptr = 0;
     }
     return bit;
 }
 
-static int nb_bits = 0, errors = 0, sync_count = 0, got_sync = 0;
-
 static void test_put_bit(void *opaque, int bit)
 {
+    TestState *t = opaque;
     int tbit;
     
-    if (!got_sync) {
+    if (!t->got_sync) {
         
         if (bit) {
-            sync_count++;
+            t->sync_count++;
         } else {
-            if (sync_count > 16)
-                got_sync = 1;
-            sync_count = 0;
+            if (t->sync_count > 16)
+                t->got_sync = 1;
+            t->sync_count = 0;
         }
     } else {
-        tbit = tx_bits[rx_ptr];
-        if (++rx_ptr == MAXDELAY)
-            rx_ptr = 0;
+        tbit = t->tx_bits[t->rx_ptr];
+        if (++t->rx_ptr == MAXDELAY)
+            t->rx_ptr = 0;
         if (bit != tbit) {
-            errors++;
+            t->errors++;
         }
-        nb_bits++;
+        t->nb_bits++;
     }
 }
 
@@ -212,6 +226,7 @@ void FSK_test(int do_v23)
     s16 buf2[NB_SAMPLES];
     s16 buf3[NB_SAMPLES];
     FILE *f1;
+    TestState t;
     
     err = lm_display_init();
     if (err < 0) {
@@ -219,7 +234,7 @@ void FSK_test(int do_v23)
         exit(1);
     }
 
-    line_state = line_model_init();
+    line_state = line_model_init(NULL);
 
     f1 = fopen("cal.sw", "wb");
     if (f1 == NULL) {
@@ -227,17 +242,18 @@ void FSK_test(int do_v23)
         exit(1);
     }
 
+    memset(&t, 0, sizeof(t));
+    t.tx_blank = 32;
+
     calling = 0;
     if (do_v23) {
-        V23_mod_init(&tx, calling, test_get_bit, NULL);
-        V23_demod_init(&rx, 1 - calling, test_put_bit, NULL);
+        V23_mod_init(&tx, calling, test_get_bit, &t);
+        V23_demod_init(&rx, 1 - calling, test_put_bit, &t);
     } else {
-        V21_mod_init(&tx, calling, test_get_bit, NULL);
-        V21_demod_init(&rx, 1 - calling, test_put_bit, NULL);
+        V21_mod_init(&tx, calling, test_get_bit, &t);
+        V21_demod_init(&rx, 1 - calling, test_put_bit, &t);
     }
 
-    nb_bits = 0;
-    errors = 0;
     for(;;) {
         if (lm_display_poll_event())
             break;
@@ -255,5 +271,5 @@ void FSK_test(int do_v23)
     fclose(f1);
 
     printf("errors=%d nb_bits=%d Pe=%f\n", 
-           errors, nb_bits, (float) errors / (float)nb_bits);
+           t.errors, t.nb_bits, (float) t.errors / (float)t.nb_bits);
 }
@@ -24,6 +24,7 @@ typedef struct {
     int f_lo,f_hi;
     int sample_rate;
     int baud_rate;
+    int high_pass;      /* true to reject the low frequencies */
 
     /* local variables */
     int filter_size;
@@ -40,6 +41,7 @@ typedef struct {
     int baud_pll, baud_pll_adj, baud_pll_threshold;
     int lastsample;
     int shift;
+    int hp_buf[3];      /* last samples of the high pass filter */
 
     void *opaque;
     put_bit_func put_bit;
@@ -35,7 +35,17 @@ static LinModemConfig default_lm_config =
     dtmf_level: -9, 
     dtmf_digit_length: 150,
     dtmf_pause_length: 100,
+    /* XXX: V34 is not advertised: its phase 2 is simplified (no
+       INFO0, INFO sequences sent with V21, see v34phase2.c), so it
+       only works between two linmodems */
     available_modulations: V8_MOD_V21 | V8_MOD_V23,
+    lapm_fcs32: 0,
+    lapm_n401: 128,
+    v42bis_n2: 2048,
+    v42bis_n7: 32,
+    wake_level: -43,
+    sleep_delay: 1000,
+    v34_rx_pipeline: 1,
 };
 
 /* fifo handling */
@@ -118,21 +128,18 @@ int sm_get_bits(struct sm_fifo *f, int n)
 
 /* timer handling */
 
-/* note: the current time handling is horrible because we use a global
-   state which is initialized when entering in sm_process() */
-static unsigned int sim_time;
-
-
-/* current time, in samples */
-int sm_time(void)
+/* 'clock' is usually the time of the modem (sm->time), which is
+   advanced at the end of sm_process() */
+void sm_timer_init(struct sm_timer *t, const unsigned int *clock)
 {
-    return sim_time;
+    t->clock = clock;
+    t->timeout = 0;
 }
 
 /* delay is in ms */
 void sm_set_timer(struct sm_timer *t, int delay)
 {
-    t->timeout = sm_time() + (delay * 8000) / 1000;
+    t->timeout = *t->clock + (delay * 8000) / 1000;
 }
 
 /* return 1 if timer expired */
@@ -140,7 +147,7 @@ int sm_check_timer(struct sm_timer *t)
 {
     long timeout;
     
-    timeout = sm_time();
+    timeout = *t->clock;
     return (timeout >= t->timeout);
 }
 
@@ -169,10 +176,112 @@ static void dtmf_put_digit(void *opaque, int digit)
     printf("DTMF: got digit '%c'\n", digit);
 }
 
+/* update the quiet time counter. Return true if the block is quiet */
+static int sm_update_quiet(struct sm_state *sm, const s16 *input, int nb_samples)
+{
+    if (dsp_sum_abs(input, nb_samples) <= sm->wake_threshold * nb_samples) {
+        sm->quiet_samples += nb_samples;
+        return 1;
+    } else {
+        sm->quiet_samples = 0;
+        return 0;
+    }
+}
+
+static void sm_wakeup(struct sm_state *sm)
+{
+    sm->sleeping = 0;
+    sm->quiet_samples = 0;
+}
+
+/* select the bit I/O of the data pump: V42 LAPM (with V42bis
+   compression if configured) if negotiated, asynchronous
+   otherwise. The rates (in bits/s) are only used by LAPM. The block
+   bit I/O is also returned in 'get_bits' and 'put_bits' if they are
+   not NULL. */
+static void sm_data_init(struct sm_state *sm, int lapm, 
+                         int tx_rate, int rx_rate,
+                         get_bit_func *get_bit, put_bit_func *put_bit,
+                         get_bits_func *get_bits, put_bits_func *put_bits,
+                         void **opaque)
+{
+    struct sm_fifo *rx_fifo, *tx_fifo;
+
+    sm->v42bis = NULL;
+    if (lapm) {
+        rx_fifo = &sm->rx_fifo;
+        tx_fifo = &sm->tx_fifo;
+        /* XXX: no XID negotiation, both modems must use the same
+           parameters */
+        if (sm->lm_config->v42bis_n2 > 0) {
+            sm->v42bis = sm_call_alloc(sm, sizeof(V42bisState));
+            if (sm->v42bis &&
+                v42bis_init(sm->v42bis, &sm->call_arena,
+                            sm->lm_config->v42bis_n2, 
+                            sm->lm_config->v42bis_n7) == 0) {
+                rx_fifo = &sm->v42bis->rx_fifo;
+                tx_fifo = &sm->v42bis->tx_fifo;
+            } else {
+                sm->v42bis = NULL;
+            }
+        }
+        sm->v42 = sm_call_alloc(sm, sizeof(V42State));
+        if (sm->v42) {
+            v42_init(sm->v42, sm->calling, sm->lm_config->lapm_fcs32,
+                     sm->lm_config->lapm_n401, tx_rate, rx_rate,
+                     rx_fifo, tx_fifo, &sm->time);
+            *get_bit = v42_get_bit;
+            *put_bit = v42_put_bit;
+            if (get_bits)
+                *get_bits = v42_get_bits;
+            if (put_bits)
+                *put_bits = v42_put_bits;
+            *opaque = sm->v42;
+            return;
+        }
+    }
+    sm->v42 = NULL;
+    sm->v42bis = NULL;
+    *get_bit = serial_get_bit;
+    *put_bit = serial_put_bit;
+    if (get_bits)
+        *get_bits = serial_get_bits;
+    if (put_bits)
+        *put_bits = serial_put_bits;
+    *opaque = sm;
+}
+
+/* return true if the data connection must be closed. With LAPM, a
+   DISC is sent first. */
+static int sm_data_hangup(struct sm_state *sm, int pump_ret)
+{
+    if (pump_ret)
+        return 1;
+    if (!sm->v42)
+        return sm->hangup_request;
+    if (sm->hangup_request && sm->v42->state != V42_DISCONNECTING)
+        v42_disconnect(sm->v42);
+    return v42_closed(sm->v42);
+}
+
+/* stop the threads of the V34 receiver before the call arena is
+   reset */
+static void sm_v34_close(struct sm_state *sm)
+{
+    if (sm->u.v34_state->rx_pipe) {
+        V34_pipeline_free(sm->u.v34_state->rx_pipe);
+        sm->u.v34_state->rx_pipe = NULL;
+    }
+}
+
 void sm_process(struct sm_state *sm, s16 *output, s16 *input, int nb_samples)
 {
-    /* XXX: time hack */
-    sim_time = sm->time;
+    /* idle channel: no DSP at all until something happens on the line */
+    if (!lm_wakeup_check(sm, input, nb_samples)) {
+        memset(output, 0, nb_samples * sizeof(s16));
+        sm->time += nb_samples;
+        return;
+    }
 
     /* modulation */
     switch(sm->state) {
@@ -188,7 +297,15 @@ void sm_process(struct sm_state *sm, s16 *output, s16 *input, int nb_samples)
     /* demodulation */
     switch(sm->state) {
     case SM_TEST_RING2:
-        DTMF_demod(&sm->dtmf_rx, input, nb_samples);
+        /* once the DTMF window only contains silence, the DFTs are
+           useless: we just reset the decoder as a silent block would do */
+        if (sm_update_quiet(sm, input, nb_samples) &&
+            sm->quiet_samples >= DTMF_N) {
+            sm->dtmf_rx.buf_ptr = 0;
+            sm->dtmf_rx.last_digit = 0;
+        } else {
+            DTMF_demod(&sm->dtmf_rx, input, nb_samples);
+        }
         break;
     }
 
@@ -204,11 +321,22 @@ void sm_process(struct sm_state *sm, s16 *output, s16 *input, int nb_samples)
         
         /* nothing to do (except waiting for a connection) */
     case SM_IDLE:
+        /* go to sleep after some quiet time */
+        if (sm->lm_config->sleep_delay >= 0 &&
+            sm_update_quiet(sm, input, nb_samples) &&
+            sm->quiet_samples >= (sm->lm_config->sleep_delay * 8000) / 1000) {
+            sm->sleeping = 1;
+        }
         break;
 
     case SM_GO_ONHOOK:
         {
             sm->hw->set_offhook(sm->hw_state, 0);
+            /* free all the states of the call */
+            sm_arena_reset(&sm->call_arena);
+            sm->v42 = NULL;
+            sm->v42bis = NULL;
+            sm->quiet_samples = 0;
             sm->state = SM_IDLE;
         }
         break;
@@ -258,7 +386,8 @@ void sm_process(struct sm_state *sm, s16 *output, s16 *input, int nb_samples)
         {
             if (sm_check_timer(&sm->dtmf_timer)) {
                 /* start of V8 */
-                V8_init(&sm->u.v8_state, 1, sm->lm_config->available_modulations);
+                V8_init(&sm->u.v8_state, 1, sm->lm_config->available_modulations,
+                        &sm->time);
                 sm->state = SM_V8;
             }
         }
@@ -271,6 +400,7 @@ void sm_process(struct sm_state *sm, s16 *output, s16 *input, int nb_samples)
     case SM_TEST_RING:
         {
             sm->calling = 0;
+            sm->quiet_samples = 0;
             sm->dtmf_rx.opaque = sm;
             sm->dtmf_rx.put_digit = dtmf_put_digit;
             DTMF_demod_init(&sm->dtmf_rx);
@@ -295,7 +425,8 @@ void sm_process(struct sm_state *sm, s16 *output, s16 *input, int nb_samples)
             sm->calling = 0;
             sm->hangup_request = 0;
             sm->hw->set_offhook(sm->hw_state, 1);
-            V8_init(&sm->u.v8_state, 0, sm->lm_config->available_modulations);
+            V8_init(&sm->u.v8_state, 0, sm->lm_config->available_modulations,
+                    &sm->time);
             sm->state = SM_V8;
         }
         break;
@@ -303,26 +434,66 @@ void sm_process(struct sm_state *sm, s16 *output, s16 *input, int nb_samples)
         /* V8 handling (both calling & receive) */
     case SM_V8:
         {
-            int ret;
+            int ret, lapm;
+            get_bit_func get_bit;
+            put_bit_func put_bit;
+            void *opaque;
+
             if (sm->hangup_request) {
                 printf("ddezde\n");
                 sm->state = SM_GO_ONHOOK;
             } else {
                 ret = V8_process(&sm->u.v8_state, output, input, nb_samples);
+                lapm = (sm->u.v8_state.selected_mod_mask & V8_PROT_LAPM) != 0;
                 switch(ret) {
                 case V8_MOD_HANGUP:
                     sm->state = SM_GO_ONHOOK;
                     break;
                 case V8_MOD_V21:
+                    sm_data_init(sm, lapm, 300, 300, 
+                                 &get_bit, &put_bit, NULL, NULL, &opaque);
                     V21_init(&sm->u.v21_state, sm->calling,
-                             serial_get_bit, serial_put_bit, sm);
+                             get_bit, put_bit, opaque);
                     sm->state = SM_V21;
                     break;
                 case V8_MOD_V23:
+                    /* the caller sends at 75 bauds */
+                    sm_data_init(sm, lapm, 
+                                 sm->calling ? 75 : 1200, 
+                                 sm->calling ? 1200 : 75, 
+                                 &get_bit, &put_bit, NULL, NULL, &opaque);
                     V23_init(&sm->u.v23_state, sm->calling,
-                             serial_get_bit, serial_put_bit, sm);
+                             get_bit, put_bit, opaque);
                     sm->state = SM_V23;
                     break;
+                case V8_MOD_V34:
+                    sm->u.v34_state = sm_call_alloc(sm, sizeof(V34State));
+                    if (!sm->u.v34_state) {
+                        sm->state = SM_GO_ONHOOK;
+                        break;
+                    }
+                    V34_init(sm->u.v34_state, sm->calling,
+                             NULL, NULL, NULL);
+                    /* the rates are only known after the line
+                       probing: the lowest V34 rate gives the longest
+                       LAPM timers */
+                    sm_data_init(sm, lapm, 2400, 2400,
+                                 &sm->u.v34_state->get_bit,
+                                 &sm->u.v34_state->put_bit,
+                                 &sm->u.v34_state->get_bits,
+                                 &sm->u.v34_state->put_bits,
+                                 &opaque);
+                    sm->u.v34_state->opaque = opaque;
+                    /* the stages of the receiver run in other threads
+                       (in sequence if they cannot be started) */
+                    if (sm->lm_config->v34_rx_pipeline &&
+                        sysconf(_SC_NPROCESSORS_ONLN) > 1) {
+                        sm->u.v34_state->rx_pipe =
+                            V34_pipeline_new(&sm->u.v34_state->v34_rx,
+                                             &sm->call_arena);
+                    }
+                    sm->state = SM_V34;
+                    break;
                 }
             }
         }
@@ -332,8 +503,10 @@ void sm_process(struct sm_state *sm, s16 *output, s16 *input, int nb_samples)
     case SM_V21:
         {
             int ret;
+            if (sm->v42bis)
+                v42bis_process(sm->v42bis, &sm->rx_fifo, &sm->tx_fifo);
             ret = V21_process(&sm->u.v21_state, output, input, nb_samples);
-            if (ret || sm->hangup_request)
+            if (sm_data_hangup(sm, ret))
                 sm->state = SM_GO_ONHOOK;
         }
         break;
@@ -342,15 +515,30 @@ void sm_process(struct sm_state *sm, s16 *output, s16 *input, int nb_samples)
     case SM_V23:
         {
             int ret;
+            if (sm->v42bis)
+                v42bis_process(sm->v42bis, &sm->rx_fifo, &sm->tx_fifo);
             ret = V23_process(&sm->u.v23_state, output, input, nb_samples);
-            if (ret || sm->hangup_request)
+            if (sm_data_hangup(sm, ret))
+                sm->state = SM_GO_ONHOOK;
+        }
+        break;
+
+        /* V34 handling (both calling & receive) */
+    case SM_V34:
+        {
+            int ret;
+            if (sm->v42bis)
+                v42bis_process(sm->v42bis, &sm->rx_fifo, &sm->tx_fifo);
+            ret = V34_process(sm->u.v34_state, output, input, nb_samples);
+            if (sm_data_hangup(sm, ret)) {
+                sm_v34_close(sm);
                 sm->state = SM_GO_ONHOOK;
+            }
         }
         break;
     }
 
-    /* XXX: time hack */
-    sm->time = sim_time + nb_samples;
+    sm->time += nb_samples;
 }
 
 /*
@@ -360,6 +548,7 @@ int lm_start_dial(struct sm_state *s, int pulse, const char *number)
 {
     if (s->state != SM_IDLE)
         return -1;
+    sm_wakeup(s);
     s->pulse_dial = pulse;
     strcpy(s->call_num, number);
     s->state = SM_CALL;
@@ -373,6 +562,7 @@ int lm_start_receive(struct sm_state *s)
 {
     if (s->state != SM_IDLE)
         return -1;
+    sm_wakeup(s);
     s->state = SM_RECEIVE;
     return 0;
 }
@@ -384,10 +574,44 @@ int lm_hangup(struct sm_state *s)
 {
     if (s->state == SM_IDLE)
         return -1;
+    sm_wakeup(s);
     s->hangup_request = 1;
     return 0;
 }
 
+/*
+ * must be called by the driver when a ring is detected
+ */
+void lm_ring(struct sm_state *s)
+{
+    s->nb_rings++;
+    sm_wakeup(s);
+}
+
+/*
+ * return true if the modem is sleeping. In this case, the driver
+ * may even not call sm_process() until a ring or a host command
+ * occurs (the output must then be silence).
+ */
+int lm_is_sleeping(struct sm_state *s)
+{
+    return s->sleeping;
+}
+
+/*
+ * check if the input samples must wake up a sleeping modem. Return
+ * true if the modem is awake.
+ */
+int lm_wakeup_check(struct sm_state *s, const s16 *input, int nb_samples)
+{
+    if (!s->sleeping)
+        return 1;
+    if (dsp_sum_abs(input, nb_samples) <= s->wake_threshold * nb_samples)
+        return 0;
+    sm_wakeup(s);
+    return 1;
+}
+
 /* 
  * return a simplified state of the modem.
  */
@@ -399,13 +623,39 @@ enum lm_get_state_val lm_get_state(struct sm_state *s)
     case SM_V21:
     case SM_V23: 
         return LM_STATE_CONNECTED;
+    case SM_V34:
+        /* after the training */
+        if (s->u.v34_state->v34_tx.state == V34_DATA &&
+            s->u.v34_state->v34_rx.state == V34_DATA)
+            return LM_STATE_CONNECTED;
+        return LM_STATE_CONNECTING;
     default:
         return LM_STATE_CONNECTING;
     }
 }
 
+/*
+ * allocate memory for the current call. It is freed when the modem
+ * goes on hook. Return NULL if the call arena is too small.
+ */
+void *sm_call_alloc(struct sm_state *sm, int size)
+{
+    void *ptr;
 
-void lm_init(struct sm_state *sm, struct sm_hw_info *hw, const char *name)
+    ptr = sm_arena_alloc(&sm->call_arena, size);
+    if (!ptr)
+        fprintf(stderr, "%s: call arena full (%d bytes needed)\n",
+                sm->name, size);
+    return ptr;
+}
+
+/*
+ * init a modem. The driver state & the per call arena are carved in
+ * 'arena' (or taken from the heap if 'arena' is NULL, lm_close() then
+ * frees them). Return -1 if there is not enough memory.
+ */
+int lm_init(struct sm_state *sm, struct sm_hw_info *hw, const char *name,
+            struct sm_arena *arena)
 {
     memset(sm, 0, sizeof(*sm));
     sm->hw = hw;
@@ -417,16 +667,84 @@ void lm_init(struct sm_state *sm, struct sm_hw_info *hw, const char *name)
     sm_init_fifo(&sm->tx_fifo, sm->tx_fifo_buf, SM_FIFO_SIZE);
     sm_init_fifo(&sm->rx_fifo, sm->rx_fifo_buf, SM_FIFO_SIZE);
     
+    if (sm_arena_init_sub(&sm->call_arena, arena, SM_CALL_ARENA_SIZE) < 0) {
+        fprintf(stderr, "%s: could not allocate call arena\n", name);
+        return -1;
+    }
+
     /* we open the hardware driver */
-    sm->hw_state = malloc(sizeof(struct lm_interface_state)); 
+    sm->hw_state = sm_arena_alloc(arena, sizeof(struct lm_interface_state)); 
+    if (!sm->hw_state) {
+        fprintf(stderr, "%s: could not allocate driver state\n", name);
+        sm_arena_free(&sm->call_arena);
+        return -1;
+    }
+    sm->hw_state_allocated = (arena == NULL);
     sm->hw_state->sm = sm;
     sm->hw->open(sm->hw_state);
     
     sm->debug_laststate = -1;
     sm->state = SM_IDLE;
+    sm_timer_init(&sm->dtmf_timer, &sm->time);
+    sm_timer_init(&sm->ring_timer, &sm->time);
 
     /* config */
     sm->lm_config = &default_lm_config;
+
+    /* mean absolute value of a sine wave at wake_level */
+    sm->wake_threshold = (int) (pow(10, sm->lm_config->wake_level / 20.0) * 
+                                32768.0 * 2.0 / M_PI);
+    return 0;
+}
+
+/*
+ * close the driver of a modem initialized by lm_init(). The memory
+ * taken in an arena is freed with the arena.
+ */
+void lm_close(struct sm_state *sm)
+{
+    if (sm->state == SM_V34)
+        sm_v34_close(sm);
+    sm->hw->close(sm->hw_state);
+    if (sm->hw_state_allocated)
+        free(sm->hw_state);
+    sm->hw_state = NULL;
+    sm_arena_free(&sm->call_arena);
+}
+
+/*
+ * allocate & init a modem in 'arena'. Return NULL if the arena is
+ * too small.
+ */
+struct sm_state *lm_new(struct sm_arena *arena, 
+                        struct sm_hw_info *hw, const char *name)
+{
+    struct sm_state *sm;
+    int mark;
+
+    mark = 0;
+    if (arena)
+        mark = sm_arena_mark(arena);
+    sm = sm_arena_alloc(arena, sizeof(struct sm_state));
+    if (!sm)
+        return NULL;
+    if (lm_init(sm, hw, name, arena) < 0) {
+        if (arena)
+            sm_arena_release(arena, mark);
+        else
+            free(sm);
+        return NULL;
+    }
+    sm->allocated = (arena == NULL);
+    return sm;
+}
+
+/* close & free a modem allocated by lm_new() */
+void lm_delete(struct sm_state *sm)
+{
+    lm_close(sm);
+    if (sm->allocated)
+        free(sm);
 }
 
 
@@ -445,8 +763,10 @@ void help(void)
            "Test options:\n"
            "-v : verbose mode (additive)\n"
            "-s : modem test with the line simulator\n"
+           "-o ppm: clock offset of the answer modem in the line simulator\n"
            "-m mod: test the modulation 'mod'. 'mod' can be:\n"
-           "        v21, v23, v22, v34, v90\n"
+           "        v21, v23, v22, v34, v90 (v42: LAPM layer)\n"
+           "-b name: run the benchmark 'name' ('all' runs all of them)\n"
            "\n"
            "Sound card support\n"
            "-t : use sound card as modem\n"
@@ -466,6 +786,8 @@ enum {
     MODE_V23TEST,
     MODE_V34TEST,
     MODE_V90TEST,
+    MODE_V42TEST,
+    MODE_BENCH,
     MODE_LTMODEM_CALL,
     MODE_LTMODEM_ANSWER,
     MODE_SOUNDCARD,
@@ -477,6 +799,8 @@ extern char *modem_command, *dial_number;
 int main(int argc, char **argv)
 {
     int c, mode, calling;
+    const char *bench_name = NULL;
+    float clock_offset = 0;
     
     signal(SIGUSR1, sigusr1_debug);
     
@@ -484,7 +808,7 @@ int main(int argc, char **argv)
     calling = 0;
 
     for(;;) {
-        c = getopt(argc, argv, "hvstrac:d:m:");
+        c = getopt(argc, argv, "hvstrac:d:m:b:o:");
         if (c == -1) break;
         switch(c) {
         case 'v':
@@ -501,14 +825,23 @@ int main(int argc, char **argv)
                 mode = MODE_V34TEST;
             else if (!strcasecmp(optarg, "v90"))
                 mode = MODE_V90TEST;
+            else if (!strcasecmp(optarg, "v42"))
+                mode = MODE_V42TEST;
             else {
                 fprintf(stderr, "incorrect modulation: '%s'\n", optarg);
                 exit(1);
             }
 	    break;
+        case 'b':
+            mode = MODE_BENCH;
+            bench_name = optarg;
+            break;
         case 's':
             mode = MODE_LINESIM;
             break;
+        case 'o':
+            clock_offset = atof(optarg);
+            break;
         case 't':
             mode = MODE_SOUNDCARD;
             break;
@@ -557,8 +890,14 @@ int main(int argc, char **argv)
     case MODE_V90TEST:
         V90_test();
         break;
+    case MODE_V42TEST:
+        V42_test();
+        break;
+    case MODE_BENCH:
+        lm_bench(bench_name);
+        break;
     case MODE_LINESIM:
-        line_simulate();
+        line_simulate(clock_offset);
         break;
     case MODE_LTMODEM_CALL:
     case MODE_LTMODEM_ANSWER:
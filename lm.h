@@ -23,16 +23,44 @@ int sm_get_bit(struct sm_fifo *f);
 int sm_get_bits(struct sm_fifo *f, int n);
 void sm_init_fifo(struct sm_fifo *f, u8 *buf, int size);
 
+/* memory arena (arena.c) */
+
+struct sm_arena {
+    u8 *base;
+    int size;       /* size of the arena in bytes */
+    int ptr;        /* current allocation offset */
+    int allocated;  /* true if base was malloc'ed by sm_arena_init */
+    /* statistics */
+    int high_water; /* maximum value of ptr */
+    int nb_allocs;
+    int nb_failed;
+    int nb_resets;
+};
+
+int sm_arena_init(struct sm_arena *a, int size);
+int sm_arena_init_sub(struct sm_arena *a, struct sm_arena *parent, int size);
+void sm_arena_free(struct sm_arena *a);
+void *sm_arena_alloc(struct sm_arena *a, int size);
+int sm_arena_mark(struct sm_arena *a);
+void sm_arena_release(struct sm_arena *a, int mark);
+void sm_arena_reset(struct sm_arena *a);
+void sm_arena_dump(struct sm_arena *a, const char *name);
+
 /* bit I/O for data pumps */
 typedef void (*put_bit_func)(void *opaque, int bit);
 typedef int (*get_bit_func)(void *opaque);
+/* block bit I/O: 'n' bits packed MSB first (oldest bit in the MSB) */
+typedef void (*put_bits_func)(void *opaque, int bits, int n);
+typedef int (*get_bits_func)(void *opaque, int n);
 
-/* timer */
+/* timer: it reads the time of its modem through 'clock', so that
+   each modem has its own time */
 struct sm_timer {
+    const unsigned int *clock; /* current time, in samples */
     long timeout;
 };
 
-int sm_time(void);
+void sm_timer_init(struct sm_timer *t, const unsigned int *clock);
 void sm_set_timer(struct sm_timer *t, int delay);
 int sm_check_timer(struct sm_timer *t);
 
@@ -43,22 +71,35 @@ extern char *sm_states_str[];
 /* protocol description */
 
 #include "dtmf.h"
+#include "echocancel.h"
 #include "fsk.h"
+#include "scrambler.h"
 #include "v21.h"
 #include "v22.h"
 #include "v23.h"
 #include "v8.h"
 #include "v34.h"
+#include "v42.h"
+#include "v42bis.h"
 
 /* modem state */
 #define SM_FIFO_SIZE 4096
 
+/* size of the arena reserved by each modem for its per call states
+   (the V34 state & its pipelined receiver, the V42 & V42bis states) */
+#define SM_CALL_ARENA_SIZE (128 * 1024 + sizeof(V34State) + V34_PIPELINE_SIZE)
+
 struct sm_state {
     /* pretty name of the modem (to debug) */
     char name[16];
 
     struct sm_hw_info *hw;
     struct lm_interface_state *hw_state;
+    int hw_state_allocated; /* true if hw_state was taken from the heap */
+    int allocated;          /* true if lm_new() took sm from the heap */
+
+    /* per call states are allocated here. It is reset at hangup */
+    struct sm_arena call_arena;
 
     /* bytes to be transmitted */
     struct sm_fifo tx_fifo;
@@ -83,11 +124,13 @@ struct sm_state {
     struct sm_timer ring_timer;
     DTMF_demod_state dtmf_rx;
 
-    /* modulation state */
+    /* modulation state. The V34 state is too big to be kept for
+       each modem: it is in the call arena */
     union {
         V8State v8_state;
         V21State v21_state;
         V23State v23_state;
+        V34State *v34_state;
     } u;
 
     /* serial state */
@@ -95,18 +138,33 @@ struct sm_state {
     int serial_parity, serial_use_parity;
     int serial_wordsize;
 
-    unsigned int serial_buf;
+    u16 serial_tx_tab[256];  /* framed word for each byte */
+    s16 serial_rx_tab[512];  /* byte for each word body, -1 if bad parity */
+
+    u64 serial_buf;
     int serial_cnt;
     
-    unsigned int serial_tx_buf;
+    u64 serial_tx_buf;
     int serial_tx_cnt;
 
+    /* V42 LAPM state (in the call arena), NULL if async */
+    V42State *v42;
+    /* V42bis state (in the call arena), NULL if no compression */
+    V42bisState *v42bis;
+
     /* main modem state */
     int state;
     int debug_laststate;
     int hangup_request;
     unsigned int time; /* current time (in samples) */
 
+    /* idle channel handling: when sleeping, no DSP is done until the
+       input energy, a ring or a host command wakes the modem */
+    int sleeping;
+    int quiet_samples;  /* number of consecutive quiet input samples */
+    int wake_threshold; /* mean absolute sample value to wake up */
+    int nb_rings;       /* number of rings reported by the driver */
+
     /* config */
     struct LinModemConfig *lm_config;
 };
@@ -118,6 +176,13 @@ typedef struct LinModemConfig {
     int dtmf_digit_length; /* in ms */
     int dtmf_pause_length; /* in ms */
     int available_modulations; /* mask of available modulations */
+    int lapm_fcs32;   /* use a 32 bit FCS for LAPM (no XID negotiation) */
+    int lapm_n401;    /* maximum size of the transmitted LAPM I frames */
+    int v42bis_n2;    /* V42bis dictionary size over LAPM, 0 = disabled */
+    int v42bis_n7;    /* V42bis maximum string length */
+    int wake_level;   /* input level (in dB) which wakes an idle modem */
+    int sleep_delay;  /* quiet time before sleeping (in ms, -1 = never) */
+    int v34_rx_pipeline; /* pipelined V34 receiver if several CPUs */
 } LinModemConfig;
 
 /* abstract line interface driver */
@@ -135,8 +200,8 @@ struct sm_hw_info {
     /* off hook or on hook modem */
     void (*set_offhook)(struct lm_interface_state *s, int v);
 
-    /* when the ring is enabled, an event E_RING is sent to the
-       process if a ring occured */
+    /* when the ring is enabled, the driver must call lm_ring() if
+       a ring occured */
     void (*set_ring)(struct lm_interface_state *s, int v);
 
     /* the main modem loop is here */
@@ -150,14 +215,30 @@ enum {
 #include "lmstates.h"
 };
 
-void lm_init(struct sm_state *sm, struct sm_hw_info *hw, const char *name);
-
-/* main modem process */
+int lm_init(struct sm_state *sm, struct sm_hw_info *hw, const char *name,
+            struct sm_arena *arena);
+void lm_close(struct sm_state *sm);
+struct sm_state *lm_new(struct sm_arena *arena, 
+                        struct sm_hw_info *hw, const char *name);
+void lm_delete(struct sm_state *sm);
+void *sm_call_alloc(struct sm_state *sm, int size);
+
+/* main modem process.
+
+   Threads: all the state of a modem is in its sm_state and its arena,
+   and the constant tables are computed by dsp_init() and
+   V34_static_init() before any modem is created. So several modems
+   can run in different threads, but a given modem (and its arena) must
+   only be used by one thread at a time. The bit callbacks are called
+   by the thread which runs the data pump. */
 void sm_process(struct sm_state *sm, s16 *output, s16 *input, int nb_samples);
 
 int lm_start_dial(struct sm_state *s, int pulse, const char *number);
 int lm_start_receive(struct sm_state *s);
 int lm_hangup(struct sm_state *s);
+void lm_ring(struct sm_state *s);
+int lm_is_sleeping(struct sm_state *s);
+int lm_wakeup_check(struct sm_state *s, const s16 *input, int nb_samples);
 
 enum lm_get_state_val {
     LM_STATE_IDLE,
@@ -169,16 +250,29 @@ enum lm_get_state_val lm_get_state(struct sm_state *s);
 
 /* lmsim.c */
 
-void line_simulate(void);
+void line_simulate(float clock_offset);
 
 struct LineModelState;
 
-struct LineModelState *line_model_init(void);
+/* a line model has its own noise generator, so each simulation
+   thread can have its own line */
+struct LineModelState *line_model_init(struct sm_arena *arena);
+void line_model_set_snr(struct LineModelState *s, float snr);
+void line_model_set_seed(struct LineModelState *s, unsigned int seed);
+void line_model_set_clock_offset(struct LineModelState *s, float ppm);
+/* tests only: they use the global state of random() */
+float random_unif(void);
+float random_gaussian(void);
 void line_model(struct LineModelState *s, 
                 s16 *output1, const s16 *input1,
                 s16 *output2, const s16 *input2,
                 int nb_samples);
 
+/* bench.c */
+
+s64 bench_time(void);
+void lm_bench(const char *name);
+
 /* lmreal.c */
 
 void real_test(int calling);
@@ -191,6 +285,9 @@ void soundcard_modem(void);
 void serial_init(struct sm_state *s, int data_bits, int parity);
 int serial_get_bit(void *opaque);
 void serial_put_bit(void *opaque, int bit);
+int serial_get_bits(void *opaque, int n);
+void serial_put_bits(void *opaque, int bits, int n);
+void serial_bench(void);
 
 /* atparser.c */
 
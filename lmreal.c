@@ -34,7 +34,8 @@ void real_test(int calling)
     s16 in_buf[NB_SAMPLES];
     s16 out_buf[NB_SAMPLES];
 
-    lm_init(dce, &sm_hw_null, "real");
+    if (lm_init(dce, &sm_hw_null, "real", NULL) < 0)
+        exit(1);
 
     strcpy(dce->call_num,dial_number);
 
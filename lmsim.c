@@ -15,6 +15,10 @@
 
 #define SAMPLE_REF  0x4000  /* 0 dB reference (sample level) */
 
+/* arena of the simulation: two modems & the line model */
+#define SIM_ARENA_SIZE (2 * (sizeof(struct sm_state) + SM_CALL_ARENA_SIZE) + \
+                        64 * 1024)
+
 /* 'calling' is used to know in which direction we transmit for echo cancellation */
 struct sm_hw_info sm_hw_null;
 
@@ -43,13 +47,16 @@ static void tx_rx(struct sm_state *A, struct sm_state *B, int dump)
         }
 }
 
-void line_simulate(void)
+/* 'clock_offset' is the clock offset of the answer modem (in ppm) */
+void line_simulate(float clock_offset)
 {
-    struct sm_state sm1, sm2, *call_dce = &sm1, *answer_dce = &sm2;
+    struct sm_arena arena;
+    struct sm_state *call_dce, *answer_dce;
     s16 answer_buf[NB_SAMPLES], call_buf[NB_SAMPLES];
     s16 answer_buf1[NB_SAMPLES], call_buf1[NB_SAMPLES];
     FILE *f1,*f2;
     struct LineModelState *line_state;
+    LinModemConfig config;
     int err;
 
     err = lm_display_init();
@@ -58,11 +65,29 @@ void line_simulate(void)
         exit(1);
     }
 
-    line_state = line_model_init();
+    if (sm_arena_init(&arena, SIM_ARENA_SIZE) < 0) {
+        fprintf(stderr, "Could not allocate simulation arena\n");
+        exit(1);
+    }
+
+    line_state = line_model_init(&arena);
+    if (line_state)
+        line_model_set_clock_offset(line_state, clock_offset);
 
     /* init two modems */
-    lm_init(call_dce, &sm_hw_null, "cal");
-    lm_init(answer_dce, &sm_hw_null, "ans");
+    call_dce = lm_new(&arena, &sm_hw_null, "cal");
+    answer_dce = lm_new(&arena, &sm_hw_null, "ans");
+    if (!line_state || !call_dce || !answer_dce) {
+        fprintf(stderr, "Simulation arena too small\n");
+        exit(1);
+    }
+
+    /* both modems are linmodems, so the simplified V34 startup can
+       be used (it is not in the default modulations) */
+    config = *call_dce->lm_config;
+    config.available_modulations |= V8_MOD_V34;
+    call_dce->lm_config = &config;
+    answer_dce->lm_config = &config;
 
     /* start calls */
     lm_start_dial(call_dce, 0, "1234567890");
@@ -117,12 +142,21 @@ void line_simulate(void)
     fclose(f1);
     fclose(f2);
 
+    if (lm_debug) {
+        sm_arena_dump(&arena, "sim");
+        sm_arena_dump(&call_dce->call_arena, call_dce->name);
+        sm_arena_dump(&answer_dce->call_arena, answer_dce->name);
+    }
+
     for(;;) {
         if (lm_display_poll_event())
             break;
     }
 
     lm_display_close();
+    lm_delete(call_dce);
+    lm_delete(answer_dce);
+    sm_arena_free(&arena);
 }
 
 static int sim_open(struct lm_interface_state *s)
@@ -166,6 +200,20 @@ struct sm_hw_info sm_hw_null =
 #define A 0.99 /* constant for exponential averaging for power estimations */
 #define FFT_SIZE    1024
 
+/* clock offset: fractional delay line with a windowed sinc
+   interpolator. The delay starts in the middle of the buffer and
+   drifts by 1.6 samples per second at 200 ppm, so the drift is only
+   simulated during about 150 s at 200 ppm. */
+#define RESAMPLE_TAPS 16
+#define RESAMPLE_SIZE 512 /* power of two */
+
+typedef struct {
+    float buf[RESAMPLE_SIZE]; /* last input samples (ring buffer) */
+    unsigned int ptr;         /* number of input samples */
+    double delay;             /* delay of the next output (in samples) */
+    double incr;              /* delay change per sample */
+} LineResampler;
+
 /* state of a uni directional line */
 typedef struct {
     float buf[LINE_FILTER_SIZE]; /* last transmitted samples (ring buffer, 
@@ -180,14 +228,20 @@ typedef struct {
 typedef struct LineModelState {
     UniDirLineState line1, line2;
     float fout1, fout2; 
+    float sigma;    /* gaussian noise sigma */
+    float line_filter[LINE_FILTER_SIZE];
+    int nb_clamped; /* number of overflows */
+    float modem_hybrid_echo; /* echo level created by the modem hybrid */
+    float cs_hybrid_echo; /* echo level created by the central site hybrid */
+    int dump_count;
+    /* the clock of the answer modem is offset (if not zero, in ppm) */
+    float clock_offset;
+    LineResampler resample1, resample2;
+    /* noise generator: same sequence as random() after srandom(seed) */
+    struct random_data rand;
+    char rand_state[128];
 } LineModelState;
 
-static float line_filter[LINE_FILTER_SIZE];
-static float sigma;    /* gaussian noise sigma */
-static int nb_clamped; /* number of overflows */
-static float modem_hybrid_echo; /* echo level created by the modem hybrid */
-static float cs_hybrid_echo; /* echo level created by the central site hybrid */
-
 #define RANDMAX 0x7fffffff
 
 float random_unif(void)
@@ -207,6 +261,26 @@ float random_gaussian(void)
   return v1 * m;
 }
 
+static float line_random_unif(LineModelState *s)
+{
+    int32_t v;
+
+    random_r(&s->rand, &v);
+    return (float) v / RANDMAX;
+}
+
+static float line_random_gaussian(LineModelState *s)
+{
+  float v1, v2, r , m;
+  do {
+    v1 = 2 * line_random_unif(s) - 1; 
+    v2 = 2 * line_random_unif(s) - 1;
+    r = v1 * v1 + v2 * v2;
+  } while (r >= 1);
+  m = sqrt(-2 * log(r)/r);
+  return v1 * m;
+}
+
 /* tabulated medium range telephone line respond (from p 537, Digital
    Communication, John G. Proakis */
 
@@ -266,7 +340,7 @@ float phone_delay[23] = {
     2.2, /* NA */
 };
 
-static void build_line_impulse_response(void)
+static void build_line_impulse_response(float *line_filter)
 {
     float f, f1, a, amp, phase, delay;
     int index, i, j;
@@ -314,26 +388,28 @@ static void build_line_impulse_response(void)
     fclose(outfile);
 }
 
-LineModelState *line_model_init(void)
+LineModelState *line_model_init(struct sm_arena *arena)
 {
-    float N0,SNR, p, echo_level;
+    float p, echo_level, *line_filter;
     int i;
     LineModelState *s;
 
-    s = malloc(sizeof(LineModelState));
-    memset(s, 0, sizeof(LineModelState));
+    s = sm_arena_alloc(arena, sizeof(LineModelState));
+    if (!s)
+        return NULL;
+    memset(s, 0, sizeof(*s));
 
-    SNR = 25; /* wanted SNR */
-    N0 = pow(10,-SNR/10.0);
-    sigma=sqrt(N0/2) * (float)SAMPLE_REF;
+    line_model_set_snr(s, 25);
+    line_model_set_seed(s, 0);
 
     /* echos */
     echo_level = -15; /* in dB */
-    cs_hybrid_echo = pow(10, echo_level/20.0);
-    modem_hybrid_echo = pow(10, echo_level/20.0);
+    s->cs_hybrid_echo = pow(10, echo_level/20.0);
+    s->modem_hybrid_echo = pow(10, echo_level/20.0);
     
+    line_filter = s->line_filter;
 #if 0
-    build_line_impulse_response();
+    build_line_impulse_response(line_filter);
 #else
     /* simple filter */
     line_filter[LINE_FILTER_SIZE/2+1] = 0.3;
@@ -357,14 +433,76 @@ LineModelState *line_model_init(void)
 }
 
 
+/* set the wanted SNR (in dB) */
+void line_model_set_snr(LineModelState *s, float snr)
+{
+    float N0;
+
+    N0 = pow(10,-snr/10.0);
+    s->sigma = sqrt(N0/2) * (float)SAMPLE_REF;
+}
+
+/* seed of the noise generator */
+void line_model_set_seed(LineModelState *s, unsigned int seed)
+{
+    memset(&s->rand, 0, sizeof(s->rand));
+    initstate_r(seed, s->rand_state, sizeof(s->rand_state), &s->rand);
+}
+
+static void resampler_init(LineResampler *r, double incr)
+{
+    memset(r, 0, sizeof(*r));
+    r->delay = RESAMPLE_SIZE / 2;
+    r->incr = incr;
+}
+
+/* add the input sample 'v' and return the output sample */
+static float resample(LineResampler *r, float v)
+{
+    double t, x, w;
+    float sum;
+    int n0, j;
+
+    r->buf[r->ptr++ & (RESAMPLE_SIZE - 1)] = v;
+
+    /* the output is the input at time t */
+    t = (double)(r->ptr - 1) - r->delay;
+    n0 = (int)floor(t);
+    sum = 0;
+    for(j = -RESAMPLE_TAPS/2 + 1; j <= RESAMPLE_TAPS/2; j++) {
+        x = t - (n0 + j);
+        w = 0.5 + 0.5 * cos(M_PI * x / (RESAMPLE_TAPS / 2));
+        if (fabs(x) > 1e-9)
+            w *= sin(M_PI * x) / (M_PI * x);
+        sum += w * r->buf[(n0 + j) & (RESAMPLE_SIZE - 1)];
+    }
+
+    /* XXX: the drift stops when the buffer limit is reached */
+    if (r->delay + r->incr >= RESAMPLE_TAPS &&
+        r->delay + r->incr <= RESAMPLE_SIZE - RESAMPLE_TAPS)
+        r->delay += r->incr;
+    return sum;
+}
+
+/* set the clock offset of the answer modem relative to the calling
+   modem (in ppm, 0 = same clock). It must be set before the first
+   samples. */
+void line_model_set_clock_offset(LineModelState *s, float ppm)
+{
+    s->clock_offset = ppm;
+    /* the line runs on the clock of the calling modem: the answer
+       modem takes a sample every 1 / (1 + e) line samples and its
+       samples last 1 + e line samples */
+    resampler_init(&s->resample1, ppm * 1e-6);
+    resampler_init(&s->resample2, -ppm * 1e-6);
+}
+
 float compute_db(float a)
 {
     return 10.0 * log(a) / log(10.0);
 }
 
-static int dump_count;
-
-static float calc_line_filter(UniDirLineState *s, 
+static float calc_line_filter(LineModelState *m, UniDirLineState *s, 
                               float v, int calling)
 {
     float sum, noise;
@@ -383,13 +521,13 @@ static float calc_line_filter(UniDirLineState *s,
     /* apply the filter */
     sum = 0;
     for(j=0;j<LINE_FILTER_SIZE;j++) {
-        sum += line_filter[j] * s->buf[p];
+        sum += m->line_filter[j] * s->buf[p];
         if (++p == LINE_FILTER_SIZE)
             p = 0;
     }
     
     /* add noise */
-    noise = random_gaussian() * sigma;
+    noise = line_random_gaussian(m) * m->sigma;
     sum += noise;
     
     /* (testing only: noise power) */
@@ -399,10 +537,10 @@ static float calc_line_filter(UniDirLineState *s,
     s->rx_pow = (sum * sum) * (1.0 - A) + A * s->rx_pow;
     
     /* dump estimations */
-    if (calling && ++dump_count == 50) {
+    if (calling && ++m->dump_count == 50) {
         float ref_db;
         
-        dump_count = 0;
+        m->dump_count = 0;
         ref_db = compute_db(SAMPLE_REF * SAMPLE_REF);
         lm_dump_linesim_power(compute_db(s->tx_pow) - ref_db, 
                               compute_db(s->rx_pow) - ref_db,
@@ -412,14 +550,14 @@ static float calc_line_filter(UniDirLineState *s,
     return sum;
 }
 
-static int clamp(float a)
+static int clamp(LineModelState *s, float a)
 {
     if (a < -32768) {
         a = -32768;
-        nb_clamped++;
+        s->nb_clamped++;
     } else if (a > 32767) {
         a = 32767;
-        nb_clamped++;
+        s->nb_clamped++;
     }
     return (int)rint(a);
 }
@@ -437,31 +575,41 @@ void line_model(LineModelState *s,
 {
     int i;
     float in1, in2, out1, out2;
-    float tmp1, tmp2;
+    float tmp1, tmp2, line1, line2;
 
     for(i=0;i<nb_samples;i++) {
         in1 = input1[i];
         in2 = input2[i];
 
+        /* the answer modem signal on the line clock */
+        line2 = in2;
+        if (s->clock_offset != 0)
+            line2 = resample(&s->resample2, in2);
+
         /* echo from cal modem central site hybrid */
-        tmp1 = in1 + s->fout2 * cs_hybrid_echo;
+        tmp1 = in1 + s->fout2 * s->cs_hybrid_echo;
 
         /* echo from ans modem central site hybrid */
-        tmp2 = in2 + s->fout1 * cs_hybrid_echo;
+        tmp2 = line2 + s->fout1 * s->cs_hybrid_echo;
 
         /* line filters & noise */
-        s->fout1 = calc_line_filter(&s->line1, tmp1, 1);
+        s->fout1 = calc_line_filter(s, &s->line1, tmp1, 1);
+
+        s->fout2 = calc_line_filter(s, &s->line2, tmp2, 0);
 
-        s->fout2 = calc_line_filter(&s->line2, tmp2, 0);
+        /* the line signal on the answer modem clock */
+        line1 = s->fout1;
+        if (s->clock_offset != 0)
+            line1 = resample(&s->resample1, s->fout1);
 
         /* echo from ans modem hybrid */
-        out1 = s->fout1 + in2 * modem_hybrid_echo;
+        out1 = line1 + in2 * s->modem_hybrid_echo;
         lm_dump_sample(CHANNEL_SAMPLE, out1 / 32768.0);
 
         /* echo from cal modem hybrid */
-        out2 = s->fout2 + in1 * modem_hybrid_echo;
+        out2 = s->fout2 + in1 * s->modem_hybrid_echo;
 
-        output1[i] = clamp(out1);
-        output2[i] = clamp(out2);
+        output1[i] = clamp(s, out1);
+        output2[i] = clamp(s, out2);
     }
 }
@@ -47,7 +47,8 @@ void soundcard_modem(void)
     }
     fcntl(tty_handle, F_SETFL, O_NONBLOCK);
 
-    lm_init(dce, hw, "sc");
+    if (lm_init(dce, hw, "sc", NULL) < 0)
+        exit(1);
     lm_at_parser_init(&at_parser, dce);
 
 
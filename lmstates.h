@@ -14,6 +14,7 @@ TAG(SM_RECEIVE)
 TAG(SM_V8)
 TAG(SM_V21)
 TAG(SM_V23)
+TAG(SM_V34)
 
 /* V8_process: call */
 TAG(V8_WAIT_1SECOND)
@@ -35,6 +35,10 @@ void lm_dump_equalizer(s32 eq_filter1[][2], int norm, int size)
 {
 }
 
+void lm_dump_echocancel(s32 *ec_filter1, int norm, int size)
+{
+}
+
 void lm_dump_agc(float gain)
 {
 }
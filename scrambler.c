@@ -0,0 +1,215 @@
+/*
+ * Self synchronizing scramblers
+ *
+ * Copyright (c) 2000 Fabrice Bellard.
+ *
+ * This code is released under the GNU General Public License version
+ * 2. Please read the file COPYING to know the exact terms of the
+ * license.
+ *
+ */
+
+#include "lm.h"
+
+/*
+ * The scrambler divides the data bits by the polynomial: the line bit
+ * is y(t) = x(t) ^ y(t-a) ^ y(t-n), and the descrambler multiplies by
+ * it: x(t) = y(t) ^ y(t-a) ^ y(t-n). Both only keep the last n line
+ * bits.
+ *
+ * Up to n bits are scrambled at once: the y(t-n) terms all come from
+ * the history, and the recursion on y(t-a) is solved by the
+ * doubling steps y ^= y >> a, y ^= y >> 2a, ...
+ */
+
+void scrambler_init(Scrambler *s, int a, int n)
+{
+    s->a = a;
+    s->n = n;
+    s->hist = 0;
+}
+
+/* bit by bit versions (also used as reference) */
+int scrambler_bit(Scrambler *s, int b)
+{
+    b ^= ((s->hist >> (s->a - 1)) ^ (s->hist >> (s->n - 1))) & 1;
+    s->hist = ((s->hist << 1) | b) & ((1U << s->n) - 1);
+    return b;
+}
+
+int descrambler_bit(Scrambler *s, int b)
+{
+    int b1;
+
+    b1 = b ^ (((s->hist >> (s->a - 1)) ^ (s->hist >> (s->n - 1))) & 1);
+    s->hist = ((s->hist << 1) | b) & ((1U << s->n) - 1);
+    return b1;
+}
+
+u64 scrambler_bits(Scrambler *s, u64 bits, int nb)
+{
+    u64 h, y, out, mask;
+    int k, sh;
+
+    out = 0;
+    while (nb > 0) {
+        k = nb;
+        if (k > s->n)
+            k = s->n;
+        nb -= k;
+        mask = (1ULL << k) - 1;
+        h = (u64)s->hist << k;
+        y = ((bits >> nb) ^ (h >> s->a) ^ (h >> s->n)) & mask;
+        for(sh = s->a; sh < k; sh <<= 1)
+            y ^= y >> sh;
+        s->hist = (h | y) & ((1U << s->n) - 1);
+        out = (out << k) | y;
+    }
+    return out;
+}
+
+u64 descrambler_bits(Scrambler *s, u64 bits, int nb)
+{
+    u64 e, out;
+    int k;
+
+    out = 0;
+    while (nb > 0) {
+        k = nb;
+        if (k > 32)
+            k = 32;
+        nb -= k;
+        e = ((u64)s->hist << k) | ((bits >> nb) & ((1ULL << k) - 1));
+        out = (out << k) | ((e ^ (e >> s->a) ^ (e >> s->n)) &
+                            ((1ULL << k) - 1));
+        s->hist = e & ((1U << s->n) - 1);
+    }
+    return out;
+}
+
+/* benchmark & test: the bit by bit version of V34 (polynomial division
+   with a shift register) is the reference */
+
+#define SCRAMBLER_BENCH_WORDS 4096  /* 64 bit words */
+#define SCRAMBLER_BENCH_LOOPS 50
+
+static int scrambler_ref_bit(int *preg, int b, int a, int n)
+{
+    int b1, reg;
+
+    reg = *preg;
+    b1 = (reg >> (n - 1)) ^ b;
+    reg = (reg << 1) & ((1 << n) - 1);
+    if (b1)
+        reg ^= 1 | (1 << (n - a));
+    *preg = reg;
+    return b1;
+}
+
+/* scramble (or descramble) 'in' by blocks of 'block' bits (0 = bit by
+   bit API) and return the time in us */
+static s64 scrambler_bench_run(Scrambler *s, u64 *out, const u64 *in,
+                               int block, int descramble)
+{
+    int i, j, k;
+    u64 w;
+    s64 t;
+
+    t = bench_time();
+    for(k=0;k<SCRAMBLER_BENCH_LOOPS;k++) {
+        s->hist = 0;
+        for(i=0;i<SCRAMBLER_BENCH_WORDS;i++) {
+            w = 0;
+            if (block == 0) {
+                for(j=63;j>=0;j--) {
+                    if (descramble)
+                        w = (w << 1) | descrambler_bit(s, (in[i] >> j) & 1);
+                    else
+                        w = (w << 1) | scrambler_bit(s, (in[i] >> j) & 1);
+                }
+            } else if (block == 64) {
+                if (descramble)
+                    w = descrambler_bits(s, in[i], 64);
+                else
+                    w = scrambler_bits(s, in[i], 64);
+            } else {
+                for(j=64-block;j>=0;j-=block) {
+                    if (descramble)
+                        w = (w << block) | descrambler_bits(s, in[i] >> j, block);
+                    else
+                        w = (w << block) | scrambler_bits(s, in[i] >> j, block);
+                }
+            }
+            out[i] = w;
+        }
+    }
+    return bench_time() - t;
+}
+
+void scrambler_bench(void)
+{
+    static const struct {
+        int a, n;
+        const char *name;
+    } polys[] = {
+        { 18, 23, "V34 GPC 1+x^-18+x^-23" },
+        { 5, 23,  "V34 GPA 1+x^-5+x^-23" },
+        { 14, 17, "V22bis 1+x^-14+x^-17" },
+    };
+    static const int blocks[4] = { 0, 8, 32, 64 };
+    Scrambler s1, *s = &s1;
+    u64 *data, *ref, *out, *out1, w;
+    int i, j, p, reg, err;
+    s64 t[4], t1[4];
+    float nb_bits;
+
+    data = malloc(SCRAMBLER_BENCH_WORDS * sizeof(u64));
+    ref = malloc(SCRAMBLER_BENCH_WORDS * sizeof(u64));
+    out = malloc(SCRAMBLER_BENCH_WORDS * sizeof(u64));
+    out1 = malloc(SCRAMBLER_BENCH_WORDS * sizeof(u64));
+    if (!data || !ref || !out || !out1) {
+        fprintf(stderr, "scrambler_bench: no memory\n");
+        exit(1);
+    }
+    for(i=0;i<SCRAMBLER_BENCH_WORDS;i++)
+        data[i] = ((u64)random() << 42) ^ ((u64)random() << 21) ^ random();
+
+    nb_bits = 64.0 * SCRAMBLER_BENCH_WORDS * SCRAMBLER_BENCH_LOOPS;
+    printf("scrambler: %d bits, %d loops, Mbit/s for 1/8/32/64 bits per call\n",
+           SCRAMBLER_BENCH_WORDS * 64, SCRAMBLER_BENCH_LOOPS);
+    for(p=0;p<sizeof(polys)/sizeof(polys[0]);p++) {
+        scrambler_init(s, polys[p].a, polys[p].n);
+
+        reg = 0;
+        for(i=0;i<SCRAMBLER_BENCH_WORDS;i++) {
+            w = 0;
+            for(j=63;j>=0;j--)
+                w = (w << 1) | scrambler_ref_bit(&reg, (data[i] >> j) & 1,
+                                                 polys[p].a, polys[p].n);
+            ref[i] = w;
+        }
+
+        err = 0;
+        for(j=0;j<4;j++) {
+            t[j] = scrambler_bench_run(s, out, data, blocks[j], 0);
+            t1[j] = scrambler_bench_run(s, out1, ref, blocks[j], 1);
+            for(i=0;i<SCRAMBLER_BENCH_WORDS;i++) {
+                if (out[i] != ref[i])
+                    err++;
+                if (out1[i] != data[i])
+                    err++;
+            }
+        }
+        printf("%-22s scramble: %6.1f %6.1f %6.1f %6.1f  "
+               "descramble: %6.1f %6.1f %6.1f %6.1f  errors=%d\n",
+               polys[p].name,
+               nb_bits / t[0], nb_bits / t[1], nb_bits / t[2], nb_bits / t[3],
+               nb_bits / t1[0], nb_bits / t1[1], nb_bits / t1[2],
+               nb_bits / t1[3], err);
+    }
+
+    free(out1);
+    free(out);
+    free(ref);
+    free(data);
+}
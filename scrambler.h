@@ -0,0 +1,20 @@
+#ifndef SCRAMBLER_H
+#define SCRAMBLER_H
+
+/* self synchronizing scrambler of generating polynomial 1 + x^-a + x^-n
+   (V22bis: a=14 n=17, V32bis & V34: a=18 or a=5 n=23) */
+
+typedef struct {
+    int a, n;   /* 0 < a < n <= 31 */
+    u32 hist;   /* last n bits on the line side, the most recent in bit 0 */
+} Scrambler;
+
+void scrambler_init(Scrambler *s, int a, int n);
+int scrambler_bit(Scrambler *s, int b);
+int descrambler_bit(Scrambler *s, int b);
+/* 'nb' <= 64 bits packed MSB first (oldest bit in the MSB) */
+u64 scrambler_bits(Scrambler *s, u64 bits, int nb);
+u64 descrambler_bits(Scrambler *s, u64 bits, int nb);
+void scrambler_bench(void);
+
+#endif
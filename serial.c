@@ -11,15 +11,50 @@
 
 #include "lm.h"
 
+/*
+ * A serial word is sent MSB first: a start bit (0), the data bits
+ * (MSB first), an optional parity bit and a stop bit (1). The framing
+ * and the parity are precomputed for each byte value, so that whole
+ * words are sent and received at once. The bit streams are packed MSB
+ * first (oldest bit in the MSB).
+ */
+
 /* Init the serial encoder & decoder. 5 <= data_bits <= 8 and parity
    can be 'E', 'O', or 'N' */
 void serial_init(struct sm_state *s, int data_bits, int parity)
 {
+    int i, j, p, body_bits;
+
     s->serial_data_bits = data_bits;
     s->serial_use_parity = (parity == 'E' || parity == 'O');
     s->serial_parity = (parity == 'O');
     s->serial_wordsize = data_bits + 2 + s->serial_use_parity;
 
+    /* framed word for each data value */
+    for(i=0;i<256;i++) {
+        int data = i & ((1 << data_bits) - 1);
+        if (s->serial_use_parity) {
+            p = s->serial_parity;
+            for(j=0;j<data_bits;j++) p ^= (data >> j) & 1;
+            s->serial_tx_tab[i] = (data << 2) | (p << 1) | 1;
+        } else {
+            s->serial_tx_tab[i] = (data << 1) | 1;
+        }
+    }
+
+    /* data value for each word body (data + parity bits), -1 if
+       parity error */
+    body_bits = s->serial_wordsize - 2;
+    for(i=0;i<(1 << body_bits);i++) {
+        if (s->serial_use_parity) {
+            p = s->serial_parity;
+            for(j=0;j<body_bits;j++) p ^= (i >> j) & 1;
+            s->serial_rx_tab[i] = p ? -1 : (i >> 1);
+        } else {
+            s->serial_rx_tab[i] = i;
+        }
+    }
+
     /* rx init */
     s->serial_buf = 0;
     s->serial_cnt = 0;
@@ -29,16 +64,102 @@ void serial_init(struct sm_state *s, int data_bits, int parity)
     s->serial_tx_cnt = 0;
 }
 
+/* return 'n' bits (n <= 31) from the tx fifo with serial encoding,
+   MSB first. Stop bits are sent if the fifo is empty. */
+int serial_get_bits(void *opaque, int n)
+{
+    struct sm_state *s = opaque;
+    int data;
+
+    while (s->serial_tx_cnt < n) {
+        data = sm_get_bit(&s->tx_fifo);
+        if (data == -1) {
+            /* idle: fill with stop bits */
+            s->serial_tx_buf = (s->serial_tx_buf << (n - s->serial_tx_cnt)) |
+                ((1U << (n - s->serial_tx_cnt)) - 1);
+            s->serial_tx_cnt = n;
+            break;
+        }
+        s->serial_tx_buf = (s->serial_tx_buf << s->serial_wordsize) |
+            s->serial_tx_tab[data & 0xff];
+        s->serial_tx_cnt += s->serial_wordsize;
+    }
+    s->serial_tx_cnt -= n;
+    return (s->serial_tx_buf >> s->serial_tx_cnt) & ((1U << n) - 1);
+}
+
 /* return a bit from the tx fifo with serial encoding */
 int serial_get_bit(void *opaque)
+{
+    return serial_get_bits(opaque, 1);
+}
+
+/* decode 'n' bits (n <= 31, MSB first) of a serial stream and put
+   the received words in rx_fifo. 'serial_buf' contains the
+   'serial_cnt' pending bits, left aligned. */
+void serial_put_bits(void *opaque, int bits, int n)
 {
     struct sm_state *s = opaque;
-    int data, j, bit, p;
+    int wordsize, q, data;
+    u64 buf, z;
+
+    wordsize = s->serial_wordsize;
+    buf = s->serial_buf | ((u64)(bits & ((1U << n) - 1)) << (64 - s->serial_cnt - n));
+    s->serial_cnt += n;
+
+    for(;;) {
+        /* hunt for the next start bit */
+        z = ~buf & ~(((u64)-1) >> s->serial_cnt);
+        if (z == 0) {
+            /* only stop bits */
+            buf = 0;
+            s->serial_cnt = 0;
+            break;
+        }
+        q = __builtin_clzll(z);
+        buf <<= q;
+        s->serial_cnt -= q;
+        if (s->serial_cnt < wordsize)
+            break;
+
+        if ((buf >> (64 - wordsize)) & 1) {
+            data = s->serial_rx_tab[(buf >> (65 - wordsize)) &
+                                    ((1 << (wordsize - 2)) - 1)];
+            if (data >= 0)
+                sm_put_bit(&s->rx_fifo, data);
+            q = wordsize;
+        } else {
+            /* no stop bit: false start bit */
+            q = 1;
+        }
+        buf <<= q;
+        s->serial_cnt -= q;
+    }
+    s->serial_buf = buf;
+}
+
+/* decode a serial stream and put it in rx_fifo */
+void serial_put_bit(void *opaque, int bit)
+{
+    serial_put_bits(opaque, bit, 1);
+}
+
+/* benchmark: bit by bit framing (reference) versus word framing */
+
+#define SERIAL_BENCH_SIZE  4096
+#define SERIAL_BENCH_LOOPS 500
+#define SERIAL_BENCH_BITS  24  /* bits per block call */
+
+/* reference encoder: one bit from the tx fifo */
+static int serial_ref_get_bit(struct sm_state *s)
+{
+    int data, j, p;
 
     if (s->serial_tx_cnt == 0) {
         data = sm_get_bit(&s->tx_fifo);
         if (data == -1)
             return 1;
+        data &= (1 << s->serial_data_bits) - 1;
         s->serial_tx_cnt = s->serial_wordsize;
         if (s->serial_use_parity) {
             p = s->serial_parity;
@@ -49,23 +170,19 @@ int serial_get_bit(void *opaque)
         }
     }
     s->serial_tx_cnt--;
-    bit = (s->serial_tx_buf >> s->serial_tx_cnt) & 1;
-    return bit;
+    return (s->serial_tx_buf >> s->serial_tx_cnt) & 1;
 }
 
-/* decode a serial stream and put it in rx_fifo. Not optimized */
-void serial_put_bit(void *opaque, int bit)
+/* reference decoder: one bit to the rx fifo */
+static void serial_ref_put_bit(struct sm_state *s, int bit)
 {
-    struct sm_state *s = opaque;
     int mask, p, j, data;
 
     s->serial_buf = (s->serial_buf << 1) | bit;
     if (s->serial_cnt >= (s->serial_wordsize-1)) {
         mask = 1 | (1 << (s->serial_wordsize-1));
-
         if ((s->serial_buf & mask) == 0x1) {
             data = (s->serial_buf & ((1 << s->serial_wordsize) - 1)) >> 1;
-            
             if (s->serial_use_parity) {
                 p = s->serial_parity;
                 for(j=0;j<=s->serial_data_bits;j++) p ^= (data >> j) & 1;
@@ -74,7 +191,6 @@ void serial_put_bit(void *opaque, int bit)
             } else {
                 sm_put_bit(&s->rx_fifo, data);
             }
-            
             s->serial_cnt = 0;
         }
     } else {
@@ -82,3 +198,130 @@ void serial_put_bit(void *opaque, int bit)
     }
 }
 
+static s64 serial_bench_tx(struct sm_state *s, const u8 *data, u8 *fifo_buf,
+                           u32 *out, int nb_words, int block)
+{
+    int i, j, k, w;
+    s64 t;
+
+    t = bench_time();
+    for(k=0;k<SERIAL_BENCH_LOOPS;k++) {
+        sm_init_fifo(&s->tx_fifo, fifo_buf, SERIAL_BENCH_SIZE);
+        for(i=0;i<SERIAL_BENCH_SIZE;i++)
+            sm_put_bit(&s->tx_fifo, data[i]);
+        s->serial_tx_cnt = 0;
+        for(i=0;i<nb_words;i++) {
+            if (block) {
+                w = serial_get_bits(s, SERIAL_BENCH_BITS);
+            } else {
+                w = 0;
+                for(j=0;j<SERIAL_BENCH_BITS;j++)
+                    w = (w << 1) | serial_ref_get_bit(s);
+            }
+            out[i] = w;
+        }
+    }
+    return bench_time() - t;
+}
+
+static s64 serial_bench_rx(struct sm_state *s, u8 *fifo_buf,
+                           const u32 *in, int nb_words, int block)
+{
+    int i, j, k;
+    s64 t;
+
+    t = bench_time();
+    for(k=0;k<SERIAL_BENCH_LOOPS;k++) {
+        sm_init_fifo(&s->rx_fifo, fifo_buf, SERIAL_BENCH_SIZE);
+        s->serial_buf = 0;
+        s->serial_cnt = 0;
+        for(i=0;i<nb_words;i++) {
+            if (block) {
+                serial_put_bits(s, in[i], SERIAL_BENCH_BITS);
+            } else {
+                for(j=SERIAL_BENCH_BITS-1;j>=0;j--)
+                    serial_ref_put_bit(s, (in[i] >> j) & 1);
+            }
+        }
+    }
+    return bench_time() - t;
+}
+
+/* return the number of bytes in the rx fifo which differ from 'data' */
+static int serial_bench_check(struct sm_state *s, const u8 *data)
+{
+    int i, err;
+
+    err = abs(sm_size(&s->rx_fifo) - SERIAL_BENCH_SIZE);
+    for(i=0;i<SERIAL_BENCH_SIZE;i++) {
+        if (sm_get_bit(&s->rx_fifo) !=
+            (data[i] & ((1 << s->serial_data_bits) - 1)))
+            err++;
+    }
+    return err;
+}
+
+void serial_bench(void)
+{
+    static const struct {
+        int data_bits, parity;
+    } modes[] = {
+        { 8, 'N' }, { 7, 'E' }, { 8, 'O' }, { 5, 'N' },
+    };
+    struct sm_state *s;
+    u8 *data, *tx_buf, *rx_buf;
+    u32 *ref_bits, *bits;
+    int i, m, nb_words, err;
+    s64 t_ref_tx, t_ref_rx, t_tx, t_rx;
+    float nb_bytes;
+
+    /* enough words for the data and some trailing stop bits */
+    nb_words = (SERIAL_BENCH_SIZE * 11) / SERIAL_BENCH_BITS + 2;
+
+    s = calloc(1, sizeof(*s));
+    data = malloc(SERIAL_BENCH_SIZE);
+    tx_buf = malloc(SERIAL_BENCH_SIZE);
+    rx_buf = malloc(SERIAL_BENCH_SIZE);
+    ref_bits = malloc(nb_words * sizeof(u32));
+    bits = malloc(nb_words * sizeof(u32));
+    if (!s || !data || !tx_buf || !rx_buf || !ref_bits || !bits) {
+        fprintf(stderr, "serial_bench: no memory\n");
+        exit(1);
+    }
+    for(i=0;i<SERIAL_BENCH_SIZE;i++)
+        data[i] = random();
+
+    nb_bytes = (float)SERIAL_BENCH_SIZE * SERIAL_BENCH_LOOPS;
+    printf("serial: %d bytes, %d loops, %d bits per block\n", 
+           SERIAL_BENCH_SIZE, SERIAL_BENCH_LOOPS, SERIAL_BENCH_BITS);
+
+    for(m=0;m<sizeof(modes)/sizeof(modes[0]);m++) {
+        serial_init(s, modes[m].data_bits, modes[m].parity);
+
+        t_ref_tx = serial_bench_tx(s, data, tx_buf, ref_bits, nb_words, 0);
+        t_tx = serial_bench_tx(s, data, tx_buf, bits, nb_words, 1);
+        err = 0;
+        for(i=0;i<nb_words;i++) {
+            if (bits[i] != ref_bits[i])
+                err++;
+        }
+
+        t_ref_rx = serial_bench_rx(s, rx_buf, ref_bits, nb_words, 0);
+        err += serial_bench_check(s, data);
+        t_rx = serial_bench_rx(s, rx_buf, ref_bits, nb_words, 1);
+        err += serial_bench_check(s, data);
+
+        printf("%d%c1: tx: bit=%6.2f MB/s word=%6.2f MB/s  "
+               "rx: bit=%6.2f MB/s word=%6.2f MB/s  errors=%d\n",
+               modes[m].data_bits, modes[m].parity,
+               nb_bytes / t_ref_tx, nb_bytes / t_tx,
+               nb_bytes / t_ref_rx, nb_bytes / t_rx, err);
+    }
+
+    free(bits);
+    free(ref_bits);
+    free(rx_buf);
+    free(tx_buf);
+    free(data);
+    free(s);
+}
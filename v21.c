@@ -44,6 +44,7 @@ void V21_demod_init(FSK_demod_state *s, int calling, put_bit_func put_bit, void
     }
     s->baud_rate = 300;
     s->sample_rate = SAMPLE_RATE;
+    s->high_pass = 0;
     s->put_bit = put_bit;
     s->opaque = opaque;
     FSK_demod_init(s);
@@ -10,9 +10,13 @@
 #include "lm.h"
 
 /*
- * This code is also used by the V34 phase 2 at 600 bits/s. V22bis
- * 2400 bps is implemented in the modulation but not in the
- * demodulation.  
+ * This code is also used by the V34 phase 2 at 600 bits/s (without
+ * scrambler). 
+ *
+ * The receiver shares its building blocks with V34: polyphase
+ * matched filter (v34table.h), LMS equalizer update and NCO
+ * (dsp.h). All its state is in V22DemodState and its tables are
+ * constant, so that many channels can be processed by one CPU.
  */
 
 void V22_mod_init(V22ModState *s)
@@ -26,6 +30,10 @@ void V22_mod_init(V22ModState *s)
     s->carrier_phase = 0;
     s->carrier2_phase = 0;
     s->Z = 0;
+    s->train_count = 0;
+    if (s->mod_type == V22_MOD_2400)
+        s->train_count = V22_TRAIN_SYMBOLS;
+    scrambler_init(&s->scrambler, 14, 17);
     
     if (s->calling) {
         /* call modem DPSK: 600 bps, carrier at 1200 Hz, 0 db */
@@ -38,6 +46,18 @@ void V22_mod_init(V22ModState *s)
     }
 }
 
+/* next bit to send: scrambled ones during the V22bis training */
+static int v22_get_bit(V22ModState *s)
+{
+    int b;
+
+    if (s->train_count > 0)
+        b = 1;
+    else
+        b = s->get_bit(s->opaque);
+    return scrambler_bit(&s->scrambler, b);
+}
+
 static void V22_mod_baseband(V22ModState *s, s16 *x_ptr, s16 *y_ptr)
 {
     int x, y, x1, y1, b1, b2;
@@ -53,15 +73,15 @@ static void V22_mod_baseband(V22ModState *s, s16 *x_ptr, s16 *y_ptr)
         y1 = 0x2000;
         break;
     case V22_MOD_600:
-        b1 = s->get_bit(s->opaque);
+        b1 = v22_get_bit(s);
         /* rotation by 90 or 270 degrees */
         s->Z = (s->Z + ((b1 << 1) | 1)) & 3;
         x1 = 0x2000;
         y1 = 0x2000;
         break;
     case V22_MOD_1200:
-        b1 = s->get_bit(s->opaque);
-        b2 = s->get_bit(s->opaque);
+        b1 = v22_get_bit(s);
+        b2 = v22_get_bit(s);
         b2 ^= (1 - b1);
         s->Z = (s->Z + ((b1 << 1) | b2)) & 3;
         x1 = 0x2000;
@@ -69,13 +89,20 @@ static void V22_mod_baseband(V22ModState *s, s16 *x_ptr, s16 *y_ptr)
         break;
     case V22_MOD_2400:
         /* quadrant selection */
-        b1 = s->get_bit(s->opaque);
-        b2 = s->get_bit(s->opaque);
+        b1 = v22_get_bit(s);
+        b2 = v22_get_bit(s);
         b2 ^= (1 - b1);
         s->Z = (s->Z + ((b1 << 1) | b2)) & 3;
+        if (s->train_count > 0) {
+            /* training at 1200 bit/s */
+            s->train_count--;
+            x1 = 0x2000;
+            y1 = 0x2000;
+            break;
+        }
         /* 4 positions inside the quadrant */
-        b1 = s->get_bit(s->opaque);
-        b2 = s->get_bit(s->opaque);
+        b1 = v22_get_bit(s);
+        b2 = v22_get_bit(s);
         /* XXX: normalize */
         x1 = 0x1000;
         if (b2) 
@@ -141,7 +168,7 @@ void V22_mod(V22ModState *s, s16 *samples, unsigned int nb)
         }
         
         val = (si * dsp_cos(s->carrier_phase) - 
-               sq * dsp_cos((PHASE_BASE/4) - s->carrier_phase)) >> COS_BITS;
+               sq * dsp_sin(s->carrier_phase)) >> COS_BITS;
         s->carrier_phase += s->carrier_incr;
         if (!s->calling) {
             /* a 1800 Hz tone is added for answer modem modulation at 6 dB below it */
@@ -152,142 +179,519 @@ void V22_mod(V22ModState *s, s16 *samples, unsigned int nb)
     }
 }
 
+enum {
+    V22_RX_WAIT_CARRIER,
+    V22_RX_DATA,
+};
+
+/* carrier detection: power of the matched filter output (about -43
+   dB and -48 dB of the 0 dB sample level) */
+#define V22_CARRIER_ON  13000
+#define V22_CARRIER_OFF 4000
+
+/* constellation unit at the equalizer output: the 4 point signal is
+   at (+-2A, +-2A), the 16 point signal at (+-A or +-3A, +-A or +-3A) */
+#define V22_A 1024
+
+/* the decisions are used once the AGC has converged */
+#define V22_AGC_SYMBOLS      32
+
+/* the timing is acquired before the equalizer is adapted: otherwise
+   the equalizer may converge half a symbol away */
+#define V22_TIMING_SYMBOLS   128
+
+/* equalizer adaptation shift: faster at the beginning */
+#define V22_EQ_SHIFT_TRAIN   3
+#define V22_EQ_SHIFT         5
+#define V22_EQ_TRAIN_SYMBOLS 384
+
+/* timing correction for a normalized timing error of 1 (in
+   baud_phase units: a symbol is 2 * V22_RX_DECIM << 16). Smaller
+   after the training to reduce the jitter */
+#define V22_TIMING_GAIN_TRAIN ((2 * V22_RX_DECIM << 16) / 128)
+#define V22_TIMING_GAIN       ((2 * V22_RX_DECIM << 16) / 1024)
+
+/* carrier PLL: phase and frequency corrections for an error of 1 rad */
+#define V22_PLL_KP           (0.25 * PHASE_BASE / (2 * M_PI))
+#define V22_PLL_KI           (V22_PLL_KP / 64)
+
 void V22_demod_init(V22DemodState *s)
 {
+    int i;
+
+    s->state = V22_RX_WAIT_CARRIER;
+    s->power = 0;
+
+    /* the answer modem receives the 1200 Hz carrier */
+    if (s->calling)
+        s->rx_filter = v22_rx_filter_2400;
+    else
+        s->rx_filter = v22_rx_filter_1200;
     s->baud_phase = 0;
-    s->baud_num = 3;
-    s->baud_denom = 40;
+    s->baud_num = V22_RX_UPSAMPLE << 16;
+    s->baud_denom = V22_RX_DECIM << 16;
+    memset(s->rx_buf, 0, sizeof(s->rx_buf));
+    s->rx_buf_ptr = 0;
+    s->half = 0;
+    s->half_power[0] = 0;
+    s->half_power[1] = 0;
+
+    s->agc_power = 0;
+    s->agc_gain = 0;
+
+    /* equalizer: identity on a symbol sample */
+    memset(s->eq_filter, 0, sizeof(s->eq_filter));
+    s->eq_filter[V22_EQ_SIZE/2 - 1][0] = 0x4000 << 16;
+    for(i=0;i<V22_EQ_SIZE;i++) {
+        s->eq_coef[0][i] = s->eq_filter[i][0] >> 16;
+        s->eq_coef[1][i] = s->eq_filter[i][1] >> 16;
+    }
+    memset(s->eq_buf, 0, sizeof(s->eq_buf));
+    s->eq_buf_ptr = 0;
 
+    /* at 2 samples per symbol, the carriers (2 or 4 times 600 Hz) are
+       at frequency 0: only the phase has to be tracked */
     s->carrier_phase = 0;
+    s->carrier_incr = 0;
 
-    if (!s->calling) {
-        /* call modem DPSK: 600 bps, carrier at 1200 Hz, 0 db */
-        s->carrier_incr = (PHASE_BITS * 1200) / 8000;
+    s->sym_count = 0;
+    s->qam = 0;
+    s->qam_count = 0;
+    s->Z = 0;
+    scrambler_init(&s->descrambler, 14, 17);
+}
+
+static inline int v22_clamp(float v)
+{
+    if (v < -32768)
+        return -32768;
+    else if (v > 32767)
+        return 32767;
+    return (int)v;
+}
+
+/* sample rate conversion, timing correction & matched filter: complex
+   output sample at baud_phase */
+static inline void v22_rx_filter(V22DemodState *s, int *yr, int *yi)
+{
+    int frac, ph1;
+    const s16 *f0, *x;
+    s16 coefs[2 * V22_RX_FILTER_STRIDE] __attribute__((aligned(16)));
+
+    ph1 = s->baud_phase >> 16;
+    frac = s->baud_phase & 0xffff;
+    if (ph1 >= V22_RX_FILTER_PHASES - 1) {
+        /* XXX: only possible with a huge timing correction */
+        ph1 = V22_RX_FILTER_PHASES - 2;
+        frac = 0x10000;
+    }
+    f0 = s->rx_filter + ph1 * 2 * V22_RX_FILTER_STRIDE;
+    dsp_poly_coefs(coefs, f0, f0 + 2 * V22_RX_FILTER_STRIDE, frac, 
+                   2 * V22_RX_FILTER_STRIDE);
+    x = dsp_hist_last(s->rx_buf, s->rx_buf_ptr, V22_RX_BUF_SIZE, 
+                      V22_RX_FILTER_TAPS);
+    *yr = dsp_dot_prod(coefs, x, V22_RX_FILTER_TAPS, 0) >> 14;
+    *yi = dsp_dot_prod(coefs + V22_RX_FILTER_STRIDE, x, 
+                       V22_RX_FILTER_TAPS, 0) >> 14;
+}
+
+static inline int v22_qam_level(int v)
+{
+    if (v >= 0)
+        return (v < 2 * V22_A) ? V22_A : 3 * V22_A;
+    else
+        return (v > -2 * V22_A) ? -V22_A : -3 * V22_A;
+}
+
+static void v22_put_bit(V22DemodState *s, int b)
+{
+    s->put_bit(s->opaque, descrambler_bit(&s->descrambler, b));
+}
+
+/* decode the decided symbol (x, y) */
+static void v22_decode(V22DemodState *s, int x, int y)
+{
+    int Z, dZ, b1, b2, x1, y1;
+
+    if (x >= 0)
+        Z = (y >= 0) ? 0 : 3;
+    else
+        Z = (y >= 0) ? 1 : 2;
+    dZ = (Z - s->Z) & 3;
+    s->Z = Z;
+    b1 = dZ >> 1;
+    b2 = (dZ & 1) ^ (1 - b1);
+
+    switch(s->mod_type) {
+    default:
+    case V34_MOD_600:
+        s->put_bit(s->opaque, b1);
+        break;
+    case V22_MOD_600:
+        v22_put_bit(s, b1);
+        break;
+    case V22_MOD_1200:
+        v22_put_bit(s, b1);
+        v22_put_bit(s, b2);
+        break;
+    case V22_MOD_2400:
+        if (!s->qam) {
+            /* training: only the descrambler is synchronized */
+            descrambler_bit(&s->descrambler, b1);
+            descrambler_bit(&s->descrambler, b2);
+            break;
+        }
+        v22_put_bit(s, b1);
+        v22_put_bit(s, b2);
+        /* rotate clockwise to the first quadrant */
+        switch(Z) {
+        case 0:
+            x1 = x;
+            y1 = y;
+            break;
+        case 1:
+            x1 = y;
+            y1 = -x;
+            break;
+        case 2:
+            x1 = -x;
+            y1 = -y;
+            break;
+        default:
+        case 3:
+            x1 = -y;
+            y1 = x;
+            break;
+        }
+        v22_put_bit(s, y1 > 2 * V22_A);
+        v22_put_bit(s, x1 > 2 * V22_A);
+        break;
+    }
+}
+
+/* symbol processing: the last T/2 sample of eq_buf is on the symbol */
+static void v22_rx_symbol(V22DemodState *s)
+{
+    const s16 *xr, *xi;
+    int yr, yi, rr, ri, dr, di, er, ei, e0, e1, cosw, sinw, shift, update;
+    float e, a;
+
+    xr = dsp_hist_last(s->eq_buf[0], s->eq_buf_ptr, V22_EQ_SIZE, V22_EQ_SIZE);
+    xi = dsp_hist_last(s->eq_buf[1], s->eq_buf_ptr, V22_EQ_SIZE, V22_EQ_SIZE);
+
+    /* timing recovery (early-late): the power of the symbol sample
+       must be maximum */
+    e = (float)xr[V22_EQ_SIZE - 3] * 
+        (xr[V22_EQ_SIZE - 2] - xr[V22_EQ_SIZE - 4]) +
+        (float)xi[V22_EQ_SIZE - 3] * 
+        (xi[V22_EQ_SIZE - 2] - xi[V22_EQ_SIZE - 4]);
+    if (s->sym_count < V22_TIMING_SYMBOLS)
+        e *= V22_TIMING_GAIN_TRAIN / (8.0 * V22_A * V22_A);
+    else
+        e *= V22_TIMING_GAIN / (8.0 * V22_A * V22_A);
+    s->baud_phase -= (int)e;
+
+    /* equalizer */
+    yr = dsp_dot_prod(s->eq_coef[0], xr, V22_EQ_SIZE,
+                      -dsp_dot_prod(s->eq_coef[1], xi, V22_EQ_SIZE, 0)) >> 14;
+    yi = dsp_dot_prod(s->eq_coef[0], xi, V22_EQ_SIZE,
+                      dsp_dot_prod(s->eq_coef[1], xr, V22_EQ_SIZE, 0)) >> 14;
+
+    /* carrier phase */
+    cosw = dsp_cos(s->carrier_phase);
+    sinw = dsp_sin(s->carrier_phase);
+    rr = (yr * cosw + yi * sinw) >> COS_BITS;
+    ri = (yi * cosw - yr * sinw) >> COS_BITS;
+
+    update = (s->sym_count >= V22_AGC_SYMBOLS);
+    if (s->mod_type == V22_MOD_2400 && !s->qam &&
+        s->sym_count >= V22_TRAIN_SYMBOLS / 2) {
+        /* end of the training: the 16 point symbols are far from
+           the 4 point ones */
+        if (abs(abs(rr) - 2 * V22_A) + abs(abs(ri) - 2 * V22_A) > V22_A) {
+            update = 0;
+            if (++s->qam_count >= 4)
+                s->qam = 1;
+        } else {
+            s->qam_count = 0;
+        }
+    }
+
+    /* decision */
+    if (s->qam) {
+        dr = v22_qam_level(rr);
+        di = v22_qam_level(ri);
     } else {
-        /* answer modem DPSK: 600 bps, carrier at 2400 Hz, -1 db, 
-           guard tone at 1800 Hz, -7db */
-        s->carrier_incr = (PHASE_BITS * 2400) / 8000;
+        dr = (rr >= 0) ? 2 * V22_A : -2 * V22_A;
+        di = (ri >= 0) ? 2 * V22_A : -2 * V22_A;
+    }
+
+    if (update) {
+        er = dr - rr;
+        ei = di - ri;
+
+        /* decision directed PLL */
+        a = (float)(ri * dr - rr * di) / (float)(dr * dr + di * di);
+        s->carrier_incr += (int)(a * V22_PLL_KI);
+        s->carrier_phase += (int)(a * V22_PLL_KP);
+
+        /* equalizer update with the error rotated back: two real
+           updates for the complex input */
+        e0 = (er * cosw - ei * sinw) >> COS_BITS;
+        e1 = (er * sinw + ei * cosw) >> COS_BITS;
+        if (s->sym_count >= V22_TIMING_SYMBOLS) {
+            if (s->sym_count < V22_EQ_TRAIN_SYMBOLS)
+                shift = V22_EQ_SHIFT_TRAIN;
+            else
+                shift = V22_EQ_SHIFT;
+            dsp_eq_update(s->eq_filter, s->eq_coef[0], s->eq_coef[1], 
+                          xr, V22_EQ_SIZE, e0, e1, shift);
+            dsp_eq_update(s->eq_filter, s->eq_coef[0], s->eq_coef[1], 
+                          xi, V22_EQ_SIZE, e1, -e0, shift);
+        }
+    }
+    s->carrier_phase += s->carrier_incr;
+
+    s->sym_count++;
+    v22_decode(s, dr, di);
+}
+
+/* T/2 sample of the matched filter */
+static void v22_rx_sample(V22DemodState *s, int yr, int yi)
+{
+    float p, amp;
+    int ptr;
+
+    /* carrier detection */
+    p = (float)yr * yr + (float)yi * yi;
+    s->power += (p - s->power) * (1.0 / 32.0);
+    if (s->state == V22_RX_WAIT_CARRIER) {
+        if (s->power < V22_CARRIER_ON)
+            return;
+        s->state = V22_RX_DATA;
+        s->agc_power = s->power;
+    } else if (s->power < V22_CARRIER_OFF) {
+        V22_demod_init(s);
+        return;
     }
+
+    /* AGC: fast until the signal is stable, then slow because the
+       equalizer corrects the remaining gain error */
+    if (s->sym_count < V22_AGC_SYMBOLS)
+        s->agc_power = s->power;
+    else
+        s->agc_power += (p - s->agc_power) * (1.0 / 1024.0);
+    if (s->qam)
+        amp = sqrt(10.0) * V22_A;
+    else
+        amp = sqrt(8.0) * V22_A;
+    s->agc_gain = amp / sqrtf(s->agc_power);
+
+    ptr = s->eq_buf_ptr;
+    dsp_hist_put(s->eq_buf[0], &ptr, V22_EQ_SIZE, 
+                 v22_clamp(yr * s->agc_gain));
+    dsp_hist_put(s->eq_buf[1], &s->eq_buf_ptr, V22_EQ_SIZE, 
+                 v22_clamp(yi * s->agc_gain));
+
+    /* coarse timing: the early-late detector is very slow to leave
+       the middle of the symbol, so the T/2 sample with the most power
+       is chosen as symbol sample once the AGC has converged */
+    if (s->sym_count < V22_AGC_SYMBOLS)
+        s->half_power[s->half] += p;
+    if (++s->half < 2)
+        return;
+    s->half = 0;
+    if (s->sym_count == V22_AGC_SYMBOLS &&
+        s->half_power[0] > s->half_power[1]) {
+        s->half_power[0] = 0;
+        s->half = 1;
+        return;
+    }
+    v22_rx_symbol(s);
 }
 
-void V22_demod(V22DemodState *s, s16 *samples, unsigned int nb)
+void V22_demod(V22DemodState *s, const s16 *samples, unsigned int nb)
 {
-    
+    int i, yr, yi;
 
+    for(i=0;i<nb;i++) {
+        dsp_hist_put(s->rx_buf, &s->rx_buf_ptr, V22_RX_BUF_SIZE, samples[i]);
+
+        s->baud_phase += s->baud_num;
+        if (s->baud_phase >= s->baud_denom) {
+            s->baud_phase -= s->baud_denom;
+            v22_rx_filter(s, &yr, &yi);
+            v22_rx_sample(s, yr, yi);
+        }
+    }
 }
 
 
-/* test for FSK using V21 or V23 */
+/* test of the V22 & V22bis data pumps: both modems send random bits
+   through the line model at the same time. Give the bit error rate
+   in each direction and the CPU cost of the demodulator. */
 
 #define NB_SAMPLES 40
 
-#define MAXDELAY 32
+#define MAXDELAY 256
+
+/* the random bits are preceded by ones for the training and by
+   SYNC_WORD */
+#define SYNC_WORD 0x2d
 
-static int tx_bits[MAXDELAY], tx_ptr = 0, rx_ptr = 0;
-static int tx_blank = 32;
+#define TEST_SECONDS 20
+
+typedef struct {
+    int tx_bits[MAXDELAY], tx_ptr, rx_ptr;
+    int tx_blank;
+    u32 seed;
+    u64 sync_reg;
+    int nb_bits, errors, got_sync;
+} TestState;
 
-/* transmit random bits with a sync header (31 ones, 1 zero) */
 static int test_get_bit(void *opaque)
 {
+    TestState *t = opaque;
     int bit;
 
-    if (tx_blank != 0) {
-        /* send 1 at the beginning for synchronization */
-        bit = (tx_blank > 1);
-        tx_blank--;
+    if (t->tx_blank != 0) {
+        if (t->tx_blank > 8)
+            bit = 1;
+        else
+            bit = (SYNC_WORD >> (t->tx_blank - 1)) & 1;
+        t->tx_blank--;
     } else {
-        bit = random() % 2;
-        tx_bits[tx_ptr] = bit;
-        if (++tx_ptr == MAXDELAY)
-            tx_ptr = 0;
+        t->seed = t->seed * 1103515245 + 12345;
+        bit = (t->seed >> 16) & 1;
+        t->tx_bits[t->tx_ptr] = bit;
+        if (++t->tx_ptr == MAXDELAY)
+            t->tx_ptr = 0;
     }
     return bit;
 }
 
-static int nb_bits = 0, errors = 0, sync_count = 0, got_sync = 0;
-
 static void test_put_bit(void *opaque, int bit)
 {
+    TestState *t = opaque;
     int tbit;
     
-    if (!got_sync) {
-        
-        if (bit) {
-            sync_count++;
-        } else {
-            if (sync_count > 16)
-                got_sync = 1;
-            sync_count = 0;
-        }
+    if (!t->got_sync) {
+        /* 48 ones and the sync word */
+        t->sync_reg = (t->sync_reg << 1) | bit;
+        if ((t->sync_reg & (((u64)1 << 56) - 1)) == 
+            (((((u64)1 << 48) - 1) << 8) | SYNC_WORD))
+            t->got_sync = 1;
     } else {
-        tbit = tx_bits[rx_ptr];
-        if (++rx_ptr == MAXDELAY)
-            rx_ptr = 0;
+        tbit = t->tx_bits[t->rx_ptr];
+        if (++t->rx_ptr == MAXDELAY)
+            t->rx_ptr = 0;
         if (bit != tbit) {
-            errors++;
+            t->errors++;
         }
-        nb_bits++;
+        t->nb_bits++;
     }
 }
 
-void V22_test(void)
+/* CPU cycles when the time stamp counter is available */
+static inline u64 test_cycles(void)
 {
-    V22ModState tx;
-    V22DemodState rx;
-    int err, calling;
-    struct LineModelState *line_state;
-    s16 buf[NB_SAMPLES];
-    s16 buf1[NB_SAMPLES];
-    s16 buf2[NB_SAMPLES];
-    s16 buf3[NB_SAMPLES];
-    FILE *f1;
-    
-    err = lm_display_init();
-    if (err < 0) {
-        fprintf(stderr, "Could not init X display\n");
-        exit(1);
-    }
-
-    line_state = line_model_init();
-
-    f1 = fopen("cal.sw", "wb");
-    if (f1 == NULL) {
-        perror("cal.sw");
-        exit(1);
-    }
-
-    calling = 0;
-
-    tx.calling = calling;
-    tx.opaque = NULL;
-    tx.get_bit = test_get_bit;
-    tx.mod_type = V34_MOD_600;
-    V22_mod_init(&tx);
-
-    rx.calling = !calling;
-    rx.opaque = NULL;
-    rx.put_bit = test_put_bit;
-    rx.mod_type = tx.mod_type;
-    V22_demod_init(&rx);
+#if defined(__i386__) || defined(__x86_64__)
+    u32 lo, hi;
+
+    asm volatile("rdtsc" : "=a" (lo), "=d" (hi));
+    return ((u64)hi << 32) | lo;
+#else
+    return 0;
+#endif
+}
 
-    nb_bits = 0;
-    errors = 0;
-    for(;;) {
-        if (lm_display_poll_event())
-            break;
-        
-        V22_mod(&tx, buf, NB_SAMPLES);
-        memset(buf3, 0, sizeof(buf3));
+static void test_init(TestState *t, V22ModState *tx, V22DemodState *rx,
+                      int calling, enum ModulationType mod_type)
+{
+    static const int bit_rates[] = { 600, 600, 1200, 2400 };
+
+    memset(t, 0, sizeof(*t));
+    /* one second of ones */
+    t->tx_blank = bit_rates[mod_type] + 8;
+    t->seed = calling;
+
+    tx->calling = calling;
+    tx->opaque = t;
+    tx->get_bit = test_get_bit;
+    tx->mod_type = mod_type;
+    V22_mod_init(tx);
+
+    rx->calling = !calling;
+    rx->opaque = t;
+    rx->put_bit = test_put_bit;
+    rx->mod_type = mod_type;
+    V22_demod_init(rx);
+}
 
-        line_model(line_state, buf1, buf, buf2, buf3, NB_SAMPLES);
+static void test_print(TestState *t)
+{
+    if (!t->got_sync)
+        printf("     no sync      ");
+    else
+        printf("%5d/%-6d %0.1e", t->errors, t->nb_bits, 
+               (float)t->errors / (float)t->nb_bits);
+}
 
-        fwrite(buf, 1, NB_SAMPLES * 2, f1);
-        
-        V22_demod(&rx, buf1, NB_SAMPLES);
+void V22_test(void)
+{
+    static const struct {
+        enum ModulationType mod_type;
+        const char *name;
+    } mods[] = {
+        { V22_MOD_600, "V22 600" },
+        { V22_MOD_1200, "V22 1200" },
+        { V22_MOD_2400, "V22bis 2400" },
+    };
+    static const int snrs[] = { 10, 15, 20, 25, 30 };
+    V22ModState tx1, tx2;
+    V22DemodState rx1, rx2;
+    TestState t1, t2;
+    struct LineModelState *line_state;
+    s16 buf1[NB_SAMPLES], buf2[NB_SAMPLES], buf3[NB_SAMPLES], buf4[NB_SAMPLES];
+    int m, i, n;
+    u64 cycles, c;
+    s64 us, t;
+
+    printf("%-12s %4s %-24s %-24s\n", "", "SNR", "cal->ans errors", 
+           "ans->cal errors");
+    for(m=0;m<sizeof(mods)/sizeof(mods[0]);m++) {
+        cycles = 0;
+        us = 0;
+        for(i=0;i<sizeof(snrs)/sizeof(snrs[0]);i++) {
+            line_state = line_model_init(NULL);
+            line_model_set_snr(line_state, snrs[i]);
+
+            test_init(&t1, &tx1, &rx1, 1, mods[m].mod_type);
+            test_init(&t2, &tx2, &rx2, 0, mods[m].mod_type);
+
+            for(n=0;n<(TEST_SECONDS * 8000) / NB_SAMPLES;n++) {
+                V22_mod(&tx1, buf1, NB_SAMPLES);
+                V22_mod(&tx2, buf4, NB_SAMPLES);
+                line_model(line_state, buf2, buf1, buf3, buf4, NB_SAMPLES);
+
+                t = bench_time();
+                c = test_cycles();
+                V22_demod(&rx1, buf2, NB_SAMPLES);
+                V22_demod(&rx2, buf3, NB_SAMPLES);
+                cycles += test_cycles() - c;
+                us += bench_time() - t;
+            }
+            free(line_state);
+
+            printf("%-12s %2d dB ", mods[m].name, snrs[i]);
+            test_print(&t1);
+            printf("   ");
+            test_print(&t2);
+            printf("\n");
+        }
+        n = 2 * sizeof(snrs)/sizeof(snrs[0]) * TEST_SECONDS * 8000;
+        printf("%-12s demodulator: %0.1f cycles/sample, %0.2f us/s\n",
+               mods[m].name, (float)cycles / n, 
+               (float)us * 8000 / n);
     }
-
-    fclose(f1);
-
-    printf("errors=%d nb_bits=%d Pe=%f\n", 
-           errors, nb_bits, (float) errors / (float)nb_bits);
 }
@@ -6,10 +6,17 @@ enum ModulationType {
     V22_MOD_2400, 
 };
 
-/* 40 phases (sure too much, but we don't optimize right now) */
-#define V22_TX_FILTER_SIZE (20 * 40)
+/* the tx filter v22_tx_filter and the rx filters v22_rx_filter_xxx
+   are generated with the V34 tables (v34table.h) */
 #define V22_TX_BUF_SIZE    64
 
+/* V22bis 2400 bit/s: scrambled ones are first sent at 1200 bit/s so
+   that the receiver can train with 4 point decisions */
+#define V22_TRAIN_SYMBOLS  360
+
+#define V22_RX_BUF_SIZE    128 /* >= V22_RX_FILTER_TAPS, power of two */
+#define V22_EQ_SIZE        16  /* taps of the T/2 equalizer */
+
 typedef struct {
     /* parameters */
     int calling;
@@ -25,6 +32,8 @@ typedef struct {
     s16 tx_buf[V22_TX_BUF_SIZE][2];  /* complex symbols to be sent */
     int tx_outbuf_ptr;               /* index of the next symbol in tx_buf */
     int Z;              /* last value transmitted */
+    int train_count;    /* remaining V22bis training symbols */
+    Scrambler scrambler;
 } V22ModState;
 
 typedef struct {
@@ -34,13 +43,44 @@ typedef struct {
     void *opaque;
     put_bit_func put_bit;
 
+    /* state */
+    int state;          /* V22_RX_xxx */
+    float power;        /* power of the matched filter output */
+
+    /* matched filter & timing recovery: T/2 complex samples */
+    const s16 *rx_filter;
     int baud_phase, baud_num, baud_denom;
+    s16 rx_buf[2 * V22_RX_BUF_SIZE]; /* written twice (dsp_hist_put()) */
+    int rx_buf_ptr;
+    int half;           /* index of the T/2 sample in the symbol */
+    float half_power[2]; /* power of each T/2 sample (coarse timing) */
+
+    /* AGC */
+    float agc_power, agc_gain;
+
+    /* fractionally spaced equalizer with complex coefficients */
+    s32 eq_filter[V22_EQ_SIZE][2];
+    s16 eq_coef[2][V22_EQ_SIZE] __attribute__((aligned(16)));
+    s16 eq_buf[2][2 * V22_EQ_SIZE]; /* real & imaginary parts */
+    int eq_buf_ptr;
+
+    /* carrier recovery */
     int carrier_phase, carrier_incr;
-} V22DemodState;
 
-extern s16 v22_tx_filter[V22_TX_FILTER_SIZE];
+    /* decoding */
+    int sym_count;
+    int qam;            /* V22bis 16 point decisions */
+    int qam_count;
+    int Z;              /* last received quadrant */
+    Scrambler descrambler;
+} V22DemodState;
 
 void V22_mod_init(V22ModState *s);
 void V22_mod(V22ModState *s, s16 *samples, unsigned int nb);
 
+/* The demodulator state is only used by one thread at a time, the
+   tables are shared. */
+void V22_demod_init(V22DemodState *s);
+void V22_demod(V22DemodState *s, const s16 *samples, unsigned int nb);
+
 void V22_test(void);
@@ -43,11 +43,14 @@ void V23_demod_init(FSK_demod_state *s, int calling, put_bit_func put_bit, void
         s->f_lo = 390;
         s->f_hi = 450;
         s->baud_rate = 75;
+        s->high_pass = 0;
     } else {
-        /* 1200 bauds */
+        /* 1200 bauds: the short demodulation filters do not reject
+           the echo of the 75 bauds channel */
         s->f_lo = 1300;
         s->f_hi = 2100;
         s->baud_rate = 1200;
+        s->high_pass = 1;
     }
     s->sample_rate = SAMPLE_RATE;
     s->put_bit = put_bit;
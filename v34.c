@@ -36,45 +36,14 @@ void print_bit_vector(char *str, u8 *tab, int n)
 
 
 static void agc_init(V34DSPState *s);
+static void eq_load_coefs(V34DSPState *s);
 static void baseband_decode(V34DSPState *s, int si, int sq);
 static void put_sym(V34DSPState *s, int si, int sq);
 
-/* divide the bit sequence by poly */
+/* the scrambler generating polynomials are 1 + x^-a + x^-23 */
 #define SCRAMBLER_DEG 23
-#define V34_GPC       (1 | (1 << (23-18)))
-#define V34_GPA       (1 | (1 << (23-5)))
-
-int scramble_bit(V34DSPState *s, int b, int poly)
-{
-  int b1, reg;
- 
-  reg = s->scrambler_reg;
-
-  b1 = (reg >> (SCRAMBLER_DEG-1)) ^ b;
-  reg = (reg << 1) & ((1 << SCRAMBLER_DEG) - 1);
-  if (b1)
-    reg ^= poly;
-  
-  s->scrambler_reg = reg;
-
-  return b1;
-}
-
-int unscramble_bit(V34DSPState *s, int b, int poly)
-{
-  int b1, reg;
- 
-  reg = s->scrambler_reg;
-
-  b1 = (reg >> (SCRAMBLER_DEG-1)) ^ b;
-  reg = (reg << 1) & ((1 << SCRAMBLER_DEG) - 1);
-  if (b)
-    reg ^= poly;
-  
-  s->scrambler_reg = reg;
-
-  return b1;
-}
+#define V34_GPC       18
+#define V34_GPA       5
 
 /* build the constellation (no need to store it completely, we are lazy!) */
 
@@ -115,131 +84,147 @@ static int constellation_cmp(const void *a_ptr, const void *b_ptr)
       }\
 }
 
-static void build_constellation(V34DSPState *s)
+/* the constellation is the same for all the data rates (only the
+   number of points used changes): it is built once and shared by all
+   the modems */
+static s8 v34_constellation[C_MAX_SIZE][2];
+/* decision tables, indexed by L/4 (see build_decision_table()). They
+   are filled lazily by build_decision_table(), which is only safe
+   because build_config() runs from V34_static_init(), before any
+   modem thread is started. */
+static u16 (*v34_decision_tables[L_MAX/4 + 1])[C_RADIUS+1];
+
+static void build_constellation(void)
 {
-  int x,y,i,j,k;
+  int x,y,k;
 
   k = 0;
   for(y=C_MIN; y<= C_MAX; y++) {
       for(x=C_MIN; x<= C_MAX; x++) {
-          s->constellation[k][0] = 4*x+1;
-          s->constellation[k][1] = 4*y+1;
+          v34_constellation[k][0] = 4*x+1;
+          v34_constellation[k][1] = 4*y+1;
           k++;
       }
   }
 
   /* now sort the constellation */
-  qsort(s->constellation, C_MAX_SIZE, 2, constellation_cmp);
+  qsort(v34_constellation, C_MAX_SIZE, 2, constellation_cmp);
 
 #if 0
   for(i=0;i<L_MAX/4;i++) printf("%d: x=%d y=%d\n",
-                            i, s->constellation[i][0], s->constellation[i][1]);
+                            i, v34_constellation[i][0], v34_constellation[i][1]);
 #endif
+}
 
-  /* build the table for the decoder (not the best table, the corners
-     are not ok) */
-  
-  memset(s->constellation_to_code, 0, sizeof(s->constellation_to_code));
-  for(j=0;j<4;j++) {
-    for(i=0;i<L_MAX/4;i++) {
-      int x1,y1;
-
-      x1 = s->constellation[i][0];
-      y1 = s->constellation[i][1];
-
-      rotate_clockwise(x, y, x1, y1, j);
-
-      x = (x + C_RADIUS) >> 1;
-      y = (y + C_RADIUS) >> 1;
-      
-      s->constellation_to_code[x][y] = i | (j << 14);
+/* Build the decision table of the L point constellation: for each
+   point (x, y) of the lattice with odd coordinates in [-C_RADIUS,
+   C_RADIUS], store the nearest point of the constellation in the
+   same rotation class (i.e. with the same value of Z), as i | (j <<
+   14) where i is the index in the quarter constellation and j the
+   rotation. The points outside the constellation (corners, decoding
+   errors) are thus mapped to a valid code. The tables are shared by
+   all the configurations with the same L. */
+static const u16 (*build_decision_table(int L))[C_RADIUS+1]
+{
+  u16 (*tab)[C_RADIUS+1];
+  int n, x, y, x1, y1, i, j, k, d, d_min, best;
+
+  n = L / 4;
+  if (v34_decision_tables[n])
+      return (const u16 (*)[C_RADIUS+1])v34_decision_tables[n];
+
+  tab = malloc(sizeof(u16) * (C_RADIUS+1) * (C_RADIUS+1));
+  for(y=-C_RADIUS;y<=C_RADIUS;y+=2) {
+    for(x=-C_RADIUS;x<=C_RADIUS;x+=2) {
+      /* rotation class: the quarter constellation is on (1,1) + 4Z^2 */
+      for(j=0;j<4;j++) {
+        rotate_clockwise(x1, y1, 1, 1, j);
+        if (((x - x1) & 3) == 0 && ((y - y1) & 3) == 0)
+          break;
+      }
+      d_min = 0x7fffffff;
+      best = 0;
+      for(i=0;i<n;i++) {
+        rotate_clockwise(x1, y1, v34_constellation[i][0], 
+                         v34_constellation[i][1], j);
+        d = (x1 - x) * (x1 - x) + (y1 - y) * (y1 - y);
+        if (d < d_min) {
+          d_min = d;
+          best = i;
+          if (d == 0)
+            break;
+        }
+      }
+      k = best | (j << 14);
+      tab[(x + C_RADIUS) >> 1][(y + C_RADIUS) >> 1] = k;
     }
   }
+  v34_decision_tables[n] = tab;
+  return (const u16 (*)[C_RADIUS+1])tab;
 }
 
 /* index to ring utilities */
 
-static inline int g2(V34DSPState *st, int p, int m)
-{
-  if (p >= 0 && p <= 2*(m-1))
-    return m - abs(p-(m-1));
-  else {
-    return 0;
-  }
-}
+static V34Rings v34_rings[M_MAX + 1];
 
-static inline int g4(V34DSPState *st, int p, int m)
+/* return the largest j in [lo, hi] such that tab[j] <= v */
+static inline int ring_search(const s64 *tab, int lo, int hi, s64 v)
 {
-  int s,i;
-  
-  s = 0;
-  if (p >= 0 && p <= 4*(m-1)) {
-    for(i=0;i<=p;i++) s += st->g2_tab[i] * st->g2_tab[p-i];
+  int n, half;
+
+  /* tab[lo] <= v is always true. No branch in the loop body, so that
+     the compiler can use conditional moves. */
+  n = hi - lo + 1;
+  while (n > 1) {
+    half = n >> 1;
+    lo = (tab[lo + half] <= v) ? lo + half : lo;
+    n -= half;
   }
-  return s;
+  return lo;
 }
 
-static inline int g8(V34DSPState *st, int p, int m)
+static inline int ring_search_int(const int *tab, int lo, int hi, int v)
 {
-  int s,i;
+  int n, half;
 
-  s = 0;
-  if (p >= 0 && p <= 8*(m-1)) {
-    for(i=0;i<=p;i++) s += st->g4_tab[i] * st->g4_tab[p-i];
+  n = hi - lo + 1;
+  while (n > 1) {
+    half = n >> 1;
+    lo = (tab[lo + half] <= v) ? lo + half : lo;
+    n -= half;
   }
-  return s;
+  return lo;
 }
 
+/* ( 9.3.1) find the rings of the 8 2D symbols of a mapping frame */
 static void index_to_rings(V34DSPState *s, int ring[4][2], int r0)
 {
+  const V34Rings *rt = s->rings;
   int a,b,c,d,e,f,g,h,r1,r2,r3,r4,r5,tmp,m;
   
-  m = s->M;
+  m = rt->m;
 
-  a = -1;
-  r1 = 0;
-  for(;;) {
-    tmp = r0 - s->z8_tab[a+1];
-    if (tmp < 0) break;
-    r1 = tmp;
-    a++;
-  }
-  
-  b = 0;
-  for(;;) {
-    tmp = r1 - s->g4_tab[b] * s->g4_tab[a-b];
-    if (tmp < 0) break;
-    r1 = tmp;
-    b++;
-  }
+  a = ring_search(rt->z8, 0, 8*(m-1), r0);
+  r1 = r0 - rt->z8[a];
+
+  b = ring_search(rt->c4 + a * rt->w4, 0, rt->w4 - 1, r1);
+  r1 -= rt->c4[a * rt->w4 + b];
   
-  tmp = s->g4_tab[b];
+  tmp = rt->g4[b];
   r2 = r1 % tmp;
   r3 = (r1 - r2) / tmp;
 
-  c = 0;
-  r4 = r2;
-  for(;;) {
-    tmp = r4 - s->g2_tab[c] * s->g2_tab[b-c];
-    if (tmp < 0) break;
-    r4 = tmp;
-    c++;
-  }
+  c = ring_search_int(rt->c2 + b * rt->w2, 0, rt->w2 - 1, r2);
+  r4 = r2 - rt->c2[b * rt->w2 + c];
 
-  d = 0;
-  r5 = r3;
-  for(;;) {
-    tmp = r5 - s->g2_tab[d] * s->g2_tab[a-b-d];
-    if (tmp < 0) break;
-    r5 = tmp;
-    d++;
-  }
+  d = ring_search_int(rt->c2 + (a-b) * rt->w2, 0, rt->w2 - 1, r3);
+  r5 = r3 - rt->c2[(a-b) * rt->w2 + d];
 
-  tmp = s->g2_tab[c];
+  tmp = rt->g2[c];
   e = r4 % tmp;
   f = (r4 - e) / tmp;
   
-  tmp = s->g2_tab[d];
+  tmp = rt->g2[d];
   g = r5 % tmp;
   h = (r5 - g) / tmp;
   
@@ -279,9 +264,10 @@ static void index_to_rings(V34DSPState *s, int ring[4][2], int r0)
 /* return the K bit index corresponding to the rings */
 static int rings_to_index(V34DSPState *s, int ring[4][2])
 {
-  int a,b,c,d,e,f,g,h,r0,r1,r2,r3,r4,r5,m,i;
+  const V34Rings *rt = s->rings;
+  int a,b,c,d,e,f,g,h,r1,r2,r3,r4,r5,m;
 
-  m = s->M;
+  m = rt->m;
 
   /* find back the parameters */
   c = ring[0][0] + ring[0][1];
@@ -298,89 +284,93 @@ static int rings_to_index(V34DSPState *s, int ring[4][2])
   if (a < m) h = ring[3][0]; else h = m - 1 - ring[3][1];
   a += b + d;
 
-  r5 = h * s->g2_tab[d] + g;
-  r4 = f * s->g2_tab[c] + e;
-  
-  r3 = r5;
-  for(i=0;i<d;i++) r3 += s->g2_tab[i] * s->g2_tab[a-b-i];
-  
-  r2 = r4;
-  for(i=0;i<c;i++) r2 += s->g2_tab[i] * s->g2_tab[b-i];
-
-  r1 = r3 * s->g4_tab[b] + r2;
+  r5 = h * rt->g2[d] + g;
+  r4 = f * rt->g2[c] + e;
   
-  for(i=0;i<b;i++) r1 += s->g4_tab[i] * s->g4_tab[a-i];
+  r3 = r5 + rt->c2[(a-b) * rt->w2 + d];
+  r2 = r4 + rt->c2[b * rt->w2 + c];
 
-  r0 = r1 + s->z8_tab[a];
+  r1 = r3 * rt->g4[b] + r2 + rt->c4[a * rt->w4 + b];
 
-  return r0;
+  return r1 + rt->z8[a];
 }
 
-/* initialize the g2, g4, g8 & z8 tables */
-static void build_rings(V34DSPState *s)
+/* initialize the g2, g4, g8 & z8 tables and their cumulative sums for
+   m rings */
+static void build_rings(V34Rings *rt, int m)
 {
-  int n,i,m;
-  m = s->M;
+  int n,i,j;
+  
+  rt->m = m;
   n = 8*(m - 1) + 1;
-  for(i=0;i<n;i++) s->g2_tab[i] = g2(s,i,m);
-  for(i=0;i<n;i++) s->g4_tab[i] = g4(s,i,m);
-  for(i=0;i<n;i++) s->g8_tab[i] = g8(s,i,m);
+  for(i=0;i<n;i++) {
+    if (i <= 2*(m-1))
+      rt->g2[i] = m - abs(i-(m-1));
+    else
+      rt->g2[i] = 0;
+  }
+  for(i=0;i<n;i++) {
+    rt->g4[i] = 0;
+    for(j=0;j<=i;j++) rt->g4[i] += rt->g2[j] * rt->g2[i-j];
+  }
+  for(i=0;i<n;i++) {
+    rt->g8[i] = 0;
+    for(j=0;j<=i;j++) rt->g8[i] += rt->g4[j] * rt->g4[i-j];
+  }
   
-  s->z8_tab[0] = 0;
-  for(i=1;i<n;i++) {
-    s->z8_tab[i] = s->z8_tab[i-1] + s->g8_tab[i-1];
+  rt->z8[0] = 0;
+  for(i=1;i<=n;i++) {
+    rt->z8[i] = rt->z8[i-1] + rt->g8[i-1];
   }
 
-#if 0
-  {
-    int i;
-    for(i=0;i<=(1 << s->K);i++) {
-      int m[4][2],j, r1,r0;
-      r0 = random() % (1 << s->K);
-      index_to_rings(s, m, r0);
-      r1 = rings_to_index(s, m);
-      printf("%d:", r0);
-      for(j=0;j<4;j++) printf(" %d %d",m[j][0], m[j][1]);
-      printf("\n");
-      if (r0 != r1) {
-        printf("error r0=%d r1=%d\n" , r0, r1);
-        exit(1);
-      }
+  /* cumulative sums for the 4D and 2D ring sums */
+  rt->w4 = 4*(m - 1) + 2;
+  rt->c4 = malloc(n * rt->w4 * sizeof(s64));
+  rt->w2 = 2*(m - 1) + 2;
+  rt->c2 = malloc((4*(m - 1) + 1) * rt->w2 * sizeof(int));
+  if (!rt->c4 || !rt->c2) {
+    fprintf(stderr, "V34: no memory\n");
+    exit(1);
+  }
+  for(i=0;i<n;i++) {
+    rt->c4[i * rt->w4] = 0;
+    for(j=1;j<rt->w4;j++) {
+      rt->c4[i * rt->w4 + j] = rt->c4[i * rt->w4 + j - 1];
+      if (j - 1 <= i)
+        rt->c4[i * rt->w4 + j] += (s64)rt->g4[j-1] * rt->g4[i-j+1];
+    }
+  }
+  for(i=0;i<=4*(m - 1);i++) {
+    rt->c2[i * rt->w2] = 0;
+    for(j=1;j<rt->w2;j++) {
+      rt->c2[i * rt->w2 + j] = rt->c2[i * rt->w2 + j - 1];
+      if (j - 1 <= i)
+        rt->c2[i * rt->w2 + j] += rt->g2[j-1] * rt->g2[i-j+1];
     }
   }
-#endif
-
 }
 
-/* parameters for each symbol rate */
+/* parameters for each symbol rate (see v34table.h) */
 static u8 S_tab[6][8] = {
   /* a, c, d1, e1, d2, e2, J, P */
-    { 1, 1, 2, 3, 3, 4, 7, 12, }, /* S=2400 */
-    { 8, 7, 3, 5, 2, 3, 8, 12, }, /* S=2743 */
-    { 7, 6, 3, 5, 2, 3, 7, 14, }, /* S=2800 */
-    { 5, 4, 3, 5, 2, 3, 7, 15, }, /* S=3000 */
-    { 4, 3, 4, 7, 3, 5, 7, 16, }, /* S=3200 */
-    {10, 7, 4, 7, 4, 7, 8, 15, }, /* S=3429 */
+#define SYMBOL_RATE(a, c, d1, e1, d2, e2, J, P, a1, c1) \
+    { a, c, d1, e1, d2, e2, J, P },
+    V34_SYMBOL_RATES
+#undef SYMBOL_RATE
 };
 
 /* this table depends on the sample rate. We have S=a1/c1 * V34_SAMPLE_RATE */
 static u8 baud_tab[6][2] = {
     /* a1, c1 */
-    { 3, 10 },
-    { 12, 35 },
-    { 7, 20 },
-    { 3, 8 },
-    { 2, 5 },
-    { 3, 7 },
+#define SYMBOL_RATE(a, c, d1, e1, d2, e2, J, P, a1, c1) { a1, c1 },
+    V34_SYMBOL_RATES
+#undef SYMBOL_RATE
 };
 
 static s16 *rc_filter[6] = {
-    v34_rc_10_filter,
-    v34_rc_35_filter,
-    v34_rc_20_filter,
-    v34_rc_8_filter,
-    v34_rc_5_filter,
-    v34_rc_7_filter,
+#define TX_FILTER(c1, S) [S] = v34_rc_ ## c1 ## _filter,
+    V34_TX_FILTERS
+#undef TX_FILTER
 };
     
 static void build_tx_filter(V34DSPState *s)
@@ -562,19 +552,10 @@ float hilbert[156] =
 };
 
 
-s16 *v34_rx_filters[12] = {
-    v34_rx_filter_2400_1600,
-    v34_rx_filter_2400_1800,
-    v34_rx_filter_2743_1646,
-    v34_rx_filter_2743_1829,
-    v34_rx_filter_2800_1680,
-    v34_rx_filter_2800_1867,
-    v34_rx_filter_3000_1800,
-    v34_rx_filter_3000_2000,
-    v34_rx_filter_3200_1829,
-    v34_rx_filter_3200_1920,
-    v34_rx_filter_3429_1959,
-    v34_rx_filter_3429_1959,
+static s16 *v34_rx_filters[V34_NB_S][2] = {
+#define RX_FILTER(name, S, high) [S][high] = v34_rx_filter_ ## name,
+    V34_RX_FILTERS
+#undef RX_FILTER
 };
     
 static void build_rx_filter(V34DSPState *s)
@@ -583,7 +564,13 @@ static void build_rx_filter(V34DSPState *s)
     int i;
 
 
-    s->rx_filter = v34_rx_filters[s->S * 2 + s->use_high_carrier];
+    s->rx_filter = v34_rx_filters[s->S][s->use_high_carrier];
+    /* same carrier for both */
+    if (!s->rx_filter)
+        s->rx_filter = v34_rx_filters[s->S][0];
+    s->rx_filter_stride = V34_RX_FILTER_STRIDE(s->baud_num, s->baud_denom);
+    s->rx_filter_phases = V34_RX_FILTER_PHASES(s->baud_num);
+    s->rx_filter_wsize = V34_RX_FILTER_TAPS(s->baud_num, s->baud_denom);
 
     /* XXX: temporary hack to synchronize */
     if (s->S == V34_S3429)
@@ -595,7 +582,6 @@ static void build_rx_filter(V34DSPState *s)
     s->carrier_incr = s->carrier_freq * (float)0x10000 / s->symbol_rate;
     s->carrier_phase = 0;
     s->rx_buf1_ptr = 0;
-    s->rx_filter_wsize = (s->baud_denom * RC_FILTER_SIZE) / s->baud_num;
     printf("cincr=%d baudincr=%d\n", s->carrier_incr, s->baud_incr);
 
     s->baud_phase = s->baud_phase << 16;
@@ -610,6 +596,9 @@ static void build_rx_filter(V34DSPState *s)
     
     /* adaptation shift : big at the beginning, should be small after. */
     s->eq_shift = 0;
+    s->eq_update_mode = EQ_UPDATE_LMS;
+    s->eq_update_period = 1;
+    eq_load_coefs(s);
 
     /* synchronization : Nyquist filters at the upper & lower frequencies */
     a = 0.99;
@@ -617,7 +606,6 @@ static void build_rx_filter(V34DSPState *s)
         (3.0 * s->symbol_rate);
     f_high = 2 * M_PI * (s->carrier_freq + s->symbol_rate / 2.0) / 
         (3.0 * s->symbol_rate);
-    printf("%f %f\n", f_low, f_high);
 
     s->sync_low_coef[0] = (int)(2 * a * cos(f_low) * 0x4000);
     s->sync_low_coef[1] = (int)( - a * a * 0x4000);
@@ -631,68 +619,210 @@ static void build_rx_filter(V34DSPState *s)
     s->sync_C = (int)( - a * sin(f_low) * 0x4000);
 }
 
+/* data frame & mapping parameters of each symbol rate, data rate,
+   shaping and aux channel */
+#define NL_ZETA_MEAN 0.3125 /* zeta of the non linear encoder for a
+                               symbol of mean power */
+
+static V34Config v34_configs[V34_NB_S][V34_NB_R][2][2];
+
+/* superframe synchronisation bits of each symbol rate */
+static u64 v34_sync_v0[V34_NB_S][V34_SYNC_WORDS];
+
+static void build_config(V34Config *c, int S, int R, int expanded_shape,
+                         int use_aux_channel)
+{
+  int J, P, i, p, rcnt, acnt;
+
+  J = S_tab[S][6];
+  P = S_tab[S][7];
+  c->R = R;
+  if (use_aux_channel)
+      c->R += 200;
+
+  c->N = (c->R * 28) / (J * 100); 
+  /* max length of a mapping frame (no need for table 8 as in the spec !) */
+  c->b = c->N / P; 
+  if ((c->b * P) < c->N) c->b++;
+  c->r = c->N - (c->b - 1) * P;
+  
+  /* aux channel */
+  if (use_aux_channel)
+      c->W = 15 - J; /* no need to test as in the spec ! */
+  else
+      c->W = 0; /* no aux channel */
+
+  /* data frame schedule: r mapping frames of b bits and W aux bits,
+     spread with fractional counters ( 9.2) */
+  rcnt = 0;
+  acnt = 0;
+  c->aux_frames = 0;
+  for(i=0;i<P;i++) {
+      rcnt += c->r;
+      if (rcnt < P) {
+          c->mp_size[i] = c->b - 1;
+      } else {
+          rcnt -= P;
+          c->mp_size[i] = c->b;
+      }
+      acnt += c->W;
+      if (acnt >= P) {
+          acnt -= P;
+          c->aux_frames |= 1 << i;
+      }
+  }
+
+  /* mapping parameters */
+  c->q = 0;
+  if (c->b <= 12) {
+    c->K = 0;
+  } else {
+    c->K = c->b - 12;
+    while (c->K >= 32) {
+      c->K -= 8;
+      c->q++;
+    }
+  }
+
+  if (!expanded_shape) {
+    c->M = (int) ceil(pow(2.0, c->K / 8.0));
+  } else {
+    c->M = (int) rint(1.25 * pow(2.0, c->K / 8.0));
+  }
+  c->L = 4 * c->M * (1 << c->q);
+  c->valid = 0;
+  /* data rate too high for this symbol rate */
+  if (c->M > M_MAX || c->L > L_MAX)
+      return;
+  c->rings = &v34_rings[c->M];
+  /* the expanded shape cannot code K bits at the lowest rates */
+  if (c->K != 0 && c->rings->z8[8 * (c->M - 1) + 1] < ((s64)1 << c->K))
+      return;
+  c->valid = 1;
+  c->decision = build_decision_table(c->L);
+
+  p = 0;
+  for(i=0;i<c->L/4;i++) {
+      p += v34_constellation[i][0] * v34_constellation[i][0] + 
+          v34_constellation[i][1] * v34_constellation[i][1];
+  }
+  c->data_power = (float)p / (c->L/4);
+  /* |x|^2 >> 8 is data_power * 64 for a symbol of the mean power */
+  c->nl_scale = (int)(NL_ZETA_MEAN * (1 << 30) / (c->data_power * 64.0));
+}
+
+/* v0 of each 4D symbol of a superframe of J data frames of P mapping
+   frames: the bit of SYNC_PATTERN of each half data frame is sent
+   with its first 4D symbol */
+static void build_sync_table(u64 *tab, int P, int J)
+{
+  int k;
+
+  assert(4 * P * J <= 64 * V34_SYNC_WORDS);
+  memset(tab, 0, V34_SYNC_WORDS * sizeof(u64));
+  for(k=0;k<4*P*J;k+=2*P) {
+      if ((SYNC_PATTERN >> (15 - k / (2*P))) & 1)
+          tab[k >> 6] |= 1ULL << (k & 63);
+  }
+}
+
+/* return true if the data rate 'R' can be used with the symbol rate
+   'S' */
+int V34_rate_valid(int S, int R, int expanded_shape, int use_aux_channel)
+{
+  if (R < 2400 || R > 33600 || (R % 2400) != 0)
+      return 0;
+  return v34_configs[S][R / 2400 - 1][expanded_shape][use_aux_channel].valid;
+}
+
+/* highest valid data rate lower or equal to 'R' (with and without
+   aux channel) for the symbol rate 'S'. Used for the rates received
+   from the remote modem. */
+static int V34_clamp_rate(int S, int R, int expanded_shape)
+{
+  if (R > 33600)
+      R = 33600;
+  R = (R / 2400) * 2400;
+  while (R > 2400 && (!V34_rate_valid(S, R, expanded_shape, 0) ||
+                      !V34_rate_valid(S, R, expanded_shape, 1)))
+      R -= 2400;
+  if (R < 2400)
+      R = 2400;
+  return R;
+}
+
+/* select the data frame & mapping parameters of the data rate 'R'
+   (the symbol rate must be set). The rate must be valid. */
+static void V34_init_rate(V34DSPState *s, int R, int use_aux_channel)
+{
+  const V34Config *c;
+
+  c = &v34_configs[s->S][R / 2400 - 1][s->expanded_shape][use_aux_channel];
+  assert(c->valid);
+  s->cfg = c;
+  s->R = c->R;
+  s->N = c->N;
+  s->W = c->W;
+  s->b = c->b;
+  s->r = c->r;
+  s->K = c->K;
+  s->q = c->q;
+  s->M = c->M;
+  s->L = c->L;
+  s->rings = c->rings;
+  s->constellation_to_code = c->decision;
+}
+
+/* symbol rate & carrier frequency (in Hz) of the symbol rate index 'S' */
+void V34_get_freqs(int S, int use_high_carrier, 
+                   float *symbol_rate, float *carrier_freq)
+{
+  int d, e;
+  float W;
+
+  if (!use_high_carrier) {
+    d = S_tab[S][2];
+    e = S_tab[S][3];
+  } else {
+    d = S_tab[S][4];
+    e = S_tab[S][5];
+  }
+  W = 2400.0 * (float)S_tab[S][0] / (float)S_tab[S][1];
+  *symbol_rate = W;
+  if (carrier_freq)
+    *carrier_freq = W * (float)d / (float)e;
+}
+
+/* return -1 if the data rate cannot be used with the symbol rate */
 int V34_init_low(V34DSPState *s, V34State *p, int transmit)
 {
-  int S,d,e;
+  int S;
   
+  if (!V34_rate_valid(p->S, p->R, p->expanded_shape, p->use_aux_channel))
+      return -1;
+
   /* copy the params */
   s->calling = p->calling;
   s->S = p->S;
   s->expanded_shape = p->expanded_shape;
-  s->R = p->R;
-  if (p->use_aux_channel)
-      s->R += 200;
+  s->use_aux_channel = p->use_aux_channel;
   s->conv_nb_states = p->conv_nb_states;
   s->use_non_linear = p->use_non_linear;
   s->use_high_carrier = p->use_high_carrier;
   memcpy(s->h, p->h, sizeof(s->h));
+  s->use_precoding = (p->h[0][0] | p->h[0][1] | p->h[1][0] | p->h[1][1] | 
+                      p->h[2][0] | p->h[2][1]) != 0;
 
   /* superframe & data frame size */
   S = s->S;
-  if (!s->use_high_carrier) {
-    d = S_tab[S][2];
-    e = S_tab[S][3];
-  } else {
-    d = S_tab[S][4];
-    e = S_tab[S][5];
-  }
-  s->symbol_rate = 2400.0 * (float)S_tab[S][0] / (float)S_tab[S][1];
-  s->carrier_freq = s->symbol_rate * (float)d / (float)e;
+  V34_get_freqs(S, s->use_high_carrier, &s->symbol_rate, &s->carrier_freq);
+  s->constellation = v34_constellation;
 
   s->J = S_tab[S][6];
   s->P = S_tab[S][7];
-  s->N = (s->R * 28) / (s->J * 100); 
-  /* max length of a mapping frame (no need for table 8 as in the spec !) */
-  s->b = s->N / s->P; 
-  if ((s->b * s->P) < s->N) s->b++;
-  s->r = s->N - (s->b - 1) * s->P;
-  
-  /* aux channel */
-  if (p->use_aux_channel)
-      s->W = 15 - s->J; /* no need to test as in the spec ! */
-  else
-      s->W = 0; /* no aux channel */
-
-  /* mapping parameters */
-  s->q = 0;
-  if (s->b <= 12) {
-    s->K = 0;
-  } else {
-    s->K = s->b - 12;
-    while (s->K >= 32) {
-      s->K -= 8;
-      s->q++;
-    }
-  }
-
-  /* XXX: use integer arith ! */
-  if (!s->expanded_shape) {
-    s->M = (int) ceil(pow(2.0, s->K / 8.0));
-  } else {
-    s->M = (int) rint(1.25 * pow(2.0, s->K / 8.0));
-  }
-  s->L = 4 * s->M * (1 << s->q);
-
+  s->sync_v0 = v34_sync_v0[S];
+  s->sync_len = 4 * s->P * s->J;
+  V34_init_rate(s, p->R, p->use_aux_channel);
 #ifdef DEBUG
   printf("S_index=%d (S=%0.0f carrier=%0.0f)\n"
          "R=%d J=%d P=%d N=%d b=%d r=%d W=%d\n", 
@@ -701,10 +831,6 @@ int V34_init_low(V34DSPState *s, V34State *p, int transmit)
   printf("K=%d q=%d M=%d L=%d\n", s->K, s->q, s->M, s->L);
 #endif
 
-  build_constellation(s);
-  
-  build_rings(s);
-
   s->baud_num = baud_tab[S][0];
   s->baud_denom = baud_tab[S][1];
 
@@ -719,14 +845,18 @@ int V34_init_low(V34DSPState *s, V34State *p, int transmit)
   s->Z_1 = 0;
   s->U0 = 0; /* trellis coder memory */
   memset(s->x, 0, sizeof(s->x));
-  s->half_data_frame_count = 0;
-  s->sync_count = 0;
+  s->sync_pos = 0;
   s->conv_reg = 0;
-  s->scrambler_reg = 0;
+  /* GPC is used by the calling modem to transmit */
+  scrambler_init(&s->scrambler, 
+                 (transmit ? s->calling : !s->calling) ? V34_GPC : V34_GPA,
+                 SCRAMBLER_DEG);
+
+  s->mapping_frame = 0;
 
-  s->mapping_frame = 0; /* mapping frame counters */
-  s->acnt = 0;
-  s->rcnt = 0;
+  s->rx_pow = 2 * 128 * 128;
+  s->rx_signal = 1;
+  s->rx_gain = 256;
 
   return 0;
 }
@@ -758,6 +888,63 @@ static inline int clamp(int a, int v)
     return a;
 }
 
+/* ( 9.7) non linear encoder: x'(n) = theta(zeta) * x(n) with
+   theta(zeta) = 1 + zeta / 6 + zeta^2 / 120. zeta is proportional to
+   |x(n)|^2 and is NL_ZETA_MEAN for a symbol of the mean power of the
+   constellation. Everything is in 2.14 fixed point. */
+#define NL_ZETA_MAX  (3 << 14) /* theta < 1.6, theta * x fits in 32 bits */
+#define NL_ITER      2         /* Newton iterations of the inverse */
+
+static inline int nl_zeta(V34DSPState *s, int x_re, int x_im)
+{
+  int x2;
+
+  x_re >>= 4;
+  x_im >>= 4;
+  x2 = x_re * x_re + x_im * x_im;
+  return ((s64)x2 * s->cfg->nl_scale) >> 16;
+}
+
+static inline int nl_theta(int zeta)
+{
+  int t;
+
+  if (zeta > NL_ZETA_MAX)
+    zeta = NL_ZETA_MAX;
+  t = (1 << 14) / 6 + ((zeta * ((1 << 14) / 120)) >> 14);
+  return (1 << 14) + ((zeta * t) >> 14);
+}
+
+static inline void nl_encode(V34DSPState *s, int *x_re, int *x_im)
+{
+  int theta;
+
+  theta = nl_theta(nl_zeta(s, *x_re, *x_im));
+  *x_re = (*x_re * theta + (1 << 13)) >> 14;
+  *x_im = (*x_im * theta + (1 << 13)) >> 14;
+}
+
+/* inverse of nl_encode(): x = g * x' with g * theta(g^2 * zeta(x')) = 1,
+   solved with Newton iterations from g = 1 / theta(zeta(x')). */
+static inline void nl_decode(V34DSPState *s, int *x_re, int *x_im)
+{
+  int i, z, z1, g, f, df;
+
+  z = nl_zeta(s, *x_re, *x_im);
+  g = (1 << 28) / nl_theta(z);
+  for(i=0;i<NL_ITER;i++) {
+    z1 = ((((g * g) >> 14) * (s64)z) >> 14);
+    if (z1 > 4 * NL_ZETA_MAX)
+      z1 = 4 * NL_ZETA_MAX;
+    f = ((g * nl_theta(z1)) >> 14) - (1 << 14);
+    /* derivative: 1 + zeta / 2 + zeta^2 / 24 */
+    df = (1 << 14) + (z1 >> 1) + ((((z1 >> 2) * (z1 >> 2)) >> 10) / 24);
+    g -= (f << 14) / df;
+  }
+  *x_re = (*x_re * g + (1 << 13)) >> 14;
+  *x_im = (*x_im * g + (1 << 13)) >> 14;
+}
+
 /* compute the next state in the trellis (Y[0] is ignored) */
 static int trellis_next_state(int conv_nb_states, int conv_reg, int trans)
 {
@@ -806,9 +993,22 @@ static int trellis_next_state(int conv_nb_states, int conv_reg, int trans)
     return conv_reg;
 }
 
-/* ( 9.6.3) trellis encoder, return U0 */
+/* ( 9.6.3) trellis encoder, return U0 without c0 (c0 is only known
+   when the next 4D symbol is mapped) */
+
+/* superframe synchronisation bit of the next 4D symbol: the bits of
+   SYNC_PATTERN at the start of each half data frame ( 9.6.3.2) */
+static inline int sync_bit(V34DSPState *s)
+{
+  int v0;
+
+  v0 = (s->sync_v0[s->sync_pos >> 6] >> (s->sync_pos & 63)) & 1;
+  if (++s->sync_pos == s->sync_len)
+    s->sync_pos = 0;
+  return v0;
+}
 
-static int trellis_encoder(V34DSPState *s, int c0, int yy[2][2])
+static int trellis_encoder(V34DSPState *s, int yy[2][2])
 {
   int v0, ss[2][3], Y[5], i, trans;
 
@@ -846,105 +1046,158 @@ static int trellis_encoder(V34DSPState *s, int c0, int yy[2][2])
   Y[0] = s->conv_reg & 1;
 
   /* super frame synchronisation pattern */
-  if (s->sync_count == 0) {
-    v0 = (SYNC_PATTERN >> (15 - s->half_data_frame_count)) & 1;
-  } else {
-    v0 = 0;
-  }
+  v0 = sync_bit(s);
 
-  return Y[0] ^ c0 ^ v0;
+  return Y[0] ^ v0;
 }
 
 
-static int get_bit(V34DSPState *s)
+/* mapping frames: the bits are packed LSB first in MAPPING_FRAME_WORDS
+   64 bit words, so that the fields can be extracted with shifts */
+
+/* data bits are read, scrambled and written by blocks of this size */
+#define V34_BITS_BLOCK 24
+
+/* return the 'n' bits (n <= 32) at position 'pos' */
+static inline u32 frame_get(const u64 *f, int pos, int n)
+{
+    u64 v;
+    int sh;
+
+    sh = pos & 63;
+    v = f[pos >> 6] >> sh;
+    if (sh + n > 64)
+        v |= f[(pos >> 6) + 1] << (64 - sh);
+    return v & ((1ULL << n) - 1);
+}
+
+/* or the 'n' bits of 'v' at position 'pos' */
+static inline void frame_put(u64 *f, int pos, int n, u32 v)
 {
-    int b, poly;
+    int sh;
 
-    b = s->get_bit(s->opaque);
-    if (b == -1) b = 1;
-    if (s->calling)
-        poly = V34_GPC;
-    else
-        poly = V34_GPA;
-    b = scramble_bit(s, b, poly);
-    return b;
+    sh = pos & 63;
+    f[pos >> 6] |= (u64)v << sh;
+    if (sh + n > 64)
+        f[(pos >> 6) + 1] |= (u64)v >> (64 - sh);
+}
+
+/* read 'n' data bits and scramble them at position 'pos' of the
+   frame */
+static void get_data_bits(V34DSPState *s, u64 *f, int pos, int n)
+{
+    int j, k, b;
+    u32 w;
+
+    while (n > 0) {
+        k = n;
+        if (k > V34_BITS_BLOCK)
+            k = V34_BITS_BLOCK;
+        if (s->get_bits) {
+            w = s->get_bits(s->opaque, k);
+        } else {
+            w = 0;
+            for(j=0;j<k;j++) {
+                b = s->get_bit(s->opaque);
+                if (b == -1) b = 1;
+                w = (w << 1) | b;
+            }
+        }
+        w = scrambler_bits(&s->scrambler, w, k);
+        /* the oldest bit goes to the LSB */
+        frame_put(f, pos, k, dsp_bit_reverse32(w) >> (32 - k));
+        pos += k;
+        n -= k;
+    }
 }
 
-/* auxilary channel bit */
+/* auxiliary channel bit (not scrambled) */
 static int aux_get_bit(V34DSPState *s)
 {
-    return 0;
+    int b;
+
+    if (!s->get_aux_bit)
+        return 0;
+    b = s->get_aux_bit(s->opaque);
+    if (b == -1)
+        b = 0;
+    return b;
 }
 
-/* encode size bits into the corresponding symbols of the constellation */
-/* return exactly 8 baseband complex samples */
-static void encode_mapping_frame(V34DSPState *s)
+/* read a mapping frame of 'mp_size' bits. If 'aux' is true, its
+   first bit is an auxiliary channel bit */
+static void get_mapping_frame(V34DSPState *s, u64 *f, int mp_size, int aux)
 {
-  int m[4][2], r0; /* rings */
-  u8 I[3][4];
-  int Q[4][2], Z[2], Y[2][2];
-  u8 *ptr;
-  int t,i,j,k,x,y,x1,y1,w,mp_size;
-  int u_re, u_im, p_re, p_im, c_re, c_im, C0, x_re, x_im, xp_re, xp_im;
-  u8 data[MAX_MAPPING_FRAME_SIZE];
+  f[0] = 0;
+  f[1] = 0;
 
-  /* compute mapping frame size */
-  s->rcnt += s->r;
-  if (s->rcnt < s->P) {
-      mp_size = s->b - 1;
-  } else {
-      s->rcnt -= s->P;
-      mp_size = s->b;
-  }
-    
-  /* send an auxilary channel bit if needed */
-  s->acnt += s->W;
-  if (s->acnt < s->P) {
-      data[0] = get_bit(s);
+  if (aux) {
+      f[0] = aux_get_bit(s);
+      get_data_bits(s, f, 1, mp_size - 1);
   } else {
-      s->acnt -= s->P;
-      data[0] = aux_get_bit(s); 
+      get_data_bits(s, f, 0, mp_size);
   }
+  if (s->put_frame)
+      s->put_frame(s->frame_opaque, f, mp_size, aux);
+}
 
-  for(i=1;i<mp_size;i++) data[i] = get_bit(s); 
+/* ( 9.3) compute the rings, I and Q bits of a mapping frame */
+static void parse_mapping_frame(V34DSPState *s, const u64 *f, int mp_size,
+                                int m[4][2], u8 I[3][4], int Q[4][2])
+{
+  int j, n, pos, t, qmask, qsize;
 
-  //  print_bit_vector("sent", data, mp_size);
-  
   if (s->b <= 12) {
     /* ( 9.3.2) simple case: no shell mapping */
-    memset(m, 0, sizeof(m));
-    for(i=0;i<s->b;i++) ((u8 *)I)[i] = data[i];
-    for(i=s->b;i<12;i++) ((u8 *)I)[i] = 0;
-    memset(Q, 0, sizeof(Q));
+    memset(m, 0, 4 * 2 * sizeof(int));
+    t = frame_get(f, 0, s->b);
+    for(j=0;j<4;j++) {
+      I[0][j] = t & 1;
+      I[1][j] = (t >> 4) & 1;
+      I[2][j] = (t >> 8) & 1;
+      t >>= 1;
+    }
+    memset(Q, 0, 4 * 2 * sizeof(int));
   } else {
     /* ( 9.3.1) */
     /* leave one bit if low frame */
-    int n;
-
     n = s->K;
     if (mp_size < s->b) n--;
     
-    ptr = data;
-    r0 = 0;
-    for(i=0;i<n;i++) r0 |= *ptr++ << i;
-    index_to_rings(s, m, r0);
+    index_to_rings(s, m, frame_get(f, 0, n));
 
+    pos = n;
+    qsize = 3 + 2 * s->q;
+    qmask = (1 << s->q) - 1;
     for(j=0;j<4;j++) {
-      I[0][j] = ptr[0];
-      I[1][j] = ptr[1];
-      I[2][j] = ptr[2];
-      ptr += 3;
-
-      t = 0;
-      for(i=0;i<s->q;i++) t |= *ptr++ << i;
-      Q[j][0] = t;
-
-      t = 0;
-      for(i=0;i<s->q;i++) t |= *ptr++ << i;
-      Q[j][1] = t;
+      t = frame_get(f, pos, qsize);
+      pos += qsize;
+      I[0][j] = t & 1;
+      I[1][j] = (t >> 1) & 1;
+      I[2][j] = (t >> 2) & 1;
+      Q[j][0] = (t >> 3) & qmask;
+      Q[j][1] = (t >> (3 + s->q)) & qmask;
     }
   }
-  
+}
+
+/* encode size bits into the corresponding symbols of the constellation */
+/* return exactly 8 baseband complex samples */
+static void encode_mapping_frame(V34DSPState *s)
+{
+  int m[4][2]; /* rings */
+  u8 I[3][4];
+  int Q[4][2], Z[2], Y[2][2];
+  int t,i,j,k,x,y,x1,y1,w,mp_size;
+  int u_re, u_im, p_re, p_im, c_re, c_im, C0, x_re, x_im, xp_re, xp_im;
+  u64 f[MAPPING_FRAME_WORDS];
+
+  /* mapping frame size & aux bit from the data frame schedule */
+  mp_size = s->cfg->mp_size[s->mapping_frame];
+  get_mapping_frame(s, f, mp_size, 
+                    (s->cfg->aux_frames >> s->mapping_frame) & 1);
+  parse_mapping_frame(s, f, mp_size, m, I, Q);
+
   if (s->b < 56) 
     w = 1;
   else 
@@ -957,21 +1210,8 @@ static void encode_mapping_frame(V34DSPState *s)
     Z[0] = (I[1][j] + 2 * I[2][j] + s->Z_1) & 3;
     s->Z_1 = Z[0];
     
-    /* ( 9.6.1) mapping to 2D symbols */
-    Z[1] = (Z[0] + 2 * I[0][j] + s->U0) & 3;
-
     C0 = 0; /* for trellis coding */
     for(i=0;i<2;i++) {
-      t = Q[j][i] + (m[j][i] << s->q);
-
-      assert(t >= 0 && t < L_MAX/4);
-      x1 = s->constellation[t][0];
-      y1 = s->constellation[t][1];
-      /* rotation by Z[i] * 90 degress clockwise */
-      rotate_clockwise(x, y, x1, y1, Z[i]);
-      u_re = x;
-      u_im = y;
-
       /* ( 9.6.2) precoder */
       x = 0;
       y = 0;
@@ -988,13 +1228,29 @@ static void encode_mapping_frame(V34DSPState *s)
       c_im = shr_round0(p_im, 7 + w) << w;
       C0 += c_re + c_im;
 
-      Y[i][0] = clamp(u_re + c_re, 255);
-      Y[i][1] = clamp(u_im + c_im, 255);
-      
-      x_re = (Y[i][0] << 7) - p_re;
-      x_im = (Y[i][1] << 7) - p_im;
+      /* ( 9.6.1) mapping to 2D symbols. c(n) of the second 2D
+         symbol does not depend on its rotation, so c0 can be used for
+         the current 4D symbol: y(n) follows the trellis. */
+      if (i == 1)
+        Z[1] = (Z[0] + 2 * I[0][j] + (s->U0 ^ ((C0 >> 1) & 1))) & 3;
 
-      for(k=2;k>=1;k--) {
+      t = Q[j][i] + (m[j][i] << s->q);
+
+      assert(t >= 0 && t < L_MAX/4);
+      x1 = s->constellation[t][0];
+      y1 = s->constellation[t][1];
+      /* rotation by Z[i] * 90 degress clockwise */
+      rotate_clockwise(x, y, x1, y1, Z[i]);
+      u_re = x;
+      u_im = y;
+
+      Y[i][0] = clamp(u_re + c_re, 255);
+      Y[i][1] = clamp(u_im + c_im, 255);
+      
+      x_re = (Y[i][0] << 7) - p_re;
+      x_im = (Y[i][1] << 7) - p_im;
+
+      for(k=2;k>=1;k--) {
         s->x[k][0] = s->x[k-1][0];
         s->x[k][1] = s->x[k-1][1];
       }
@@ -1002,42 +1258,19 @@ static void encode_mapping_frame(V34DSPState *s)
       s->x[0][1] = x_im;
 
       /* ( 9.7) non linear encoder */
-
-      if (!s->use_non_linear) {
-        xp_re = x_re;
-        xp_im = x_im;
-      } else {
-        int x2;
-        float dzeta,theta;
-        /* XXX: average power ? */
-
-        x2 = (x_re * x_re + x_im * x_im) >> 7;
-        dzeta = 0.3125 /* x2 / 128.0 */;
-        theta = (1 + dzeta / 6.0 + dzeta * dzeta / 120.0);
-        
-        xp_re = rint(theta * x_re);
-        xp_im = rint(theta * x_im);
-      }
+      xp_re = x_re;
+      xp_im = x_im;
+      if (s->use_non_linear)
+        nl_encode(s, &xp_re, &xp_im);
 
       put_sym(s, xp_re, xp_im);
     }
-    s->U0 = trellis_encoder(s, (C0 >> 1) & 1, Y);
-
-    /* 4D symbol count & data frame count for synchronisation */
-    if (++s->sync_count == 2*s->P) {
-      s->sync_count = 0;
-      if (++s->half_data_frame_count == 2*s->J) {
-        s->half_data_frame_count = 0;
-      }
-    }
+    s->U0 = trellis_encoder(s, Y);
   }
 
-  if (++s->mapping_frame >= s->P) {
-      /* new data frame */
+  /* new data frame */
+  if (++s->mapping_frame == s->P)
       s->mapping_frame = 0;
-      s->rcnt = 0;
-      s->acnt = 0;
-  }
 }
 
 
@@ -1076,11 +1309,9 @@ static int V34_baseband_to_carrier(V34DSPState *s,
             sq += s->tx_buf[k][1] * s->tx_filter[ph];
             ph += s->baud_denom;
         }
-        si = si >> 14;
-        sq = sq >> 14;
-        if ( si != (short)si || sq != (short)sq) {
-            printf("error %d %d\n", si, sq);
-        }
+        /* the peaks of the data constellations may overflow */
+        si = clamp(si >> 14, 32767);
+        sq = clamp(sq >> 14, 32767);
         // printf("M: phase=%04X %d %d\n", s->baud_phase, si, sq);
         /* get next baseband symbols */
         s->baud_phase += s->baud_num;
@@ -1091,8 +1322,9 @@ static int V34_baseband_to_carrier(V34DSPState *s,
         }
         
         /* center on the carrier */
-        samples[i] = (si * dsp_cos(s->carrier_phase) - 
-            sq * dsp_cos((PHASE_BASE/4) - s->carrier_phase)) >> COS_BITS;
+        samples[i] = clamp((si * dsp_cos(s->carrier_phase) - 
+                sq * dsp_sin(s->carrier_phase)) >> COS_BITS,
+                           32767);
         s->carrier_phase += s->carrier_incr;
     }
     return i;
@@ -1146,28 +1378,23 @@ static void V34_send_PP(V34DSPState *s)
     }
 }
 
-/* send the TRN sequence, (4 or 16 states), sent for 2048 T (XXX: this
-   time was choosen randomly */
-static void V34_send_TRN(V34DSPState *s)
+/* send the TRN sequence (4 or 16 states) during 'length' T */
+static void V34_send_TRN(V34DSPState *s, int length)
 {
-    int i,x,y,x1,y1,z,poly,I1,I2,Q1,Q2,q;
-
-    if (s->calling)
-        poly = V34_GPC;
-    else
-        poly = V34_GPA;
+    int i,x,y,x1,y1,z,I1,I2,Q1,Q2,q;
 
     if (s->is_16states) 
         s->tx_amp = CALC_AMP(TRN16_POWER);
     else
         s->tx_amp = CALC_AMP(TRN4_POWER);
         
-    for(i=0;i<1024;i++) {
-        I1 = scramble_bit(s, 1, poly);
-        I2 = scramble_bit(s, 1, poly);
+    z = s->Z_1;
+    for(i=0;i<length;i++) {
+        I1 = scrambler_bit(&s->scrambler, 1);
+        I2 = scrambler_bit(&s->scrambler, 1);
         if (s->is_16states) {
-            Q1 = scramble_bit(s, 1, poly);
-            Q2 = scramble_bit(s, 1, poly);
+            Q1 = scrambler_bit(&s->scrambler, 1);
+            Q2 = scrambler_bit(&s->scrambler, 1);
             q = (Q2 << 1) | Q1;
         } else {
             q = 0;
@@ -1217,14 +1444,9 @@ int calc_crc(u8 *buf, int size)
 /* modulate an MP sequence */
 static void V34_mod_MP(V34DSPState *s, u8 *buf, int size, int is_16states)
 {
-    int x,y,x1,y1,z,poly,I1,I2,Q1,Q2,q;
+    int x,y,x1,y1,z,I1,I2,Q1,Q2,q;
     u8 *p;
     
-    if (s->calling)
-        poly = V34_GPC;
-    else
-        poly = V34_GPA;
-
     if (is_16states) 
         s->tx_amp = CALC_AMP(TRN16_POWER);
     else
@@ -1233,11 +1455,11 @@ static void V34_mod_MP(V34DSPState *s, u8 *buf, int size, int is_16states)
     p = buf;
     z = s->Z_1;
     while ((p - buf) < size) {
-        I1 = scramble_bit(s, *p++, poly);
-        I2 = scramble_bit(s, *p++, poly);
+        I1 = scrambler_bit(&s->scrambler, *p++);
+        I2 = scrambler_bit(&s->scrambler, *p++);
         if (is_16states) {
-            Q1 = scramble_bit(s, *p++, poly);
-            Q2 = scramble_bit(s, *p++, poly);
+            Q1 = scrambler_bit(&s->scrambler, *p++);
+            Q2 = scrambler_bit(&s->scrambler, *p++);
             q = (Q2 << 1) | Q1;
         } else {
             q = 0;
@@ -1264,11 +1486,11 @@ static void V34_send_MP(V34DSPState *s, int type, int do_ack)
     put_bits(&p, 1, 0); /* start bit */
     put_bits(&p, 1, type); /* type: 1 */
     put_bits(&p, 1, 0); /* reserved */
-    put_bits(&p, 4, 12); /* call to answer max rate: 28800 */
-    put_bits(&p, 4, 12); /* answer to call max rate: 28800 */
-    put_bits(&p, 1, 0); /* no aux channel */
+    put_bits(&p, 4, s->mp_R[0] / 2400); /* call to answer max rate */
+    put_bits(&p, 4, s->mp_R[1] / 2400); /* answer to call max rate */
+    put_bits(&p, 1, s->use_aux_channel); /* aux channel */
     put_bits(&p, 2, 0); /* 0=16 state trellis */
-    put_bits(&p, 1, 0); /* non linear encoder disabled */
+    put_bits(&p, 1, s->use_non_linear); /* non linear encoder */
     put_bits(&p, 1, 0); /* constellation shaping, 0=minimum, 1=expanded */
     put_bits(&p, 1, do_ack); /* acknowledge bit */
     
@@ -1344,37 +1566,58 @@ static void V34_send_JP(V34DSPState *s)
     V34_mod_MP(s, buf, 16, 0);
 }
 
+/* silence: zero symbols, so that the symbol clock & the carrier go on */
+static void V34_send_silence(V34DSPState *s, int length)
+{
+    int i;
+
+    for(i=0;i<length;i++)
+        put_sym(s, 0, 0);
+}
+
+/* mean power of the data constellation (the power of (1,1) is 2) */
+static inline float V34_data_power(V34DSPState *s)
+{
+    return s->cfg->data_power;
+}
+
+
+/*
+ * Simplified startup (phase 2 is in v34phase2.c):
+ *
+ * phase 3: the caller sends S S' S S' PP TRN, then J until it receives
+ * the answer S, then JP and silence. The answer modem waits for the
+ * caller J and sends S S' S S' PP TRN, then J until it receives the
+ * caller phase 4 S. Each modem trains its echo canceller during its
+ * PP & TRN, while the remote modem is silent.
+ *
+ * phase 4 (full duplex): when the caller receives the answer J, it
+ * sends S S' TRN, MP until it receives the remote MP, MP' E, then
+ * data. The answer modem does the same when it receives the caller
+ * S.
+ *
+ * rate renegotiation: a modem sends S S' TRN MP... MP' E during the
+ * data mode. The remote modem detects S and does the same.
+ */
+
+/* length of the TRN sequences (in T) */
+#define TRN3_LENGTH 4096
+#define TRN4_LENGTH 512
+#define TRN_BLOCK   256 /* symbols queued at once */
 
+/* symbols sent at once in the repeated & silent states */
+#define V34_SILENCE_LENGTH 8
 
 static void V34_mod(V34DSPState *s, s16 *samples, unsigned int nb)
 {
-    int n;
+    int n, R;
 
     for(;;) {
         /* modulate the symbols in the TX queue */
-        switch(s->state) {
-        case V34_STARTUP3_WAIT_J:
-            /* silence */
-            if (nb > 0) {
-                *samples++ = 0;
-                nb--;
-            }
-            break;
-        
-#if 0
-        case V34_START:
-            /* 600 bps DPSK modulation */
-            
-
-#endif
-        default:
-            /* V34 modulation */
-            while (s->tx_buf_size >= s->tx_filter_wsize && nb > 0) {
-                n = V34_baseband_to_carrier(s, samples, nb);
-                samples += n;
-                nb -= n;
-            }
-            break;
+        while (s->tx_buf_size >= s->tx_filter_wsize && nb > 0) {
+            n = V34_baseband_to_carrier(s, samples, nb);
+            samples += n;
+            nb -= n;
         }
 
         if (nb == 0) break;
@@ -1382,13 +1625,6 @@ static void V34_mod(V34DSPState *s, s16 *samples, unsigned int nb)
         /* protocol state machine */
 
         switch(s->state) {
-#if 0
-            /* phase 2 */
-        case V34_START:
-            V34_send_info0(s, 0);
-            break;
-#endif
-
             /* phase 3 */
         case V34_STARTUP3_S1:
             V34_send_S(s);
@@ -1408,63 +1644,104 @@ static void V34_mod(V34DSPState *s, s16 *samples, unsigned int nb)
             break;
         case V34_STARTUP3_PP:
             V34_send_PP(s);
+            s->sym_count = 0;
             s->state = V34_STARTUP3_TRN;
             break;
         case V34_STARTUP3_TRN:
-            V34_send_TRN(s);
-            //            s->state = V34_STARTUP3_J;
+            V34_send_TRN(s, TRN_BLOCK);
+            s->sym_count += TRN_BLOCK;
+            if (s->sym_count >= TRN3_LENGTH) {
+                s->S_received = 0;
+                s->sym_count = 0; /* number of J sequences */
+                s->state = V34_STARTUP3_J;
+            }
             break;
         case V34_STARTUP3_J:
-            V34_send_J(s, 10); /* XXX: must wait for S on other end */
-            if (s->calling) {
-                s->state = V34_STARTUP3_JP;
+            /* until the remote S is received */
+            if (s->S_received) {
+                if (s->calling) {
+                    s->state = V34_STARTUP3_JP;
+                } else {
+                    s->state = V34_STARTUP4_S;
+                }
             } else {
-                /* the anwser modem wait for the S signal */
-                s->state = V34_STARTUP3_WAIT_J;
+                V34_send_J(s, 1);
+                s->sym_count++;
             }
             break;
         case V34_STARTUP3_JP:
             V34_send_JP(s); 
-            //s->state = V34_STARTUP4_TRN;
-            s->state = V34_STARTUP3_S1;
+            s->state = V34_STARTUP3_WAIT_J;
             break;
 
         case V34_STARTUP3_WAIT_J:
-            if (s->J_received)
-                s->state = V34_STARTUP4_S;
+            /* silence until the remote J is received */
+            if (s->J_received) {
+                if (s->calling)
+                    s->state = V34_STARTUP4_S;
+                else
+                    s->state = V34_STARTUP3_S1;
+            } else {
+                V34_send_silence(s, V34_SILENCE_LENGTH);
+            }
             break;
                 
             /* phase 4 */
         case V34_STARTUP4_S:
             V34_send_S(s);
-            s->state = V34_STARTUP4_WAIT_JP;
-            break;
-        case V34_STARTUP4_WAIT_JP:
-            if (s->JP_received)
-                s->state = V34_STARTUP4_SINV;
+            s->state = V34_STARTUP4_SINV;
             break;
         case V34_STARTUP4_SINV:
-            V34_send_S(s);
+            V34_send_Sinv(s);
+            s->sym_count = 0;
             s->state = V34_STARTUP4_TRN;
             break;
 
         case V34_STARTUP4_TRN:
-            V34_send_TRN(s);
-            s->state = V34_STARTUP4_MP;
+            V34_send_TRN(s, TRN_BLOCK);
+            s->sym_count += TRN_BLOCK;
+            if (s->sym_count >= TRN4_LENGTH)
+                s->state = V34_STARTUP4_MP;
             break;
         case V34_STARTUP4_MP:
-            V34_send_MP(s, 1, 0); /* type 1, no ack */
-            s->state = V34_STARTUP4_MPP;
+            /* until the remote MP is received */
+            if (s->MP_received) {
+                s->state = V34_STARTUP4_MPP;
+            } else {
+                V34_send_MP(s, 1, 0); /* type 1, no ack */
+                s->renegotiate = 0;
+            }
             break;
         case V34_STARTUP4_MPP:
+            /* until the remote modem acknowledges our MP */
             V34_send_MP(s, 1, 1); /* type 1, ack */
-            s->state = V34_STARTUP4_E;
+            if (s->MP_ack_received)
+                s->state = V34_STARTUP4_E;
             break;
         case V34_STARTUP4_E:
             V34_send_E(s);
+            /* the data rate is the lowest of the two MP rates */
+            R = s->mp_R[s->calling ? 0 : 1];
+            if (s->remote_R < R)
+                R = s->remote_R;
+            /* the aux channel is used if both modems request it */
+            V34_init_rate(s, R, s->use_aux_channel && s->remote_aux);
+            s->U0 = 0;
+            memset(s->x, 0, sizeof(s->x));
+            s->sync_pos = 0;
+            s->conv_reg = 0;
+            s->mapping_frame = 0;
+            /* same mean power as the training sequences */
+            s->tx_amp = CALC_AMP(V34_data_power(s));
             s->state = V34_DATA;
             break;
         case V34_DATA:
+            if (s->renegotiate) {
+                s->MP_received = 0;
+                s->MP_ack_received = 0;
+                s->state = V34_STARTUP4_S;
+                break;
+            }
             /* compute the next 8 baseband symbols */
             encode_mapping_frame(s);
             break;
@@ -1474,11 +1751,15 @@ static void V34_mod(V34DSPState *s, s16 *samples, unsigned int nb)
 
 static void V34_mod_init(V34DSPState *s, V34State *p)
 {
+    memset(s, 0, sizeof(V34DSPState));
+
     V34_init_low(s, p, 1);
-    s->state = V34_STARTUP3_S1;
-    s->JP_received = 1;
-    //    s->state = V34_DATA;
-    s->is_16states = 0; /* use 16 states */
+    /* the answer modem waits for the caller J */
+    if (s->calling)
+        s->state = V34_STARTUP3_S1;
+    else
+        s->state = V34_STARTUP3_WAIT_J;
+    s->is_16states = 0; /* use 4 states */
 }
 
 /*****************************************************/
@@ -1510,14 +1791,276 @@ static int tcm_dist(int level, int sample)
     return (e*e) >> 8;
 }
 
+/* 2D subset of the 2D level a = 4 * x + y (x, y = 0..3). The levels a
+   and a ^ 10 are in the same subset. */
+#define SUBSET_2D(a) (((a) & 4) | ((((a) >> 2) ^ (a)) & 2) | ((a) & 1))
+
+/* Each 4D subset of trellis_trans_x[] is the union of n/4 products of
+   two 2D subsets. trellis_pairs[] gives these products and
+   trellis_index[] the index in trellis_trans_x[] of the 4D level
+   (a, b). Indexed by nbbt - 2. */
+static u8 trellis_pairs[3][32][8][2];
+static u8 trellis_index[3][256];
+
+/* for each state of the 16, 32 and 64 state trellis, its 1 << nbbt
+   predecessors (in increasing order) and the 4D subset of each
+   transition. Indexed by nbbt - 2. */
+static u8 trellis_prev_state[3][TRELLIS_MAX_STATES][16];
+static u8 trellis_prev_subset[3][TRELLIS_MAX_STATES][16];
+
+static void trellis_init(void)
+{
+    int t, i, j, k, idx, n, a, b, nb_pairs, nb_states, nb_trans, state, ns;
+    int count[TRELLIS_MAX_STATES];
+    u8 *p;
+
+    for(t=0;t<3;t++) {
+        switch(t) {
+        case 0:
+            p = &trellis_trans_4[0][0];
+            break;
+        case 1:
+            p = &trellis_trans_8[0][0];
+            break;
+        default:
+            p = &trellis_trans_16[0][0];
+            break;
+        }
+        n = 128 >> (t + 2);
+        for(i=0;i<(256 / n);i++) {
+            nb_pairs = 0;
+            for(idx=i*n;idx<(i+1)*n;idx++) {
+                a = p[idx * 4] * 4 + p[idx * 4 + 1];
+                b = p[idx * 4 + 2] * 4 + p[idx * 4 + 3];
+                trellis_index[t][a * 16 + b] = idx;
+                for(k=0;k<nb_pairs;k++) {
+                    if (trellis_pairs[t][i][k][0] == SUBSET_2D(a) &&
+                        trellis_pairs[t][i][k][1] == SUBSET_2D(b))
+                        break;
+                }
+                if (k == nb_pairs) {
+                    assert(nb_pairs < n / 4);
+                    trellis_pairs[t][i][k][0] = SUBSET_2D(a);
+                    trellis_pairs[t][i][k][1] = SUBSET_2D(b);
+                    nb_pairs++;
+                }
+            }
+            assert(nb_pairs == n / 4);
+        }
+
+        /* predecessors */
+        nb_states = 16 << t;
+        nb_trans = 1 << (t + 2);
+        memset(count, 0, sizeof(count));
+        for(state=0;state<nb_states;state++) {
+            for(j=0;j<nb_trans;j++) {
+                ns = trellis_next_state(nb_states, state, j);
+                k = count[ns]++;
+                assert(k < nb_trans);
+                trellis_prev_state[t][ns][k] = state;
+                trellis_prev_subset[t][ns][k] = j + ((state & 1) << (t + 2));
+            }
+        }
+    }
+}
+
+/* compute the error of the nearest point of each of the 2 *
+   (1 << nbbt) 4D subsets, and its index in trellis_trans_x[]. As
+   tcm_dist() <= 1024, the error and the 2D/4D level are packed in one
+   integer so that the first level is selected on equal errors, as in
+   the brute force search. */
+static void trellis_metrics(int nbbt, s16 yy[2][2], 
+                            int *error_table, int *decision_table)
+{
+    int d[4][4], m[2][8];
+    int i, k, h, a, e, emin, nb_trans, nb_pairs;
+    u8 (*pairs)[2];
+
+    /* nearest point of each 1D coset */
+    for(k=0;k<4;k++) {
+        for(i=0;i<4;i++)
+            d[k][i] = tcm_dist(i, yy[k >> 1][k & 1]);
+    }
+
+    /* nearest point of each 2D subset: (error << 4) | level */
+    for(h=0;h<2;h++) {
+        for(i=0;i<8;i++)
+            m[h][i] = 0x7fffffff;
+        for(a=0;a<16;a++) {
+            e = ((d[2 * h][a >> 2] + d[2 * h + 1][a & 3]) << 4) | a;
+            i = SUBSET_2D(a);
+            if (e < m[h][i])
+                m[h][i] = e;
+        }
+    }
+
+    /* 4D subsets: (error << 8) | (16 * a + b) */
+    nb_trans = 1 << nbbt;
+    nb_pairs = 32 >> nbbt;
+    for(i=0;i<(nb_trans*2);i++) {
+        pairs = trellis_pairs[nbbt - 2][i];
+        emin = 0x7fffffff;
+        for(k=0;k<nb_pairs;k++) {
+            e = (((m[0][pairs[k][0]] >> 4) + (m[1][pairs[k][1]] >> 4)) << 8) |
+                ((m[0][pairs[k][0]] & 15) << 4) | (m[1][pairs[k][1]] & 15);
+            if (e < emin)
+                emin = e;
+        }
+        error_table[i] = emin >> 8;
+        decision_table[i] = trellis_index[nbbt - 2][emin & 0xff];
+    }
+}
+
+/* reference brute force version of trellis_metrics() */
+static void trellis_metrics_ref(int nbbt, s16 yy[2][2], 
+                                int *error_table, int *decision_table)
+{
+    int i, j, n, e, emin, jmin;
+    u8 *p;
+
+    switch(nbbt) {
+    case 2:
+        p = &trellis_trans_4[0][0];
+        break;
+    case 3:
+        p = &trellis_trans_8[0][0];
+        break;
+    default:
+        p = &trellis_trans_16[0][0];
+        break;
+    }
+    n = 128 >> nbbt;
+    jmin = 0; /* no warning */
+    for(i=0;i<(2 << nbbt);i++) {
+        emin = 0x7fffffff;
+        for(j=0;j<n;j++) {
+            e = tcm_dist(p[0], yy[0][0]) + 
+                tcm_dist(p[1], yy[0][1]) +
+                tcm_dist(p[2], yy[1][0]) +
+                tcm_dist(p[3], yy[1][1]);
+            if (e < emin) {
+                emin = e;
+                jmin = j;
+            }
+            p+=4;
+        }
+        error_table[i] = emin;
+        decision_table[i] = i * n + jmin;
+    }
+}
+
 /* Viterbi decoder for the V34 trellis coded modulation */
 
+/* return the decoded 4D symbol for the decision 'd' of the received
+   symbol 'y' and its mean square error (normalized to 2^7). '*rot' is
+   the rotation of the second 2D symbol after the decision (see
+   rotate_clockwise()). */
+static int trellis_output(s16 yout[2][2], int d, int u0, s16 *y, 
+                          u8 *p, u8 *rot)
+{
+    int x, yy, mse;
+    u8 *q;
+
+    q = p + d * 4;
+    yout[0][0] = tcm_decision(q[0], y[0]);
+    yout[0][1] = tcm_decision(q[1], y[1]);
+    yout[1][0] = tcm_decision(q[2], y[2]);
+    yout[1][1] = tcm_decision(q[3], y[3]);
+    /* error of the decision (before the rotation) */
+    mse = (dsp_sqr(yout[0][0] - y[0]) + 
+           dsp_sqr(yout[0][1] - y[1]) + 
+           dsp_sqr(yout[1][0] - y[2]) + 
+           dsp_sqr(yout[1][1] - y[3])) >> 7;
+    /* undo the rotation */    
+    if (d >> 7) {
+        x = yout[1][1];
+        yy = - yout[1][0];
+        yout[1][0] = x;
+        yout[1][1] = yy;
+    }
+    /* rotate only if u0 is set */
+    if (u0 ^ (d >> 7)) {
+        x = - yout[1][1];
+        yy = yout[1][0];
+        yout[1][0] = x;
+        yout[1][1] = yy;
+    }
+    *rot = ((u0 ^ (d >> 7)) - (d >> 7)) & 3;
+    return mse;
+}
+
+/* add compare select for the 4D symbol at s->trellis_ptr. 'nb_states'
+   and 'nbbt' are constants so that the loops are specialized for each
+   trellis. The metrics are renormalized so that the best path has a
+   zero metric: they are bounded by a few 4D symbol errors. */
+static inline void trellis_acs(V34DSPState *s, int *error_table, 
+                               int *decision_table, int nb_states, int nbbt)
+{
+    int ns, k, e, emin, min, *err, *err1;
+    u8 *ps, *pt, *dec, *path;
+
+    err = s->state_error[s->trellis_cur];
+    err1 = s->state_error[s->trellis_cur ^ 1];
+    dec = s->state_decision[s->trellis_ptr];
+    path = s->state_path[s->trellis_ptr];
+    min = 0x7fffffff;
+    for(ns=0;ns<nb_states;ns++) {
+        ps = trellis_prev_state[nbbt - 2][ns];
+        pt = trellis_prev_subset[nbbt - 2][ns];
+        /* (metric << 4) | predecessor: the first predecessor is
+           selected on equal metrics */
+        emin = 0x7fffffff;
+        for(k=0;k<(1 << nbbt);k++) {
+            e = ((err[ps[k]] + error_table[pt[k]]) << 4) | k;
+            if (e < emin)
+                emin = e;
+        }
+        k = emin & 15;
+        emin >>= 4;
+        err1[ns] = emin;
+        dec[ns] = decision_table[pt[k]];
+        path[ns] = ps[k];
+        if (emin < min)
+            min = emin;
+    }
+    for(ns=0;ns<nb_states;ns++)
+        err1[ns] -= min;
+    s->trellis_cur ^= 1;
+}
+
+/* follow the best path back from the last 4D symbol and decode the
+   TRELLIS_BLOCK symbols which are TRELLIS_LENGTH symbols older */
+static void trellis_traceback(V34DSPState *s, u8 *p)
+{
+    int i, k, state, *err;
+
+    /* best state */
+    err = s->state_error[s->trellis_cur];
+    state = dsp_argmin(err, s->conv_nb_states);
+
+    k = s->trellis_ptr;
+    for(i=0;i<TRELLIS_LENGTH;i++) {
+        state = s->state_path[k][state];
+        if (--k < 0) k = TRELLIS_HIST-1;
+    }
+    for(i=TRELLIS_BLOCK-1;i>=0;i--) {
+        s->trellis_out_mse[i] = 
+            trellis_output(s->trellis_out[i], s->state_decision[k][state], 
+                           s->u0_memory[k], s->state_memory[k], p,
+                           &s->trellis_out_rot[i]);
+        state = s->state_path[k][state];
+        if (--k < 0) k = TRELLIS_HIST-1;
+    }
+}
+
+/* decode the 4D symbol 'yy'. The decoded symbol 'yout' is delayed by
+   TRELLIS_DELAY symbols. */
 static void trellis_decoder(V34DSPState *s, s16 yout[2][2], s16 yy[2][2], 
-                             int *mse)
+                             int *mse, int *rot)
 {
-    int i, j, k, n, nbbt, nb_trans, state, next_state, error, trellis_ptr;
-    int error_table[32],decision_table[32],emin,jmin,u0,x,y;
-    u8 *p,*q;
+    int i, nbbt, nb_trans, emin, jmin, trellis_ptr;
+    int error_table[32], decision_table[32];
+    u8 *p;
 
     trellis_ptr = s->trellis_ptr;
 
@@ -1538,79 +2081,13 @@ static void trellis_decoder(V34DSPState *s, s16 yout[2][2], s16 yy[2][2],
     }
     nb_trans = 1 << nbbt;
 
-    /* write a previous decoded symbol : extract a decoded bit from
-       the beginning of a path */
-
-    k = trellis_ptr;
-    k--;
-    if (k < 0) k = TRELLIS_LENGTH-1;
-    j = 0; /* arbitrary path selected : all the paths converge to same
-              decoded bits*/
-    for(i=0;i<(TRELLIS_LENGTH-1);i++) {
-        j = s->state_path[j][k];
-        k--;
-        if (k < 0) k = TRELLIS_LENGTH-1;
-    }
-    u0 = s->u0_memory[trellis_ptr];
-    q = p + (s->state_decision[j][k] * 4);
-#if 1
-    yout[0][0] = tcm_decision(q[0], s->state_memory[trellis_ptr][0]);
-    yout[0][1] = tcm_decision(q[1], s->state_memory[trellis_ptr][1]);
-    yout[1][0] = tcm_decision(q[2], s->state_memory[trellis_ptr][2]);
-    yout[1][1] = tcm_decision(q[3], s->state_memory[trellis_ptr][3]);
-    /* undo the rotation */    
-    if ((s->state_decision[j][k] >> 7)) {
-        x = yout[1][1];
-        y = - yout[1][0];
-        yout[1][0] = x;
-        yout[1][1] = y;
-    }
-    /* rotate only if u0 is set */
-    if (u0 ^ (s->state_decision[j][k] >> 7)) {
-        x = - yout[1][1];
-        y = yout[1][0];
-        yout[1][0] = x;
-        yout[1][1] = y;
-    }
-#else
-    /* no trellis */
-    yout[0][0] = s->state_memory[trellis_ptr][0];
-    yout[0][1] = s->state_memory[trellis_ptr][1];
-    yout[1][0] = s->state_memory[trellis_ptr][2];
-    yout[1][1] = s->state_memory[trellis_ptr][3];
-#endif
-    /* compute the mean square error (normalized to 2^7) */
-    *mse = (dsp_sqr(yout[0][0] - s->state_memory[trellis_ptr][0]) + 
-        dsp_sqr(yout[0][1] - s->state_memory[trellis_ptr][1]) + 
-        dsp_sqr(yout[1][0] - s->state_memory[trellis_ptr][2]) + 
-        dsp_sqr(yout[1][1] - s->state_memory[trellis_ptr][3])) >> 7;
-
     s->state_memory[trellis_ptr][0] = yy[0][0];
     s->state_memory[trellis_ptr][1] = yy[0][1];
     s->state_memory[trellis_ptr][2] = yy[1][0];
     s->state_memory[trellis_ptr][3] = yy[1][1];
 
     /* compute the error table */
-    /* XXX: may be optimized by using the algebraic properties of the mapping */    
-    n = 128 >> nbbt;
-    jmin = 0; /* no warning */
-    for(i=0;i<(nb_trans*2);i++) {
-        emin = 0x7fffffff;
-        for(j=0;j<n;j++) {
-            int e;
-            e = tcm_dist(p[0], yy[0][0]) + 
-                tcm_dist(p[1], yy[0][1]) +
-                tcm_dist(p[2], yy[1][0]) +
-                tcm_dist(p[3], yy[1][1]);
-            if (e < emin) {
-                emin = e;
-                jmin = j;
-            }
-            p+=4;
-        }
-        error_table[i] = emin;
-        decision_table[i] = i * n + jmin;
-    }
+    trellis_metrics(nbbt, yy, error_table, decision_table);
 
     /* we compute the bit u0 (needed for synchronization & c0 estimation) */
     jmin = 0;
@@ -1623,85 +2100,149 @@ static void trellis_decoder(V34DSPState *s, s16 yout[2][2], s16 yy[2][2],
     }
     s->u0_memory[trellis_ptr] = (jmin >= nb_trans);
 
-    /* init the error table to +infinity */
-    for(state=0;state<s->conv_nb_states;state++) {
-        s->state_error1[state] = 0x7fffffff;
+    /* the synchronization bit of the previous 4D symbol inverted U0,
+       so the subsets following each state are exchanged */
+    if (s->rx_v0) {
+        for(i=0;i<nb_trans;i++) {
+            emin = error_table[i];
+            error_table[i] = error_table[i + nb_trans];
+            error_table[i + nb_trans] = emin;
+            jmin = decision_table[i];
+            decision_table[i] = decision_table[i + nb_trans];
+            decision_table[i + nb_trans] = jmin;
+        }
     }
 
-    for(state=0;state<s->conv_nb_states;state++) {
-        /* select the value of y0 depending on the current state */
-        /* for each state, we update the next state entry by selecting
-           the shortest path */
-        /* XXX: should handle error overflow */
-        if (state & 1)
-            n = nb_trans;
-        else 
-            n = 0;
-        for(j=0;j<nb_trans;j++) {
-            next_state = trellis_next_state(s->conv_nb_states, state, j);
-            error = s->state_error[state] + error_table[j + n];
-            if (error < s->state_error1[next_state]) {
-                s->state_error1[next_state] = error;
-                s->state_decision[next_state][trellis_ptr] = decision_table[j + n];
-                s->state_path[next_state][trellis_ptr] = state;
-            }
-        }
+    switch(nbbt) {
+    case 2:
+        trellis_acs(s, error_table, decision_table, 16, 2);
+        break;
+    case 3:
+        trellis_acs(s, error_table, decision_table, 32, 3);
+        break;
+    default:
+        trellis_acs(s, error_table, decision_table, 64, 4);
+        break;
     }
 
-    /* XXX: this copy is not needed. Permute the two tables */
-    memcpy(s->state_error, s->state_error1, sizeof(s->state_error));
+    if (++s->trellis_count == TRELLIS_BLOCK) {
+        s->trellis_count = 0;
+        trellis_traceback(s, p);
+    }
+    memcpy(yout, s->trellis_out[s->trellis_count], 4 * sizeof(s16));
+    *mse = s->trellis_out_mse[s->trellis_count];
+    *rot = s->trellis_out_rot[s->trellis_count];
 
-    trellis_ptr = (trellis_ptr + 1) % TRELLIS_LENGTH;
+    if (++trellis_ptr == TRELLIS_HIST)
+        trellis_ptr = 0;
     s->trellis_ptr = trellis_ptr;
 }
 
-static void put_bit(V34DSPState *s, int b)
+/* descramble the 'n' data bits at position 'pos' of the frame and
+   write them */
+static void put_data_bits(V34DSPState *s, const u64 *f, int pos, int n)
 {
-    int poly;
-
-    if (!s->calling)
-        poly = V34_GPC;
-    else
-        poly = V34_GPA;
-    b = unscramble_bit(s, b, poly);
-    //    printf("recv: %d\n", b);
-    s->put_bit(s->opaque, b);
+    int j, k;
+    u32 w;
+
+    while (n > 0) {
+        k = n;
+        if (k > V34_BITS_BLOCK)
+            k = V34_BITS_BLOCK;
+        w = dsp_bit_reverse32(frame_get(f, pos, k)) >> (32 - k);
+        w = descrambler_bits(&s->scrambler, w, k);
+        if (s->put_bits) {
+            s->put_bits(s->opaque, w, k);
+        } else {
+            for(j=k-1;j>=0;j--)
+                s->put_bit(s->opaque, (w >> j) & 1);
+        }
+        pos += k;
+        n -= k;
+    }
 }
 
-/* auxilary channel bit */
+/* auxiliary channel bit */
 static void aux_put_bit(V34DSPState *s, int b)
 {
-    /* not used now */
+    if (s->put_aux_bit)
+        s->put_aux_bit(s->opaque, b);
 }
 
-static void decode_mapping_frame(V34DSPState *s, s16 rx_mapping_frame[8][2])
+/* inverse of parse_mapping_frame() */
+static void build_mapping_frame(V34DSPState *s, u64 *f, int mp_size,
+                                int m[4][2], u8 I[3][4], int Q[4][2])
 {
-  int m[4][2], r0; /* rings */
-  u8 I[3][4];
-  int Q[4][2], Z[2];
-  u8 *ptr;
-  int t,i,j,x,y,n,mp_size,xout_ptr;
-  u8 data[MAX_MAPPING_FRAME_SIZE];
-
-  xout_ptr = 0;
-  for(j=0;j<4;j++) {
-    /* for each 4D symbol */
-
-    for(i=0;i<2;i++) {
-      x = rx_mapping_frame[xout_ptr][0];
-      y = rx_mapping_frame[xout_ptr][1];
-      xout_ptr++;
+  int j, n, pos, t, qsize;
 
-      /* decision */
-      x = (x >> 8) * 2 + 1;
-      x = clamp(x, C_RADIUS);
-      y = (y >> 8) * 2 + 1;
-      y = clamp(y, C_RADIUS);
-      
-      t = s->constellation_to_code[(x+C_RADIUS) >> 1][(y+C_RADIUS) >> 1];
+  f[0] = 0;
+  f[1] = 0;
+  if (s->b <= 12) {
+    t = 0;
+    for(j=0;j<4;j++)
+      t |= (I[0][j] << j) | (I[1][j] << (j + 4)) | (I[2][j] << (j + 8));
+    f[0] = t & ((1 << s->b) - 1);
+  } else {
+    n = s->K;
+    if (mp_size < s->b) n--;
+    frame_put(f, 0, n, rings_to_index(s, m));
+    
+    pos = n;
+    qsize = 3 + 2 * s->q;
+    for(j=0;j<4;j++) {
+      t = I[0][j] | (I[1][j] << 1) | (I[2][j] << 2) | 
+        (Q[j][0] << 3) | (Q[j][1] << (3 + s->q));
+      frame_put(f, pos, qsize, t);
+      pos += qsize;
+    }
+  }
+}
+
+/* write a received mapping frame of 'mp_size' bits. If 'aux' is
+   true, its first bit is an auxiliary channel bit */
+static void put_mapping_frame(V34DSPState *s, const u64 *f, int mp_size,
+                              int aux)
+{
+  if (aux) {
+      aux_put_bit(s, f[0] & 1);
+      put_data_bits(s, f, 1, mp_size - 1);
+  } else {
+      put_data_bits(s, f, 0, mp_size);
+  }
+}
+
+/* slice the received point (x, y) (the lattice points are at (2k+1) *
+   128) to the nearest point of the constellation and return its code
+   (see build_decision_table()) */
+static inline int v34_slice(V34DSPState *s, int x, int y)
+{
+  x = clamp((x >> 8) * 2 + 1, C_RADIUS);
+  y = clamp((y >> 8) * 2 + 1, C_RADIUS);
+  return s->constellation_to_code[(x + C_RADIUS) >> 1][(y + C_RADIUS) >> 1];
+}
+
+static void decode_mapping_frame(V34DSPState *s, s16 rx_mapping_frame[8][2])
+{
+  int m[4][2]; /* rings */
+  u8 I[3][4];
+  int Q[4][2], Z[2];
+  int t,i,j,x,y,mp_size,aux,xout_ptr;
+  u64 f[MAPPING_FRAME_WORDS];
+
+  xout_ptr = 0;
+  for(j=0;j<4;j++) {
+    /* for each 4D symbol */
+
+    for(i=0;i<2;i++) {
+      x = rx_mapping_frame[xout_ptr][0];
+      y = rx_mapping_frame[xout_ptr][1];
+      xout_ptr++;
+
+      /* decision */
+      t = v34_slice(s, x, y);
       /* mapping to the symbol */
       Z[i] = t >> 14;
-      t = t & 0xff;
+      t = t & 0x3fff;
 
       Q[j][i] = t & ((1 << s->q)-1);
       m[j][i] = t >> s->q;
@@ -1716,75 +2257,102 @@ static void decode_mapping_frame(V34DSPState *s, s16 rx_mapping_frame[8][2])
     I[0][j] = t >> 1;
   }
 
-  /* compute mapping frame size */
-  s->rcnt += s->r;
-  if (s->rcnt < s->P) {
-      mp_size = s->b - 1;
-  } else {
-      s->rcnt -= s->P;
-      mp_size = s->b;
-  }
+  /* mapping frame size & aux bit from the data frame schedule */
+  mp_size = s->cfg->mp_size[s->mapping_frame];
+  aux = (s->cfg->aux_frames >> s->mapping_frame) & 1;
     
   /* now everything is "decoded", we can write the data */
-  ptr = data;
-  if (s->b <= 12) {
-    for(i=0;i<s->b;i++) *ptr++ = ((u8 *)I)[i];
-  } else {
-    r0 = rings_to_index(s, m);
+  build_mapping_frame(s, f, mp_size, m, I, Q);
+  if (s->put_frame)
+      s->put_frame(s->frame_opaque, f, mp_size, aux);
+  else
+      put_mapping_frame(s, f, mp_size, aux);
 
-    n = s->K;
-    if (mp_size < s->b) n--;
-    for(i=0;i<n;i++) *ptr++ = (r0 >> i) & 1;
-    
-    for(j=0;j<4;j++) {
-      ptr[0] = I[0][j];
-      ptr[1] = I[1][j];
-      ptr[2] = I[2][j];
-      ptr += 3;
-  
-      t=Q[j][0];
-      for(i=0;i<s->q;i++) *ptr++ = (t >> i) & 1;
+  /* new data frame */
+  if (++s->mapping_frame == s->P)
+      s->mapping_frame = 0;
+}
 
-      t=Q[j][1];
-      for(i=0;i<s->q;i++) *ptr++ = (t >> i) & 1;
+/* ( 9.6.2) received x(n) -> y(n) = x(n) + p(n). The noisy x(n) are
+   used because the decisions are only known after the Viterbi
+   decoder. */
+static void precoder_filter(V34DSPState *s, int *si, int *sq)
+{
+    int k, x, y;
+
+    x = 0;
+    y = 0;
+    for(k=0;k<3;k++) {
+        x += s->x_hat[k][0] * s->h[k][0] - s->x_hat[k][1] * s->h[k][1];
+        y += s->x_hat[k][1] * s->h[k][0] + s->x_hat[k][0] * s->h[k][1];
     }
-  }
+    for(k=2;k>=1;k--) {
+        s->x_hat[k][0] = s->x_hat[k-1][0];
+        s->x_hat[k][1] = s->x_hat[k-1][1];
+    }
+    s->x_hat[0][0] = clamp(*si, 32767);
+    s->x_hat[0][1] = clamp(*sq, 32767);
+    *si += shr_round0(x, 14);
+    *sq += shr_round0(y, 14);
+}
 
-  /* send an auxilary channel bit if needed */
-  s->acnt += s->W;
-  if (s->acnt < s->P) {
-      put_bit(s, data[0]);
-  } else {
-      s->acnt -= s->P;
-      aux_put_bit(s, data[0]); 
-  }
+/* ( 9.6.2) u(n) = y(n) - c(n) for the decoded 4D symbol 'y': p(n) is
+   computed exactly as in the transmitter from the decided y(n). The
+   rotation 'rot' of the second 2D symbol is undone: it is not needed
+   to decode the mapping frame (U0 is ignored). */
+static void precoder_remove(V34DSPState *s, s16 y[2][2], int rot)
+{
+    int i, k, x, yy, p_re, p_im, c_re, c_im, w;
 
-  /* send all the decoded bits */
-  for(i=1;i<mp_size;i++) put_bit(s, data[i]); 
-  //  print_bit_vector("recv", data, mp_size);
+    if (s->b < 56) 
+        w = 1;
+    else 
+        w = 2;
 
-  if (++s->mapping_frame >= s->P) {
-      /* new data frame */
-      s->mapping_frame = 0;
-      s->rcnt = 0;
-      s->acnt = 0;
-  }
+    x = y[1][0];
+    yy = y[1][1];
+    rotate_clockwise(y[1][0], y[1][1], x, yy, (-rot) & 3);
+
+    for(i=0;i<2;i++) {
+        x = 0;
+        yy = 0;
+        for(k=0;k<3;k++) {
+            x += s->x[k][0] * s->h[k][0] - s->x[k][1] * s->h[k][1];
+            yy += s->x[k][1] * s->h[k][0] + s->x[k][0] * s->h[k][1];
+        }
+        p_re = shr_round0(x, 14);
+        p_im = shr_round0(yy, 14);
+        c_re = shr_round0(p_re, 7 + w) << w;
+        c_im = shr_round0(p_im, 7 + w) << w;
+        for(k=2;k>=1;k--) {
+            s->x[k][0] = s->x[k-1][0];
+            s->x[k][1] = s->x[k-1][1];
+        }
+        s->x[0][0] = y[i][0] - p_re;
+        s->x[0][1] = y[i][1] - p_im;
+
+        y[i][0] -= c_re << 7;
+        y[i][1] -= c_im << 7;
+    }
 }
 
 static void baseband_decode(V34DSPState *s, int si, int sq)
 {
     s16 y[2][2];
-    static int delay = 0;
-    int mse,v0;
+    int mse,rot;
 
     lm_dump_qam(si / (10.0 * 128.0), sq / (10.0 * 128.0));
 
-    s->yy[s->phase_4d][0] = si;
-    s->yy[s->phase_4d][1] = sq;
+    s->yy[s->phase_4d][0] = clamp(si, 32767);
+    s->yy[s->phase_4d][1] = clamp(sq, 32767);
     
     if (++s->phase_4d == 2) {
-
-        trellis_decoder(s, y, s->yy , &mse);
+        trellis_decoder(s, y, s->yy , &mse, &rot);
+        /* the first outputs are not symbols of the data mode */
+        if (s->dec_delay == 0)
+            precoder_remove(s, y, rot);
+        if (++s->rate_mse_cnt > 0)
+            s->rate_mse += mse;
         s->phase_mse += mse;
         s->phase_mse_cnt++;
         if (s->phase_mse_cnt >= 8) {
@@ -1793,24 +2361,13 @@ static void baseband_decode(V34DSPState *s, int si, int sq)
         }
 
         /* synchronization bit */
-        if (s->sync_count == 0) {
-            v0 = (SYNC_PATTERN >> (15 - s->half_data_frame_count)) & 1;
-        } else {
-            v0 = 0;
-        }
-
-        /* synchronization bit */
-        if (++s->sync_count == 2*s->P) {
-            s->sync_count = 0;
-            if (++s->half_data_frame_count == 2*s->J) {
-                s->half_data_frame_count = 0;
-            }
-        }
+        s->rx_v0 = sync_bit(s);
 
         memcpy(&s->rx_mapping_frame[s->rx_mapping_frame_count][0], 
                &y[0][0], 4 * sizeof(s16));
-        delay++;
-        if (delay > TRELLIS_LENGTH) {
+        if (s->dec_delay > 0) {
+            s->dec_delay--;
+        } else {
 
             s->rx_mapping_frame_count += 2;
             if (s->rx_mapping_frame_count == 8) {
@@ -1850,48 +2407,27 @@ static void agc_estimate(V34DSPState *s, int sample)
     lm_dump_agc(sqrt(power));
 }
 
-#if 0
-static void test_nyq(float *a_ptr, float *b_ptr, float f, float val)
-{
-    float a,b,c,d;
-
-    a = *a_ptr;
-    b = *b_ptr;
-    c = 0.99 * cos(f);
-    d = 0.99 * sin(f);
-    
-    *a_ptr = a * c - b * d + val;
-    *b_ptr = a * d + b * c;
-}
-
-static float al, bl, ah, bh;
-static float f_low, f_high;
-static float low_mem[2], low_coef[2];
-#endif
-
-#define SYNC_THR 32
+/* symbol timing recovery (band edge method): the components of the
+   received signal at carrier -/+ symbol_rate/2 are extracted with two
+   resonators. Their cross correlation, computed once per symbol, is
+   proportional to the sine of the timing error. A PI loop filter
+   moves the phase of the polyphase receive filter: the proportional
+   term corrects the phase error and the integral term follows the
+   frequency offset between the remote and local clocks. */
+
+#define SYNC_ERR_BITS   19 /* scale of the normalized timing error */
+#define SYNC_GAIN_BITS  22 /* the corrections are e * k * baud_denom >> SYNC_GAIN_BITS */
+#define SYNC_FREQ_BITS  12 /* fractional bits of sync_freq */
+#define SYNC_KP_ACQUIRE 32 /* proportional gain during the first S signal */
+#define SYNC_KP_REFINE  8  /* proportional gain during the second S signal */
+#define SYNC_KP_TRACK   2  /* proportional gain after the S signals */
+#define SYNC_KI         1  /* integral gain (TRN & data mode only) */
+#define SYNC_ERR_MAX    (1 << 15) /* limit of the normalized error */
 
-/* Fast symbol timing recovery */
 static void v34_symbol_sync(V34DSPState *s, int spl)
 {
-    int a, b, c, v;
-#if 0
-    int tmp0, tmp1;
-    static s16 dc_filter[2];
-    static s16 ac_filter[3];
-#endif
-
-#if 0
-    {
-        static int k = 0;
-        float v;
+    int a, b, c, v, e, p, kp, ki;
 
-        f_low = 2 * M_PI * (s->carrier_freq - s->symbol_rate / 2.0) / (3.0 * s->symbol_rate);
-        f_high = 2 * M_PI * (s->carrier_freq + s->symbol_rate / 2.0) / (3.0 * s->symbol_rate);
-        test_nyq(&al, &bl, f_low, spl);
-        test_nyq(&ah, &bh, f_high, spl);
-    }
-#endif
     /* sync_low_mem has an amplitude of about spl / ( 1 - a), so we
        store it with a scaling of 2^6 to reduce its amplitude */
 
@@ -1905,109 +2441,169 @@ static void v34_symbol_sync(V34DSPState *s, int spl)
     s->sync_high_mem[1] = s->sync_high_mem[0];
     s->sync_high_mem[0] = v;
 
-    if (s->baud3_phase == 0) {
-        /* high & low nyquist filters for symbol timing recovery */
-        
-        /* XXX: the shift should adapt to the power */
-        a = (s->sync_low_mem[1] * s->sync_high_mem[1]) >> 14;
-        b = (s->sync_high_mem[1] * s->sync_low_mem[0]) >> 14;
-        c = (s->sync_low_mem[1] * s->sync_high_mem[0]) >> 14;
-        
-        v = (a * s->sync_A + b * s->sync_B + c * s->sync_C) >> 14;
-        printf("v=%d\n", v);
-        s->baud_phase -= v << 3;
-
-#if 0
-        /* DC filter h(z) = z - z^-2 */
-        tmp0 = v - dc_filter[1];
-        dc_filter[1] = dc_filter[0];
-        dc_filter[0] = v;
-
-        /* AC filter h(z) = z + z^-3 */
-        tmp1 = tmp0 + ac_filter[2];
-        ac_filter[2] = ac_filter[1];
-        ac_filter[1] = ac_filter[0];
-        ac_filter[0] = tmp0;
-
-        if (tmp1 < -SYNC_THR)
-            tmp1 = -SYNC_THR;
-        else if (tmp1 > SYNC_THR) 
-            tmp1 = SYNC_THR;
-        else
-            tmp1 =0;
-#endif
-#if 1
-        //        lm_dump_sample(CHANNEL_SAMPLE, v);
-
-        //        printf("corr=%0.0f\n", 
-        //               corr * 32.0 / 100.0);
-#else
-        printf("al=%0.1f ah=%0.1f al1=%0.1f ah1=%0.1f\n",
-               ah / 100.0, bh / 100.0, 
-               (s->sync_high_mem[0] - s->sync_high_mem[1] * 0.99 * cos(f_high)) * 32.0 / 100.0,
-               (s->sync_high_mem[1] * 0.99 * sin(f_high)) * 32.0 / 100.0);
-#endif        
+    if (s->baud3_phase != 0)
+        return;
+
+    /* timing error detector */
+    a = (s->sync_low_mem[1] * s->sync_high_mem[1]) >> 14;
+    b = (s->sync_high_mem[1] * s->sync_low_mem[0]) >> 14;
+    c = (s->sync_low_mem[1] * s->sync_high_mem[0]) >> 14;
+    v = (a * s->sync_A + b * s->sync_B + c * s->sync_C) >> 14;
+
+    /* normalize it with the band edge power so that the loop gain
+       does not depend on the signal level and the line */
+    p = ((s->sync_low_mem[0] * s->sync_low_mem[0]) >> 10) + 
+        ((s->sync_low_mem[1] * s->sync_low_mem[1]) >> 10) + 
+        ((s->sync_high_mem[0] * s->sync_high_mem[0]) >> 10) + 
+        ((s->sync_high_mem[1] * s->sync_high_mem[1]) >> 10);
+    e = ((s64)v << SYNC_ERR_BITS) / (p + 1);
+    /* with random data, the band edge power of a symbol is sometimes
+       near zero: the error would move the clock by a large part of
+       the symbol and the equalizer would lose it */
+    if (e > SYNC_ERR_MAX)
+        e = SYNC_ERR_MAX;
+    else if (e < -SYNC_ERR_MAX)
+        e = -SYNC_ERR_MAX;
+
+    /* PI loop filter. The gains are relative to the symbol period
+       (3 * baud_denom) so that they do not depend on the symbol
+       rate. A positive error means that we sample too late. The
+       detector has a small bias which depends on the received signal
+       (S, PP), so the clock frequency offset is only integrated
+       during the scrambled signals (TRN and data mode). Starting
+       during TRN avoids the errors at the start of the data mode
+       with a large offset. */
+    ki = 0;
+    if (s->state < V34_STARTUP3_S2) {
+        kp = SYNC_KP_ACQUIRE;
+    } else if (s->state < V34_STARTUP3_PP) {
+        kp = SYNC_KP_REFINE;
+    } else {
+        kp = SYNC_KP_TRACK;
+        if (s->state == V34_DATA || s->state == V34_STARTUP3_TRN ||
+            s->state == V34_STARTUP4_TRN)
+            ki = SYNC_KI;
     }
+    s->sync_freq += ((s64)e * ki * s->baud_denom) >> SYNC_GAIN_BITS;
+    s->baud_phase -= (((s64)e * kp * s->baud_denom) >> SYNC_GAIN_BITS) + 
+        (s->sync_freq >> SYNC_FREQ_BITS);
 }
 
+/* step of the sign-error LMS: an error of 1/8 of the distance between
+   two constellation points */
+#define EQ_SIGN_STEP 32
 
-/* equalize & adapt the equalizer */
-static int v34_equalize(V34DSPState *s, 
-                        int *ri_ptr, int *rq_ptr, int spl)
-{
-    int p,q,i;
-    int ri, rq, fi, fq, q_ri, q_rq, ei, eq, ei1, eq1, si, sq;
-    int cosw, sinw, dphi, norm;
-
-    /* add the sample in the equalizer ring buffer */
-    p = s->eq_buf_ptr;
-
-    s->eq_buf[p] = spl;
-
-    if (++p == EQ_SIZE)
-        p = 0;
-    s->eq_buf_ptr = p;
+/* signal detection on the power of the equalized symbols (the power
+   of the 4 point sequences is 2 * 128 * 128) */
+#define RX_POW_SHIFT 4
+#define RX_POW_ON    (128 * 128 / 2)
+#define RX_POW_OFF   (128 * 128 / 8)
 
-    if (s->baud3_phase != 0)
-        return 0;
+/* set the filtering coefficients from the 16.16 ones */
+static void eq_load_coefs(V34DSPState *s)
+{
+    int i;
 
-    /* apply the equalizer filter to the data */
-    ri = rq = 0;
-    q = p;
     for(i=0;i<EQ_SIZE;i++) {
-        fi = s->eq_filter[i][0] >> 16;
-        fq = s->eq_filter[i][1] >> 16;
-        
-        ri += fi * s->eq_buf[q];
-        rq += fq * s->eq_buf[q];
+        s->eq_coef[0][i] = s->eq_filter[i][0] >> 16;
+        s->eq_coef[1][i] = s->eq_filter[i][1] >> 16;
+    }
+    if (s->fd_eq)
+        V34_fd_eq_set_filter(s->fd_eq, s->eq_filter, EQ_SIZE);
+}
 
-        q++;
-        if (q == EQ_SIZE)
-            q = 0;
+/* data mode: return in (*ri, *rq) the y(n) of the received x'(n)
+   and in (*q_ri, *q_rq) the x'(n) of the nearest y(n) of the
+   lattice. */
+static void data_decision(V34DSPState *s, int *ri, int *rq, 
+                          int *q_ri, int *q_rq)
+{
+    int xi, xq, yi, yq, qi, qq, t, x1, y1;
+
+    xi = *ri;
+    xq = *rq;
+    if (s->use_non_linear)
+        nl_decode(s, &xi, &xq);
+    yi = xi;
+    yq = xq;
+    precoder_filter(s, &yi, &yq);
+
+    if (s->use_precoding) {
+        /* y(n) is not limited to the constellation */
+        qi = ((yi >> 8) * 2 + 1) << 7;
+        qq = ((yq >> 8) * 2 + 1) << 7;
+    } else {
+        t = v34_slice(s, yi, yq);
+        x1 = s->constellation[t & 0x3fff][0];
+        y1 = s->constellation[t & 0x3fff][1];
+        rotate_clockwise(qi, qq, x1, y1, t >> 14);
+        qi <<= 7;
+        qq <<= 7;
     }
-    si = ri >> 14;
-    sq = rq >> 14;
-    
+    qi -= yi - xi;
+    qq -= yq - xq;
+    if (s->use_non_linear)
+        nl_encode(s, &qi, &qq);
+    *q_ri = qi;
+    *q_rq = qq;
+    *ri = yi;
+    *rq = yq;
+}
+
+/* decision & phase tracking of the equalized passband symbol (si,
+   sq). Return true if the filter must be updated with the remodulated
+   error (*ei_ptr, *eq_ptr) according to the update policy. */
+static int eq_decision(V34DSPState *s, int si, int sq, 
+                       int *ri_ptr, int *rq_ptr, int *ei_ptr, int *eq_ptr)
+{
+    int ri, rq, q_ri, q_rq, ei1, eq1;
+    int cosw, sinw, dphi, norm;
+
     /* rotate by the carrier phase */
     /* translate back to baseband */
 
     cosw = dsp_cos(s->carrier_phase);
-    sinw = - dsp_cos((PHASE_BASE/4) - s->carrier_phase);
+    sinw = - dsp_sin(s->carrier_phase);
     ri = ( si * cosw - sq * sinw ) >> COS_BITS;
     rq = ( si * sinw + sq * cosw ) >> COS_BITS;
     
+    /* signal detection: no decision in the silences */
+    s->rx_pow += (ri * ri + rq * rq - s->rx_pow) >> RX_POW_SHIFT;
+    if (s->rx_pow > RX_POW_ON)
+        s->rx_signal = 1;
+    else if (s->rx_pow < RX_POW_OFF)
+        s->rx_signal = 0;
+    if (!s->rx_signal) {
+        *ri_ptr = ri;
+        *rq_ptr = rq;
+        s->carrier_phase += s->carrier_incr;
+        return 0;
+    }
+
+    /* data mode: the constellation is transmitted with the power of
+       the training sequences */
+    if (s->rx_gain != 256) {
+        ri = (ri * s->rx_gain) >> 8;
+        rq = (rq * s->rx_gain) >> 8;
+    }
     *ri_ptr = ri;
     *rq_ptr = rq;
 
     /* compute the error */
 
     /* quantification */
-    q_ri = ((ri >> 8) * 2 + 1) << 7;
-    q_rq = ((rq >> 8) * 2 + 1) << 7;
+    if (s->state == V34_DATA) {
+        data_decision(s, ri_ptr, rq_ptr, &q_ri, &q_rq);
+    } else {
+        q_ri = ((ri >> 8) * 2 + 1) << 7;
+        q_rq = ((rq >> 8) * 2 + 1) << 7;
+    }
 
     /* error computation */
     ei1 = - (ri - q_ri);
     eq1 = - (rq - q_rq);
+    s->eq_mse_sum += ei1 * ei1 + eq1 * eq1;
+    s->eq_mse_count++;
 
     /**** phase tracking */
 
@@ -2021,98 +2617,431 @@ static int v34_equalize(V34DSPState *s,
     }
     s->carrier_phase += s->carrier_incr - dphi;
 
+    if (++s->eq_update_count < s->eq_update_period)
+        return 0;
+    s->eq_update_count = 0;
+    if (s->rx_gain != 256) {
+        ei1 = (ei1 << 8) / s->rx_gain;
+        eq1 = (eq1 << 8) / s->rx_gain;
+    }
+    if (s->eq_update_mode == EQ_UPDATE_SIGN) {
+        ei1 = (ei1 > 0) ? EQ_SIGN_STEP : (ei1 < 0) ? -EQ_SIGN_STEP : 0;
+        eq1 = (eq1 > 0) ? EQ_SIGN_STEP : (eq1 < 0) ? -EQ_SIGN_STEP : 0;
+    }
     /* remodulate (because the equalizer is done before converting to
        baseband) */
-    ei = ( ei1 * cosw + eq1 * sinw ) >> COS_BITS;
-    eq = ( - ei1 * sinw + eq1 * cosw ) >> COS_BITS;
+    *ei_ptr = ( ei1 * cosw + eq1 * sinw ) >> COS_BITS;
+    *eq_ptr = ( - ei1 * sinw + eq1 * cosw ) >> COS_BITS;
+    return 1;
+}
 
-#if 1
-    /* update the coefficients with the error */
-    q = p;
+/* the gain of the fast equalizer is only approximate: normalize it so
+   that the symbols of the PP window 'pp' (which is periodic) have the
+   power of the TRN sequence */
+static void eq_normalize_gain(V34DSPState *s, const s16 *pp)
+{
+    s16 x[EQ_SIZE];
+    int i, j, k, n, ri, rq;
+    float p, g;
+
+    n = EQ_FRAC * V34_PP_SIZE;
+    p = 0;
+    for(k=0;k<V34_PP_SIZE;k++) {
+        for(j=0;j<EQ_SIZE;j++) {
+            i = (EQ_FRAC * k - (EQ_SIZE - 1) + j) % n;
+            if (i < 0)
+                i += n;
+            x[j] = pp[i];
+        }
+        ri = dsp_dot_prod(s->eq_coef[0], x, EQ_SIZE, 0) >> 14;
+        rq = dsp_dot_prod(s->eq_coef[1], x, EQ_SIZE, 0) >> 14;
+        p += (float)ri * ri + (float)rq * rq;
+    }
+    if (p <= 0)
+        return;
+    g = sqrt(2 * 128 * 128 * V34_PP_SIZE / p);
     for(i=0;i<EQ_SIZE;i++) {
-        int di, dq;
-        di = ei * s->eq_buf[q];
-        dq = eq * s->eq_buf[q];
-        
-        s->eq_filter[i][0] += (di >> s->eq_shift) * 16;
-        s->eq_filter[i][1] += (dq >> s->eq_shift) * 16;
+        s->eq_filter[i][0] = (s32)(s->eq_filter[i][0] * g);
+        s->eq_filter[i][1] = (s32)(s->eq_filter[i][1] * g);
+    }
+    eq_load_coefs(s);
+}
 
-        q++;
-        if (q == EQ_SIZE)
-            q = 0;
+/* equalize & adapt the equalizer */
+static int v34_equalize(V34DSPState *s, 
+                        int *ri_ptr, int *rq_ptr, int spl, int phase)
+{
+    int p, ri, rq, ei, eq;
+    const s16 *x;
+
+    /* add the sample in the equalizer delay line */
+    p = s->eq_buf_ptr;
+
+    s->eq_buf[p] = spl;
+    s->eq_buf[p + EQ_SIZE] = spl;
+
+    if (++p == EQ_SIZE)
+        p = 0;
+    s->eq_buf_ptr = p;
+
+    if (phase != 0)
+        return 0;
+
+    /* apply the equalizer filter to the data */
+    x = s->eq_buf + p;
+    ri = dsp_dot_prod(s->eq_coef[0], x, EQ_SIZE, 0);
+    rq = dsp_dot_prod(s->eq_coef[1], x, EQ_SIZE, 0);
+
+    /* update the coefficients with the error */
+    if (eq_decision(s, ri >> 14, rq >> 14, ri_ptr, rq_ptr, &ei, &eq)) {
+        dsp_eq_update(s->eq_filter, s->eq_coef[0], s->eq_coef[1], x, EQ_SIZE,
+                  ei, eq, s->eq_shift);
     }
-#endif
 
     lm_dump_equalizer(s->eq_filter, 1 << 30, EQ_SIZE);
 
     return 1;
 }
 
-static void V34_demod(V34DSPState *s, 
-                      const s16 *samples, unsigned int nb)
+/* same with the frequency domain equalizer: the symbols are computed
+   by blocks, so they are returned with a delay of about one block */
+static int v34_fd_equalize(V34DSPState *s, 
+                           int *ri_ptr, int *rq_ptr, int spl, int phase)
 {
-    int si, sq, i, j, k , ph, spl;
-    int v, frac, ph1;
+    V34FDEq *e = s->fd_eq;
+    int i, j, ri, rq, ei, eq, update;
+
+    e->x[e->block + e->ptr] = spl;
+    e->sym[e->ptr] = (phase == 0);
+    if (++e->ptr == e->block) {
+        V34_fd_eq_filter(e);
+        update = 0;
+        for(i=0;i<e->block;i++) {
+            ei = eq = 0;
+            if (e->sym[i]) {
+                if (eq_decision(s, (int)floor(e->y[i].re), 
+                                (int)floor(e->y[i].im),
+                                &ri, &rq, &ei, &eq))
+                    update = 1;
+                if (e->out_count < e->out_size) {
+                    j = e->out_rptr + e->out_count;
+                    if (j >= e->out_size)
+                        j -= e->out_size;
+                    e->out[j][0] = ri;
+                    e->out[j][1] = rq;
+                    e->out_count++;
+                }
+            }
+            e->y[i].re = ei;
+            e->y[i].im = eq;
+        }
+        if (update)
+            V34_fd_eq_update(e);
+        memcpy(e->x, e->x + e->block, e->block * sizeof(float));
+        e->ptr = 0;
+    }
 
-    for(i=0;i<nb;i++) {
-        /* Automatic Gain Control */
-        spl = samples[i];
+    if (phase != 0 || e->out_count == 0)
+        return 0;
+    *ri_ptr = e->out[e->out_rptr][0];
+    *rq_ptr = e->out[e->out_rptr][1];
+    if (++e->out_rptr == e->out_size)
+        e->out_rptr = 0;
+    e->out_count--;
+    return 1;
+}
 
-        agc_estimate(s, spl);
-        spl = (spl * s->agc_gain) >> 14;
+/* use a frequency domain equalizer of 'nb_taps' taps instead of the
+   time domain one (nb_taps = 0 selects the time domain one). It is
+   initialized with the current filter and then with the PP
+   estimate. */
+int V34_set_fd_equalizer(V34DSPState *s, struct sm_arena *arena, int nb_taps)
+{
+    V34FDEq *e;
 
-        /* insert the new sample in the ring buffer */
-        s->rx_buf1[s->rx_buf1_ptr] = spl;
-        s->rx_buf1_ptr = (s->rx_buf1_ptr + 1) & (RX_BUF1_SIZE-1);
+    s->fd_eq = NULL;
+    if (nb_taps == 0)
+        return 0;
+    e = sm_arena_alloc(arena, sizeof(V34FDEq));
+    if (!e || V34_fd_eq_init(e, arena, nb_taps) < 0)
+        return -1;
+    V34_fd_eq_set_filter(e, s->eq_filter, EQ_SIZE);
+    s->fd_eq = e;
+    return 0;
+}
 
-        /* sample rate convertion, timing correction & matched filter
-           (root raised cosine) */
-        s->baud_phase += s->baud_num;
-        while (s->baud_phase >= s->baud_denom) {
-            s->baud_phase -= s->baud_denom;
-            
-            ph = s->baud_phase;
-            si = 0;
-            for(j=0;j<s->rx_filter_wsize;j++) {
-                k = (s->rx_buf1_ptr - s->rx_filter_wsize + j) & (RX_BUF1_SIZE-1);
-                /* XXX: verify that there is no overflow */
-
-                /* interpolation of the filter coefficient */
-                ph1 = ph >> 16;
-                frac = ph & 0xffff;
-                v = ((0x10000 - frac) * s->rx_filter[ph1] + 
-                     frac * s->rx_filter[ph1+1]) >> 16;
-                si += v * s->rx_buf1[k];
-                ph += s->baud_num;
+/* one bit of the J, MP & E sequences */
+static void v34_rx_bit(V34DSPState *s, int b)
+{
+    int type, size, crc, i, ones;
+
+    ones = s->rx_ones;
+    s->rx_bits = (s->rx_bits << 1) | b;
+    if (b)
+        s->rx_ones++;
+    else
+        s->rx_ones = 0;
+
+    switch(s->state) {
+    case V34_STARTUP3_TRN:
+        /* two J sequences */
+        if ((s->rx_bits & 0xffff) == J4POINTS && 
+            (s->rx_bits >> 16) == J4POINTS) {
+            s->J_received = 1;
+            s->state = V34_STARTUP4_MP;
+            s->mp_ptr = 0;
+        }
+        break;
+    case V34_STARTUP4_MP:
+        if (s->mp_ptr == 0) {
+            /* frame sync: 17 ones & the start bit */
+            if (b == 0 && ones >= 17) {
+                memset(s->mp_buf, 1, 17);
+                s->mp_buf[17] = 0;
+                s->mp_ptr = 18;
+            }
+            break;
+        }
+        s->mp_buf[s->mp_ptr++] = b;
+        if (s->mp_ptr < 19)
+            break;
+        /* the CRC follows the bits 17 to 170 (type 1) or 68 (type 0) */
+        type = s->mp_buf[18];
+        size = type ? 171 : 69;
+        if (s->mp_ptr < size + 16)
+            break;
+        crc = 0;
+        for(i=0;i<16;i++)
+            crc = (crc << 1) | s->mp_buf[size + i];
+        if (crc == calc_crc(s->mp_buf + 17, size - 17)) {
+            /* XXX: only the data rates are used */
+            s->mp_R[0] = 0;
+            s->mp_R[1] = 0;
+            for(i=0;i<4;i++) {
+                s->mp_R[0] = (s->mp_R[0] << 1) | s->mp_buf[20 + i];
+                s->mp_R[1] = (s->mp_R[1] << 1) | s->mp_buf[24 + i];
+            }
+            /* the rate of our direction is checked here, the other
+               one by the transmitter (its symbol rate may differ) */
+            s->mp_R[0] *= 2400;
+            s->mp_R[1] *= 2400;
+            i = s->calling ? 1 : 0;
+            s->mp_R[i] = V34_clamp_rate(s->S, s->mp_R[i], s->expanded_shape);
+            s->mp_aux = s->mp_buf[28];
+            s->MP_received = 1;
+            /* E follows the acknowledge MP */
+            if (s->mp_buf[33]) {
+                s->MP_ack_received = 1;
+                s->state = V34_STARTUP4_E;
             }
-            si = (si >> 14);
-            lm_dump_sample(CHANNEL_SAMPLESYNC, si / 32768.0);
+        }
+        s->mp_ptr = 0;
+        break;
+    }
+}
 
-            /* we have here EQ_FRAC = 3 symbols per baud */
+/* the MSE is not measured during the convergence of the equalizer
+   after the training (in 4D symbols) */
+#define V34_RATE_SKIP 1024
 
-            switch(s->state) {
-            case V34_STARTUP3_WAIT_S1:
-                /* wait for the S signal */
-                printf("waiting S1 %d\n", si);
-                /* XXX: find a better test ! */
-                if (abs(si) > 13000) {
-                    s->state = V34_STARTUP3_S1;
-                    s->sym_count = 0;
-                }
-                break;
+/* the E sequence was received: the next symbol is the first data
+   symbol */
+static void v34_rx_data_init(V34DSPState *s)
+{
+    int R;
+
+    /* the data rate is the lowest of the two MP rates */
+    R = s->mp_R[s->calling ? 1 : 0];
+    if (s->max_R < R)
+        R = s->max_R;
+    /* the aux channel is used if both modems request it */
+    V34_init_rate(s, R, s->use_aux_channel && s->mp_aux);
+    s->rate_mse = 0;
+    s->rate_mse_cnt = -V34_RATE_SKIP;
+    s->s_corr = 0;
+    s->s_pow = 0;
+    memset(s->s_last, 0, sizeof(s->s_last));
+
+    s->rx_gain = (int)(256.0 * sqrt(V34_data_power(s) / TRN4_POWER));
+    s->phase_4d = 0;
+    s->dec_delay = TRELLIS_DELAY;
+    s->rx_mapping_frame_count = 0;
+    s->mapping_frame = 0;
+    s->sync_pos = 0;
+    s->rx_v0 = 0;
+    memset(s->x, 0, sizeof(s->x));
+    memset(s->x_hat, 0, sizeof(s->x_hat));
+    memset(s->state_error, 0, sizeof(s->state_error));
+    s->trellis_ptr = 0;
+    s->trellis_count = 0;
+    s->state = V34_DATA;
+}
 
-            case V34_STARTUP3_S1:
-                /* S signals are mainly used to recover the symbol clock */
-                v34_symbol_sync(s, si);
-                if (++s->sym_count >= 128 * EQ_FRAC) {
-                    s->state = V34_STARTUP3_SINV1;
-                    s->sym_count = 0;
-                }
-                break;
-            case V34_STARTUP3_SINV1:
-                v34_symbol_sync(s, si);
-                if (++s->sym_count >= 16 * EQ_FRAC) {
-                    s->state = V34_STARTUP3_S2;
+/* S detection in data mode: S repeats the same point every 2 T, the
+   data symbols are uncorrelated */
+#define S_DETECT_SHIFT 6
+
+static int v34_detect_S(V34DSPState *s, int ri, int rq)
+{
+    int c, p;
+
+    c = (ri * s->s_last[1][0] + rq * s->s_last[1][1]) >> 8;
+    p = (ri * ri + rq * rq) >> 8;
+    s->s_corr += (c - s->s_corr) >> S_DETECT_SHIFT;
+    s->s_pow += (p - s->s_pow) >> S_DETECT_SHIFT;
+    s->s_last[1][0] = s->s_last[0][0];
+    s->s_last[1][1] = s->s_last[0][1];
+    s->s_last[0][0] = ri;
+    s->s_last[0][1] = rq;
+    return (s->s_corr > s->s_pow - (s->s_pow >> 2));
+}
+
+/* S was detected in data mode: rate renegotiation (S S' TRN MP E) */
+static void v34_rx_renegotiate(V34DSPState *s)
+{
+    s->rx_gain = 256;
+    s->state = V34_STARTUP4_MP;
+    s->mp_ptr = 0;
+    s->renegotiate = 1;
+}
+
+/* an equalized symbol (ri, rq) was received after the PP sequence */
+static void v34_rx_symbol(V34DSPState *s, int ri, int rq)
+{
+    int z, i;
+
+    if (s->state == V34_DATA) {
+        if (v34_detect_S(s, ri, rq))
+            v34_rx_renegotiate(s);
+        else
+            baseband_decode(s, ri, rq);
+        return;
+    }
+
+    if (!s->rx_signal) {
+        s->sym_count = 0;
+        return;
+    }
+    /* the remote modem starts transmitting again */
+    if (s->sym_count == 0)
+        s->S_received = 1;
+    s->sym_count++;
+
+    /* 4 point differential decoding (Z_1 is the previous quadrant) */
+    if (ri >= 0)
+        z = (rq >= 0) ? 0 : 3;
+    else
+        z = (rq >= 0) ? 1 : 2;
+    i = (z - s->Z_1) & 3;
+    s->Z_1 = z;
+    v34_rx_bit(s, descrambler_bit(&s->scrambler, i & 1));
+    v34_rx_bit(s, descrambler_bit(&s->scrambler, i >> 1));
+
+    /* E: 20 ones */
+    if (s->state == V34_STARTUP4_E && s->rx_ones >= 20)
+        v34_rx_data_init(s);
+}
+
+/* Automatic Gain Control & insertion of the sample in the ring
+   buffer of the matched filter */
+static inline void v34_rx_agc(V34DSPState *s, int spl)
+{
+    agc_estimate(s, spl);
+    spl = (spl * s->agc_gain) >> 14;
+
+    dsp_hist_put(s->rx_buf1, &s->rx_buf1_ptr, RX_BUF1_SIZE, spl);
+}
+
+/* sample rate convertion, timing correction & matched filter (root
+   raised cosine): output sample at baud_phase */
+static inline int v34_rx_filter(V34DSPState *s)
+{
+    int si, frac, ph1;
+    const s16 *f0, *f1;
+    s16 coefs[RX_BUF1_SIZE];
+
+    /* the coefficients are interpolated between two phases of the
+       polyphase filter. The rows are contiguous. */
+    ph1 = s->baud_phase >> 16;
+    frac = s->baud_phase & 0xffff;
+    if (ph1 >= s->rx_filter_phases - 1) {
+        /* XXX: only possible with a huge timing correction */
+        ph1 = s->rx_filter_phases - 2;
+        frac = 0x10000;
+    }
+    f0 = s->rx_filter + ph1 * s->rx_filter_stride;
+    f1 = f0 + s->rx_filter_stride;
+    dsp_poly_coefs(coefs, f0, f1, frac, s->rx_filter_wsize);
+    si = dsp_dot_prod(coefs, 
+                      dsp_hist_last(s->rx_buf1, s->rx_buf1_ptr, RX_BUF1_SIZE,
+                                    s->rx_filter_wsize),
+                      s->rx_filter_wsize, 0);
+    si = (si >> 14);
+    lm_dump_sample(CHANNEL_SAMPLESYNC, si / 32768.0);
+    return si;
+}
+
+/* input of the equalizer: the T/3 sample 'si' normalized with the
+   power of the 4 point TRN */
+static inline int v34_rx_eq_input(int si)
+{
+    return (float)si * 128.0 / CALC_AMP(TRN4_POWER);
+}
+
+/* adaptive equalization of the T/3 sample 'si' at position 'phase'
+   in the symbol. Return true if a symbol is output */
+static inline int v34_rx_equalize(V34DSPState *s, int *ri_ptr, int *rq_ptr,
+                                  int si, int phase)
+{
+    si = v34_rx_eq_input(si);
+    if (s->fd_eq)
+        return v34_fd_equalize(s, ri_ptr, rq_ptr, si, phase);
+    else
+        return v34_equalize(s, ri_ptr, rq_ptr, si, phase);
+}
+
+static void V34_demod(V34DSPState *s, 
+                      const s16 *samples, unsigned int nb)
+{
+    int si, sq, i, v;
+
+    for(i=0;i<nb;i++) {
+        v34_rx_agc(s, samples[i]);
+
+        s->baud_phase += s->baud_num;
+        while (s->baud_phase >= s->baud_denom) {
+            s->baud_phase -= s->baud_denom;
+            si = v34_rx_filter(s);
+
+            /* we have here EQ_FRAC = 3 symbols per baud */
+
+            switch(s->state) {
+            case V34_STARTUP3_WAIT_S1:
+                /* wait for the S signal */
+                /* XXX: find a better test ! */
+                if (abs(si) > 13000) {
+                    s->state = V34_STARTUP3_S1;
+                    s->sym_count = 0;
+                    s->S_received = 1;
+                    /* the symbols are output when baud3_phase = 0:
+                       align them with the start of the PP window
+                       used by the fast equalizer */
+                    s->baud3_phase = EQ_FRAC - 1;
+                }
+                break;
+
+            case V34_STARTUP3_S1:
+                /* S signals are mainly used to recover the symbol clock */
+                v34_symbol_sync(s, si);
+                if (++s->sym_count >= 128 * EQ_FRAC) {
+                    s->state = V34_STARTUP3_SINV1;
+                    s->sym_count = 0;
+                }
+                break;
+            case V34_STARTUP3_SINV1:
+                v34_symbol_sync(s, si);
+                if (++s->sym_count >= 16 * EQ_FRAC) {
+                    s->state = V34_STARTUP3_S2;
                     s->sym_count = 0;
                 }
                 break;
@@ -2134,6 +3063,7 @@ static void V34_demod(V34DSPState *s,
                 break;
 
             case V34_STARTUP3_PP:
+                v34_symbol_sync(s, si);
 #if 1
                 /* PP is used to fast train the equalizer */
 
@@ -2142,13 +3072,17 @@ static void V34_demod(V34DSPState *s,
                    equalizer that the sequence is periodic */
                 if (s->sym_count >= (120) * EQ_FRAC && 
                     s->sym_count < (168) * EQ_FRAC) {
-                    s->eq_buf[s->sym_count - (120) * EQ_FRAC] = si;
+                    /* the peaks of PP do not fit in 16 bits */
+                    s->eq_buf[s->sym_count - (120) * EQ_FRAC] = 
+                        v34_rx_eq_input(si);
                 }
 
                 if (s->sym_count == (168) * EQ_FRAC) {
                     /* XXX: this call takes a long time. Is it a
                        problem ? */
                     V34_fast_equalize(s, s->eq_buf);
+                    eq_load_coefs(s);
+                    eq_normalize_gain(s, s->eq_buf);
                     /* reset eq_buf to avoid potential problems when the
                        adaptive is started */
                     memset(s->eq_buf, 0, sizeof(s->eq_buf));
@@ -2156,6 +3090,11 @@ static void V34_demod(V34DSPState *s,
                 
                 if (++s->sym_count == 288 * EQ_FRAC) {
                     s->state = V34_STARTUP3_TRN;
+                    /* carrier phase of the fast equalizer output
+                       (0 at the start of the PP window) */
+                    s->carrier_phase = (288 - 120) * s->carrier_incr;
+                    s->rx_pow = 2 * 128 * 128;
+                    s->rx_signal = 1;
                 }
 #else
                 memmove(s->eq_buf, &s->eq_buf[1], 2 * EQ_SIZE);
@@ -2163,21 +3102,19 @@ static void V34_demod(V34DSPState *s,
                 
                 if ((++s->sym_count % EQ_SIZE) == 0) {
                     V34_fast_equalize(s, s->eq_buf);
+                    eq_load_coefs(s);
                     lm_dump_equalizer(s->eq_filter, 1 << 30, EQ_SIZE);
                 }
 #endif
 
                 break;
 
-            case V34_STARTUP3_TRN:
-                si = (float)si * 128.0 / CALC_AMP(TRN4_POWER);
-                if (v34_equalize(s, &si, &sq, si)) {
-                    static int ptr = 0;
-                    
-                    if (++ptr > (28 * 2)) {
-                        baseband_decode(s, si, sq);
-                    }
-                }
+            default:
+                /* TRN and after: adaptive equalization */
+                v34_symbol_sync(s, si);
+                v = v34_rx_equalize(s, &si, &sq, si, s->baud3_phase);
+                if (v)
+                    v34_rx_symbol(s, si, sq);
                 break;
             }
 
@@ -2189,6 +3126,71 @@ static void V34_demod(V34DSPState *s,
     }
 }
 
+/* stages of the receiver in data mode, used by the pipelined
+   receiver (v34pipe.c). Each stage only modifies its own part of the
+   state, the V34 state is not modified (see V34_rx_stage3()). */
+
+/* stage 1: AGC, matched filter & timing recovery of the sample
+   'spl'. The T/3 samples and their position in the symbol are stored
+   in out[] (at most 2). Return their number. */
+int V34_rx_stage1(V34DSPState *s, int (*out)[2], int spl)
+{
+    int n, si;
+
+    v34_rx_agc(s, spl);
+
+    n = 0;
+    s->baud_phase += s->baud_num;
+    while (s->baud_phase >= s->baud_denom) {
+        s->baud_phase -= s->baud_denom;
+        si = v34_rx_filter(s);
+        v34_symbol_sync(s, si);
+        out[n][0] = si;
+        out[n][1] = s->baud3_phase;
+        n++;
+        if (++s->baud3_phase == EQ_FRAC)
+            s->baud3_phase = 0;
+    }
+    return n;
+}
+
+/* stage 2: equalizer & carrier tracking. Return true if a symbol is
+   output */
+int V34_rx_stage2(V34DSPState *s, int *ri_ptr, int *rq_ptr, 
+                  int si, int phase)
+{
+    return v34_rx_equalize(s, ri_ptr, rq_ptr, si, phase);
+}
+
+/* stage 3: S detection, Viterbi decoder, precoder & mapping frame
+   decoding. The mapping frames are given to s->put_frame() (stage
+   4). Return true if S was detected: the data mode must then be left
+   with V34_rx_stage3_end() once the other stages are idle. */
+int V34_rx_stage3(V34DSPState *s, int ri, int rq)
+{
+    if (v34_detect_S(s, ri, rq))
+        return 1;
+    baseband_decode(s, ri, rq);
+    return 0;
+}
+
+/* leave the data mode after V34_rx_stage3() returned true, then
+   process the 'n' symbols sym[] which were equalized after S */
+void V34_rx_stage3_end(V34DSPState *s, int (*sym)[2], int n)
+{
+    int i;
+
+    v34_rx_renegotiate(s);
+    for(i=0;i<n;i++)
+        v34_rx_symbol(s, sym[i][0], sym[i][1]);
+}
+
+/* stage 4: aux channel, descrambler & data bits of a mapping frame */
+void V34_rx_stage4(V34DSPState *s, const u64 *f, int mp_size, int aux)
+{
+    put_mapping_frame(s, f, mp_size, aux);
+}
+
 static void V34_demod_init(V34DSPState *s, V34State *p)
 {
     memset(s, 0, sizeof(V34DSPState));
@@ -2197,27 +3199,259 @@ static void V34_demod_init(V34DSPState *s, V34State *p)
     s->state = V34_STARTUP3_WAIT_S1;
 }
 
+static u32 table_sum(u32 sum, const s16 *tab, int n)
+{
+    int i;
+
+    for(i=0;i<n;i++)
+        sum = v34_table_sum(sum, tab[i]);
+    return sum;
+}
+
+/* verify that v34table.c was generated from the current v34table.h */
+static void v34_check_tables(void)
+{
+    u32 sum;
+    int i;
+
+    sum = V34_TABLE_SUM_INIT;
+#define TRELLIS(n) \
+    for(i=0;i<256*4;i++) \
+        sum = v34_table_sum(sum, trellis_trans_ ## n[i >> 2][i & 3]);
+    V34_TRELLIS_TABLES
+#undef TRELLIS
+#define RX_FILTER(name, S, high) \
+    sum = table_sum(sum, v34_rx_filter_ ## name, \
+                    V34_RX_FILTER_SIZE(baud_tab[S][0], baud_tab[S][1]));
+    V34_RX_FILTERS
+#undef RX_FILTER
+#define TX_FILTER(c1, S) \
+    sum = table_sum(sum, v34_rc_ ## c1 ## _filter, RC_FILTER_SIZE * c1 + 1);
+    V34_TX_FILTERS
+#undef TX_FILTER
+    sum = table_sum(sum, v22_tx_filter, V22_TX_FILTER_SIZE);
+#define V22_RX_FILTER(carrier) \
+    sum = table_sum(sum, v22_rx_filter_ ## carrier, V22_RX_FILTER_SIZE);
+    V22_RX_FILTERS
+#undef V22_RX_FILTER
+
+    if (v34_table_version != V34_TABLE_VERSION || 
+        sum != v34_table_checksum) {
+        fprintf(stderr, "v34table.c does not match v34table.h "
+                "(version %d, expected %d): rebuild it with v34gen\n",
+                v34_table_version, V34_TABLE_VERSION);
+        exit(1);
+    }
+}
+
 /* init the V34 constants. Should be launched once */
 void V34_static_init(void)
 {
+    int m, S, R, e, a;
+
+    v34_check_tables();
+    trellis_init();
+    for(m=1;m<=M_MAX;m++)
+        build_rings(&v34_rings[m], m);
+    build_constellation();
+    for(S=0;S<V34_NB_S;S++) {
+        build_sync_table(v34_sync_v0[S], S_tab[S][7], S_tab[S][6]);
+        for(R=0;R<V34_NB_R;R++) {
+            for(e=0;e<2;e++) {
+                for(a=0;a<2;a++)
+                    build_config(&v34_configs[S][R][e][a], S, 
+                                 (R + 1) * 2400, e, a);
+            }
+        }
+    }
     V34eq_init();
 }
 
 
-void V34_init(struct V34State *s, int calling)
+/* maximum time to reach the data mode (in samples) */
+#define V34_TRAINING_TIMEOUT (15 * 8000)
+
+void V34_init(struct V34State *s, int calling, 
+              get_bit_func get_bit, put_bit_func put_bit, void *opaque)
 {
-    
+    s->calling = calling;
+    s->expanded_shape = 0;
+    s->conv_nb_states = 16;
+    s->use_non_linear = 0;
+    s->use_aux_channel = 0;
+    memset(s->h, 0, sizeof(s->h));
+    s->get_bit = get_bit;
+    s->put_bit = put_bit;
+    s->get_bits = NULL;
+    s->put_bits = NULL;
+    s->get_aux_bit = NULL;
+    s->put_aux_bit = NULL;
+    s->opaque = opaque;
+
+    /* the symbol rate, carrier & data rate of each direction are
+       known after phase 2 */
+    memset(&s->v34_tx, 0, sizeof(V34DSPState));
+    memset(&s->v34_rx, 0, sizeof(V34DSPState));
+    V34_phase2_init(s);
+
+    echo_cancel_init(&s->ec);
+    s->time = 0;
+    s->rx_pipe = NULL;
+}
+
+/* start phase 3 with the INFO1 parameters */
+static void V34_phase3_init(V34State *s)
+{
+    s->S = s->S_tx;
+    s->use_high_carrier = s->high_carrier_tx;
+    s->R = s->R_tx;
+    V34_mod_init(&s->v34_tx, s);
+    /* the receiver limits the rate: it may be renegotiated above the
+       projected one */
+    s->v34_tx.max_R = V34_highest_rate(s->S_tx);
+    s->v34_tx.get_bit = s->get_bit;
+    s->v34_tx.get_bits = s->get_bits;
+    s->v34_tx.get_aux_bit = s->get_aux_bit;
+    s->v34_tx.opaque = s->opaque;
+
+    s->S = s->S_rx;
+    s->use_high_carrier = s->high_carrier_rx;
+    s->R = s->R_rx;
+    V34_demod_init(&s->v34_rx, s);
+    s->v34_rx.max_R = s->R_rx;
+    s->v34_rx.put_bit = s->put_bit;
+    s->v34_rx.put_bits = s->put_bits;
+    s->v34_rx.put_aux_bit = s->put_aux_bit;
+    s->v34_rx.opaque = s->opaque;
+}
 
+/* rate renegotiation: the SNR of the decisions is measured during
+   V34_RATE_WINDOW 4D symbols. The rate is increased only if the SNR
+   is V34_RATE_MARGIN higher than needed. */
+#define V34_RATE_WINDOW 2048
+#define V34_RATE_MARGIN 1.6 /* 2 dB */
+
+static void V34_rate_monitor(V34State *s)
+{
+    V34DSPState *rx = &s->v34_rx;
+    float snr;
+    int R, R1, *mse, *cnt;
+
+    /* the sums of 'rx' belong to the thread of stage 3 when the
+       receiver is pipelined */
+    if (s->rx_pipe) {
+        V34_pipeline_rate_mse(s->rx_pipe, &mse, &cnt);
+    } else {
+        mse = &rx->rate_mse;
+        cnt = &rx->rate_mse_cnt;
+    }
+    if (*cnt < V34_RATE_WINDOW)
+        return;
+    /* a 4D symbol has the power 2 * V34_data_power * 128 * 128 and
+       the MSE is divided by 128 */
+    snr = V34_data_power(rx) * 256.0 * *cnt / (*mse + 1);
+    *mse = 0;
+    *cnt = 0;
+
+    R = rx->R - (rx->W ? 200 : 0);
+    R1 = V34_max_rate(rx->S, snr);
+    if (R1 >= R) {
+        R1 = V34_max_rate(rx->S, snr / V34_RATE_MARGIN);
+        if (R1 <= R)
+            return;
+        R1 = R + 2400;
+    }
+#ifdef DEBUG
+    printf("%s: SNR=%0.1f dB: rx rate %d -> %d\n", 
+           s->calling ? "cal" : "ans", 10 * log10(snr), R, R1);
+#endif
+    rx->max_R = R1;
+    s->v34_tx.renegotiate = 1;
 }
 
+/* full duplex V34. Return non zero if the connection must be closed */
 int V34_process(struct V34State *s, s16 *output, s16 *input, int nb_samples)
 {
-    
+    V34DSPState *tx = &s->v34_tx, *rx = &s->v34_rx;
+    int mode, n;
+
+    if (s->p2_state != V34_P2_DONE) {
+        V34_phase2(s, output, input, nb_samples);
+        if (s->p2_state == V34_P2_DONE)
+            V34_phase3_init(s);
+        goto timeout;
+    }
+
+    /* our MP sequence: the transmitter gives its rate and the
+       receiver the rate it can receive */
+    tx->mp_R[s->calling ? 0 : 1] = tx->max_R;
+    tx->mp_R[s->calling ? 1 : 0] = rx->max_R;
+    V34_mod(tx, output, nb_samples);
+
+    /* the echo canceller is trained while our PP & TRN are sent (the
+       state is the next sequence to send) */
+    if (tx->state == V34_STARTUP3_TRN || 
+        (tx->state == V34_STARTUP3_J && tx->sym_count == 0))
+        mode = EC_TRAIN;
+    else if (tx->state <= V34_STARTUP3_PP || 
+             (tx->state == V34_STARTUP3_WAIT_J && !s->calling))
+        mode = EC_OFF;
+    else
+        mode = EC_TRACK;
+    if (mode != s->ec.mode)
+        echo_cancel_set_mode(&s->ec, mode);
+    echo_cancel(&s->ec, input, output, nb_samples);
+
+    /* the caller only listens after its phase 3 */
+    if (!s->calling || tx->state >= V34_STARTUP3_J) {
+        n = 0;
+        if (s->rx_pipe && rx->state == V34_DATA)
+            n = V34_pipeline_demod(s->rx_pipe, input, nb_samples);
+        V34_demod(rx, input + n, nb_samples - n);
+    }
 
+    /* events from the receiver */
+    if (rx->J_received) {
+        rx->J_received = 0;
+        tx->J_received = 1;
+    }
+    if (rx->S_received) {
+        rx->S_received = 0;
+        tx->S_received = 1;
+    }
+    if (rx->MP_received) {
+        rx->MP_received = 0;
+        tx->MP_received = 1;
+        tx->remote_R = V34_clamp_rate(tx->S, rx->mp_R[s->calling ? 0 : 1],
+                                      tx->expanded_shape);
+        tx->remote_aux = rx->mp_aux;
+    }
+    if (rx->MP_ack_received) {
+        rx->MP_ack_received = 0;
+        tx->MP_ack_received = 1;
+    }
+    /* the remote modem started a rate renegotiation */
+    if (rx->renegotiate) {
+        rx->renegotiate = 0;
+        if (tx->state == V34_DATA)
+            tx->renegotiate = 1;
+    }
+    if (rx->state == V34_DATA && tx->state == V34_DATA)
+        V34_rate_monitor(s);
+
+ timeout:
+    if (rx->state != V34_DATA || tx->state != V34_DATA) {
+        s->time += nb_samples;
+        if (s->time >= V34_TRAINING_TIMEOUT)
+            return 1;
+    } else {
+        s->time = 0;
+    }
     return 0;
 }
 
-/* V34 test: half duplex with fixed parameters */
+/* V34 test: full duplex with the parameters selected by the line
+   probing. Both modems send ones. */
 
 #define NB_SAMPLES 40 /* 5 ms */
 
@@ -2226,26 +3460,28 @@ static int test_get_bit(void *opaque)
     return 1;
 }
 
-static int nb_bits, errors;
+typedef struct {
+    int nb_bits, errors;
+} V34TestCount;
 
 static void test_put_bit(void *opaque, int bit)
 {
-    nb_bits++;
+    V34TestCount *c = opaque;
+
+    c->nb_bits++;
     if (bit != 1) {
-        errors++;
+        c->errors++;
     }
 }
 
 void V34_test(void)
 {
-    V34State s;
-    V34DSPState v34_rx, v34_tx;
-    int err;
+    V34State *cal, *ans;
+    V34TestCount cal_count, ans_count;
+    int err, n;
     struct LineModelState *line_state;
-    s16 buf[NB_SAMPLES];
-    s16 buf1[NB_SAMPLES];
-    s16 buf2[NB_SAMPLES];
-    s16 buf3[NB_SAMPLES];
+    s16 cal_out[NB_SAMPLES], cal_in[NB_SAMPLES];
+    s16 ans_out[NB_SAMPLES], ans_in[NB_SAMPLES];
     FILE *f1;
     
     err = lm_display_init();
@@ -2254,22 +3490,18 @@ void V34_test(void)
         exit(1);
     }
 
-    line_state = line_model_init();
+    line_state = line_model_init(NULL);
 
-    /* fill the test V34 parameters */
-#if 0
-    s.S = V34_S3200;
-    s.R = 28800;
-#else
-    s.S = V34_S2400;
-    s.R = 19200;
-#endif
-    s.expanded_shape = 0;
-    s.conv_nb_states = 16;
-    s.use_non_linear = 0;
-    s.use_high_carrier = 1;
-    s.use_aux_channel = 0;
-    memset(s.h, 0, sizeof(s.h));
+    cal = malloc(sizeof(V34State));
+    ans = malloc(sizeof(V34State));
+    if (!cal || !ans) {
+        fprintf(stderr, "V34_test: no memory\n");
+        exit(1);
+    }
+    memset(&cal_count, 0, sizeof(cal_count));
+    memset(&ans_count, 0, sizeof(ans_count));
+    V34_init(cal, 1, test_get_bit, test_put_bit, &cal_count);
+    V34_init(ans, 0, test_get_bit, test_put_bit, &ans_count);
 
     f1 = fopen("cal.sw", "wb");
     if (f1 == NULL) {
@@ -2277,35 +3509,1570 @@ void V34_test(void)
         exit(1);
     }
 
-    s.calling = 1;
-    V34_mod_init(&v34_tx, &s);
-    v34_tx.opaque = NULL;
-    v34_tx.get_bit = test_get_bit;
-
-    s.calling = 0;
-    V34_demod_init(&v34_rx, &s);
-    v34_rx.opaque = NULL;
-    v34_rx.put_bit = test_put_bit;
-
-    nb_bits = 0;
-    errors = 0;
-    for(;;) {
+    memset(cal_in, 0, sizeof(cal_in));
+    memset(ans_in, 0, sizeof(ans_in));
+    for(n = 0;; n++) {
         if (lm_display_poll_event())
             break;
         
-        V34_mod(&v34_tx, buf, NB_SAMPLES);
+        if (V34_process(cal, cal_out, cal_in, NB_SAMPLES) ||
+            V34_process(ans, ans_out, ans_in, NB_SAMPLES)) {
+            printf("training timeout\n");
+            break;
+        }
         
-        memset(buf3, 0, sizeof(buf3));
-
-        line_model(line_state, buf1, buf, buf2, buf3, NB_SAMPLES);
+        line_model(line_state, ans_in, cal_out, cal_in, ans_out, NB_SAMPLES);
         
-        fwrite(buf, 1, NB_SAMPLES * 2, f1);
+        fwrite(cal_out, 1, NB_SAMPLES * 2, f1);
 
-        V34_demod(&v34_rx, buf, NB_SAMPLES);
+        if ((n % 200) == 0) {
+            printf("t=%0.1f s: cal: errors=%d nb_bits=%d  ans: errors=%d nb_bits=%d\n",
+                   (float)n * NB_SAMPLES / 8000,
+                   cal_count.errors, cal_count.nb_bits,
+                   ans_count.errors, ans_count.nb_bits);
+        }
     }
 
     fclose(f1);
 
-    printf("errors=%d nb_bits=%d Pe=%f\n", 
-           errors, nb_bits, (float) errors / (float)nb_bits);
+    printf("cal: errors=%d nb_bits=%d Pe=%f\n", 
+           cal_count.errors, cal_count.nb_bits, 
+           (float)cal_count.errors / (float)cal_count.nb_bits);
+    printf("ans: errors=%d nb_bits=%d Pe=%f\n", 
+           ans_count.errors, ans_count.nb_bits, 
+           (float)ans_count.errors / (float)ans_count.nb_bits);
+    free(ans);
+    free(cal);
+}
+
+/* cost of the data rate dependent setup, done by V34_init_low for
+   each tx & rx and at each rate renegotiation */
+
+#define SETUP_BENCH_LOOPS 2000
+
+void V34_setup_bench(void)
+{
+    static const int max_R[6] = { 21600, 26400, 26400, 28800, 31200, 33600 };
+    V34DSPState *s;
+    V34State p;
+    int S, R, i, n;
+    s64 t;
+
+    s = malloc(sizeof(*s));
+    if (!s) {
+        fprintf(stderr, "V34_setup_bench: no memory\n");
+        exit(1);
+    }
+    printf("setup: us per data rate setup (V34_init_rate), mean over the rates\n");
+    memset(&p, 0, sizeof(p));
+    p.conv_nb_states = 16;
+    p.use_high_carrier = 1;
+    for(S=V34_S2400;S<=V34_S3429;S++) {
+        p.S = S;
+        p.R = 2400;
+        memset(s, 0, sizeof(*s));
+        V34_init_low(s, &p, 1);
+        n = 0;
+        t = bench_time();
+        for(R=2400;R<=max_R[S];R+=2400) {
+            if (!V34_rate_valid(S, R, 0, 0))
+                continue;
+            for(i=0;i<SETUP_BENCH_LOOPS;i++)
+                V34_init_rate(s, R, 0);
+            n += SETUP_BENCH_LOOPS;
+        }
+        t = bench_time() - t;
+        printf("S=%4.0f: %7.3f us\n", s->symbol_rate, (float)t / n);
+    }
+    free(s);
+}
+
+/* Viterbi benchmark */
+
+#define TRELLIS_BENCH_SYMBOLS 100000 /* 4D symbols */
+
+/* reference decoder: brute force metrics, ACS over all the
+   transitions and traceback from state 0 for each symbol */
+typedef struct {
+    u8 state_decision[TRELLIS_MAX_STATES][TRELLIS_LENGTH];
+    u8 state_path[TRELLIS_MAX_STATES][TRELLIS_LENGTH];
+    s16 state_memory[TRELLIS_LENGTH][4];
+    u8 u0_memory[TRELLIS_LENGTH];
+    int state_error[TRELLIS_MAX_STATES];
+    int state_error1[TRELLIS_MAX_STATES];
+    int trellis_ptr;
+} TrellisRef;
+
+static void trellis_decoder_ref(TrellisRef *s, int conv_nb_states, 
+                                s16 yout[2][2], s16 yy[2][2], int *mse)
+{
+    int i, j, k, n, nbbt, nb_trans, state, next_state, error, trellis_ptr;
+    int error_table[32],decision_table[32],emin,jmin;
+    u8 *p, rot;
+
+    trellis_ptr = s->trellis_ptr;
+    switch(conv_nb_states) {
+    case 16:
+        nbbt = 2;
+        p = &trellis_trans_4[0][0];
+        break;
+    case 32:
+        nbbt = 3;
+        p = &trellis_trans_8[0][0];
+        break;
+    default:
+        nbbt = 4;
+        p = &trellis_trans_16[0][0];
+        break;
+    }
+    nb_trans = 1 << nbbt;
+
+    k = trellis_ptr;
+    k--;
+    if (k < 0) k = TRELLIS_LENGTH-1;
+    j = 0;
+    for(i=0;i<(TRELLIS_LENGTH-1);i++) {
+        j = s->state_path[j][k];
+        k--;
+        if (k < 0) k = TRELLIS_LENGTH-1;
+    }
+    *mse = trellis_output(yout, s->state_decision[j][k], 
+                          s->u0_memory[trellis_ptr], 
+                          s->state_memory[trellis_ptr], p, &rot);
+
+    s->state_memory[trellis_ptr][0] = yy[0][0];
+    s->state_memory[trellis_ptr][1] = yy[0][1];
+    s->state_memory[trellis_ptr][2] = yy[1][0];
+    s->state_memory[trellis_ptr][3] = yy[1][1];
+
+    trellis_metrics_ref(nbbt, yy, error_table, decision_table);
+
+    jmin = 0;
+    emin = 0x7fffffff;
+    for(i=0;i<nb_trans*2;i++) {
+        if (error_table[i] < emin) {
+            jmin = i;
+            emin = error_table[i];
+        }
+    }
+    s->u0_memory[trellis_ptr] = (jmin >= nb_trans);
+
+    for(state=0;state<conv_nb_states;state++)
+        s->state_error1[state] = 0x7fffffff;
+    for(state=0;state<conv_nb_states;state++) {
+        if (state & 1)
+            n = nb_trans;
+        else 
+            n = 0;
+        for(j=0;j<nb_trans;j++) {
+            next_state = trellis_next_state(conv_nb_states, state, j);
+            error = s->state_error[state] + error_table[j + n];
+            if (error < s->state_error1[next_state]) {
+                s->state_error1[next_state] = error;
+                s->state_decision[next_state][trellis_ptr] = decision_table[j + n];
+                s->state_path[next_state][trellis_ptr] = state;
+            }
+        }
+    }
+    memcpy(s->state_error, s->state_error1, sizeof(s->state_error));
+
+    trellis_ptr = (trellis_ptr + 1) % TRELLIS_LENGTH;
+    s->trellis_ptr = trellis_ptr;
+}
+
+/* random path in the trellis, with gaussian noise (in units of
+   1/128). 'ysent' is the expected decoder output: the second 2D symbol
+   of the 'y0 = 1' subsets is rotated back by the decoder */
+static void trellis_bench_gen(s16 (*yy)[2][2], s16 (*ysent)[2][2], 
+                              int nb, int nb_states, float sigma)
+{
+    int i, j, k, n, nbbt, state, trans, d, x;
+    u8 *p;
+
+    switch(nb_states) {
+    case 16:
+        nbbt = 2;
+        p = &trellis_trans_4[0][0];
+        break;
+    case 32:
+        nbbt = 3;
+        p = &trellis_trans_8[0][0];
+        break;
+    default:
+        nbbt = 4;
+        p = &trellis_trans_16[0][0];
+        break;
+    }
+    n = 128 >> nbbt;
+    state = 0;
+    for(i=0;i<nb;i++) {
+        trans = random() % (1 << nbbt);
+        d = (trans + ((state & 1) << nbbt)) * n + (random() % n);
+        for(k=0;k<4;k++) {
+            j = k >> 1;
+            x = random() % 4 - 2;
+            ysent[i][j][k & 1] = (((4 * x + p[d * 4 + k] - 2) << 8) + 128);
+            yy[i][j][k & 1] = ysent[i][j][k & 1] + 
+                (int)rint(random_gaussian() * sigma);
+        }
+        if (d >> 7) {
+            x = ysent[i][1][1];
+            ysent[i][1][1] = -ysent[i][1][0];
+            ysent[i][1][0] = x;
+        }
+        state = trellis_next_state(nb_states, state, trans);
+    }
+}
+
+/* return the number of symbols of 'yout' delayed by 'delay' which
+   differ from 'ysent' */
+static int trellis_bench_errors(s16 (*yout)[2][2], s16 (*ysent)[2][2], 
+                                int nb, int delay)
+{
+    int i, err;
+
+    err = 0;
+    for(i=0;i<nb-delay;i++) {
+        if (memcmp(yout[i + delay], ysent[i], 4 * sizeof(s16)))
+            err++;
+    }
+    return err;
+}
+
+void V34_bench(void)
+{
+    static const int nb_states[3] = { 16, 32, 64 };
+    static const float sigma[2] = { 50, 70 };
+    V34DSPState *s;
+    TrellisRef *r;
+    s16 (*yy)[2][2], (*ysent)[2][2], (*yout)[2][2], (*yout_ref)[2][2];
+    int error_table[32], decision_table[32];
+    int error_table_ref[32], decision_table_ref[32];
+    int i, j, k, err, mse, rot, nbbt, nb, ser, ser_ref;
+    s64 t, t_ref, tm, tm_ref;
+
+    s = calloc(1, sizeof(*s));
+    r = calloc(1, sizeof(*r));
+    nb = TRELLIS_BENCH_SYMBOLS;
+    yy = malloc(nb * sizeof(yy[0]));
+    ysent = malloc(nb * sizeof(yy[0]));
+    yout = malloc(nb * sizeof(yy[0]));
+    yout_ref = malloc(nb * sizeof(yy[0]));
+    if (!s || !r || !yy || !ysent || !yout || !yout_ref) {
+        fprintf(stderr, "V34_bench: no memory\n");
+        exit(1);
+    }
+
+    printf("viterbi: %d 4D symbols, time per 4D symbol and symbol errors,\n"
+           "         reference decoder -> current decoder\n", nb);
+    for(i=0;i<3;i++) {
+        nbbt = i + 2;
+        for(j=0;j<2;j++) {
+            trellis_bench_gen(yy, ysent, nb, nb_states[i], sigma[j]);
+
+            /* subset metrics: must be bit exact */
+            err = 0;
+            tm_ref = bench_time();
+            for(k=0;k<nb;k++)
+                trellis_metrics_ref(nbbt, yy[k], 
+                                    error_table_ref, decision_table_ref);
+            tm_ref = bench_time() - tm_ref;
+            tm = bench_time();
+            for(k=0;k<nb;k++)
+                trellis_metrics(nbbt, yy[k], error_table, decision_table);
+            tm = bench_time() - tm;
+            for(k=0;k<nb;k++) {
+                trellis_metrics_ref(nbbt, yy[k], 
+                                    error_table_ref, decision_table_ref);
+                trellis_metrics(nbbt, yy[k], error_table, decision_table);
+                if (memcmp(error_table, error_table_ref, 
+                           (2 << nbbt) * sizeof(int)) ||
+                    memcmp(decision_table, decision_table_ref, 
+                           (2 << nbbt) * sizeof(int)))
+                    err++;
+            }
+
+            /* complete decoder */
+            memset(r, 0, sizeof(*r));
+            t_ref = bench_time();
+            for(k=0;k<nb;k++)
+                trellis_decoder_ref(r, nb_states[i], yout_ref[k], yy[k], &mse);
+            t_ref = bench_time() - t_ref;
+
+            memset(s, 0, sizeof(*s));
+            s->conv_nb_states = nb_states[i];
+            t = bench_time();
+            for(k=0;k<nb;k++)
+                trellis_decoder(s, yout[k], yy[k], &mse, &rot);
+            t = bench_time() - t;
+
+            ser_ref = trellis_bench_errors(yout_ref, ysent, nb, TRELLIS_LENGTH);
+            ser = trellis_bench_errors(yout, ysent, nb, TRELLIS_DELAY);
+
+            printf("%d states sigma=%3.0f: metrics: %6.3f -> %6.3f us  "
+                   "decoder: %6.3f -> %6.3f us (x%4.1f)  "
+                   "errors: %5d -> %5d  metric mismatches=%d\n",
+                   nb_states[i], sigma[j],
+                   (float)tm_ref / nb, (float)tm / nb, 
+                   (float)t_ref / nb, (float)t / nb, (float)t_ref / t, 
+                   ser_ref, ser, err);
+        }
+    }
+
+    free(yout_ref);
+    free(yout);
+    free(ysent);
+    free(yy);
+    free(r);
+    free(s);
+}
+
+/* shell mapping benchmark: table driven ring computation against the
+   previous linear searches (kept here as reference) */
+
+#define SHELL_BENCH_FRAMES 20000
+
+static void index_to_rings_ref(const V34Rings *rt, int ring[4][2], int r0)
+{
+  int a,b,c,d,e,f,g,h,r1,r2,r3,r4,r5,tmp,m;
+  
+  m = rt->m;
+
+  a = -1;
+  r1 = 0;
+  for(;;) {
+    tmp = r0 - rt->z8[a+1];
+    if (tmp < 0) break;
+    r1 = tmp;
+    a++;
+  }
+  b = 0;
+  for(;;) {
+    tmp = r1 - rt->g4[b] * rt->g4[a-b];
+    if (tmp < 0) break;
+    r1 = tmp;
+    b++;
+  }
+  tmp = rt->g4[b];
+  r2 = r1 % tmp;
+  r3 = (r1 - r2) / tmp;
+  c = 0;
+  r4 = r2;
+  for(;;) {
+    tmp = r4 - rt->g2[c] * rt->g2[b-c];
+    if (tmp < 0) break;
+    r4 = tmp;
+    c++;
+  }
+  d = 0;
+  r5 = r3;
+  for(;;) {
+    tmp = r5 - rt->g2[d] * rt->g2[a-b-d];
+    if (tmp < 0) break;
+    r5 = tmp;
+    d++;
+  }
+  tmp = rt->g2[c];
+  e = r4 % tmp;
+  f = (r4 - e) / tmp;
+  tmp = rt->g2[d];
+  g = r5 % tmp;
+  h = (r5 - g) / tmp;
+  
+  if (c < m) {
+    ring[0][0] = e;
+    ring[0][1] = c - ring[0][0];
+  } else {
+    ring[0][1] = m - 1 - e;
+    ring[0][0] = c - ring[0][1];
+  }
+  if ((b-c) < m) {
+    ring[1][0] = f;
+    ring[1][1] = b - c - ring[1][0];
+  } else {
+    ring[1][1] = m - 1 - f;
+    ring[1][0] = b - c - ring[1][1];
+  }
+  if (d < m) {
+    ring[2][0] = g;
+    ring[2][1] = d - ring[2][0];
+  } else {
+    ring[2][1] = m - 1 - g;
+    ring[2][0] = d - ring[2][1];
+  }
+  if ((a-b-d) < m) {
+    ring[3][0] = h;
+    ring[3][1] = a - b - d - ring[3][0];
+  } else {
+    ring[3][1] = m - 1 - h;
+    ring[3][0] = a - b - d - ring[3][1];
+  }
+}
+
+static int rings_to_index_ref(const V34Rings *rt, int ring[4][2])
+{
+  int a,b,c,d,e,f,g,h,r1,r2,r3,r4,r5,m,i;
+
+  m = rt->m;
+  c = ring[0][0] + ring[0][1];
+  if (c < m) e = ring[0][0]; else e = m - 1 - ring[0][1];
+  b = ring[1][0] + ring[1][1];
+  if (b < m) f = ring[1][0]; else f = m - 1 - ring[1][1];
+  b += c;
+  d = ring[2][0] + ring[2][1];
+  if (d < m) g = ring[2][0]; else g = m - 1 - ring[2][1];
+  a = ring[3][0] + ring[3][1];
+  if (a < m) h = ring[3][0]; else h = m - 1 - ring[3][1];
+  a += b + d;
+
+  r5 = h * rt->g2[d] + g;
+  r4 = f * rt->g2[c] + e;
+  r3 = r5;
+  for(i=0;i<d;i++) r3 += rt->g2[i] * rt->g2[a-b-i];
+  r2 = r4;
+  for(i=0;i<c;i++) r2 += rt->g2[i] * rt->g2[b-i];
+  r1 = r3 * rt->g4[b] + r2;
+  for(i=0;i<b;i++) r1 += rt->g4[i] * rt->g4[a-i];
+  return r1 + rt->z8[a];
+}
+
+/* all the (K, M) pairs used by the symbol rates 2400 to 3429 */
+void V34_shell_bench(void)
+{
+    static const int S_rates[6] = { 2400, 2743, 2800, 3000, 3200, 3429 };
+    V34DSPState *s;
+    V34State p;
+    int *r0_tab, (*ring_tab)[4][2], (*ring_tab2)[4][2];
+    int S, R, e, i, k, err, nb;
+    s64 t, t_ref, t1;
+
+    s = malloc(sizeof(*s));
+    r0_tab = malloc(SHELL_BENCH_FRAMES * sizeof(int));
+    ring_tab = malloc(SHELL_BENCH_FRAMES * sizeof(ring_tab[0]));
+    ring_tab2 = malloc(SHELL_BENCH_FRAMES * sizeof(ring_tab[0]));
+    if (!s || !r0_tab || !ring_tab || !ring_tab2) {
+        fprintf(stderr, "V34_shell_bench: no memory\n");
+        exit(1);
+    }
+
+    printf("shell: time per mapping frame (index_to_rings + rings_to_index)\n"
+           "       for all the data rates, linear search -> tables\n");
+    memset(&p, 0, sizeof(p));
+    p.conv_nb_states = 16;
+    for(S=0;S<6;S++) {
+        t = t_ref = 0;
+        nb = 0;
+        err = 0;
+        for(e=0;e<2;e++) {
+            for(R=2400;R<=33600;R+=2400) {
+                memset(s, 0, sizeof(*s));
+                p.S = S;
+                p.R = R;
+                p.expanded_shape = e;
+                if (V34_init_low(s, &p, 1) < 0 || s->K == 0)
+                    continue;
+                for(i=0;i<SHELL_BENCH_FRAMES;i++)
+                    r0_tab[i] = (random() ^ (random() << 16)) & 
+                        ((1U << s->K) - 1);
+
+                t1 = bench_time();
+                for(i=0;i<SHELL_BENCH_FRAMES;i++) {
+                    index_to_rings_ref(s->rings, ring_tab[i], r0_tab[i]);
+                    if (rings_to_index_ref(s->rings, ring_tab[i]) != r0_tab[i])
+                        err++;
+                }
+                t_ref += bench_time() - t1;
+
+                t1 = bench_time();
+                for(i=0;i<SHELL_BENCH_FRAMES;i++) {
+                    index_to_rings(s, ring_tab2[i], r0_tab[i]);
+                    if (rings_to_index(s, ring_tab2[i]) != r0_tab[i])
+                        err++;
+                }
+                t += bench_time() - t1;
+
+                for(i=0;i<SHELL_BENCH_FRAMES;i++) {
+                    if (memcmp(ring_tab[i], ring_tab2[i], sizeof(ring_tab[0])))
+                        err++;
+                    for(k=0;k<8;k++) {
+                        if (ring_tab[i][k >> 1][k & 1] < 0 || 
+                            ring_tab[i][k >> 1][k & 1] >= s->M)
+                            err++;
+                    }
+                }
+                nb++;
+            }
+        }
+        printf("S=%d: %2d rates  %6.3f us -> %6.3f us (x%4.1f) errors=%d\n",
+               S_rates[S], nb, 
+               (float)t_ref / (nb * SHELL_BENCH_FRAMES),
+               (float)t / (nb * SHELL_BENCH_FRAMES),
+               (float)t_ref / t, err);
+    }
+
+    free(ring_tab2);
+    free(ring_tab);
+    free(r0_tab);
+    free(s);
+}
+
+/* mapping frame benchmark: packed frames and block bit I/O against the
+   previous byte per bit frames (kept here as reference) */
+
+#define MAPPING_BENCH_FRAMES 20000
+#define MAPPING_BENCH_WORDS  (MAPPING_BENCH_FRAMES * MAX_MAPPING_FRAME_SIZE / 32 + 2)
+
+/* random bit stream, read by the transmitter and checked by the
+   receiver. Bit k is bit (31 - k % 32) of data[k / 32]. */
+typedef struct {
+    u32 *data;
+    int tx_pos, rx_pos;
+    int errors;
+} MappingBenchStream;
+
+static inline u32 mapping_bench_read(const u32 *data, int pos, int n)
+{
+    u64 v;
+
+    v = ((u64)data[pos >> 5] << 32) | data[(pos >> 5) + 1];
+    return (v >> (64 - (pos & 31) - n)) & ((1ULL << n) - 1);
+}
+
+static int mapping_bench_get_bits(void *opaque, int n)
+{
+    MappingBenchStream *st = opaque;
+    u32 v;
+
+    v = mapping_bench_read(st->data, st->tx_pos, n);
+    st->tx_pos += n;
+    return v;
+}
+
+static int mapping_bench_get_bit(void *opaque)
+{
+    return mapping_bench_get_bits(opaque, 1);
+}
+
+static void mapping_bench_put_bits(void *opaque, int bits, int n)
+{
+    MappingBenchStream *st = opaque;
+
+    if (bits != mapping_bench_read(st->data, st->rx_pos, n))
+        st->errors++;
+    st->rx_pos += n;
+}
+
+static void mapping_bench_put_bit(void *opaque, int bit)
+{
+    mapping_bench_put_bits(opaque, bit, 1);
+}
+
+/* size of the next mapping frame (no aux channel) */
+static int mapping_bench_size(V34DSPState *s)
+{
+    int mp_size;
+
+    mp_size = s->cfg->mp_size[s->mapping_frame];
+    if (++s->mapping_frame == s->P)
+        s->mapping_frame = 0;
+    return mp_size;
+}
+
+/* reference: one scrambled bit per byte */
+static void mapping_ref_encode(V34DSPState *s, int mp_size, 
+                               int m[4][2], u8 I[3][4], int Q[4][2])
+{
+  u8 data[MAX_MAPPING_FRAME_SIZE], *ptr;
+  int i, j, n, r0, t, b;
+
+  for(i=0;i<mp_size;i++) {
+    b = s->get_bit(s->opaque);
+    if (b == -1) b = 1;
+    data[i] = scrambler_bit(&s->scrambler, b);
+  }
+  if (s->b <= 12) {
+    memset(m, 0, 4 * 2 * sizeof(int));
+    for(i=0;i<mp_size;i++) ((u8 *)I)[i] = data[i];
+    for(i=mp_size;i<12;i++) ((u8 *)I)[i] = 0;
+    memset(Q, 0, 4 * 2 * sizeof(int));
+  } else {
+    n = s->K;
+    if (mp_size < s->b) n--;
+    ptr = data;
+    r0 = 0;
+    for(i=0;i<n;i++) r0 |= *ptr++ << i;
+    index_to_rings(s, m, r0);
+    for(j=0;j<4;j++) {
+      I[0][j] = ptr[0];
+      I[1][j] = ptr[1];
+      I[2][j] = ptr[2];
+      ptr += 3;
+      t = 0;
+      for(i=0;i<s->q;i++) t |= *ptr++ << i;
+      Q[j][0] = t;
+      t = 0;
+      for(i=0;i<s->q;i++) t |= *ptr++ << i;
+      Q[j][1] = t;
+    }
+  }
+}
+
+static void mapping_ref_decode(V34DSPState *s, int mp_size,
+                               int m[4][2], u8 I[3][4], int Q[4][2])
+{
+  u8 data[MAX_MAPPING_FRAME_SIZE], *ptr;
+  int i, j, n, r0, t;
+
+  ptr = data;
+  if (s->b <= 12) {
+    for(i=0;i<s->b;i++) *ptr++ = ((u8 *)I)[i];
+  } else {
+    r0 = rings_to_index(s, m);
+    n = s->K;
+    if (mp_size < s->b) n--;
+    for(i=0;i<n;i++) *ptr++ = (r0 >> i) & 1;
+    for(j=0;j<4;j++) {
+      ptr[0] = I[0][j];
+      ptr[1] = I[1][j];
+      ptr[2] = I[2][j];
+      ptr += 3;
+      t=Q[j][0];
+      for(i=0;i<s->q;i++) *ptr++ = (t >> i) & 1;
+      t=Q[j][1];
+      for(i=0;i<s->q;i++) *ptr++ = (t >> i) & 1;
+    }
+  }
+  for(i=0;i<mp_size;i++) 
+    s->put_bit(s->opaque, descrambler_bit(&s->scrambler, data[i]));
+}
+
+/* transmit and receive MAPPING_BENCH_FRAMES mapping frames and return
+   the time in us. The rings, I and Q bits are stored in 'tab'. */
+static s64 mapping_bench_run(V34DSPState *tx, V34DSPState *rx, 
+                             MappingBenchStream *st, int ref, int (*tab)[20])
+{
+    int i, mp_size, m[4][2], Q[4][2];
+    u8 I[3][4];
+    u64 f[MAPPING_FRAME_WORDS];
+    s64 t;
+
+    st->tx_pos = 0;
+    st->rx_pos = 0;
+    st->errors = 0;
+    tx->mapping_frame = rx->mapping_frame = 0;
+    tx->scrambler.hist = 0;
+    rx->scrambler.hist = 0;
+    t = bench_time();
+    for(i=0;i<MAPPING_BENCH_FRAMES;i++) {
+        mp_size = mapping_bench_size(tx);
+        if (ref)
+            mapping_ref_encode(tx, mp_size, m, I, Q);
+        else {
+            get_mapping_frame(tx, f, mp_size, 0);
+            parse_mapping_frame(tx, f, mp_size, m, I, Q);
+        }
+        memcpy(tab[i], m, sizeof(m));
+        memcpy(tab[i] + 8, Q, sizeof(Q));
+        memcpy(tab[i] + 16, I, sizeof(I));
+
+        mp_size = mapping_bench_size(rx);
+        if (ref)
+            mapping_ref_decode(rx, mp_size, m, I, Q);
+        else {
+            build_mapping_frame(rx, f, mp_size, m, I, Q);
+            put_mapping_frame(rx, f, mp_size, 0);
+        }
+    }
+    return bench_time() - t;
+}
+
+void V34_mapping_bench(void)
+{
+    V34DSPState *tx, *rx;
+    V34State p;
+    MappingBenchStream st;
+    int (*tab)[20], (*tab_ref)[20];
+    int R, i, err;
+    s64 t, t_ref;
+
+    tx = malloc(sizeof(*tx));
+    rx = malloc(sizeof(*rx));
+    st.data = malloc(MAPPING_BENCH_WORDS * sizeof(u32));
+    tab = calloc(MAPPING_BENCH_FRAMES, sizeof(tab[0]));
+    tab_ref = calloc(MAPPING_BENCH_FRAMES, sizeof(tab[0]));
+    if (!tx || !rx || !st.data || !tab || !tab_ref) {
+        fprintf(stderr, "V34_mapping_bench: no memory\n");
+        exit(1);
+    }
+    for(i=0;i<MAPPING_BENCH_WORDS;i++)
+        st.data[i] = random() ^ (random() << 16);
+
+    printf("mapping: S=3429, %d mapping frames (tx + rx) per rate,\n"
+           "         Mframes/s for byte per bit frames -> packed frames\n",
+           MAPPING_BENCH_FRAMES);
+    memset(&p, 0, sizeof(p));
+    p.S = V34_S3429;
+    p.conv_nb_states = 16;
+    for(R=2400;R<=33600;R+=2400) {
+        p.R = R;
+        p.calling = 1;
+        memset(tx, 0, sizeof(*tx));
+        V34_init_low(tx, &p, 1);
+        p.calling = 0;
+        memset(rx, 0, sizeof(*rx));
+        V34_init_low(rx, &p, 0);
+        tx->opaque = rx->opaque = &st;
+        tx->get_bit = mapping_bench_get_bit;
+        rx->put_bit = mapping_bench_put_bit;
+        tx->get_bits = NULL;
+        rx->put_bits = NULL;
+
+        t_ref = mapping_bench_run(tx, rx, &st, 1, tab_ref);
+        err = st.errors;
+
+        tx->get_bits = mapping_bench_get_bits;
+        rx->put_bits = mapping_bench_put_bits;
+        t = mapping_bench_run(tx, rx, &st, 0, tab);
+        err += st.errors;
+        for(i=0;i<MAPPING_BENCH_FRAMES;i++) {
+            if (memcmp(tab[i], tab_ref[i], sizeof(tab[0])))
+                err++;
+        }
+        printf("R=%5d b=%2d K=%2d q=%d: %6.2f -> %6.2f Mframes/s errors=%d\n",
+               R, tx->b, tx->K, tx->q,
+               (float)MAPPING_BENCH_FRAMES / t_ref,
+               (float)MAPPING_BENCH_FRAMES / t, err);
+    }
+
+    free(tab_ref);
+    free(tab);
+    free(st.data);
+    free(rx);
+    free(tx);
+}
+
+/* equalizer benchmark: cost per symbol of the update policies against
+   the previous ring buffer equalizer, and convergence in TRN through
+   the simulated line */
+
+#define EQ_BENCH_SYMBOLS 50000
+#define EQ_BENCH_WINDOW  480   /* symbols per MSE measure */
+#define EQ_BENCH_NB_WINDOWS 8
+
+static const struct {
+    int mode, period;
+    const char *name;
+} eq_bench_policies[] = {
+    { EQ_UPDATE_LMS, 1, "LMS" },
+    { EQ_UPDATE_LMS, 4, "LMS 1/4" },
+    { EQ_UPDATE_LMS, 16, "LMS 1/16" },
+    { EQ_UPDATE_SIGN, 1, "sign LMS" },
+    { EQ_UPDATE_SIGN, 4, "sign LMS 1/4" },
+};
+
+static const int eq_bench_fd_taps[] = { 156, 256, 512, 1024 };
+
+#define EQ_BENCH_NB_POLICIES \
+    (sizeof(eq_bench_policies) / sizeof(eq_bench_policies[0]))
+
+/* reference: previous equalizer (ring buffer, update every symbol) */
+static int v34_equalize_ref(V34DSPState *s, 
+                            int *ri_ptr, int *rq_ptr, int spl)
+{
+    int p,q,i;
+    int ri, rq, fi, fq, q_ri, q_rq, ei, eq, ei1, eq1, si, sq;
+    int cosw, sinw, dphi, norm;
+
+    p = s->eq_buf_ptr;
+    s->eq_buf[p] = spl;
+    if (++p == EQ_SIZE)
+        p = 0;
+    s->eq_buf_ptr = p;
+
+    if (s->baud3_phase != 0)
+        return 0;
+
+    ri = rq = 0;
+    q = p;
+    for(i=0;i<EQ_SIZE;i++) {
+        fi = s->eq_filter[i][0] >> 16;
+        fq = s->eq_filter[i][1] >> 16;
+        ri += fi * s->eq_buf[q];
+        rq += fq * s->eq_buf[q];
+        q++;
+        if (q == EQ_SIZE)
+            q = 0;
+    }
+    si = ri >> 14;
+    sq = rq >> 14;
+    
+    cosw = dsp_cos(s->carrier_phase);
+    sinw = - dsp_sin(s->carrier_phase);
+    ri = ( si * cosw - sq * sinw ) >> COS_BITS;
+    rq = ( si * sinw + sq * cosw ) >> COS_BITS;
+    *ri_ptr = ri;
+    *rq_ptr = rq;
+
+    q_ri = ((ri >> 8) * 2 + 1) << 7;
+    q_rq = ((rq >> 8) * 2 + 1) << 7;
+    ei1 = - (ri - q_ri);
+    eq1 = - (rq - q_rq);
+
+    norm = (int) sqrt(ri * ri + rq * rq );
+    if (norm > 0) {
+        dphi = (ri * eq1 - rq * ei1) / norm;
+    } else {
+        dphi = 0;
+    }
+    s->carrier_phase += s->carrier_incr - dphi;
+
+    ei = ( ei1 * cosw + eq1 * sinw ) >> COS_BITS;
+    eq = ( - ei1 * sinw + eq1 * cosw ) >> COS_BITS;
+
+    q = p;
+    for(i=0;i<EQ_SIZE;i++) {
+        int di, dq;
+        di = ei * s->eq_buf[q];
+        dq = eq * s->eq_buf[q];
+        s->eq_filter[i][0] += (di >> s->eq_shift) * 16;
+        s->eq_filter[i][1] += (dq >> s->eq_shift) * 16;
+        q++;
+        if (q == EQ_SIZE)
+            q = 0;
+    }
+    return 1;
+}
+
+/* equalize 'nb' samples and return the time in us. If 'out' is not
+   NULL, the equalized symbols are stored in it. */
+static s64 eq_bench_run(V34DSPState *s, const s16 *samples, int nb,
+                        int *out, int ref)
+{
+    int i, ri, rq, r;
+    s64 t;
+
+    t = bench_time();
+    for(i=0;i<nb;i++) {
+        if (ref)
+            r = v34_equalize_ref(s, &ri, &rq, samples[i]);
+        else
+            r = v34_equalize(s, &ri, &rq, samples[i], s->baud3_phase);
+        if (r && out) {
+            *out++ = ri;
+            *out++ = rq;
+        }
+        if (++s->baud3_phase == EQ_FRAC)
+            s->baud3_phase = 0;
+    }
+    return bench_time() - t;
+}
+
+/* time domain equalizer with 'n' taps: same code as v34_equalize() */
+static s64 eq_bench_td(V34DSPState *s, const s16 *samples, int nb, int n)
+{
+    s32 (*filter)[2];
+    s16 *coef0, *coef1, *buf;
+    const s16 *x;
+    int i, p, ri, rq, ei, eq;
+    s64 t;
+
+    filter = calloc(n, sizeof(filter[0]));
+    coef0 = calloc(n, sizeof(s16));
+    coef1 = calloc(n, sizeof(s16));
+    buf = calloc(2 * n, sizeof(s16));
+    if (!filter || !coef0 || !coef1 || !buf) {
+        fprintf(stderr, "V34_eq_bench: no memory\n");
+        exit(1);
+    }
+    filter[n / 2][0] = 0x4000 << 16;
+    coef0[n / 2] = 0x4000;
+
+    p = 0;
+    t = bench_time();
+    for(i=0;i<nb;i++) {
+        buf[p] = samples[i];
+        buf[p + n] = samples[i];
+        if (++p == n)
+            p = 0;
+        if (s->baud3_phase == 0) {
+            x = buf + p;
+            ri = dsp_dot_prod(coef0, x, n, 0);
+            rq = dsp_dot_prod(coef1, x, n, 0);
+            if (eq_decision(s, ri >> 14, rq >> 14, &ri, &rq, &ei, &eq))
+                dsp_eq_update(filter, coef0, coef1, x, n, ei, eq, s->eq_shift);
+        }
+        if (++s->baud3_phase == EQ_FRAC)
+            s->baud3_phase = 0;
+    }
+    t = bench_time() - t;
+
+    free(buf);
+    free(coef1);
+    free(coef0);
+    free(filter);
+    return t;
+}
+
+/* frequency domain equalizer with 'n' taps */
+static s64 eq_bench_fd(V34DSPState *s, const s16 *samples, int nb, int n)
+{
+    struct sm_arena arena;
+    int i, ri, rq;
+    s64 t;
+
+    if (sm_arena_init(&arena, FDEQ_MAX_TAPS * 128) < 0 ||
+        V34_set_fd_equalizer(s, &arena, n) < 0) {
+        fprintf(stderr, "V34_eq_bench: no memory\n");
+        exit(1);
+    }
+    t = bench_time();
+    for(i=0;i<nb;i++) {
+        v34_fd_equalize(s, &ri, &rq, samples[i], s->baud3_phase);
+        if (++s->baud3_phase == EQ_FRAC)
+            s->baud3_phase = 0;
+    }
+    t = bench_time() - t;
+    s->fd_eq = NULL;
+    sm_arena_free(&arena);
+    return t;
+}
+
+/* run the V34 startup through the line model and return the MSE (dB
+   relative to the TRN4 symbol power) of each window of TRN & J symbols */
+static void eq_bench_link(float *mse_db, int mode, int period, int fd_taps)
+{
+    V34State p;
+    V34DSPState *tx, *rx;
+    V34TestCount count;
+    struct sm_arena arena;
+    struct LineModelState *line;
+    s16 buf[NB_SAMPLES], buf1[NB_SAMPLES], buf2[NB_SAMPLES], buf3[NB_SAMPLES];
+    int n, w, i;
+
+    srandom(0);
+    tx = malloc(sizeof(*tx));
+    rx = malloc(sizeof(*rx));
+    if (!tx || !rx || sm_arena_init(&arena, 64 * 1024 + 
+                                    FDEQ_MAX_TAPS * 128) < 0) {
+        fprintf(stderr, "V34_eq_bench: no memory\n");
+        exit(1);
+    }
+    line = line_model_init(&arena);
+
+    memset(&p, 0, sizeof(p));
+    p.S = V34_S2400;
+    p.R = 19200;
+    p.conv_nb_states = 16;
+    p.use_high_carrier = 1;
+    p.calling = 1;
+    V34_mod_init(tx, &p);
+    tx->get_bit = test_get_bit;
+    p.calling = 0;
+    V34_demod_init(rx, &p);
+    rx->put_bit = test_put_bit;
+    memset(&count, 0, sizeof(count));
+    rx->opaque = &count;
+    rx->eq_update_mode = mode;
+    rx->eq_update_period = period;
+    if (V34_set_fd_equalizer(rx, &arena, fd_taps) < 0) {
+        fprintf(stderr, "V34_eq_bench: no memory\n");
+        exit(1);
+    }
+
+    for(i=0;i<EQ_BENCH_NB_WINDOWS;i++)
+        mse_db[i] = 0;
+    w = -1;
+    /* at most 10 s */
+    for(n = 0; n < 10 * 8000 / NB_SAMPLES && w < EQ_BENCH_NB_WINDOWS; n++) {
+        V34_mod(tx, buf, NB_SAMPLES);
+        memset(buf3, 0, sizeof(buf3));
+        line_model(line, buf1, buf, buf2, buf3, NB_SAMPLES);
+        V34_demod(rx, buf1, NB_SAMPLES);
+
+        /* TRN, then J as nobody answers */
+        if (rx->state != V34_STARTUP3_TRN && rx->state != V34_STARTUP4_MP)
+            continue;
+        if (w < 0) {
+            /* start of the adaptive equalization */
+            w = 0;
+            rx->eq_mse_sum = 0;
+            rx->eq_mse_count = 0;
+        } else if (rx->eq_mse_count >= EQ_BENCH_WINDOW) {
+            mse_db[w++] = 10 * log10((float)rx->eq_mse_sum / 
+                                     (rx->eq_mse_count * 2 * 128 * 128));
+            rx->eq_mse_sum = 0;
+            rx->eq_mse_count = 0;
+        }
+    }
+    sm_arena_free(&arena);
+    free(rx);
+    free(tx);
+}
+
+void V34_eq_bench(void)
+{
+    V34State p;
+    V34DSPState *s0, *s;
+    s16 *samples;
+    int *out, *out_ref;
+    int i, j, nb, err, nb_taps;
+    s64 t, t_ref;
+    float mse_db[EQ_BENCH_NB_POLICIES][EQ_BENCH_NB_WINDOWS];
+
+    nb = EQ_BENCH_SYMBOLS * EQ_FRAC;
+    s0 = malloc(sizeof(*s0));
+    s = malloc(sizeof(*s));
+    samples = malloc(nb * sizeof(s16));
+    out = malloc(EQ_BENCH_SYMBOLS * 2 * sizeof(int));
+    out_ref = malloc(EQ_BENCH_SYMBOLS * 2 * sizeof(int));
+    if (!s0 || !s || !samples || !out || !out_ref) {
+        fprintf(stderr, "V34_eq_bench: no memory\n");
+        exit(1);
+    }
+
+    /* convergence */
+    for(j=0;j<EQ_BENCH_NB_POLICIES;j++) {
+        eq_bench_link(mse_db[j], eq_bench_policies[j].mode,
+                      eq_bench_policies[j].period, 0);
+    }
+
+    /* cost: the samples are the 4 point TRN sequence at the
+       equalizer input level, with some noise */
+    memset(&p, 0, sizeof(p));
+    p.S = V34_S2400;
+    p.R = 19200;
+    p.conv_nb_states = 16;
+    p.use_high_carrier = 1;
+    memset(s0, 0, sizeof(*s0));
+    V34_init_low(s0, &p, 0);
+    s0->eq_shift = 4;
+    for(i=0;i<nb;i++)
+        samples[i] = ((random() & 1) ? 128 : -128) + (random() % 17) - 8;
+
+    *s = *s0;
+    t_ref = eq_bench_run(s, samples, nb, out_ref, 1);
+
+    printf("equalizer: %d taps, S=2400, time per symbol and MSE in TRN through\n"
+           "           the line model (dB, every %d symbols)\n",
+           EQ_SIZE, EQ_BENCH_WINDOW);
+    printf("%-13s %6.3f us\n", "reference", (float)t_ref / EQ_BENCH_SYMBOLS);
+    for(j=0;j<EQ_BENCH_NB_POLICIES;j++) {
+        *s = *s0;
+        s->eq_update_mode = eq_bench_policies[j].mode;
+        s->eq_update_period = eq_bench_policies[j].period;
+        t = eq_bench_run(s, samples, nb, out, 0);
+        err = 0;
+        if (j == 0) {
+            /* same arithmetic as the reference */
+            for(i=0;i<EQ_BENCH_SYMBOLS * 2;i++) {
+                if (out[i] != out_ref[i])
+                    err++;
+            }
+        }
+        printf("%-13s %6.3f us (x%4.1f)", eq_bench_policies[j].name,
+               (float)t / EQ_BENCH_SYMBOLS, (float)t_ref / t);
+        for(i=0;i<EQ_BENCH_NB_WINDOWS;i++)
+            printf(" %5.1f", mse_db[j][i]);
+        if (j == 0)
+            printf("  errors=%d", err);
+        printf("\n");
+    }
+
+    /* frequency domain equalizer against the time domain one with
+       the same number of taps */
+    printf("frequency domain equalizer: time per symbol (time domain, "
+           "frequency domain)\n"
+           "           and MSE in TRN through the line model (dB)\n");
+    for(j=0;j<sizeof(eq_bench_fd_taps)/sizeof(eq_bench_fd_taps[0]);j++) {
+        nb_taps = eq_bench_fd_taps[j];
+        *s = *s0;
+        t_ref = eq_bench_td(s, samples, nb, nb_taps);
+        *s = *s0;
+        t = eq_bench_fd(s, samples, nb, nb_taps);
+        eq_bench_link(mse_db[0], EQ_UPDATE_LMS, 1, nb_taps);
+        printf("%4d taps     %6.3f us %6.3f us (x%4.1f)", nb_taps,
+               (float)t_ref / EQ_BENCH_SYMBOLS, (float)t / EQ_BENCH_SYMBOLS,
+               (float)t_ref / t);
+        for(i=0;i<EQ_BENCH_NB_WINDOWS;i++)
+            printf(" %5.1f", mse_db[0][i]);
+        printf("\n");
+    }
+
+    free(out_ref);
+    free(out);
+    free(samples);
+    free(s);
+    free(s0);
+}
+
+/* receiver regression test: for each symbol rate and carrier, a
+   transmitter is connected to a receiver through the line model (one
+   way only: the events of the remote modem are simulated). In data
+   mode, the receiver is run stage by stage (see V34_rx_stage1()) and
+   each stage is compared to the reference values below:
+
+   - a checksum of its output, so that the first stage which changed
+     is known,
+   - equalizer: SNR of the equalized symbols (distance to the nearest
+     point of the constellation grid),
+   - Viterbi decoder: SNR of its decisions (as in V34_rate_monitor())
+     and bit errors of the decoded mapping frames, compared to the
+     transmitted ones,
+   - descrambler: bit errors of the data & aux channel bits.
+
+   A stage which is not bit exact (e.g. a SIMD or fixed point rewrite
+   of a float computation) is accepted if each measure is within its
+   tolerance RXCHECK_*_TOL of the reference.
+
+   The reference values must be updated (with the printed values)
+   each time the transmitter, the line model or the receiver is
+   modified on purpose. */
+
+#define RXCHECK_NB_SAMPLES 40  /* 5 ms */
+#define RXCHECK_LINE_SNR   40  /* dB */
+#define RXCHECK_TIMEOUT    5   /* maximum training time (s) */
+#define RXCHECK_SECONDS    2   /* in data mode */
+#define RXCHECK_PPM_SECONDS 10 /* in data mode with a clock offset */
+#define RXCHECK_MAX_FRAMES 16  /* mapping frames per block */
+#define RXCHECK_TX_FRAMES  64  /* sent frames not yet decoded */
+
+/* tolerances: SNR loss in dB and added bit errors */
+#define RXCHECK_EQ_TOL     0.5
+#define RXCHECK_SNR_TOL    0.5
+#define RXCHECK_DEC_TOL    0
+#define RXCHECK_BITS_TOL   0
+
+enum {
+    RXCHECK_INPUT,  /* line signal */
+    RXCHECK_FILTER, /* T/3 samples (stage 1) */
+    RXCHECK_EQ,     /* equalized symbols (stage 2) */
+    RXCHECK_FRAME,  /* mapping frames (stage 3) */
+    RXCHECK_BITS,   /* data bits (stage 4) */
+    RXCHECK_NB_SUMS,
+};
+
+static const char *rxcheck_names[RXCHECK_NB_SUMS] = {
+    "input", "filter", "equalizer", "decoder", "bits",
+};
+
+/* each symbol rate with the high carrier and some low carriers. The
+   SNR of the decisions is about 27 dB (see V34_RX_SNR_MAX in
+   v34phase2.c) */
+static const struct {
+    int S, high, R, nb_states, aux;
+    int ppm; /* clock offset of the receiver */
+    u32 sum[RXCHECK_NB_SUMS];
+    float eq_snr;   /* of the equalized symbols, in dB */
+    float snr;      /* of the decisions, in dB */
+    int dec_errors; /* bit errors of the decoded mapping frames */
+    int errors;     /* data bit errors */
+} rxcheck_tests[] = {
+    { V34_S2400, 0, 12000, 16, 0, 0,
+      { 0x3989e836, 0xf901aa04, 0xd088e77c, 0x2cdf0f11, 0x1de19fa5 },
+      26.6, 27.4, 0, 0 },
+    { V34_S2400, 1, 14400, 64, 0, 0,
+      { 0x7e081bc9, 0x1b1ec5c4, 0xdb200acf, 0x6f78dd63, 0xfb589805 },
+      27.0, 27.6, 0, 0 },
+    { V34_S2743, 1, 12000, 16, 0, 0,
+      { 0xff87e6e2, 0xba10e863, 0x79607b26, 0x68ee206f, 0xa034583c },
+      27.1, 28.1, 0, 0 },
+    { V34_S2800, 1,  9600, 32, 0, 0,
+      { 0x1575f819, 0xc38178d9, 0x4b7cc831, 0x8c2a4297, 0xf3997415 },
+      27.0, 27.9, 0, 0 },
+    { V34_S3000, 1, 16800, 64, 0, 0,
+      { 0xc051a8c2, 0x0e01696e, 0xb3adc540, 0xd0a66ada, 0x1f0d67b5 },
+      27.4, 28.1, 0, 0 },
+    { V34_S2743, 1, 12000, 32, 1, 0,
+      { 0xc910218e, 0x2683924c, 0x03ab471f, 0xe42fc967, 0xcdb027bc },
+      27.3, 27.9, 0, 0 },
+    { V34_S3000, 1, 16800, 16, 1, 0,
+      { 0xca9c6955, 0xa9e108e9, 0x3663f4b6, 0xa351270e, 0xf3b8aeae },
+      27.1, 28.3, 0, 0 },
+    { V34_S3000, 0, 16800, 16, 0, 0,
+      { 0x4ccc95e7, 0x99881a0f, 0x89e471b9, 0xd0a66ada, 0x1f0d67b5 },
+      25.8, 26.6, 0, 0 },
+    { V34_S3200, 1, 16800, 16, 0, 0,
+      { 0xdaeae606, 0xc5d2cbb5, 0x8304e08a, 0x687a3f9d, 0xc0d40a85 },
+      23.8, 24.8, 0, 0 },
+    { V34_S3200, 0, 16800, 16, 0, 0,
+      { 0xe5ecdd81, 0xe2d9b6a0, 0x4e8f2a67, 0x687a3f9d, 0xc0d40a85 },
+      25.9, 26.6, 0, 0 },
+    { V34_S3429, 1, 16800, 16, 0, 0,
+      { 0xbbfca8f8, 0x14d2defe, 0xc7761765, 0x5e9c84da, 0xaeb22c2d },
+      25.6, 27.0, 0, 0 },
+    { V34_S3429, 1, 21600, 16, 0, 0,
+      { 0xf2a8d3dc, 0x6d2cf9e5, 0xc30bafe5, 0x732a28d4, 0x822ddcc5 },
+      25.3, 26.5, 0, 0 },
+    /* the timing recovery must track the clock of the transmitter */
+    { V34_S3000, 1, 16800, 16, 0, 200,
+      { 0x39f25832, 0xcbd558ae, 0x6f87f55c, 0x21044d19, 0xf02ecfc5 },
+      25.7, 26.2, 0, 0 },
+    { V34_S3000, 1, 16800, 16, 0, -200,
+      { 0xde80e438, 0x053e478c, 0xfb5df928, 0x996c80ab, 0x74e67444 },
+      25.9, 26.5, 0, 0 },
+};
+
+typedef struct {
+    int connected;
+    int renegotiate; /* S was detected in data mode */
+    u32 sum[RXCHECK_NB_SUMS];
+    s64 time[4];     /* of each stage, in us */
+    double eq_err, eq_pow;
+    float eq_snr, snr;
+    int nb_bits, errors;
+    /* mapping frames sent by the transmitter & not yet decoded */
+    int nb_tx_frames, nb_rx_frames;
+    int tx_mp_size[RXCHECK_TX_FRAMES];
+    u64 tx_frames[RXCHECK_TX_FRAMES][MAPPING_FRAME_WORDS];
+    int dec_bits, dec_errors;
+    int nb_aux_tx, nb_aux, aux_errors; /* aux channel bits */
+    /* mapping frames of the current block */
+    int nb_frames;
+    int mp_size[RXCHECK_MAX_FRAMES], aux[RXCHECK_MAX_FRAMES];
+    u64 frames[RXCHECK_MAX_FRAMES][MAPPING_FRAME_WORDS];
+} RXCheckResult;
+
+static inline u32 rxcheck_sum(u32 sum, int v)
+{
+    sum = v34_table_sum(sum, v);
+    return v34_table_sum(sum, v >> 16);
+}
+
+static void rxcheck_put_bit(void *opaque, int bit)
+{
+    RXCheckResult *r = opaque;
+
+    r->sum[RXCHECK_BITS] = rxcheck_sum(r->sum[RXCHECK_BITS], bit);
+    r->nb_bits++;
+    if (bit != 1)
+        r->errors++;
+}
+
+/* aux channel: one bit out of three is set */
+static int rxcheck_get_aux_bit(void *opaque)
+{
+    RXCheckResult *r = opaque;
+
+    return (r->nb_aux_tx++ % 3) == 0;
+}
+
+static void rxcheck_put_aux_bit(void *opaque, int bit)
+{
+    RXCheckResult *r = opaque;
+
+    r->sum[RXCHECK_BITS] = rxcheck_sum(r->sum[RXCHECK_BITS], bit + 2);
+    if (bit != ((r->nb_aux++ % 3) == 0))
+        r->aux_errors++;
+}
+
+/* mapping frame sent by the transmitter */
+static void rxcheck_tx_frame(void *opaque, const u64 *f, int mp_size, 
+                             int aux)
+{
+    RXCheckResult *r = opaque;
+    int i;
+
+    if (r->nb_tx_frames - r->nb_rx_frames >= RXCHECK_TX_FRAMES) {
+        fprintf(stderr, "V34_rx_check: too many frames not decoded\n");
+        exit(1);
+    }
+    i = r->nb_tx_frames++ % RXCHECK_TX_FRAMES;
+    memcpy(r->tx_frames[i], f, sizeof(r->tx_frames[0]));
+    r->tx_mp_size[i] = mp_size;
+}
+
+static void rxcheck_put_frame(void *opaque, const u64 *f, int mp_size, 
+                              int aux)
+{
+    RXCheckResult *r = opaque;
+    const u64 *tx_f;
+    int pos, n;
+    u32 v;
+
+    /* the k-th decoded frame of the data mode is the k-th sent one */
+    if (r->nb_rx_frames >= r->nb_tx_frames) {
+        fprintf(stderr, "V34_rx_check: frame decoded before being sent\n");
+        exit(1);
+    }
+    tx_f = r->tx_frames[r->nb_rx_frames % RXCHECK_TX_FRAMES];
+    if (r->tx_mp_size[r->nb_rx_frames % RXCHECK_TX_FRAMES] != mp_size)
+        r->dec_errors += mp_size;
+    r->nb_rx_frames++;
+
+    /* the bits after mp_size are not significant */
+    for(pos = 0; pos < mp_size; pos += 16) {
+        n = mp_size - pos;
+        if (n > 16)
+            n = 16;
+        v = frame_get(f, pos, n);
+        r->sum[RXCHECK_FRAME] = rxcheck_sum(r->sum[RXCHECK_FRAME], v);
+        for(v ^= frame_get(tx_f, pos, n); v != 0; v &= v - 1)
+            r->dec_errors++;
+    }
+    r->dec_bits += mp_size;
+    if (r->nb_frames >= RXCHECK_MAX_FRAMES) {
+        fprintf(stderr, "V34_rx_check: too many mapping frames\n");
+        exit(1);
+    }
+    memcpy(r->frames[r->nb_frames], f, sizeof(r->frames[0]));
+    r->mp_size[r->nb_frames] = mp_size;
+    r->aux[r->nb_frames] = aux;
+    r->nb_frames++;
+}
+
+/* data mode: one block through the 4 stages of the receiver */
+static void rxcheck_data(V34DSPState *rx, RXCheckResult *r,
+                         const s16 *samples, int nb)
+{
+    int sym[2 * RXCHECK_NB_SAMPLES][2], eq[2 * RXCHECK_NB_SAMPLES][2];
+    int i, j, e, nb_sym, nb_eq;
+    s64 t;
+
+    t = bench_time();
+    nb_sym = 0;
+    for(i=0;i<nb;i++)
+        nb_sym += V34_rx_stage1(rx, sym + nb_sym, samples[i]);
+    r->time[0] += bench_time() - t;
+
+    t = bench_time();
+    nb_eq = 0;
+    for(i=0;i<nb_sym;i++) {
+        if (V34_rx_stage2(rx, &eq[nb_eq][0], &eq[nb_eq][1],
+                          sym[i][0], sym[i][1]))
+            nb_eq++;
+    }
+    r->time[1] += bench_time() - t;
+
+    r->nb_frames = 0;
+    t = bench_time();
+    for(i=0;i<nb_eq;i++) {
+        if (V34_rx_stage3(rx, eq[i][0], eq[i][1])) {
+            r->renegotiate = 1;
+            nb_eq = i;
+            break;
+        }
+    }
+    r->time[2] += bench_time() - t;
+
+    t = bench_time();
+    for(i=0;i<r->nb_frames;i++)
+        V34_rx_stage4(rx, r->frames[i], r->mp_size[i], r->aux[i]);
+    r->time[3] += bench_time() - t;
+
+    for(i=0;i<nb_sym;i++) {
+        for(j=0;j<2;j++)
+            r->sum[RXCHECK_FILTER] = rxcheck_sum(r->sum[RXCHECK_FILTER],
+                                                 sym[i][j]);
+    }
+    for(i=0;i<nb_eq;i++) {
+        for(j=0;j<2;j++) {
+            r->sum[RXCHECK_EQ] = rxcheck_sum(r->sum[RXCHECK_EQ], eq[i][j]);
+            /* the points are the odd multiples of 128 (see
+               tcm_decision()) */
+            e = eq[i][j] - (((eq[i][j] >> 8) << 8) + 128);
+            r->eq_err += (double)e * e;
+            r->eq_pow += (double)eq[i][j] * eq[i][j];
+        }
+    }
+}
+
+static void rxcheck_run(RXCheckResult *r, int S, int high, int R,
+                        int nb_states, int aux, int ppm)
+{
+    V34State p;
+    V34DSPState *tx, *rx;
+    struct sm_arena arena;
+    struct LineModelState *line;
+    s16 buf[RXCHECK_NB_SAMPLES], buf1[RXCHECK_NB_SAMPLES];
+    s16 buf2[RXCHECK_NB_SAMPLES], buf3[RXCHECK_NB_SAMPLES];
+    int n, n_end, i;
+
+    memset(r, 0, sizeof(*r));
+    for(i=0;i<RXCHECK_NB_SUMS;i++)
+        r->sum[i] = V34_TABLE_SUM_INIT;
+    tx = malloc(sizeof(*tx));
+    rx = malloc(sizeof(*rx));
+    if (!tx || !rx || sm_arena_init(&arena, 64 * 1024) < 0) {
+        fprintf(stderr, "V34_rx_check: no memory\n");
+        exit(1);
+    }
+    line = line_model_init(&arena);
+    line_model_set_snr(line, RXCHECK_LINE_SNR);
+    line_model_set_clock_offset(line, ppm);
+
+    memset(&p, 0, sizeof(p));
+    p.S = S;
+    p.R = R;
+    p.conv_nb_states = nb_states;
+    p.use_high_carrier = high;
+    p.use_aux_channel = aux;
+    p.calling = 1;
+    V34_mod_init(tx, &p);
+    tx->get_bit = test_get_bit;
+    tx->get_aux_bit = rxcheck_get_aux_bit;
+    tx->opaque = r;
+    tx->put_frame = rxcheck_tx_frame;
+    tx->frame_opaque = r;
+    tx->max_R = R;
+    tx->mp_R[0] = R;
+    tx->mp_R[1] = R;
+    tx->remote_R = R;
+    tx->remote_aux = aux;
+    p.calling = 0;
+    V34_demod_init(rx, &p);
+    rx->max_R = R;
+    rx->put_bit = rxcheck_put_bit;
+    rx->put_aux_bit = rxcheck_put_aux_bit;
+    rx->opaque = r;
+    rx->put_frame = rxcheck_put_frame;
+    rx->frame_opaque = r;
+
+    memset(buf3, 0, sizeof(buf3));
+    n_end = (RXCHECK_TIMEOUT * 8000) / RXCHECK_NB_SAMPLES;
+    for(n = 0; n < n_end; n++) {
+        V34_mod(tx, buf, RXCHECK_NB_SAMPLES);
+        line_model(line, buf1, buf, buf2, buf3, RXCHECK_NB_SAMPLES);
+
+        if (rx->state != V34_DATA) {
+            V34_demod(rx, buf1, RXCHECK_NB_SAMPLES);
+            /* the remote modem: its S follows our J and it
+               acknowledges our MP at once */
+            if (rx->J_received) {
+                rx->J_received = 0;
+                tx->S_received = 1;
+                tx->J_received = 1;
+            }
+            if (rx->MP_received) {
+                rx->MP_received = 0;
+                tx->MP_received = 1;
+            }
+            if (rx->MP_ack_received) {
+                rx->MP_ack_received = 0;
+                tx->MP_ack_received = 1;
+            }
+            if (rx->state == V34_DATA) {
+                r->connected = 1;
+                n_end = n + 1 + 
+                    ((ppm ? RXCHECK_PPM_SECONDS : RXCHECK_SECONDS) * 8000) /
+                    RXCHECK_NB_SAMPLES;
+            }
+            continue;
+        }
+
+        for(i=0;i<RXCHECK_NB_SAMPLES;i++)
+            r->sum[RXCHECK_INPUT] = rxcheck_sum(r->sum[RXCHECK_INPUT],
+                                                buf1[i]);
+        rxcheck_data(rx, r, buf1, RXCHECK_NB_SAMPLES);
+        if (r->renegotiate)
+            break;
+    }
+
+    /* same measure as V34_rate_monitor() */
+    if (rx->rate_mse_cnt > 0)
+        r->snr = 10 * log10(V34_data_power(rx) * 256.0 * rx->rate_mse_cnt /
+                            (rx->rate_mse + 1));
+    if (r->eq_err > 0)
+        r->eq_snr = 10 * log10(r->eq_pow / r->eq_err);
+    sm_arena_free(&arena);
+    free(rx);
+    free(tx);
+}
+
+static const char *rxcheck_status(int fail)
+{
+    return fail ? "  FAILED" : "";
+}
+
+void V34_rx_check(void)
+{
+    RXCheckResult r;
+    int i, j, k, fail, nb_fail, eq_fail, dec_fail, bits_fail;
+    float scale;
+
+    printf("rxcheck: V34 receiver regression test, line SNR=%d dB, "
+           "%d s in data mode\n"
+           "         CPU time of each stage (us per second of signal)\n",
+           RXCHECK_LINE_SNR, RXCHECK_SECONDS);
+    nb_fail = 0;
+    for(i=0;i<sizeof(rxcheck_tests)/sizeof(rxcheck_tests[0]);i++) {
+        rxcheck_run(&r, rxcheck_tests[i].S, rxcheck_tests[i].high,
+                    rxcheck_tests[i].R, rxcheck_tests[i].nb_states,
+                    rxcheck_tests[i].aux, rxcheck_tests[i].ppm);
+        printf("S=%d high=%d R=%5d%s %2d states: ", rxcheck_tests[i].S,
+               rxcheck_tests[i].high, rxcheck_tests[i].R,
+               rxcheck_tests[i].aux ? "+aux" : "    ",
+               rxcheck_tests[i].nb_states);
+        if (rxcheck_tests[i].ppm)
+            printf("%+d ppm, %d s: ", rxcheck_tests[i].ppm, 
+                   RXCHECK_PPM_SECONDS);
+        if (!r.connected || r.renegotiate) {
+            printf("FAILED (%s)\n",
+                   r.connected ? "S detected in data mode" : "no connection");
+            nb_fail++;
+            continue;
+        }
+        scale = 1.0 / RXCHECK_SECONDS;
+        printf("filter=%5.0f eq=%5.0f decoder=%5.0f bits=%5.0f\n",
+               r.time[0] * scale, r.time[1] * scale,
+               r.time[2] * scale, r.time[3] * scale);
+
+        /* each stage against its reference */
+        eq_fail = (r.eq_snr < rxcheck_tests[i].eq_snr - RXCHECK_EQ_TOL);
+        dec_fail = (r.snr < rxcheck_tests[i].snr - RXCHECK_SNR_TOL ||
+                    r.dec_errors > rxcheck_tests[i].dec_errors + RXCHECK_DEC_TOL);
+        bits_fail = (r.errors > rxcheck_tests[i].errors + RXCHECK_BITS_TOL ||
+                     (rxcheck_tests[i].aux && 
+                      (r.aux_errors || r.nb_aux == 0)));
+        printf("  equalizer: SNR=%4.1f dB (ref %4.1f)%s\n",
+               r.eq_snr, rxcheck_tests[i].eq_snr, rxcheck_status(eq_fail));
+        printf("  decoder:   SNR=%4.1f dB (ref %4.1f) errors=%d/%d (ref %d)%s\n",
+               r.snr, rxcheck_tests[i].snr, r.dec_errors, r.dec_bits,
+               rxcheck_tests[i].dec_errors, rxcheck_status(dec_fail));
+        printf("  bits:      errors=%d/%d (ref %d)",
+               r.errors, r.nb_bits, rxcheck_tests[i].errors);
+        if (rxcheck_tests[i].aux)
+            printf(" aux errors=%d/%d", r.aux_errors, r.nb_aux);
+        printf("%s\n", rxcheck_status(bits_fail));
+        fail = eq_fail || dec_fail || bits_fail;
+        if (fail)
+            nb_fail++;
+
+        /* the first stage which is not bit exact */
+        for(j=0;j<RXCHECK_NB_SUMS;j++) {
+            if (r.sum[j] != rxcheck_tests[i].sum[j])
+                break;
+        }
+        if (j == RXCHECK_NB_SUMS && !fail)
+            continue;
+        if (j < RXCHECK_NB_SUMS)
+            printf("  stage '%s' is not bit exact\n", rxcheck_names[j]);
+        printf("  new reference: { 0x%08x", r.sum[0]);
+        for(k=1;k<RXCHECK_NB_SUMS;k++)
+            printf(", 0x%08x", r.sum[k]);
+        printf(" },\n      %0.1f, %0.1f, %d, %d\n", 
+               r.eq_snr, r.snr, r.dec_errors, r.errors);
+    }
+    if (nb_fail) {
+        printf("rxcheck: %d tests FAILED\n", nb_fail);
+        exit(1);
+    }
+    printf("rxcheck: ok\n");
+}
+
+/* run the test 'i' of the regression test and return in 'sum' the
+   checksum of the received bits (used by the thread test). Return -1
+   if there is no such test or if the modems are not connected */
+int V34_rx_check_run(int i, u32 *sum)
+{
+    RXCheckResult r;
+
+    if (i < 0 || i >= sizeof(rxcheck_tests)/sizeof(rxcheck_tests[0]))
+        return -1;
+    rxcheck_run(&r, rxcheck_tests[i].S, rxcheck_tests[i].high,
+                rxcheck_tests[i].R, rxcheck_tests[i].nb_states,
+                rxcheck_tests[i].aux, rxcheck_tests[i].ppm);
+    *sum = r.sum[RXCHECK_BITS];
+    if (!r.connected || r.renegotiate)
+        return -1;
+    return 0;
 }
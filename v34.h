@@ -3,16 +3,28 @@
 
 #include "v34priv.h"
 
-/* should be called once to init some V34 static tables */
+/* should be called once to init some V34 static tables, before any
+   V34 state is created (the tables are then only read) */
 void V34_static_init(void);
 
 struct V34State; 
 
-void V34_init(struct V34State *s, int calling);
+void V34_init(struct V34State *s, int calling, 
+              get_bit_func get_bit, put_bit_func put_bit, void *opaque);
 int V34_process(struct V34State *s, s16 *output, s16 *input, int nb_samples);
 
-/* V34 half duplex test with line simulator */
+/* V34 full duplex test with line simulator */
 void V34_test(void);
+/* Viterbi decoder benchmark */
+void V34_bench(void);
+void V34_shell_bench(void);
+void V34_mapping_bench(void);
+void V34_setup_bench(void);
+void V34_eq_bench(void);
+/* pipelined receiver benchmark */
+void V34_pipeline_bench(void);
+void V34_rx_check(void);
+int V34_rx_check_run(int i, u32 *sum);
 
 #endif
 
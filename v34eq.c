@@ -144,8 +144,6 @@ static s16 cos12[12] = { 16384, 14188, 8192, 0, -8192, -14188,
                          -16384, -14188, -8192, 0, 8192, 14188 };
 
 
-static icomplex tabtmp[48];
-
 /* Init some constants for the equalizer. May be moved to v34gen.c if
    it is too complicated */
 void V34eq_init(void)
@@ -203,7 +201,6 @@ void V34eq_init(void)
 #else
         a = tabPP[i];
 #endif
-        tabtmp[i] = a;
         tab1[i].re = a.re / 16384.0 / sqrt(48);
         tab1[i].im = a.im / 16384.0 / sqrt(48);
         carrier -= 2 * M_PI * 1920.0 / 3200.0;
@@ -436,71 +433,210 @@ void V34_fast_equalize1(V34DSPState *s, s16 *input)
     (a).im=((b).im*(c).re+(b).re*(c).im);\
 }
 
+/* band of the received signal in the baseband spectrum of the PP
+   window: +-24 bins with the roll-off of 10 % */
+#define PP_BAND 26
+
+/* The PP window is periodic in baseband, but not on the carrier when
+   48 * carrier / S is not an integer (e.g. 3/5 or 4/7 of S). So the
+   window is translated to baseband, where the bin k contains the PP
+   bin (k mod 48) (and the image of the negative frequencies, which
+   is outside the band). */
 void V34_fast_equalize(V34DSPState *s, s16 *input)
 {
-    complex tab[144], tab1[144];
+    complex tab[FFT23_SIZE], tab1[FFT23_SIZE];
     complex a, b, c;
-    float norm, d;
-    int i;
+    float norm, w, vmax, v;
+    int i, j, k, shift;
 
+    w = 2 * M_PI * s->carrier_freq / (EQ_FRAC * s->symbol_rate);
     for(i=0;i<FFT23_SIZE;i++) {
-        tab1[i].re = input[i];
-        tab1[i].im = 0;
+        tab1[i].re = input[i] * cos(w * i);
+        tab1[i].im = - input[i] * sin(w * i);
     }
 
-    slow_fft(tab, tab1, 144, 0);
-
-    for(i=0;i<24;i++) {
-        c.re = tabPP_fft[i].re / FRAC;
-        c.im = tabPP_fft[i].im / FRAC;
-
-        b = tab[i];
-        norm = b.re * b.re + b.im * b.im;
-        b = tab[i+ 48];
-        norm += b.re * b.re + b.im * b.im;
-        c.re = (c.re) / norm;
-        c.im = (c.im) / norm;
-        
-        b.re = tab[i].re;
-        b.im = - tab[i].im;
-        CMUL(a, c, b);
-        tab1[i] = a;
-        
-        b.re = tab[48 + i].re;
-        b.im = - tab[48 + i].im;
-        CMUL(a, c, b);
-        tab1[48 + i] = a;
-    }
+    slow_fft(tab, tab1, FFT23_SIZE, 0);
 
-    for(i=24;i<48;i++) {
-        c.re = tabPP_fft[i].re / FRAC;
-        c.im = tabPP_fft[i].im / FRAC;
-        b = tab[i];
-        norm = b.re * b.re + b.im * b.im;
-        c.re = (c.re) / norm;
-        c.im = (c.im) / norm;
-        
+    memset(tab1, 0, sizeof(tab1));
+    for(k=-PP_BAND;k<=PP_BAND;k++) {
+        /* the bins k and k +- 48 contain the same PP bin */
+        norm = 0;
+        for(j=k-V34_PP_SIZE;j<=k+V34_PP_SIZE;j+=V34_PP_SIZE) {
+            if (j >= -PP_BAND && j <= PP_BAND) {
+                b = tab[(j + FFT23_SIZE) % FFT23_SIZE];
+                norm += b.re * b.re + b.im * b.im;
+            }
+        }
+        if (norm == 0)
+            continue;
+        i = (k + FFT23_SIZE) % FFT23_SIZE;
+        j = (k + V34_PP_SIZE) % V34_PP_SIZE;
+        c.re = tabPP_fft[j].re / FRAC / norm;
+        c.im = tabPP_fft[j].im / FRAC / norm;
         b.re = tab[i].re;
         b.im = - tab[i].im;
         CMUL(a, c, b);
         tab1[i] = a;
     }
-    
-    for(i=FFT23_SIZE/2;i<FFT23_SIZE;i++) {
-        tab1[i].re = 0;
-        tab1[i].im = 0;
-    }
 
+#ifdef DEBUG
     for(i=0;i<FFT23_SIZE;i++) {
         printf("%3d: %7.4f %7.4f\n", 
                i, tab[i].re / FRAC, tab[i].im / FRAC);
     }
+#endif
 
-    slow_fft(tab, tab1, 144, 1);
+    slow_fft(tab, tab1, FFT23_SIZE, 1);
 
-    
+    /* PP is periodic, so the delay is only known modulo 48 symbols:
+       center the impulse response in the equalizer (the shift is a
+       multiple of the symbol period) */
+    vmax = 0;
+    j = 0;
     for(i=0;i<FFT23_SIZE;i++) {
-        s->eq_filter[i][0] = (int)(tab[i].re * FRAC * FRAC / 12) << 16;
-        s->eq_filter[i][1] = (int)(tab[i].im * FRAC * FRAC / 12) << 16;
+        v = tab[i].re * tab[i].re + tab[i].im * tab[i].im;
+        if (v > vmax) {
+            vmax = v;
+            j = i;
+        }
+    }
+    shift = (FFT23_SIZE / 2 - j) / EQ_FRAC * EQ_FRAC;
+
+    /* the symbols are sqrt(48) * PP / 16384: scale them to the power
+       of TRN (2 * 128 * 128) */
+    norm = 128.0 * sqrt(2.0 / V34_PP_SIZE);
+
+    /* back to the carrier. The most recent sample is multiplied by
+       eq_filter[EQ_SIZE-1], so the impulse response is stored in
+       reverse order */
+    memset(s->eq_filter, 0, sizeof(s->eq_filter));
+    for(i=0;i<FFT23_SIZE;i++) {
+        b = tab[(i - shift + FFT23_SIZE) % FFT23_SIZE];
+        c.re = cos(w * i) * norm;
+        c.im = sin(w * i) * norm;
+        CMUL(a, b, c);
+        s->eq_filter[EQ_SIZE - 1 - i][0] = (int)(a.re * 0x4000) << 16;
+        s->eq_filter[EQ_SIZE - 1 - i][1] = (int)(a.im * 0x4000) << 16;
+    }
+}
+
+/* Frequency domain equalizer. The filter has nb_taps complex
+   coefficients applied to the real input samples. Each block of M new
+   samples is filtered with the previous block by an FFT of size 2M
+   (overlap-save). The block LMS gradient is the correlation of the
+   errors with the input, also computed with FFTs, and its taps beyond
+   nb_taps are removed before the update (constrained FLMS). */
+
+/* same step as the time domain LMS: 16 / 2^30 */
+#define FDEQ_MU (1.0 / (1 << 26))
+
+int V34_fd_eq_init(V34FDEq *e, struct sm_arena *arena, int nb_taps)
+{
+    int n;
+
+    if (nb_taps < 1 || nb_taps > FDEQ_MAX_TAPS)
+        return -1;
+    n = 2;
+    while (n < 2 * nb_taps)
+        n <<= 1;
+    e->nb_taps = nb_taps;
+    e->block = n / 2;
+    e->ptr = 0;
+    e->mu = FDEQ_MU;
+    if (fft_plan_init(&e->fft, arena, n) < 0)
+        return -1;
+    e->x = sm_arena_alloc(arena, n * sizeof(float));
+    e->sym = sm_arena_alloc(arena, e->block);
+    e->W = sm_arena_alloc(arena, n * sizeof(complex));
+    e->X = sm_arena_alloc(arena, n * sizeof(complex));
+    e->y = sm_arena_alloc(arena, n * sizeof(complex));
+    e->out_size = e->block / EQ_FRAC + 2;
+    e->out = sm_arena_alloc(arena, e->out_size * sizeof(e->out[0]));
+    if (!e->x || !e->sym || !e->W || !e->X || !e->y || !e->out)
+        return -1;
+    e->out_rptr = 0;
+    e->out_count = 0;
+    return 0;
+}
+
+/* load a time domain filter in the eq_filter format (16.16, the most
+   recent sample is multiplied by filter[n-1]) */
+void V34_fd_eq_set_filter(V34FDEq *e, s32 (*filter)[2], int n)
+{
+    int k;
+
+    memset(e->W, 0, e->fft.n * sizeof(complex));
+    for(k=0;k<n && k<e->nb_taps;k++) {
+        e->W[k].re = filter[n - 1 - k][0] * (1.0 / (1 << 30));
+        e->W[k].im = filter[n - 1 - k][1] * (1.0 / (1 << 30));
+    }
+    fft_plan_calc(&e->fft, e->W, 0);
+}
+
+/* filter the current block: e->y[i] is the output for e->x[M + i] */
+void V34_fd_eq_filter(V34FDEq *e)
+{
+    int i, n, m;
+    float norm;
+    complex *X = e->X, *y = e->y, *W = e->W;
+
+    n = e->fft.n;
+    m = e->block;
+    for(i=0;i<n;i++) {
+        X[i].re = e->x[i];
+        X[i].im = 0;
+    }
+    /* XXX: the input is real, a half size FFT would be enough */
+    fft_plan_calc(&e->fft, X, 0);
+    for(i=0;i<n;i++) {
+        y[i].re = X[i].re * W[i].re - X[i].im * W[i].im;
+        y[i].im = X[i].im * W[i].re + X[i].re * W[i].im;
+    }
+    fft_plan_calc(&e->fft, y, 1);
+    norm = 1.0 / n;
+    for(i=0;i<m;i++) {
+        y[i].re = y[m + i].re * norm;
+        y[i].im = y[m + i].im * norm;
+    }
+}
+
+/* update the filter with the errors e->y[i] of the block (zero
+   outside the symbol instants). e->X must be the spectrum computed by
+   V34_fd_eq_filter(). */
+void V34_fd_eq_update(V34FDEq *e)
+{
+    int i, n, m;
+    float re, norm;
+    complex *X = e->X, *y = e->y, *W = e->W;
+
+    n = e->fft.n;
+    m = e->block;
+    for(i=m-1;i>=0;i--) {
+        y[m + i] = y[i];
+        y[i].re = 0;
+        y[i].im = 0;
+    }
+    fft_plan_calc(&e->fft, y, 0);
+    for(i=0;i<n;i++) {
+        re = X[i].re * y[i].re + X[i].im * y[i].im;
+        y[i].im = X[i].re * y[i].im - X[i].im * y[i].re;
+        y[i].re = re;
+    }
+    fft_plan_calc(&e->fft, y, 1);
+
+    /* gradient constraint */
+    norm = e->mu / n;
+    for(i=0;i<e->nb_taps;i++) {
+        y[i].re *= norm;
+        y[i].im *= norm;
+    }
+    for(;i<n;i++) {
+        y[i].re = 0;
+        y[i].im = 0;
+    }
+    fft_plan_calc(&e->fft, y, 0);
+    for(i=0;i<n;i++) {
+        W[i].re += y[i].re;
+        W[i].im += y[i].im;
     }
 }
@@ -9,17 +9,15 @@
  */
 #include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
 #include <math.h>
 #include <assert.h>
 
 #include "dsp.h"
+#include "v34table.h"
 
-#define V34_SAMPLE_RATE_NUM 10
-#define V34_SAMPLE_RATE_DEN 3
-#define V34_SAMPLE_RATE ((2400*V34_SAMPLE_RATE_NUM)/V34_SAMPLE_RATE_DEN)
-#define V22_TX_FILTER_SIZE (20 * 40)
-
-#define RC_FILTER_SIZE 40
+/* checksum of all the printed tables */
+static u32 table_sum = V34_TABLE_SUM_INIT;
 
 void find_data_rot(int *data_ptr, int *rot_ptr, int x0, int y0)
 {
@@ -67,11 +65,12 @@ int classify(int x[2][2])
 void gen_table(int nb_trans)
 {
     int Y[5],Yt[5], trans, ss[2][3], xx[2][2];
-    int res, i, y0;
+    int res, i, y0, n;
 
     printf("u8 trellis_trans_%d[256][4] = {\n",
            nb_trans);
     
+    n = 0;
     for(y0=0;y0<2;y0++) {
 
     for(trans=0;trans<nb_trans;trans++) {
@@ -135,33 +134,31 @@ void gen_table(int nb_trans)
                    xx[0][1],
                    xx[1][0],
                    xx[1][1]);
+            for(i=0;i<4;i++)
+                table_sum = v34_table_sum(table_sum, xx[i >> 1][i & 1]);
+            n++;
         }
     }
 
     }
     }
     printf("};\n");
+    /* the rest of the table is zero */
+    for(i=n*4;i<256*4;i++)
+        table_sum = v34_table_sum(table_sum, 0);
 }
 
 static u8 S_tab[6][8] = {
-  /* a, c, d1, e1, d2, e2, J, P */
-    { 1, 1, 2, 3, 3, 4, 7, 12, }, /* S=2400 */
-    { 8, 7, 3, 5, 2, 3, 8, 12, }, /* S=2743 */
-    { 7, 6, 3, 5, 2, 3, 7, 14, }, /* S=2800 */
-    { 5, 4, 3, 5, 2, 3, 7, 15, }, /* S=3000 */
-    { 4, 3, 4, 7, 3, 5, 7, 16, }, /* S=3200 */
-    {10, 7, 4, 7, 4, 7, 8, 15, }, /* S=3429 */
+#define SYMBOL_RATE(a, c, d1, e1, d2, e2, J, P, a1, c1) \
+    { a, c, d1, e1, d2, e2, J, P },
+    V34_SYMBOL_RATES
+#undef SYMBOL_RATE
 };
 
-/* this table depends on the sample rate. We have S=a1/c1 * V34_SAMPLE_RATE */
 static u8 baud_tab[6][2] = {
-    /* a1, c1 */
-    { 3, 10 },
-    { 12, 35 },
-    { 7, 20 },
-    { 3, 8 },
-    { 2, 5 },
-    { 3, 7 },
+#define SYMBOL_RATE(a, c, d1, e1, d2, e2, J, P, a1, c1) { a1, c1 },
+    V34_SYMBOL_RATES
+#undef SYMBOL_RATE
 };
 
 #define FFT_SIZE 2048
@@ -217,24 +214,157 @@ void build_sqr_nyquist_filter(float *filter,
 
 void write_filter(char *name, float *filter, int n)
 {
-    int i;
+    int i, v;
 
     printf("s16 %s[%d]=\n{\n", 
            name, n);
     for(i=0;i<n;i++) {
-        printf("%6d, ", (int)(filter[i] * 0x4000));
+        v = (int)(filter[i] * 0x4000);
+        printf("%6d, ", v);
         if ((i % 8) == 7) 
             printf("\n");
+        table_sum = v34_table_sum(table_sum, v);
     }
     printf("\n};\n");
 }
 
+/* write the coefficients p + j * step (j < taps) of 'filter', padded
+   with zeros to 'stride' */
+void write_poly_row(float *filter, int n, int p, int step, 
+                    int taps, int stride)
+{
+    int j, k, v;
+
+    for(j=0;j<stride;j++) {
+        k = p + j * step;
+        v = 0;
+        if (j < taps) {
+            assert(k < n);
+            v = (int)(filter[k] * 0x4000);
+        }
+        printf("%6d, ", v);
+        if ((j % 8) == 7) 
+            printf("\n");
+        table_sum = v34_table_sum(table_sum, v);
+    }
+}
+
+/* write the filter in polyphase layout: 'nb_phases' rows of 'taps'
+   coefficients taken every 'step', padded to 'stride' */
+void write_poly_filter(char *name, float *filter, int n,
+                       int nb_phases, int step, int taps, int stride)
+{
+    int p;
+
+    printf("s16 %s[%d] __attribute__((aligned(16))) =\n{\n", 
+           name, nb_phases * stride);
+    for(p=0;p<nb_phases;p++) {
+        printf(" /* phase %d */\n", p);
+        write_poly_row(filter, n, p, step, taps, stride);
+    }
+    printf("};\n");
+}
+
+/* rx filters which convert the 8000 Hz flow to (symbol_rate * 3)
+   with a nyquist filter */
+void gen_rx_filter(char *name, int S, int high)
+{
+    float filter[FFT_SIZE];
+    float symbol_rate, carrier, alpha, beta, freq;
+    int n, a1, c1;
+    char buf[64];
+
+    a1 = baud_tab[S][0];
+    c1 = baud_tab[S][1];
+    symbol_rate = 2400.0 * (float)S_tab[S][0] / (float)S_tab[S][1];
+    carrier = symbol_rate * 
+        (float)S_tab[S][2 + 2*high] / (float)S_tab[S][3 + 2*high];
+    
+    alpha = symbol_rate / (2.0 * symbol_rate * 3.0 * c1);
+    beta = 0.1;
+    freq = carrier / (symbol_rate * 3.0 * c1);
+    n = RC_FILTER_SIZE * c1 + 1;
+
+    printf("/* S=%d carrier=%d alpha=%f beta=%f f0=%f */\n", 
+           (int)rint(symbol_rate), 
+           (int)rint(carrier), 
+           alpha, beta, freq);
+
+    /* the name given in v34table.h must match */
+    sprintf(buf, "v34_rx_filter_%d_%d", 
+            (int)rint(symbol_rate), (int)rint(carrier));
+    assert(!strcmp(buf, name));
+
+    build_sqr_nyquist_filter(filter, freq, alpha, beta, n);
+    write_poly_filter(name, filter, n, V34_RX_FILTER_PHASES(a1), 3 * a1,
+                      V34_RX_FILTER_TAPS(a1, c1), 
+                      V34_RX_FILTER_STRIDE(a1, c1));
+}
+
+/* V22 rx filters: the baseband nyquist filter is shifted to the
+   carrier (positive frequencies only). Its gain is 2 on each phase so
+   that the complex output has the amplitude of the received carrier */
+void gen_v22_rx_filter(char *name, int carrier)
+{
+    float filter[FFT_SIZE], re[FFT_SIZE], im[FFT_SIZE];
+    float alpha, norm, a;
+    int n, i, p;
+    char buf[64];
+
+    sprintf(buf, "v22_rx_filter_%d", carrier);
+    assert(!strcmp(buf, name));
+
+    n = V22_RX_FILTER_TAPS * V22_RX_UPSAMPLE + 1;
+    alpha = 600.0 / (2.0 * 8000.0 * V22_RX_UPSAMPLE);
+    build_sqr_nyquist_filter(filter, 0.0, alpha, 0.75, n);
+
+    norm = 0;
+    for(i=0;i<n;i++)
+        norm += filter[i];
+    norm = 2.0 * V22_RX_UPSAMPLE / norm;
+
+    for(i=0;i<n;i++) {
+        a = 2 * M_PI * carrier * (i - (n - 1) / 2) / 
+            (8000.0 * V22_RX_UPSAMPLE);
+        re[i] = filter[i] * norm * cos(a);
+        im[i] = - filter[i] * norm * sin(a);
+    }
+
+    printf("/* V22 rx carrier=%d alpha=%f beta=%f */\n", 
+           carrier, alpha, 0.75);
+    printf("s16 %s[%d] __attribute__((aligned(16))) =\n{\n", 
+           name, V22_RX_FILTER_SIZE);
+    for(p=0;p<V22_RX_FILTER_PHASES;p++) {
+        printf(" /* phase %d */\n", p);
+        write_poly_row(re, n, p, V22_RX_UPSAMPLE, 
+                       V22_RX_FILTER_TAPS, V22_RX_FILTER_STRIDE);
+        write_poly_row(im, n, p, V22_RX_UPSAMPLE, 
+                       V22_RX_FILTER_TAPS, V22_RX_FILTER_STRIDE);
+    }
+    printf("};\n");
+}
+
+/* tx filters */
+void gen_tx_filter(char *name, int c1, int S)
+{
+    float filter[FFT_SIZE];
+    float alpha, beta;
+    int n;
+
+    assert(baud_tab[S][1] == c1);
+
+    alpha = 1.0 / (2.0 * baud_tab[S][1]);
+    beta = 0.1;
+    n = RC_FILTER_SIZE * baud_tab[S][1] + 1;
+    
+    build_sqr_nyquist_filter(filter, 0.0, alpha, beta, n);
+    write_filter(name, filter, n);
+}
+
 
 int main(int argc, char **argv)
 {
-    int i, j, n;
     float filter[FFT_SIZE];
-    char buf[512];
 
     printf("/* THIS SOURCE CODE IS AUTOMATICALLY GENERATED - DO NOT MODIFY */\n");
     printf("/*\n"
@@ -251,63 +381,20 @@ int main(int argc, char **argv)
            "#include \"v34priv.h\"\n"
            "\n");
 
-    /* tables for trellis coded modulation */
-    gen_table(4);
-    gen_table(8);
-    gen_table(16);
-
-    /* rx filters which convert the 8000 Hz flow to (symbol_rate * 3)
-       with a nyquist filter */
-
-    for(j=0;j<6;j++) {
-        float symbol_rate, carrier, alpha, beta, freq;
-
-        symbol_rate = 2400.0 * 
-            (float)S_tab[j][0] / (float)S_tab[j][1];
-        
-        for(i=0;i<2;i++) {
-            if (i == 1 &&
-                S_tab[j][2] == S_tab[j][4] &&
-                S_tab[j][3] == S_tab[j][5])
-                break;
-
-            carrier = symbol_rate * 
-                (float)S_tab[j][2 + 2*i] / (float)S_tab[j][3 + 2*i];
-            
-            alpha = symbol_rate / (2.0 * symbol_rate * 3.0 * baud_tab[j][1]);
-            beta = 0.1;
-            freq = carrier / (symbol_rate * 3.0 * baud_tab[j][1]);
-            n = RC_FILTER_SIZE * baud_tab[j][1] + 1;
-
-            printf("/* S=%d carrier=%d alpha=%f beta=%f f0=%f */\n", 
-                   (int)rint(symbol_rate), 
-                   (int)rint(carrier), 
-                   alpha, beta, freq);
-
-            build_sqr_nyquist_filter(filter, freq, alpha, beta, n);
-            
-            sprintf(buf, "v34_rx_filter_%d_%d", 
-                    (int)rint(symbol_rate),
-                    (int)rint(carrier));
-
-            write_filter(buf, filter, n);
-        }
-    }
+    /* the tables are printed in the order of v34table.h */
 
-    /* tx filters */
+    /* tables for trellis coded modulation */
+#define TRELLIS(n) gen_table(n);
+    V34_TRELLIS_TABLES
+#undef TRELLIS
 
-    for(j=0;j<6;j++) {
-        float alpha, beta;
+#define RX_FILTER(name, S, high) gen_rx_filter("v34_rx_filter_" #name, S, high);
+    V34_RX_FILTERS
+#undef RX_FILTER
 
-        alpha = 1.0 / (2.0 * baud_tab[j][1]);
-        beta = 0.1;
-        n = RC_FILTER_SIZE * baud_tab[j][1] + 1;
-        
-        build_sqr_nyquist_filter(filter, 0.0, alpha, beta, n);
-
-        sprintf(buf, "v34_rc_%d_filter", baud_tab[j][1]);
-        write_filter(buf, filter, n);
-    }
+#define TX_FILTER(c1, S) gen_tx_filter("v34_rc_" #c1 "_filter", c1, S);
+    V34_TX_FILTERS
+#undef TX_FILTER
 
     /* V22 filters */
 
@@ -317,5 +404,12 @@ int main(int argc, char **argv)
     
     write_filter("v22_tx_filter", filter, V22_TX_FILTER_SIZE);
 
+#define V22_RX_FILTER(carrier) \
+    gen_v22_rx_filter("v22_rx_filter_" #carrier, carrier);
+    V22_RX_FILTERS
+#undef V22_RX_FILTER
+
+    printf("\nconst int v34_table_version = %d;\n", V34_TABLE_VERSION);
+    printf("const u32 v34_table_checksum = 0x%08x;\n", table_sum);
     return 0;
 }
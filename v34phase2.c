@@ -1,158 +1,571 @@
-/* 
+/*
  * Implementation of the V34 phase 2
- * 
+ *
  * Copyright (c) 1999,2000 Fabrice Bellard.
  *
  * This code is released under the GNU General Public License version
  * 2. Please read the file COPYING to know the exact terms of the
  * license.
- * 
+ *
  * This implementation is totally clean room. It was written by
  * reading the V34 specification and by using basic signal processing
- * knowledge.  
+ * knowledge.
  */
 #include "lm.h"
 #include "v34priv.h"
 
 #define DEBUG
 
+/*
+ * Simplified phase 2 (there is no INFO0 and no DPSK receiver):
+ *
+ * - the caller sends L1 & L2 and the answer modem measures the SNR of
+ *   the call to answer direction.
+ *
+ * - the answer modem sends L1 & L2 and the caller measures the SNR of
+ *   the answer to call direction.
+ *
+ * - the caller sends INFO1c with the projected data rate of each
+ *   symbol rate until it receives INFO1a. The answer modem chooses
+ *   the symbol rate of both directions and sends INFO1a twice. The
+ *   INFO sequences are sent with V21 instead of DPSK.
+ *
+ * A standard V34 modem cannot train with it, so V34 is not in the
+ * default modulations of lm.c (the line simulator enables it).
+ */
+
 #define INFO_SYNC 0x72
+#define INFO1C_SIZE 109
+#define INFO1A_SIZE 70
+#define INFO_PREAMBLE 16 /* marks sent before the first INFO sequence */
+
+/* durations, in samples */
+#define P2_GUARD    (100 * 8) /* silence before L1 & ignored echo after L2 */
+#define L1_LENGTH   (160 * 8)
+#define L2_LENGTH   (640 * 8)
+#define PROBE_SKIP  (L1_LENGTH + 20 * 8) /* L1 & the start of L2 */
+#define PROBE_END   (L1_LENGTH + L2_LENGTH + 20 * 8)
+#define PROBE_BLOCKS 24
+/* silence of the remote modem before phase 3. The caller waits
+   longer so that the answer modem listens when S is sent. */
+#define P2_QUIET_CAL (80 * 8)
+#define P2_QUIET_ANS (40 * 8)
+
+/* the remote modem transmits if the leaky average of x^2/256 is
+   higher than the nominal L2 power minus 12 dB. XXX: absolute level */
+#define P2_POW_SHIFT 6
+#define P2_POW_ON    (1 << 15)
+
+/* L1 & L2 are the sum of 25 tones at multiples of 150 Hz (some are
+   omitted). The phases are 0 or 180 degrees. */
+static const s8 L_tones[V34_PROBE_TONES] = {
+    /* 150 */  1,-1, 1, 1,
+    /* 750 */  1, 0, 1, 0,
+    /*1350 */  1, 1,-1, 0,
+    /*1950 */  1, 1,-1, 0,
+    /*2550 */  1,-1, 1,-1,
+    /*3150 */ -1,-1,-1, 1,
+    /*3750 */  1 };
+
+/* amplitude of each tone: the rms value of L2 is about the rms value
+   of the training sequences */
+#define L_TONE_AMP 3575
+
+/* the SNR of a data signal of bandwidth W which has the power of L2,
+   relative to the SNR of a tone in its DFT bin, is L_SNR_SCALE / W */
+#define L_SNR_SCALE (21.0 * 2.0 * 4000.0 / V34_PROBE_N)
 
-/* send the v34 info0 sequence */
-void V34_send_info0(V34State *s, int ack)
+/* receiver: symbol rates we can receive (with both carriers) */
+static const u8 rx_symbol_rates[V34_NB_S] = { 1, 1, 1, 1, 1, 1 };
+
+/* SNR gap to the capacity of the trellis coded & shaped constellation
+   with our equalizer (about 8 dB) */
+#define V34_SNR_GAP 6.3
+
+/* the receiver adds noise (equalizer, timing jitter & residual
+   echo): the SNR of the decisions does not exceed about 27 dB */
+#define V34_RX_SNR_MAX 500.0
+
+/* data rate limits for each symbol rate */
+static const int rate_limits[V34_NB_S][2] = {
+    { 2400, 21600 },
+    { 4800, 26400 },
+    { 4800, 26400 },
+    { 4800, 28800 },
+    { 4800, 31200 },
+    { 4800, 28800 }, /* XXX: 31200 & 33600 have errors even at 37 dB */
+};
+
+/* highest usable data rate for the symbol rate 'S' with the SNR 'snr'
+   of the decisions. The minimum rate is returned if the SNR is too
+   low. */
+int V34_max_rate(int S, float snr)
 {
-    u8 buf[48], *p, *q;
-    int crc;
+    float W;
+    int R;
+
+    V34_get_freqs(S, 1, &W, NULL);
+    if (snr < 0)
+        snr = 0;
+    R = (int)(W * log(1.0 + snr / V34_SNR_GAP) / log(2.0));
+    R = (R / 2400) * 2400;
+    if (R < rate_limits[S][0])
+        R = rate_limits[S][0];
+    else if (R > rate_limits[S][1])
+        R = rate_limits[S][1];
+    /* the constellation of the highest rates of some symbol rates is
+       too big (e.g. 28800 bit/s at 3000 bauds) */
+    while (R > rate_limits[S][0] && 
+           (!V34_rate_valid(S, R, 0, 0) || !V34_rate_valid(S, R, 0, 1)))
+        R -= 2400;
+    return R;
+}
+
+/* highest data rate the symbol rate 'S' can carry (the rate given by
+   the transmitter in MP) */
+int V34_highest_rate(int S)
+{
+    int R;
+
+    R = rate_limits[S][1];
+    while (R > rate_limits[S][0] && 
+           (!V34_rate_valid(S, R, 0, 0) || !V34_rate_valid(S, R, 0, 1)))
+        R -= 2400;
+    return R;
+}
+
+/* sample 'n' of L2 (L1 is 6 dB higher) */
+static int L_sample(int n)
+{
+    int i, v;
 
-    p = buf;
-    put_bits(&p, 4, 0xf); /* fill bits */
-    put_bits(&p, 8, INFO_SYNC); /* sync word */
-    
-    put_bits(&p, 1, 1); /* symbol rate 2743 supported ? */
-    put_bits(&p, 1, 1); /* symbol rate 2800 supported ? */
-    put_bits(&p, 1, 1); /* symbol rate 3429 supported ? */
-    put_bits(&p, 1, 1); /* symbol rate 3000, low carrier supported ? */
-    put_bits(&p, 1, 1); /* symbol rate 3000, high carrier supported ? */
-    put_bits(&p, 1, 1); /* symbol rate 3200, low carrier supported ? */
-    put_bits(&p, 1, 1); /* symbol rate 3200, high carrier supported ? */
-    
-    put_bits(&p, 1, 1); /* symbol rate 3429 disallowed ? */
-    put_bits(&p, 1, 1); /* can power reduce ? */
-    put_bits(&p, 3, 5); /* difference between emit & receive sym rate */
-    put_bits(&p, 1, 0); /* from CME modem ? */
-    put_bits(&p, 1, 0); /* reserved by ITU */
-    put_bits(&p, 2, 0); /* tx clock source: 0=internal */
-    put_bits(&p, 1, ack); /* ack reception */
-
-    /* crc */
-    crc = calc_crc(buf + 12, p - (buf + 12));
-    put_bits(&p, 16, crc);
-
-    put_bits(&p, 4, 0xf); /* fill bits */
-
-    for(q=buf;q<p;q++) {
-        put_sym(s, buf[i], 0);
+    v = 0;
+    for(i=0;i<V34_PROBE_TONES;i++) {
+        if (L_tones[i])
+            v += L_tones[i] * dsp_cos((((3 * (i + 1) * n) % V34_PROBE_N) *
+                                       PHASE_BASE) / V34_PROBE_N);
     }
+    return (v * L_TONE_AMP) >> COS_BITS;
 }
 
-/* send the v34 info1c sequence */
-void V34_send_info1c(V34State *s)
+static void probe_init(V34Probe *p)
 {
-    u8 buf[109], *p;
-    int crc;
-    
-    p = buf;
+    memset(p, 0, sizeof(V34Probe));
+}
 
-    put_bits(&p, 4, 0xf); /* fill bits */
-    put_bits(&p, 8, INFO_SYNC); /* sync word */
+/* accumulate the power of the tone bins and of their neighbours (the
+   noise) for one period of L2 */
+static void probe_block(V34Probe *p)
+{
+    int i, k, n, ph;
+    float re, im;
 
-    put_bits(&p, 3, 1); /* minimum power reduction (XXX) */
-    put_bits(&p, 3, 1); /* additional power reduction (XXX) */
-    put_bits(&p, 7, 0); /* length of MD sequence (35 ms incr) */
+    for(i=0;i<V34_PROBE_TONES;i++) {
+        for(k=3*(i+1)-1;k<=3*(i+1)+1;k++) {
+            re = im = 0;
+            for(n=0;n<V34_PROBE_N;n++) {
+                ph = (((k * n) % V34_PROBE_N) * PHASE_BASE) / V34_PROBE_N;
+                re += p->buf[n] * dsp_cos(ph);
+                im += p->buf[n] * dsp_cos(ph - PHASE_BASE / 4);
+            }
+            p->pow[k] += re * re + im * im;
+        }
+    }
+    p->nb_blocks++;
+}
 
-    for(i=0;i<6;i++) {
-        /* for each symbol speed (increasing order) */
-        put_bits(&p, 1, 0); /* use high carrier ? (XXX) */
-        put_bits(&p, 4, 0); /* pre emphasis filter (XXX) */
-        put_bits(&p, 4, 12); /* projected data rate (XXX) */
+/* SNR of each tone. The omitted tones are interpolated. */
+static void probe_analyse(V34Probe *p)
+{
+    int i, k;
+    float sig, noise;
+
+    for(i=0;i<V34_PROBE_TONES;i++) {
+        if (!L_tones[i])
+            continue;
+        k = 3 * (i + 1);
+        noise = 0.5 * (p->pow[k - 1] + p->pow[k + 1]);
+        sig = p->pow[k] - noise;
+        if (sig <= 0)
+            p->snr[i] = 0;
+        else if (noise < sig * 1e-6)
+            p->snr[i] = 1e6;
+        else
+            p->snr[i] = sig / noise;
+    }
+    /* the omitted tones are not at the ends of the band */
+    for(i=0;i<V34_PROBE_TONES;i++) {
+        if (!L_tones[i])
+            p->snr[i] = 0.5 * (p->snr[i - 1] + p->snr[i + 1]);
     }
+}
 
-    put_bits(&p, 10, 0); /* frequency offset (XXX) */
+/* projected SNR of the decisions with the symbol rate 'S' and the
+   carrier 'use_high_carrier': the SNR of a linear equalizer is the
+   harmonic mean of 1 + SNR over the band */
+static float probe_snr(V34Probe *p, int S, int use_high_carrier)
+{
+    float W, fc, f, snr, sum;
+    int i, n;
 
-    /* crc */
-    crc = calc_crc(buf + 12, p - (buf + 12));
-    put_bits(&p, 16, crc);
+    V34_get_freqs(S, use_high_carrier, &W, &fc);
+    sum = 0;
+    n = 0;
+    for(i=0;i<V34_PROBE_TONES;i++) {
+        f = 150.0 * (i + 1);
+        if (f < fc - W / 2 || f > fc + W / 2)
+            continue;
+        snr = p->snr[i] * L_SNR_SCALE / W;
+        sum += 1.0 / (1.0 + snr);
+        n++;
+    }
+    if (n == 0)
+        return 0;
+    snr = n / sum - 1.0;
+    if (snr <= 0)
+        return 0;
+    return 1.0 / (1.0 / snr + 1.0 / V34_RX_SNR_MAX);
+}
+
+/* compute the projected data rate of each symbol rate we can receive
+   (0 if not supported) with the carrier which gives the best SNR */
+static void probe_select(V34State *s)
+{
+    float snr_low, snr_high;
+    int S;
+
+    probe_analyse(&s->probe);
+    for(S=0;S<V34_NB_S;S++) {
+        s->probe_high_carrier[S] = 1;
+        s->probe_R[S] = 0;
+        if (!rx_symbol_rates[S])
+            continue;
+        snr_low = probe_snr(&s->probe, S, 0);
+        snr_high = probe_snr(&s->probe, S, 1);
+        if (snr_low > snr_high) {
+            s->probe_high_carrier[S] = 0;
+            snr_high = snr_low;
+        }
+        s->probe_R[S] = V34_max_rate(S, snr_high);
+#ifdef DEBUG
+        printf("%s: probe S=%d high=%d R=%d\n",
+               s->calling ? "cal" : "ans", S, 
+               s->probe_high_carrier[S], s->probe_R[S]);
+#endif
+    }
+}
+
+/* highest projected data rate of 'R' (the lowest symbol rate is
+   chosen if several ones give the same rate) */
+static int best_symbol_rate(const int *R)
+{
+    int S, best;
 
-    put_bits(&p, 4, 0xf); /* fill bits */
+    best = V34_S2400;
+    for(S=0;S<V34_NB_S;S++) {
+        if (R[S] > R[best])
+            best = S;
+    }
+    return best;
 }
 
-/* send the v34 info1a sequence */
-void V34_send_info1a(V34State *s)
+/* INFO1 sequences */
+
+static void info_start(V34State *s)
+{
+    s->info_ptr = -INFO_PREAMBLE;
+    s->info_count = 0;
+}
+
+static void info_build_header(u8 **pp)
+{
+    put_bits(pp, 4, 0xf); /* fill bits */
+    put_bits(pp, 8, INFO_SYNC); /* sync word */
+    put_bits(pp, 3, 0); /* minimum power reduction */
+    put_bits(pp, 3, 0); /* additional power reduction */
+    put_bits(pp, 7, 0); /* length of MD sequence (35 ms incr) */
+}
+
+static void info_build_end(V34State *s, u8 **pp)
 {
-    u8 buf[70], *p;
     int crc;
-    
-    p = buf;
 
-    put_bits(&p, 4, 0xf); /* fill bits */
-    put_bits(&p, 8, INFO_SYNC); /* sync word */
+    crc = calc_crc(s->info_buf + 12, *pp - (s->info_buf + 12));
+    put_bits(pp, 16, crc);
+    put_bits(pp, 4, 0xf); /* fill bits */
+    s->info_size = *pp - s->info_buf;
+}
 
-    put_bits(&p, 3, 1); /* minimum power reduction (XXX) */
-    put_bits(&p, 3, 1); /* additional power reduction (XXX) */
-    put_bits(&p, 7, 0); /* length of MD sequence (35 ms incr) */
+/* INFO1c: the projected data rate of each symbol rate (answer to call
+   direction) */
+static void info1c_build(V34State *s)
+{
+    u8 *p;
+    int S;
 
-    put_bits(&p, 1, 0); /* high carrier used (XXX) */
-    put_bits(&p, 4, 0); /* pre emphasis filter (XXX) */
-    put_bits(&p, 4, 12); /* proj max data rate (XXX) */
-    
-    put_bits(&p, 3, 4); /* sym rate ans->cal (XXX : 3200) */
-    put_bits(&p, 3, 4); /* sym rate cal->ans (XXX : 3200) */
-    
-    put_bits(&p, 10, 0); /* frequency offset (XXX) */
+    p = s->info_buf;
+    info_build_header(&p);
+    for(S=0;S<V34_NB_S;S++) {
+        put_bits(&p, 1, s->probe_high_carrier[S]); /* use high carrier */
+        put_bits(&p, 4, 0); /* pre emphasis filter */
+        put_bits(&p, 4, s->probe_R[S] / 2400); /* projected data rate */
+    }
+    put_bits(&p, 10, 0); /* frequency offset */
+    info_build_end(s, &p);
+}
 
-    /* crc */
-    crc = calc_crc(buf + 12, p - (buf + 12));
-    put_bits(&p, 16, crc);
+/* INFO1a: the symbol rates of both directions and the parameters of
+   the call to answer direction */
+static void info1a_build(V34State *s)
+{
+    u8 *p;
 
-    put_bits(&p, 4, 0xf); /* fill bits */
+    p = s->info_buf;
+    info_build_header(&p);
+    put_bits(&p, 1, s->high_carrier_rx); /* high carrier used */
+    put_bits(&p, 4, 0); /* pre emphasis filter */
+    put_bits(&p, 4, s->R_rx / 2400); /* projected max data rate */
+    put_bits(&p, 3, s->S_tx); /* symbol rate ans->cal */
+    put_bits(&p, 3, s->S_rx); /* symbol rate cal->ans */
+    put_bits(&p, 10, 0); /* frequency offset */
+    info_build_end(s, &p);
 }
 
+static int get_bits(const u8 **pp, int n)
+{
+    const u8 *p;
+    int v;
+
+    p = *pp;
+    v = 0;
+    while (n-- > 0)
+        v = (v << 1) | *p++;
+    *pp = p;
+    return v;
+}
 
-void V34_send_L1(V34State *s, int rep)
+/* the answer modem chooses the symbol rates */
+static void info1c_parse(V34State *s)
 {
-    static char ph[25] = {
-        /* 150 */  1,-1, 1, 1,
-        /* 750 */  1, 0, 1, 0,
-        /*1350 */  1, 1,-1, 0,
-        /*1950 */  1, 1,-1, 0,
-        /*2550 */  1,-1, 1,-1,
-        /*3150 */ -1,-1,-1, 1,
-        /*3750 */  1 };
+    const u8 *p;
+    int S, R[V34_NB_S], high_carrier[V34_NB_S];
 
-    for(n=0;n<rep;n++) {
-        for(i=0;i<25;i++) {
-            if (ph[i]) {
-                put_sym(s, i * 150 + 150, ph[i]);
-            }
-        }
+    p = s->info_rx_buf + 25;
+    for(S=0;S<V34_NB_S;S++) {
+        high_carrier[S] = get_bits(&p, 1);
+        get_bits(&p, 4);
+        R[S] = get_bits(&p, 4) * 2400;
     }
+    s->S_tx = best_symbol_rate(R);
+    s->high_carrier_tx = high_carrier[s->S_tx];
+    s->R_tx = R[s->S_tx];
+
+    s->S_rx = best_symbol_rate(s->probe_R);
+    s->high_carrier_rx = s->probe_high_carrier[s->S_rx];
+    s->R_rx = s->probe_R[s->S_rx];
 }
 
+static void info1a_parse(V34State *s)
+{
+    const u8 *p;
+
+    p = s->info_rx_buf + 25;
+    s->high_carrier_tx = get_bits(&p, 1);
+    get_bits(&p, 4);
+    s->R_tx = get_bits(&p, 4) * 2400;
+    s->S_rx = get_bits(&p, 3);
+    s->S_tx = get_bits(&p, 3);
+
+    s->high_carrier_rx = s->probe_high_carrier[s->S_rx];
+    s->R_rx = s->probe_R[s->S_rx];
+}
 
-int V34P2_process(V34State *s, s16 *output, s16 *input, int nb_samples)
+static int info_get_bit(void *opaque)
 {
-    /* modulation */
-    switch(s->state) {
-    case V34_P2_INFO0_SEND:
-        V34_send_info0(
-        
-    }
-    
-    /* demodulation */
-    switch(s->state) {
-    case V34_P2_INFO0_SEND:
-        
-        
+    V34State *s = opaque;
+
+    if (s->info_ptr < 0) {
+        s->info_ptr++;
+        return 1;
     }
+    if (s->info_ptr >= s->info_size)
+        return 1;
+    return s->info_buf[s->info_ptr++];
+}
+
+/* the caller receives INFO1a and the answer modem INFO1c. The last
+   bits are kept so that a false sync word cannot hide the real one:
+   the sync word & the CRC are tested at each bit. */
+static void info_put_bit(void *opaque, int bit)
+{
+    V34State *s = opaque;
+    int size, sync, crc, i;
+
+    if (s->info_received)
+        return;
+    size = (s->calling ? INFO1A_SIZE : INFO1C_SIZE) - 4;
+    memmove(s->info_rx_buf, s->info_rx_buf + 1, size - 1);
+    s->info_rx_buf[size - 1] = bit;
+    if (s->info_rx_ptr < size)
+        s->info_rx_ptr++;
+    if (s->info_rx_ptr < size)
+        return;
+    sync = 0;
+    for(i=0;i<12;i++)
+        sync = (sync << 1) | s->info_rx_buf[i];
+    if (sync != ((0xf << 8) | INFO_SYNC))
+        return;
+    crc = 0;
+    for(i=size-16;i<size;i++)
+        crc = (crc << 1) | s->info_rx_buf[i];
+    if (crc != calc_crc(s->info_rx_buf + 12, size - 16 - 12))
+        return;
+    if (s->calling)
+        info1a_parse(s);
+    else
+        info1c_parse(s);
+    s->info_received = 1;
+#ifdef DEBUG
+    printf("%s: INFO1%c: tx: S=%d high=%d R=%d  rx: S=%d high=%d R=%d\n",
+           s->calling ? "cal" : "ans", s->calling ? 'a' : 'c',
+           s->S_tx, s->high_carrier_tx, s->R_tx,
+           s->S_rx, s->high_carrier_rx, s->R_rx);
+#endif
+}
+
+void V34_phase2_init(V34State *s)
+{
+    /* the caller probes after the answer modem */
+    if (s->calling)
+        s->p2_state = V34_P2_SEND_L;
+    else
+        s->p2_state = V34_P2_WAIT_L;
+    s->p2_count = 0;
+    s->p2_pow = 0;
+    probe_init(&s->probe);
+    V21_init(&s->info, s->calling, info_get_bit, info_put_bit, s);
+    s->info_ptr = 0;
+    s->info_size = 0;
+    s->info_received = 0;
+    s->info_rx_ptr = 0;
+}
+
+static void p2_set_state(V34State *s, int state)
+{
+    s->p2_state = state;
+    s->p2_count = 0;
 }
 
+void V34_phase2(V34State *s, s16 *output, const s16 *input, int nb_samples)
+{
+    int i, x, v;
+
+    /* INFO1 sequences */
+    switch(s->p2_state) {
+    case V34_P2_SEND_INFO1C:
+        V21_process(&s->info, output, (s16 *)input, nb_samples);
+        if (s->info_ptr >= s->info_size)
+            s->info_ptr = 0;
+        if (s->info_received) {
+            /* the rest of the INFO1a sequences is ignored */
+            p2_set_state(s, V34_P2_WAIT_END);
+        }
+        return;
+    case V34_P2_WAIT_INFO1C:
+        FSK_demod(&s->info.rx, input, nb_samples);
+        memset(output, 0, nb_samples * sizeof(s16));
+        if (s->info_received) {
+            info1a_build(s);
+            info_start(s);
+            p2_set_state(s, V34_P2_SEND_INFO1A);
+        }
+        return;
+    case V34_P2_SEND_INFO1A:
+        FSK_mod(&s->info.tx, output, nb_samples);
+        if (s->info_ptr >= s->info_size) {
+            if (++s->info_count == 2)
+                p2_set_state(s, V34_P2_WAIT_END);
+            else
+                s->info_ptr = 0;
+        }
+        return;
+    }
+
+    for(i=0;i<nb_samples;i++) {
+        x = input[i];
+        s->p2_pow += (((x * x) >> 8) - s->p2_pow) >> P2_POW_SHIFT;
+        v = 0;
+
+        switch(s->p2_state) {
+        case V34_P2_SEND_L:
+            if (s->p2_count < P2_GUARD) {
+                v = 0;
+            } else if (s->p2_count < P2_GUARD + L1_LENGTH) {
+                v = 2 * L_sample((s->p2_count - P2_GUARD) % V34_PROBE_N);
+                if (v > 32767)
+                    v = 32767;
+                else if (v < -32768)
+                    v = -32768;
+            } else if (s->p2_count < P2_GUARD + L1_LENGTH + L2_LENGTH) {
+                v = L_sample((s->p2_count - P2_GUARD) % V34_PROBE_N);
+            } else {
+                if (s->calling) {
+                    p2_set_state(s, V34_P2_WAIT_L);
+                } else {
+                    p2_set_state(s, V34_P2_WAIT_INFO1C);
+                }
+                break;
+            }
+            s->p2_count++;
+            break;
+
+        case V34_P2_WAIT_L:
+            /* the caller ignores the echo of its L2. The answer modem
+               waits for the silence before L1: the end of phase 1 may
+               still be on the line */
+            if (s->p2_count < (s->calling ? P2_GUARD : P2_GUARD / 2)) {
+                if (s->p2_pow > P2_POW_ON && !s->calling)
+                    s->p2_count = 0;
+                else
+                    s->p2_count++;
+            } else if (s->p2_pow > P2_POW_ON) {
+                probe_init(&s->probe);
+                p2_set_state(s, V34_P2_PROBE);
+            }
+            break;
+
+        case V34_P2_PROBE:
+            if (s->p2_count >= PROBE_SKIP &&
+                s->probe.nb_blocks < PROBE_BLOCKS) {
+                s->probe.buf[s->probe.buf_ptr++] = x;
+                if (s->probe.buf_ptr == V34_PROBE_N) {
+                    s->probe.buf_ptr = 0;
+                    probe_block(&s->probe);
+                }
+            }
+            if (++s->p2_count >= PROBE_END) {
+                probe_select(s);
+                if (s->calling) {
+                    info1c_build(s);
+                    info_start(s);
+                    p2_set_state(s, V34_P2_SEND_INFO1C);
+                    /* the rest of the block is silent */
+                    memset(output + i, 0, (nb_samples - i) * sizeof(s16));
+                    return;
+                } else {
+                    p2_set_state(s, V34_P2_SEND_L);
+                }
+            }
+            break;
+
+        case V34_P2_WAIT_END:
+            if (s->p2_pow > P2_POW_ON)
+                s->p2_count = 0;
+            else if (++s->p2_count >= 
+                     (s->calling ? P2_QUIET_CAL : P2_QUIET_ANS))
+                p2_set_state(s, V34_P2_DONE);
+            break;
+        }
+        output[i] = v;
+    }
+}
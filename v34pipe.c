@@ -0,0 +1,695 @@
+/*
+ * Pipelined V34 receiver
+ *
+ * Copyright (c) 2000 Fabrice Bellard.
+ *
+ * This code is released under the GNU General Public License version
+ * 2. Please read the file COPYING to know the exact terms of the
+ * license.
+ */
+#include <pthread.h>
+#include <stdatomic.h>
+#include <unistd.h>
+
+#include "lm.h"
+#include "v34priv.h"
+
+/* In data mode, the receiver can be split into 4 stages connected by
+   bounded single producer / single consumer queues, so that a heavy
+   receiver uses several CPUs:
+
+   1. AGC, matched filter & timing recovery (caller thread)
+   2. equalizer & carrier tracking
+   3. S detection, Viterbi decoder, precoder & mapping frame decoding
+   4. aux channel & descrambler
+
+   Each block of samples is followed by an end marker. The caller
+   does not wait for the block it just gave: it outputs the bits of
+   the previous block, so the stages 2 to 4 run while the caller does
+   its other work (transmitter, other modems) and the output is
+   delayed by exactly one block. The data bits are given back to the
+   caller through a queue, so put_bit() and put_bits() are only
+   called by the caller thread.
+
+   The results are the same as with V34_demod() except after a rate
+   renegotiation: the stages 1 and 2 stay in data mode until the end
+   of the block following the one where S was detected. The rate
+   monitor also sees the MSE one block later. */
+
+#define PIPE_BLOCK 256  /* maximum number of samples in a block */
+#define PIPE_SPIN  4000 /* polls of a queue before sleeping (SMP only) */
+
+enum {
+    PIPE_DATA,
+    PIPE_AUX,  /* aux channel bit (stage 4 -> caller) */
+    PIPE_END,  /* end of block */
+    PIPE_QUIT, /* end of the threads */
+};
+
+/* T/3 sample and its phase (stage 1 -> 2) or symbol (stage 2 -> 3) */
+typedef struct {
+    int type;
+    int v[2];
+} PipeSym;
+
+/* given by stage 3 with the end marker of each block */
+typedef struct {
+    int data_left;          /* S was detected */
+    int rate_mse, rate_mse_cnt; /* MSE sum of the block (see V34_rate_monitor()) */
+} PipeEnd;
+
+/* mapping frame (stage 3 -> 4) */
+typedef struct {
+    int type;
+    int mp_size, aux;
+    u64 f[MAPPING_FRAME_WORDS];
+    PipeEnd end;
+} PipeFrame;
+
+/* descrambled bits (stage 4 -> caller) */
+typedef struct {
+    int type;
+    int n;
+    u32 bits;
+    PipeEnd end;
+} PipeBits;
+
+typedef struct {
+    u8 *buf;
+    int elem_size;
+    unsigned int size; /* number of elements, power of two */
+    int spin;          /* number of polls before sleeping */
+    atomic_uint wptr, rptr;
+    atomic_int sleeping; /* the consumer or the producer waits on 'cond' */
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+} PipeQueue;
+
+struct V34Pipeline {
+    V34DSPState *s;
+    int allocated; /* true if the memory was taken from the heap */
+    PipeQueue q2, q3, q4, qout; /* input of each stage & output bits */
+    pthread_t thread[3];
+    /* bit output of the receiver, replaced by the queue while the
+       stages run */
+    int running;
+    put_bit_func put_bit;
+    put_bits_func put_bits;
+    put_bit_func put_aux_bit;
+    void *opaque;
+    /* a block is in the stages */
+    int pending;
+    s64 pending_time;
+    /* MSE sums given by stage 3, read by the rate monitor */
+    int rate_mse, rate_mse_cnt;
+    /* set by stage 3 when S is detected: the following symbols are
+       stored for V34_rx_stage3_end() (at most two blocks) */
+    int data_left;
+    int nb_left;
+    int left[2 * PIPE_BLOCK][2];
+    /* statistics */
+    int nb_blocks;
+    s64 total_time, max_time;
+};
+
+static int queue_init(PipeQueue *q, struct sm_arena *a, 
+                      int elem_size, int size, int spin)
+{
+    q->buf = sm_arena_alloc(a, elem_size * size);
+    if (!q->buf)
+        return -1;
+    q->elem_size = elem_size;
+    q->size = size;
+    q->spin = spin;
+    atomic_init(&q->wptr, 0);
+    atomic_init(&q->rptr, 0);
+    atomic_init(&q->sleeping, 0);
+    pthread_mutex_init(&q->lock, NULL);
+    pthread_cond_init(&q->cond, NULL);
+    return 0;
+}
+
+static void queue_free(PipeQueue *q, int allocated)
+{
+    pthread_cond_destroy(&q->cond);
+    pthread_mutex_destroy(&q->lock);
+    if (allocated)
+        free(q->buf);
+}
+
+/* true if the producer ('full' = 1) or the consumer can go on */
+static inline int queue_ready(PipeQueue *q, int full)
+{
+    unsigned int n;
+
+    n = atomic_load(&q->wptr) - atomic_load(&q->rptr);
+    return full ? (n < q->size) : (n != 0);
+}
+
+/* the queues are short and the stages are fast, so we poll before
+   sleeping. 'sleeping' is set before testing the queue again and
+   the other side tests it after modifying the queue, so no wake up
+   is lost. */
+static void queue_wait(PipeQueue *q, int full)
+{
+    int i;
+
+    for(i=0;i<q->spin;i++) {
+        if (queue_ready(q, full))
+            return;
+    }
+    pthread_mutex_lock(&q->lock);
+    atomic_store(&q->sleeping, 1);
+    while (!queue_ready(q, full))
+        pthread_cond_wait(&q->cond, &q->lock);
+    atomic_store(&q->sleeping, 0);
+    pthread_mutex_unlock(&q->lock);
+}
+
+static inline void queue_wake(PipeQueue *q)
+{
+    if (atomic_load(&q->sleeping)) {
+        pthread_mutex_lock(&q->lock);
+        pthread_cond_broadcast(&q->cond);
+        pthread_mutex_unlock(&q->lock);
+    }
+}
+
+static void queue_push(PipeQueue *q, const void *elem)
+{
+    unsigned int w;
+
+    w = atomic_load_explicit(&q->wptr, memory_order_relaxed);
+    if (w - atomic_load(&q->rptr) >= q->size)
+        queue_wait(q, 1);
+    memcpy(q->buf + (w & (q->size - 1)) * q->elem_size, elem, q->elem_size);
+    atomic_store(&q->wptr, w + 1);
+    queue_wake(q);
+}
+
+static void queue_pop(PipeQueue *q, void *elem)
+{
+    unsigned int r;
+
+    r = atomic_load_explicit(&q->rptr, memory_order_relaxed);
+    if (atomic_load(&q->wptr) == r)
+        queue_wait(q, 0);
+    memcpy(elem, q->buf + (r & (q->size - 1)) * q->elem_size, q->elem_size);
+    atomic_store(&q->rptr, r + 1);
+    queue_wake(q);
+}
+
+static void *pipe_stage2(void *opaque)
+{
+    V34Pipeline *p = opaque;
+    PipeSym in, out;
+
+    for(;;) {
+        queue_pop(&p->q2, &in);
+        if (in.type != PIPE_DATA) {
+            queue_push(&p->q3, &in);
+            if (in.type == PIPE_QUIT)
+                break;
+        } else if (V34_rx_stage2(p->s, &out.v[0], &out.v[1],
+                                 in.v[0], in.v[1])) {
+            out.type = PIPE_DATA;
+            queue_push(&p->q3, &out);
+        }
+    }
+    return NULL;
+}
+
+/* called by V34_rx_stage3() for each decoded mapping frame */
+static void pipe_put_frame(void *opaque, const u64 *f, int mp_size, int aux)
+{
+    V34Pipeline *p = opaque;
+    PipeFrame fr;
+
+    fr.type = PIPE_DATA;
+    fr.mp_size = mp_size;
+    fr.aux = aux;
+    memcpy(fr.f, f, sizeof(fr.f));
+    queue_push(&p->q4, &fr);
+}
+
+static void *pipe_stage3(void *opaque)
+{
+    V34Pipeline *p = opaque;
+    V34DSPState *s = p->s;
+    PipeSym in;
+    PipeFrame fr;
+
+    for(;;) {
+        queue_pop(&p->q3, &in);
+        if (in.type != PIPE_DATA) {
+            fr.type = in.type;
+            memset(&fr.end, 0, sizeof(fr.end));
+            fr.end.data_left = p->data_left;
+            /* the MSE sums are moved out of 's' once the first
+               symbols of the data mode are skipped */
+            if (s->rate_mse_cnt > 0) {
+                fr.end.rate_mse = s->rate_mse;
+                fr.end.rate_mse_cnt = s->rate_mse_cnt;
+                s->rate_mse = 0;
+                s->rate_mse_cnt = 0;
+            }
+            queue_push(&p->q4, &fr);
+            if (in.type == PIPE_QUIT)
+                break;
+        } else if (p->data_left) {
+            if (p->nb_left < 2 * PIPE_BLOCK) {
+                p->left[p->nb_left][0] = in.v[0];
+                p->left[p->nb_left][1] = in.v[1];
+                p->nb_left++;
+            }
+        } else {
+            p->data_left = V34_rx_stage3(s, in.v[0], in.v[1]);
+        }
+    }
+    return NULL;
+}
+
+/* called by V34_rx_stage4() for the data & aux bits */
+static void pipe_put_bits(void *opaque, int bits, int n)
+{
+    V34Pipeline *p = opaque;
+    PipeBits b;
+
+    b.type = PIPE_DATA;
+    b.n = n;
+    b.bits = bits;
+    queue_push(&p->qout, &b);
+}
+
+static void pipe_put_aux_bit(void *opaque, int bit)
+{
+    V34Pipeline *p = opaque;
+    PipeBits b;
+
+    b.type = PIPE_AUX;
+    b.n = 1;
+    b.bits = bit;
+    queue_push(&p->qout, &b);
+}
+
+static void *pipe_stage4(void *opaque)
+{
+    V34Pipeline *p = opaque;
+    PipeFrame in;
+    PipeBits b;
+
+    for(;;) {
+        queue_pop(&p->q4, &in);
+        if (in.type != PIPE_DATA) {
+            b.type = in.type;
+            b.end = in.end;
+            queue_push(&p->qout, &b);
+            if (in.type == PIPE_QUIT)
+                break;
+        } else {
+            V34_rx_stage4(p->s, in.f, in.mp_size, in.aux);
+        }
+    }
+    return NULL;
+}
+
+/* the stages are idle: give the bit output of the receiver to the
+   queues or restore it */
+static void pipe_start(V34Pipeline *p)
+{
+    V34DSPState *s = p->s;
+
+    p->put_bit = s->put_bit;
+    p->put_bits = s->put_bits;
+    p->put_aux_bit = s->put_aux_bit;
+    p->opaque = s->opaque;
+    s->put_bits = pipe_put_bits;
+    s->put_aux_bit = p->put_aux_bit ? pipe_put_aux_bit : NULL;
+    s->opaque = p;
+    s->put_frame = pipe_put_frame;
+    s->frame_opaque = p;
+    p->running = 1;
+}
+
+static void pipe_stop(V34Pipeline *p)
+{
+    V34DSPState *s = p->s;
+
+    s->put_bit = p->put_bit;
+    s->put_bits = p->put_bits;
+    s->put_aux_bit = p->put_aux_bit;
+    s->opaque = p->opaque;
+    s->put_frame = NULL;
+    p->running = 0;
+    p->rate_mse = 0;
+    p->rate_mse_cnt = 0;
+}
+
+/* output the bits of the oldest block in the stages, which was
+   started at 'start_time'. Return its end marker in 'end'. */
+static void pipe_output(V34Pipeline *p, PipeEnd *end, s64 start_time)
+{
+    PipeBits b;
+    int j;
+    s64 t;
+
+    for(;;) {
+        queue_pop(&p->qout, &b);
+        if (b.type == PIPE_END)
+            break;
+        if (b.type == PIPE_AUX) {
+            p->put_aux_bit(p->opaque, b.bits);
+        } else if (p->put_bits) {
+            p->put_bits(p->opaque, b.bits, b.n);
+        } else {
+            for(j=b.n-1;j>=0;j--)
+                p->put_bit(p->opaque, (b.bits >> j) & 1);
+        }
+    }
+    *end = b.end;
+    p->rate_mse += b.end.rate_mse;
+    p->rate_mse_cnt += b.end.rate_mse_cnt;
+
+    t = bench_time() - start_time;
+    p->nb_blocks++;
+    p->total_time += t;
+    if (t > p->max_time)
+        p->max_time = t;
+}
+
+/* create the threads of the pipelined receiver of 's'. The memory is
+   taken in 'a' (see sm_arena_alloc()), so the pipeline of a call is
+   allocated in its call arena. Return NULL if error. */
+V34Pipeline *V34_pipeline_new(V34DSPState *s, struct sm_arena *a)
+{
+    static void *(*stages[3])(void *) = {
+        pipe_stage2, pipe_stage3, pipe_stage4,
+    };
+    V34Pipeline *p;
+    PipeSym sym;
+    int i, spin, mark;
+
+    mark = a ? sm_arena_mark(a) : 0;
+    p = sm_arena_alloc(a, sizeof(V34Pipeline));
+    if (!p)
+        return NULL;
+    p->s = s;
+    p->allocated = (a == NULL);
+    /* polling is useless if the other stages run on the same CPU */
+    spin = (sysconf(_SC_NPROCESSORS_ONLN) > 1) ? PIPE_SPIN : 0;
+    /* a block gives at most 4/3 T/3 samples and 4/9 symbols per
+       sample, so the producers seldom wait. 'qout' holds the bits of
+       two blocks at 33600 bit/s. */
+    if (queue_init(&p->q2, a, sizeof(PipeSym), 512, spin) < 0)
+        goto fail0;
+    if (queue_init(&p->q3, a, sizeof(PipeSym), 128, spin) < 0)
+        goto fail1;
+    if (queue_init(&p->q4, a, sizeof(PipeFrame), 32, spin) < 0)
+        goto fail2;
+    if (queue_init(&p->qout, a, sizeof(PipeBits), 256, spin) < 0)
+        goto fail3;
+    for(i=0;i<3;i++) {
+        if (pthread_create(&p->thread[i], NULL, stages[i], p) != 0)
+            goto fail4;
+    }
+    return p;
+
+ fail4:
+    /* stop the threads already started */
+    sym.type = PIPE_QUIT;
+    queue_push(&p->q2, &sym);
+    while (i-- > 0)
+        pthread_join(p->thread[i], NULL);
+    queue_free(&p->qout, p->allocated);
+ fail3:
+    queue_free(&p->q4, p->allocated);
+ fail2:
+    queue_free(&p->q3, p->allocated);
+ fail1:
+    queue_free(&p->q2, p->allocated);
+ fail0:
+    if (a)
+        sm_arena_release(a, mark);
+    else
+        free(p);
+    return NULL;
+}
+
+/* stop the threads. The bits of the block still in the stages are
+   lost. The memory taken in an arena is freed with the arena. */
+void V34_pipeline_free(V34Pipeline *p)
+{
+    PipeSym sym;
+    PipeBits b;
+    int i, allocated;
+
+    sym.type = PIPE_QUIT;
+    queue_push(&p->q2, &sym);
+    do {
+        queue_pop(&p->qout, &b);
+    } while (b.type != PIPE_QUIT);
+    for(i=0;i<3;i++)
+        pthread_join(p->thread[i], NULL);
+    if (p->running)
+        pipe_stop(p);
+    allocated = p->allocated;
+    queue_free(&p->qout, allocated);
+    queue_free(&p->q4, allocated);
+    queue_free(&p->q3, allocated);
+    queue_free(&p->q2, allocated);
+    if (allocated)
+        free(p);
+}
+
+/* demodulate the samples in data mode. Return the number of
+   processed samples: it is less than 'nb' if the data mode was left
+   (the other samples must be given to the normal receiver). */
+int V34_pipeline_demod(V34Pipeline *p, const s16 *samples, int nb)
+{
+    V34DSPState *s = p->s;
+    PipeSym sym;
+    PipeEnd end;
+    int out[2][2];
+    int i, j, n, len, pos;
+    s64 t;
+
+    if (!p->running)
+        pipe_start(p);
+    pos = 0;
+    while (pos < nb) {
+        len = nb - pos;
+        if (len > PIPE_BLOCK)
+            len = PIPE_BLOCK;
+        t = bench_time();
+
+        sym.type = PIPE_DATA;
+        for(i=0;i<len;i++) {
+            n = V34_rx_stage1(s, out, samples[pos + i]);
+            for(j=0;j<n;j++) {
+                sym.v[0] = out[j][0];
+                sym.v[1] = out[j][1];
+                queue_push(&p->q2, &sym);
+            }
+        }
+        sym.type = PIPE_END;
+        queue_push(&p->q2, &sym);
+        pos += len;
+
+        /* the previous block is output while this one goes through
+           the stages */
+        if (p->pending) {
+            pipe_output(p, &end, p->pending_time);
+            if (end.data_left) {
+                /* S was in the previous block: the symbols of this
+                   block are also stored */
+                pipe_output(p, &end, t);
+                p->pending = 0;
+                pipe_stop(p);
+                V34_rx_stage3_end(s, p->left, p->nb_left);
+                p->data_left = 0;
+                p->nb_left = 0;
+                break;
+            }
+        }
+        p->pending = 1;
+        p->pending_time = t;
+    }
+    return pos;
+}
+
+/* MSE sums of the decoded symbols for the rate monitor: while the
+   receiver is pipelined, stage 3 gives them with each block */
+void V34_pipeline_rate_mse(V34Pipeline *p, int **mse, int **cnt)
+{
+    *mse = &p->rate_mse;
+    *cnt = &p->rate_mse_cnt;
+}
+
+/* time (in us) between the start of a block and the output of its
+   last bit */
+void V34_pipeline_stats(V34Pipeline *p, int *nb_blocks,
+                        s64 *mean_time, s64 *max_time)
+{
+    *nb_blocks = p->nb_blocks;
+    *mean_time = p->nb_blocks ? p->total_time / p->nb_blocks : 0;
+    *max_time = p->max_time;
+}
+
+/* benchmark: two modems with heavy receivers (frequency domain
+   equalizer & 64 state Viterbi decoder) in data mode through the
+   line model. The time of each V34_process() call is measured with
+   and without the pipelined receivers. */
+
+#define PIPE_BENCH_NB_SAMPLES 40 /* 5 ms */
+#define PIPE_BENCH_SECONDS    20 /* in data mode */
+#define PIPE_BENCH_TIMEOUT    30
+#define PIPE_BENCH_FD_TAPS    1024
+#define PIPE_BENCH_SNR        50
+
+typedef struct {
+    int nb_bits, errors;
+} PipeBenchCount;
+
+static int pipe_bench_get_bit(void *opaque)
+{
+    return 1;
+}
+
+static void pipe_bench_put_bit(void *opaque, int bit)
+{
+    PipeBenchCount *c = opaque;
+
+    c->nb_bits++;
+    if (bit != 1)
+        c->errors++;
+}
+
+typedef struct {
+    int connected;
+    int nb_blocks;
+    s64 total_time, max_time; /* per V34_process() call of both modems */
+    s64 pipe_mean, pipe_max;  /* time of a block in the pipeline */
+    PipeBenchCount count[2];
+} PipeBenchResult;
+
+static void pipe_bench_run(PipeBenchResult *r, int pipelined)
+{
+    struct sm_arena arena;
+    struct LineModelState *line;
+    V34State *m[2];
+    s16 out[2][PIPE_BENCH_NB_SAMPLES], in[2][PIPE_BENCH_NB_SAMPLES];
+    int i, n, n_end, fd_set[2], nb;
+    s64 t, mean, max;
+
+    memset(r, 0, sizeof(*r));
+    srandom(0);
+    if (sm_arena_init(&arena, 64 * 1024 + 2 * FDEQ_MAX_TAPS * 128 +
+                      2 * V34_PIPELINE_SIZE) < 0) {
+        fprintf(stderr, "V34_pipeline_bench: no memory\n");
+        exit(1);
+    }
+    line = line_model_init(&arena);
+    line_model_set_snr(line, PIPE_BENCH_SNR);
+    for(i=0;i<2;i++) {
+        m[i] = malloc(sizeof(V34State));
+        if (!m[i]) {
+            fprintf(stderr, "V34_pipeline_bench: no memory\n");
+            exit(1);
+        }
+        V34_init(m[i], i == 0, pipe_bench_get_bit, pipe_bench_put_bit,
+                 &r->count[i]);
+        m[i]->conv_nb_states = 64;
+        fd_set[i] = 0;
+        if (pipelined) {
+            m[i]->rx_pipe = V34_pipeline_new(&m[i]->v34_rx, &arena);
+            if (!m[i]->rx_pipe) {
+                fprintf(stderr, "V34_pipeline_bench: cannot start the threads\n");
+                exit(1);
+            }
+        }
+        memset(in[i], 0, sizeof(in[i]));
+    }
+
+    n_end = (PIPE_BENCH_TIMEOUT * 8000) / PIPE_BENCH_NB_SAMPLES;
+    for(n = 0; n < n_end; n++) {
+        for(i=0;i<2;i++) {
+            /* the receiver is initialized after phase 2 */
+            if (!fd_set[i] && m[i]->p2_state == V34_P2_DONE) {
+                if (V34_set_fd_equalizer(&m[i]->v34_rx, &arena,
+                                         PIPE_BENCH_FD_TAPS) < 0) {
+                    fprintf(stderr, "V34_pipeline_bench: no memory\n");
+                    exit(1);
+                }
+                fd_set[i] = 1;
+            }
+        }
+        if (!r->connected &&
+            m[0]->v34_rx.state == V34_DATA && m[1]->v34_rx.state == V34_DATA) {
+            r->connected = 1;
+            n_end = n + (PIPE_BENCH_SECONDS * 8000) / PIPE_BENCH_NB_SAMPLES;
+            for(i=0;i<2;i++)
+                memset(&r->count[i], 0, sizeof(r->count[i]));
+        }
+
+        t = bench_time();
+        if (V34_process(m[0], out[0], in[0], PIPE_BENCH_NB_SAMPLES) ||
+            V34_process(m[1], out[1], in[1], PIPE_BENCH_NB_SAMPLES))
+            break;
+        t = bench_time() - t;
+        if (r->connected) {
+            r->nb_blocks++;
+            r->total_time += t;
+            if (t > r->max_time)
+                r->max_time = t;
+        }
+        line_model(line, in[1], out[0], in[0], out[1], PIPE_BENCH_NB_SAMPLES);
+    }
+
+    for(i=0;i<2;i++) {
+        if (m[i]->rx_pipe) {
+            V34_pipeline_stats(m[i]->rx_pipe, &nb, &mean, &max);
+            r->pipe_mean += mean / 2;
+            if (max > r->pipe_max)
+                r->pipe_max = max;
+            V34_pipeline_free(m[i]->rx_pipe);
+        }
+        free(m[i]);
+    }
+    sm_arena_free(&arena);
+}
+
+void V34_pipeline_bench(void)
+{
+    PipeBenchResult r[2];
+    float block_us;
+    int i, nb_cpus;
+
+    block_us = PIPE_BENCH_NB_SAMPLES * 1000000.0 / 8000;
+    nb_cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    printf("pipeline: 2 modems, %d taps FD equalizer, 64 states, %d s in data mode\n"
+           "          time of the V34_process() calls for each %0.0f us block, %d CPU(s)\n",
+           PIPE_BENCH_FD_TAPS, PIPE_BENCH_SECONDS, block_us, nb_cpus);
+    /* the stages of the other modem & of the previous block only
+       overlap the caller with free CPUs */
+    if (nb_cpus < 2)
+        printf("          one CPU: the pipelined receiver cannot be faster\n");
+    for(i=0;i<2;i++) {
+        pipe_bench_run(&r[i], i);
+        if (!r[i].connected) {
+            printf("%-12s: no connection\n", i ? "pipelined" : "sequential");
+            continue;
+        }
+        printf("%-12s: mean=%7.1f us  max=%7.1f us  errors cal=%d/%d ans=%d/%d\n",
+               i ? "pipelined" : "sequential",
+               (float)r[i].total_time / r[i].nb_blocks, (float)r[i].max_time,
+               r[i].count[0].errors, r[i].count[0].nb_bits,
+               r[i].count[1].errors, r[i].count[1].nb_bits);
+    }
+    if (r[1].connected) {
+        /* the bits of a block are output by the next call, so it
+           includes the time between the calls */
+        printf("block time (start to last bit): mean=%0.1f us  max=%0.1f us  "
+               "(%0.2f block)\n", (float)r[1].pipe_mean, (float)r[1].pipe_max,
+               r[1].pipe_max / block_us);
+    }
+}
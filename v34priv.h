@@ -1,7 +1,11 @@
 #ifndef V34PRIV_H
 #define V34PRIV_H
 
+#include "v34table.h"
+
 #define MAX_MAPPING_FRAME_SIZE 79
+/* mapping frames are packed LSB first (first bit in the LSB of word 0) */
+#define MAPPING_FRAME_WORDS    2
 #define M_MAX 18
 
 /* symbol rate */
@@ -14,6 +18,9 @@ enum {
   V34_S3429,
 };
 
+#define V34_NB_S 6 /* number of symbol rates */
+#define V34_NB_R 14 /* number of data rates (2400 to 33600 bit/s) */
+
 /* constellation parameters */
 #define L_MAX 1664   /* max number of points in the constellation */
 #define C_MIN   -11
@@ -22,12 +29,9 @@ enum {
 #define C_RADIUS (2*(C_MAX-C_MIN)+1) /* max coordinate of the constellation */
 #define SYNC_PATTERN 0x77FA /* (table 12) synchronisation pattern for J=8 */
 
-#define V34_SAMPLE_RATE_NUM 10
-#define V34_SAMPLE_RATE_DEN 3
-#define V34_SAMPLE_RATE ((2400*V34_SAMPLE_RATE_NUM)/V34_SAMPLE_RATE_DEN)
-
-/* size of the raised root cosine filter (for both rx & tx) */
-#define RC_FILTER_SIZE 40
+#define V34_MAX_P      16 /* max number of mapping frames in a data frame */
+#define V34_SYNC_WORDS 8  /* 64 bit words for the 4D symbols of a
+                             superframe (4 * P * J) */
 
 #define TX_BUF_SIZE (2048)
 
@@ -38,16 +42,85 @@ enum {
 #define EQ_FRAC        3
 #define EQ_SIZE        (52*EQ_FRAC)
 
+/* equalizer update policies */
+enum {
+  EQ_UPDATE_LMS,  /* LMS */
+  EQ_UPDATE_SIGN, /* sign-error LMS */
+};
+
 #define AGC_WINDOW_SIZE 512 /* must be a power of two, in input samples */
 
 #define TRELLIS_MAX_STATES 64
 /* 5 times the constraint length */
 #define TRELLIS_LENGTH (6*5)
+/* number of decisions output by each traceback */
+#define TRELLIS_BLOCK 8
+#define TRELLIS_HIST (TRELLIS_LENGTH + TRELLIS_BLOCK)
+/* delay of the Viterbi decoder (in 4D symbols) */
+#define TRELLIS_DELAY (TRELLIS_LENGTH + TRELLIS_BLOCK - 1)
 
 /* 10 fractional bits for nyquist filters */
 #define NQ_BITS 10
 #define NQ_BASE (1 << NQ_BITS)
 
+/* max size of an MP sequence (type 1), in bits */
+#define MP_MAX_SIZE 188
+
+/* shell mapping tables for M rings ( 9.3.1), shared by all the
+   modems. The cumulative sums give the ring parameters with a binary
+   search. */
+typedef struct V34Rings {
+    int m;
+    int g2[8*(M_MAX - 1) + 1];
+    int g4[8*(M_MAX - 1) + 1];
+    int g8[8*(M_MAX - 1) + 1];
+    s64 z8[8*(M_MAX - 1) + 2];
+    int w2, w4;  /* row sizes of c2 & c4 */
+    int *c2;     /* c2[b * w2 + j] = sum(i < j) g2[i] * g2[b - i] */
+    s64 *c4;     /* c4[a * w4 + j] = sum(i < j) g4[i] * g4[a - i] */
+} V34Rings;
+
+/* data frame & mapping parameters of a data rate ( 9.2), built once
+   for each symbol rate, data rate, shaping and aux channel. They do
+   not depend on the carrier. */
+typedef struct V34Config {
+    int valid; /* false if the data rate is too high for the symbol
+                  rate: the other fields are then not set */
+    int R; /* data rate, including aux channel */
+    int N, W, b, r, K, q, M, L;
+    float data_power; /* mean power of the L points (the power of (1,1) is 2) */
+    int nl_scale; /* non linear encoder: zeta = |x|^2 * nl_scale (see
+                     nl_zeta()) */
+    const struct V34Rings *rings;
+    const u16 (*decision)[C_RADIUS+1]; /* nearest constellation point
+                                          of each lattice point */
+    /* schedule of a data frame: size of each mapping frame (b - 1 or
+       b bits, including the aux bit) and mapping frames which start
+       with an aux bit (bit i for the mapping frame i) */
+    u8 mp_size[V34_MAX_P];
+    u16 aux_frames;
+} V34Config;
+
+/* frequency domain equalizer: overlap-save filtering and block LMS
+   with FFTs of twice the block size. It replaces the time domain
+   equalizer for long channel responses. */
+#define FDEQ_MAX_TAPS 1024
+
+typedef struct V34FDEq {
+    int nb_taps;
+    int block;        /* input samples per block (half the FFT size) */
+    int ptr;          /* samples in the current block */
+    float mu;         /* adaptation step */
+    FFTPlan fft;
+    float *x;         /* previous and current blocks of input samples */
+    u8 *sym;          /* true for the symbol instants of the block */
+    complex *W;       /* frequency response of the filter */
+    complex *X;       /* spectrum of x */
+    complex *y;       /* output of the block, then error */
+    int (*out)[2];    /* equalized symbols not returned yet */
+    int out_size, out_rptr, out_count;
+} V34FDEq;
+
 /* state of the signal processing part of the V34 transmitter */
 typedef struct V34DSPState {
   /* V34 parameters */
@@ -59,11 +132,24 @@ typedef struct V34DSPState {
   int use_non_linear;
   int use_high_carrier;
   s16 h[3][2]; /* precoding coefficients (14 bits fractional part) */
+  int use_precoding; /* true if h is not zero */
 
     void *opaque;
     get_bit_func get_bit;  
     
     put_bit_func put_bit;  
+
+    /* optional block bit I/O (NULL = use get_bit & put_bit) */
+    get_bits_func get_bits;
+    put_bits_func put_bits;
+    /* auxiliary channel bits (NULL = zeros are sent) */
+    get_bit_func get_aux_bit;
+    put_bit_func put_aux_bit;
+    /* pipelined receiver: if not NULL, the decoded mapping frames are
+       given to put_frame() instead of being written. The transmitter
+       gives it a copy of each sent frame (see V34_rx_check()) */
+    void (*put_frame)(void *opaque, const u64 *f, int mp_size, int aux);
+    void *frame_opaque;
   
   /* do not modify after this */
 
@@ -79,27 +165,30 @@ typedef struct V34DSPState {
   int M; /* current number of rings */ 
   int Z_1; /* previous Z value (see  9.5) */
 
-    int mapping_frame; /* number of the mapping frame */
-    int rcnt, acnt;    /* fractional counters to know the number of bits
-                          in a mapping frame */
-  int half_data_frame_count;    /* number of half data frame */
-  int sync_count; /* counter mod 2P for synchronisation */
+    int mapping_frame; /* number of the mapping frame in the data frame
+                          (see V34Config.mp_size) */
+    int use_aux_channel; /* aux channel requested in our MP */
+    int mp_aux;          /* rx: aux channel bit of the received MP */
+    int remote_aux;      /* tx: aux channel bit of the remote MP */
+    /* superframe synchronisation: v0 of each 4D symbol */
+    const u64 *sync_v0;
+    int sync_pos, sync_len; /* 4D symbol in the superframe, 4 * P * J */
   s16 x[3][2]; /* 3 most recent samples for precoding (7 bit fractional part) */
+  s16 x_hat[3][2]; /* receiver: 3 most recent received samples x(n) */
   int U0;
   int conv_reg; /* memory of the convolutional coder */
-  int scrambler_reg; /* state of the self synchronizing scrambler */
+  Scrambler scrambler; /* self synchronizing scrambler */
   float carrier_freq; 
   float symbol_rate; 
-    s8 constellation[C_MAX_SIZE][2];
+    /* parameters of the current data rate (shared) */
+    const V34Config *cfg;
+    const s8 (*constellation)[2];
 
-    /* precomputed bases for the ring computation */
-    int g2_tab[8*(M_MAX - 1) + 1];
-    int g4_tab[8*(M_MAX - 1) + 1];
-    int g8_tab[8*(M_MAX - 1) + 1];
-    int z8_tab[8*(M_MAX - 1) + 1];
+    /* shell mapping tables for M rings */
+    const struct V34Rings *rings;
     
     /* for decoding only */
-    u16 constellation_to_code[C_RADIUS+1][C_RADIUS+1];
+    const u16 (*constellation_to_code)[C_RADIUS+1];
 
     /* for encoding only */
     s16 *tx_filter;
@@ -116,9 +205,10 @@ typedef struct V34DSPState {
                    by it (1:8:7) */
 
     int baud3_phase;
-    s16 *rx_filter;
-    int rx_filter_wsize;
-    s16 rx_buf1[RX_BUF1_SIZE];
+    s16 *rx_filter;      /* polyphase layout (see v34table.h) */
+    int rx_filter_wsize; /* taps used for each output */
+    int rx_filter_stride, rx_filter_phases;
+    s16 rx_buf1[2 * RX_BUF1_SIZE]; /* written twice (dsp_hist_put()) */
     int rx_buf1_ptr;
     
     /* symbol synchronization */
@@ -127,12 +217,22 @@ typedef struct V34DSPState {
     s16 sync_high_mem[2];
     s16 sync_high_coef[2];
     s16 sync_A, sync_B, sync_C;
+    int sync_freq; /* integral term of the timing loop: baud_phase
+                      correction per symbol, SYNC_FREQ_BITS fractional bits */
 
     /* equalizer */
-    s32 eq_filter[EQ_SIZE][2];
-    s16 eq_buf[EQ_SIZE];
+    s32 eq_filter[EQ_SIZE][2];  /* 16.16 */
+    s16 eq_coef[2][EQ_SIZE];    /* eq_filter >> 16, used for filtering */
+    /* delay line: each sample is stored twice so that the last EQ_SIZE
+       samples are always at eq_buf[eq_buf_ptr] */
+    s16 eq_buf[2 * EQ_SIZE];
     int eq_buf_ptr;
     int eq_shift;
+    int eq_update_mode;   /* EQ_UPDATE_xxx */
+    int eq_update_period; /* update the filter every eq_update_period symbols */
+    int eq_update_count;
+    int eq_mse_sum, eq_mse_count; /* decision error energy (statistics) */
+    struct V34FDEq *fd_eq; /* if not NULL, replaces the above filter */
 
     /* AGC */
     float agc_mem;
@@ -142,22 +242,28 @@ typedef struct V34DSPState {
     
     /* Viterbi decoder */
 
-    /* the previous decoded decision comming to this path. Each
-       decision Y[5] is coded on one byte */
-
-    u8 state_decision[TRELLIS_MAX_STATES][TRELLIS_LENGTH];
-    u8  state_path[TRELLIS_MAX_STATES][TRELLIS_LENGTH];
-    s16 state_memory[TRELLIS_LENGTH][4];
-    u8  u0_memory[TRELLIS_LENGTH];
-    int state_error[TRELLIS_MAX_STATES];
-    int state_error1[TRELLIS_MAX_STATES];
+    /* for each received 4D symbol and each state, the decision
+       (index in trellis_trans_x[], on one byte) and the previous
+       state of the best path comming to this state */
+    u8 state_decision[TRELLIS_HIST][TRELLIS_MAX_STATES];
+    u8 state_path[TRELLIS_HIST][TRELLIS_MAX_STATES];
+    s16 state_memory[TRELLIS_HIST][4];
+    u8  u0_memory[TRELLIS_HIST];
+    int state_error[2][TRELLIS_MAX_STATES]; /* path metrics (ping-pong) */
+    int trellis_cur; /* index of the current path metrics */
     int trellis_ptr;
+    int trellis_count; /* symbols since the last traceback */
+    s16 trellis_out[TRELLIS_BLOCK][2][2]; /* decoded by the last traceback */
+    int trellis_out_mse[TRELLIS_BLOCK];
+    u8 trellis_out_rot[TRELLIS_BLOCK];
 
     /* decoder synchronization */
     int phase_4d; /* index of the current 2d symbol in the 4D symbol
                      (0 or 1) */
     int phase_mse; /* MSE to find if we are synchronized on a 4D symbol */
     int phase_mse_cnt;
+    int rx_v0; /* superframe synchronization bit of the previous 4D
+                  symbol: it inverts U0 */
 
     s16 yy[2][2]; /* current 4D symbol */
     s16 rx_mapping_frame[2*4][2]; 
@@ -165,20 +271,40 @@ typedef struct V34DSPState {
 
     /* rx state */
     int sym_count;
+    int dec_delay; /* 4D symbols until the Viterbi decoder output is valid */
+    int rx_pow;    /* power of the equalized symbols */
+    int rx_signal; /* true if the remote modem transmits */
+    int rx_gain;   /* gain of the equalized symbols in data mode (8.8) */
+    u32 rx_bits;   /* last descrambled bits of the 4 point sequences */
+    int rx_ones;   /* number of consecutive ones in rx_bits */
+    u8 mp_buf[MP_MAX_SIZE]; /* MP sequence being received */
+    int mp_ptr;
 
     /* current V34 protocol state */
     int state;
     int is_16states; /* 16 states required in the startup sequences */
 
-    /* interaction with receiver */
-    int J_received;
-    int JP_received;
+    /* interaction between the receiver and the transmitter */
+    int J_received; /* the J sequence was received */
+    int S_received; /* the S sequence was received after a silence */
+
+    /* data rates: the rate of each direction is the lowest of the
+       two rates given by the MP sequences of both modems */
+    int max_R;       /* tx: projected rate of the remote receiver.
+                        rx: max rate that can be received */
+    int mp_R[2];     /* call to answer & answer to call rates of the
+                        MP sequence (tx: sent, rx: last received) */
+    int MP_received; /* the remote MP sequence was received */
+    int MP_ack_received; /* the remote MP had the acknowledge bit set */
+    int remote_R;    /* tx: remote MP rate for our direction */
+    int renegotiate; /* tx: a rate renegotiation must be started.
+                        rx: the remote modem started one */
+    int rate_mse;    /* rx: sum of the Viterbi decoder MSE */
+    int rate_mse_cnt;
+    int s_corr, s_pow; /* rx: S detection in data mode */
+    s16 s_last[2][2];
 } V34DSPState;
 
-u8 trellis_trans_4[256][4];
-u8 trellis_trans_8[256][4];
-u8 trellis_trans_16[256][4];
-
 /* V34 states */
 enum {
     V34_STARTUP3_S1,
@@ -192,7 +318,6 @@ enum {
     V34_STARTUP3_WAIT_J,
 
     V34_STARTUP4_S,
-    V34_STARTUP4_WAIT_JP,
     V34_STARTUP4_SINV,
     V34_STARTUP4_TRN,
     V34_STARTUP4_MP,
@@ -206,30 +331,14 @@ enum {
 
 void put_bits(u8 **pp, int n, int bits);
 int calc_crc(u8 *buf, int size);
-void v34_send_info0(V34DSPState *s, int ack);
+int V34_set_fd_equalizer(V34DSPState *s, struct sm_arena *arena, int nb_taps);
+void V34_get_freqs(int S, int use_high_carrier, 
+                   float *symbol_rate, float *carrier_freq);
+int V34_rate_valid(int S, int R, int expanded_shape, int use_aux_channel);
 
 #define DSPK_TX_FILTER_SIZE 321
 extern s16 v34_dpsk_tx_filter[DSPK_TX_FILTER_SIZE];
 
-extern s16 v34_rc_5_filter[];
-extern s16 v34_rc_7_filter[];
-extern s16 v34_rc_8_filter[];
-extern s16 v34_rc_10_filter[];
-extern s16 v34_rc_20_filter[];
-extern s16 v34_rc_35_filter[];
-
-extern s16 v34_rx_filter_2400_1600[];
-extern s16 v34_rx_filter_2400_1800[];
-extern s16 v34_rx_filter_2743_1646[];
-extern s16 v34_rx_filter_2743_1829[];
-extern s16 v34_rx_filter_2800_1680[];
-extern s16 v34_rx_filter_2800_1867[];
-extern s16 v34_rx_filter_3000_1800[];
-extern s16 v34_rx_filter_3000_2000[];
-extern s16 v34_rx_filter_3200_1829[];
-extern s16 v34_rx_filter_3200_1920[];
-extern s16 v34_rx_filter_3429_1959[];
-
 /* v34eq.c */
 typedef struct {
     s16 re, im;
@@ -240,6 +349,59 @@ extern icomplex tabPP[V34_PP_SIZE];
 
 void V34eq_init(void);
 void V34_fast_equalize(V34DSPState *s, s16 *input);
+int V34_fd_eq_init(V34FDEq *e, struct sm_arena *arena, int nb_taps);
+void V34_fd_eq_set_filter(V34FDEq *e, s32 (*filter)[2], int n);
+void V34_fd_eq_filter(V34FDEq *e);
+void V34_fd_eq_update(V34FDEq *e);
+
+/* receiver stages (v34.c) */
+int V34_rx_stage1(V34DSPState *s, int (*out)[2], int spl);
+int V34_rx_stage2(V34DSPState *s, int *ri_ptr, int *rq_ptr, 
+                  int si, int phase);
+int V34_rx_stage3(V34DSPState *s, int ri, int rq);
+void V34_rx_stage3_end(V34DSPState *s, int (*sym)[2], int n);
+void V34_rx_stage4(V34DSPState *s, const u64 *f, int mp_size, int aux);
+
+/* v34pipe.c: receiver in data mode split into 4 stages, the last 3
+   running in their own thread. The bits are output one block late,
+   by the thread calling V34_pipeline_demod() */
+typedef struct V34Pipeline V34Pipeline;
+
+#define V34_PIPELINE_SIZE (32 * 1024) /* arena size for V34_pipeline_new() */
+
+V34Pipeline *V34_pipeline_new(V34DSPState *s, struct sm_arena *a);
+void V34_pipeline_free(V34Pipeline *p);
+int V34_pipeline_demod(V34Pipeline *p, const s16 *samples, int nb);
+void V34_pipeline_rate_mse(V34Pipeline *p, int **mse, int **cnt);
+void V34_pipeline_stats(V34Pipeline *p, int *nb_blocks, 
+                        s64 *mean_time, s64 *max_time);
+
+/* line probing analysis: the L1 & L2 sequences are periodic with a
+   period of 20 ms (160 samples), where each tone is a DFT bin */
+#define V34_PROBE_N      160
+#define V34_PROBE_TONES  25 /* 150 Hz to 3750 Hz */
+
+typedef struct {
+    int nb_blocks;
+    s16 buf[V34_PROBE_N];
+    int buf_ptr;
+    float pow[V34_PROBE_N / 2]; /* sum of the power of each bin */
+    float snr[V34_PROBE_TONES]; /* SNR of the data signal at each tone */
+} V34Probe;
+
+#define V34_INFO_MAX_SIZE 109 /* INFO1c, in bits */
+
+/* phase 2 states */
+enum {
+    V34_P2_SEND_L,      /* guard silence, L1 & L2 */
+    V34_P2_WAIT_L,      /* wait for the remote L1 */
+    V34_P2_PROBE,       /* analyse the remote L2 */
+    V34_P2_SEND_INFO1C, /* caller: until INFO1a is received */
+    V34_P2_WAIT_INFO1C, /* answer modem */
+    V34_P2_SEND_INFO1A, /* answer modem: sent twice */
+    V34_P2_WAIT_END,    /* until the remote modem is silent */
+    V34_P2_DONE,
+};
 
 typedef struct V34State {
     /* V34 parameters test */
@@ -255,7 +417,45 @@ typedef struct V34State {
 
     V34DSPState v34_tx;
     V34DSPState v34_rx;
+    struct V34Pipeline *rx_pipe; /* if not NULL, receiver used in data mode */
+    EchoCancelState ec;
+    int time; /* samples since the start of the training */
+
+    /* phase 2: the parameters of each direction come from the line
+       probing done by its receiver */
+    int p2_state;
+    int p2_count;  /* samples since the start of the state */
+    int p2_pow;    /* input power */
+    V34Probe probe;
+    /* best carrier & projected data rate (0 if not supported) for
+       each symbol rate of the received direction */
+    u8 probe_high_carrier[V34_NB_S];
+    int probe_R[V34_NB_S];
+    int S_tx, high_carrier_tx, R_tx;
+    int S_rx, high_carrier_rx, R_rx;
+    /* INFO1 sequences (sent with V21) */
+    V21State info;
+    u8 info_buf[V34_INFO_MAX_SIZE];
+    int info_ptr, info_size, info_count;
+    u8 info_rx_buf[V34_INFO_MAX_SIZE];
+    int info_rx_ptr; /* number of bits in info_rx_buf */
+    int info_received;
+
+    /* data bits (the DSP states are initialized after phase 2) */
+    get_bit_func get_bit;
+    put_bit_func put_bit;
+    get_bits_func get_bits; /* optional block bit I/O */
+    put_bits_func put_bits;
+    get_bit_func get_aux_bit; /* aux channel (NULL = not used) */
+    put_bit_func put_aux_bit;
+    void *opaque;
 } V34State;
 
+/* v34phase2.c */
+void V34_phase2_init(V34State *s);
+void V34_phase2(V34State *s, s16 *output, const s16 *input, int nb_samples);
+int V34_max_rate(int S, float snr);
+int V34_highest_rate(int S);
+
 #endif
 
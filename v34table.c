@@ -0,0 +1,3047 @@
+/* THIS SOURCE CODE IS AUTOMATICALLY GENERATED - DO NOT MODIFY */
+/*
+ * V34 tables
+ * 
+ * Copyright (c) 1999,2000 Fabrice Bellard.
+ *
+ * This code is released under the GNU General Public License version
+ * 2. Please read the file COPYING to know the exact terms of the
+ * license.
+ */
+#include "lm.h"
+#include "v34priv.h"
+
+u8 trellis_trans_4[256][4] = {
+ /* trans=0 y0=0 */
+ { 0, 0, 0, 0 },
+ { 0, 0, 0, 2 },
+ { 0, 0, 2, 0 },
+ { 0, 0, 2, 2 },
+ { 0, 2, 0, 0 },
+ { 0, 2, 0, 2 },
+ { 0, 2, 2, 0 },
+ { 0, 2, 2, 2 },
+ { 1, 1, 1, 1 },
+ { 1, 1, 1, 3 },
+ { 1, 1, 3, 1 },
+ { 1, 1, 3, 3 },
+ { 1, 3, 1, 1 },
+ { 1, 3, 1, 3 },
+ { 1, 3, 3, 1 },
+ { 1, 3, 3, 3 },
+ { 2, 0, 0, 0 },
+ { 2, 0, 0, 2 },
+ { 2, 0, 2, 0 },
+ { 2, 0, 2, 2 },
+ { 2, 2, 0, 0 },
+ { 2, 2, 0, 2 },
+ { 2, 2, 2, 0 },
+ { 2, 2, 2, 2 },
+ { 3, 1, 1, 1 },
+ { 3, 1, 1, 3 },
+ { 3, 1, 3, 1 },
+ { 3, 1, 3, 3 },
+ { 3, 3, 1, 1 },
+ { 3, 3, 1, 3 },
+ { 3, 3, 3, 1 },
+ { 3, 3, 3, 3 },
+ /* trans=1 y0=0 */
+ { 0, 0, 1, 1 },
+ { 0, 0, 1, 3 },
+ { 0, 0, 3, 1 },
+ { 0, 0, 3, 3 },
+ { 0, 2, 1, 1 },
+ { 0, 2, 1, 3 },
+ { 0, 2, 3, 1 },
+ { 0, 2, 3, 3 },
+ { 1, 1, 0, 0 },
+ { 1, 1, 0, 2 },
+ { 1, 1, 2, 0 },
+ { 1, 1, 2, 2 },
+ { 1, 3, 0, 0 },
+ { 1, 3, 0, 2 },
+ { 1, 3, 2, 0 },
+ { 1, 3, 2, 2 },
+ { 2, 0, 1, 1 },
+ { 2, 0, 1, 3 },
+ { 2, 0, 3, 1 },
+ { 2, 0, 3, 3 },
+ { 2, 2, 1, 1 },
+ { 2, 2, 1, 3 },
+ { 2, 2, 3, 1 },
+ { 2, 2, 3, 3 },
+ { 3, 1, 0, 0 },
+ { 3, 1, 0, 2 },
+ { 3, 1, 2, 0 },
+ { 3, 1, 2, 2 },
+ { 3, 3, 0, 0 },
+ { 3, 3, 0, 2 },
+ { 3, 3, 2, 0 },
+ { 3, 3, 2, 2 },
+ /* trans=2 y0=0 */
+ { 0, 1, 0, 1 },
+ { 0, 1, 0, 3 },
+ { 0, 1, 2, 1 },
+ { 0, 1, 2, 3 },
+ { 0, 3, 0, 1 },
+ { 0, 3, 0, 3 },
+ { 0, 3, 2, 1 },
+ { 0, 3, 2, 3 },
+ { 1, 0, 1, 0 },
+ { 1, 0, 1, 2 },
+ { 1, 0, 3, 0 },
+ { 1, 0, 3, 2 },
+ { 1, 2, 1, 0 },
+ { 1, 2, 1, 2 },
+ { 1, 2, 3, 0 },
+ { 1, 2, 3, 2 },
+ { 2, 1, 0, 1 },
+ { 2, 1, 0, 3 },
+ { 2, 1, 2, 1 },
+ { 2, 1, 2, 3 },
+ { 2, 3, 0, 1 },
+ { 2, 3, 0, 3 },
+ { 2, 3, 2, 1 },
+ { 2, 3, 2, 3 },
+ { 3, 0, 1, 0 },
+ { 3, 0, 1, 2 },
+ { 3, 0, 3, 0 },
+ { 3, 0, 3, 2 },
+ { 3, 2, 1, 0 },
+ { 3, 2, 1, 2 },
+ { 3, 2, 3, 0 },
+ { 3, 2, 3, 2 },
+ /* trans=3 y0=0 */
+ { 0, 1, 1, 0 },
+ { 0, 1, 1, 2 },
+ { 0, 1, 3, 0 },
+ { 0, 1, 3, 2 },
+ { 0, 3, 1, 0 },
+ { 0, 3, 1, 2 },
+ { 0, 3, 3, 0 },
+ { 0, 3, 3, 2 },
+ { 1, 0, 0, 1 },
+ { 1, 0, 0, 3 },
+ { 1, 0, 2, 1 },
+ { 1, 0, 2, 3 },
+ { 1, 2, 0, 1 },
+ { 1, 2, 0, 3 },
+ { 1, 2, 2, 1 },
+ { 1, 2, 2, 3 },
+ { 2, 1, 1, 0 },
+ { 2, 1, 1, 2 },
+ { 2, 1, 3, 0 },
+ { 2, 1, 3, 2 },
+ { 2, 3, 1, 0 },
+ { 2, 3, 1, 2 },
+ { 2, 3, 3, 0 },
+ { 2, 3, 3, 2 },
+ { 3, 0, 0, 1 },
+ { 3, 0, 0, 3 },
+ { 3, 0, 2, 1 },
+ { 3, 0, 2, 3 },
+ { 3, 2, 0, 1 },
+ { 3, 2, 0, 3 },
+ { 3, 2, 2, 1 },
+ { 3, 2, 2, 3 },
+ /* trans=0 y0=1 */
+ { 0, 0, 1, 0 },
+ { 0, 0, 1, 2 },
+ { 0, 0, 3, 0 },
+ { 0, 0, 3, 2 },
+ { 0, 2, 1, 0 },
+ { 0, 2, 1, 2 },
+ { 0, 2, 3, 0 },
+ { 0, 2, 3, 2 },
+ { 1, 1, 0, 1 },
+ { 1, 1, 0, 3 },
+ { 1, 1, 2, 1 },
+ { 1, 1, 2, 3 },
+ { 1, 3, 0, 1 },
+ { 1, 3, 0, 3 },
+ { 1, 3, 2, 1 },
+ { 1, 3, 2, 3 },
+ { 2, 0, 1, 0 },
+ { 2, 0, 1, 2 },
+ { 2, 0, 3, 0 },
+ { 2, 0, 3, 2 },
+ { 2, 2, 1, 0 },
+ { 2, 2, 1, 2 },
+ { 2, 2, 3, 0 },
+ { 2, 2, 3, 2 },
+ { 3, 1, 0, 1 },
+ { 3, 1, 0, 3 },
+ { 3, 1, 2, 1 },
+ { 3, 1, 2, 3 },
+ { 3, 3, 0, 1 },
+ { 3, 3, 0, 3 },
+ { 3, 3, 2, 1 },
+ { 3, 3, 2, 3 },
+ /* trans=1 y0=1 */
+ { 0, 0, 0, 1 },
+ { 0, 0, 0, 3 },
+ { 0, 0, 2, 1 },
+ { 0, 0, 2, 3 },
+ { 0, 2, 0, 1 },
+ { 0, 2, 0, 3 },
+ { 0, 2, 2, 1 },
+ { 0, 2, 2, 3 },
+ { 1, 1, 1, 0 },
+ { 1, 1, 1, 2 },
+ { 1, 1, 3, 0 },
+ { 1, 1, 3, 2 },
+ { 1, 3, 1, 0 },
+ { 1, 3, 1, 2 },
+ { 1, 3, 3, 0 },
+ { 1, 3, 3, 2 },
+ { 2, 0, 0, 1 },
+ { 2, 0, 0, 3 },
+ { 2, 0, 2, 1 },
+ { 2, 0, 2, 3 },
+ { 2, 2, 0, 1 },
+ { 2, 2, 0, 3 },
+ { 2, 2, 2, 1 },
+ { 2, 2, 2, 3 },
+ { 3, 1, 1, 0 },
+ { 3, 1, 1, 2 },
+ { 3, 1, 3, 0 },
+ { 3, 1, 3, 2 },
+ { 3, 3, 1, 0 },
+ { 3, 3, 1, 2 },
+ { 3, 3, 3, 0 },
+ { 3, 3, 3, 2 },
+ /* trans=2 y0=1 */
+ { 0, 1, 0, 0 },
+ { 0, 1, 0, 2 },
+ { 0, 1, 2, 0 },
+ { 0, 1, 2, 2 },
+ { 0, 3, 0, 0 },
+ { 0, 3, 0, 2 },
+ { 0, 3, 2, 0 },
+ { 0, 3, 2, 2 },
+ { 1, 0, 1, 1 },
+ { 1, 0, 1, 3 },
+ { 1, 0, 3, 1 },
+ { 1, 0, 3, 3 },
+ { 1, 2, 1, 1 },
+ { 1, 2, 1, 3 },
+ { 1, 2, 3, 1 },
+ { 1, 2, 3, 3 },
+ { 2, 1, 0, 0 },
+ { 2, 1, 0, 2 },
+ { 2, 1, 2, 0 },
+ { 2, 1, 2, 2 },
+ { 2, 3, 0, 0 },
+ { 2, 3, 0, 2 },
+ { 2, 3, 2, 0 },
+ { 2, 3, 2, 2 },
+ { 3, 0, 1, 1 },
+ { 3, 0, 1, 3 },
+ { 3, 0, 3, 1 },
+ { 3, 0, 3, 3 },
+ { 3, 2, 1, 1 },
+ { 3, 2, 1, 3 },
+ { 3, 2, 3, 1 },
+ { 3, 2, 3, 3 },
+ /* trans=3 y0=1 */
+ { 0, 1, 1, 1 },
+ { 0, 1, 1, 3 },
+ { 0, 1, 3, 1 },
+ { 0, 1, 3, 3 },
+ { 0, 3, 1, 1 },
+ { 0, 3, 1, 3 },
+ { 0, 3, 3, 1 },
+ { 0, 3, 3, 3 },
+ { 1, 0, 0, 0 },
+ { 1, 0, 0, 2 },
+ { 1, 0, 2, 0 },
+ { 1, 0, 2, 2 },
+ { 1, 2, 0, 0 },
+ { 1, 2, 0, 2 },
+ { 1, 2, 2, 0 },
+ { 1, 2, 2, 2 },
+ { 2, 1, 1, 1 },
+ { 2, 1, 1, 3 },
+ { 2, 1, 3, 1 },
+ { 2, 1, 3, 3 },
+ { 2, 3, 1, 1 },
+ { 2, 3, 1, 3 },
+ { 2, 3, 3, 1 },
+ { 2, 3, 3, 3 },
+ { 3, 0, 0, 0 },
+ { 3, 0, 0, 2 },
+ { 3, 0, 2, 0 },
+ { 3, 0, 2, 2 },
+ { 3, 2, 0, 0 },
+ { 3, 2, 0, 2 },
+ { 3, 2, 2, 0 },
+ { 3, 2, 2, 2 },
+};
+u8 trellis_trans_8[256][4] = {
+ /* trans=0 y0=0 */
+ { 0, 0, 0, 0 },
+ { 0, 0, 2, 2 },
+ { 0, 2, 0, 2 },
+ { 0, 2, 2, 0 },
+ { 1, 1, 1, 1 },
+ { 1, 1, 3, 3 },
+ { 1, 3, 1, 3 },
+ { 1, 3, 3, 1 },
+ { 2, 0, 0, 2 },
+ { 2, 0, 2, 0 },
+ { 2, 2, 0, 0 },
+ { 2, 2, 2, 2 },
+ { 3, 1, 1, 3 },
+ { 3, 1, 3, 1 },
+ { 3, 3, 1, 1 },
+ { 3, 3, 3, 3 },
+ /* trans=1 y0=0 */
+ { 0, 0, 1, 1 },
+ { 0, 0, 3, 3 },
+ { 0, 2, 1, 3 },
+ { 0, 2, 3, 1 },
+ { 1, 1, 0, 0 },
+ { 1, 1, 2, 2 },
+ { 1, 3, 0, 2 },
+ { 1, 3, 2, 0 },
+ { 2, 0, 1, 3 },
+ { 2, 0, 3, 1 },
+ { 2, 2, 1, 1 },
+ { 2, 2, 3, 3 },
+ { 3, 1, 0, 2 },
+ { 3, 1, 2, 0 },
+ { 3, 3, 0, 0 },
+ { 3, 3, 2, 2 },
+ /* trans=2 y0=0 */
+ { 0, 1, 0, 1 },
+ { 0, 1, 2, 3 },
+ { 0, 3, 0, 3 },
+ { 0, 3, 2, 1 },
+ { 1, 0, 1, 0 },
+ { 1, 0, 3, 2 },
+ { 1, 2, 1, 2 },
+ { 1, 2, 3, 0 },
+ { 2, 1, 0, 3 },
+ { 2, 1, 2, 1 },
+ { 2, 3, 0, 1 },
+ { 2, 3, 2, 3 },
+ { 3, 0, 1, 2 },
+ { 3, 0, 3, 0 },
+ { 3, 2, 1, 0 },
+ { 3, 2, 3, 2 },
+ /* trans=3 y0=0 */
+ { 0, 1, 1, 0 },
+ { 0, 1, 3, 2 },
+ { 0, 3, 1, 2 },
+ { 0, 3, 3, 0 },
+ { 1, 0, 0, 1 },
+ { 1, 0, 2, 3 },
+ { 1, 2, 0, 3 },
+ { 1, 2, 2, 1 },
+ { 2, 1, 1, 2 },
+ { 2, 1, 3, 0 },
+ { 2, 3, 1, 0 },
+ { 2, 3, 3, 2 },
+ { 3, 0, 0, 3 },
+ { 3, 0, 2, 1 },
+ { 3, 2, 0, 1 },
+ { 3, 2, 2, 3 },
+ /* trans=4 y0=0 */
+ { 0, 0, 0, 2 },
+ { 0, 0, 2, 0 },
+ { 0, 2, 0, 0 },
+ { 0, 2, 2, 2 },
+ { 1, 1, 1, 3 },
+ { 1, 1, 3, 1 },
+ { 1, 3, 1, 1 },
+ { 1, 3, 3, 3 },
+ { 2, 0, 0, 0 },
+ { 2, 0, 2, 2 },
+ { 2, 2, 0, 2 },
+ { 2, 2, 2, 0 },
+ { 3, 1, 1, 1 },
+ { 3, 1, 3, 3 },
+ { 3, 3, 1, 3 },
+ { 3, 3, 3, 1 },
+ /* trans=5 y0=0 */
+ { 0, 0, 1, 3 },
+ { 0, 0, 3, 1 },
+ { 0, 2, 1, 1 },
+ { 0, 2, 3, 3 },
+ { 1, 1, 0, 2 },
+ { 1, 1, 2, 0 },
+ { 1, 3, 0, 0 },
+ { 1, 3, 2, 2 },
+ { 2, 0, 1, 1 },
+ { 2, 0, 3, 3 },
+ { 2, 2, 1, 3 },
+ { 2, 2, 3, 1 },
+ { 3, 1, 0, 0 },
+ { 3, 1, 2, 2 },
+ { 3, 3, 0, 2 },
+ { 3, 3, 2, 0 },
+ /* trans=6 y0=0 */
+ { 0, 1, 0, 3 },
+ { 0, 1, 2, 1 },
+ { 0, 3, 0, 1 },
+ { 0, 3, 2, 3 },
+ { 1, 0, 1, 2 },
+ { 1, 0, 3, 0 },
+ { 1, 2, 1, 0 },
+ { 1, 2, 3, 2 },
+ { 2, 1, 0, 1 },
+ { 2, 1, 2, 3 },
+ { 2, 3, 0, 3 },
+ { 2, 3, 2, 1 },
+ { 3, 0, 1, 0 },
+ { 3, 0, 3, 2 },
+ { 3, 2, 1, 2 },
+ { 3, 2, 3, 0 },
+ /* trans=7 y0=0 */
+ { 0, 1, 1, 2 },
+ { 0, 1, 3, 0 },
+ { 0, 3, 1, 0 },
+ { 0, 3, 3, 2 },
+ { 1, 0, 0, 3 },
+ { 1, 0, 2, 1 },
+ { 1, 2, 0, 1 },
+ { 1, 2, 2, 3 },
+ { 2, 1, 1, 0 },
+ { 2, 1, 3, 2 },
+ { 2, 3, 1, 2 },
+ { 2, 3, 3, 0 },
+ { 3, 0, 0, 1 },
+ { 3, 0, 2, 3 },
+ { 3, 2, 0, 3 },
+ { 3, 2, 2, 1 },
+ /* trans=0 y0=1 */
+ { 0, 0, 1, 2 },
+ { 0, 0, 3, 0 },
+ { 0, 2, 1, 0 },
+ { 0, 2, 3, 2 },
+ { 1, 1, 0, 3 },
+ { 1, 1, 2, 1 },
+ { 1, 3, 0, 1 },
+ { 1, 3, 2, 3 },
+ { 2, 0, 1, 0 },
+ { 2, 0, 3, 2 },
+ { 2, 2, 1, 2 },
+ { 2, 2, 3, 0 },
+ { 3, 1, 0, 1 },
+ { 3, 1, 2, 3 },
+ { 3, 3, 0, 3 },
+ { 3, 3, 2, 1 },
+ /* trans=1 y0=1 */
+ { 0, 0, 0, 3 },
+ { 0, 0, 2, 1 },
+ { 0, 2, 0, 1 },
+ { 0, 2, 2, 3 },
+ { 1, 1, 1, 2 },
+ { 1, 1, 3, 0 },
+ { 1, 3, 1, 0 },
+ { 1, 3, 3, 2 },
+ { 2, 0, 0, 1 },
+ { 2, 0, 2, 3 },
+ { 2, 2, 0, 3 },
+ { 2, 2, 2, 1 },
+ { 3, 1, 1, 0 },
+ { 3, 1, 3, 2 },
+ { 3, 3, 1, 2 },
+ { 3, 3, 3, 0 },
+ /* trans=2 y0=1 */
+ { 0, 1, 0, 2 },
+ { 0, 1, 2, 0 },
+ { 0, 3, 0, 0 },
+ { 0, 3, 2, 2 },
+ { 1, 0, 1, 3 },
+ { 1, 0, 3, 1 },
+ { 1, 2, 1, 1 },
+ { 1, 2, 3, 3 },
+ { 2, 1, 0, 0 },
+ { 2, 1, 2, 2 },
+ { 2, 3, 0, 2 },
+ { 2, 3, 2, 0 },
+ { 3, 0, 1, 1 },
+ { 3, 0, 3, 3 },
+ { 3, 2, 1, 3 },
+ { 3, 2, 3, 1 },
+ /* trans=3 y0=1 */
+ { 0, 1, 1, 3 },
+ { 0, 1, 3, 1 },
+ { 0, 3, 1, 1 },
+ { 0, 3, 3, 3 },
+ { 1, 0, 0, 2 },
+ { 1, 0, 2, 0 },
+ { 1, 2, 0, 0 },
+ { 1, 2, 2, 2 },
+ { 2, 1, 1, 1 },
+ { 2, 1, 3, 3 },
+ { 2, 3, 1, 3 },
+ { 2, 3, 3, 1 },
+ { 3, 0, 0, 0 },
+ { 3, 0, 2, 2 },
+ { 3, 2, 0, 2 },
+ { 3, 2, 2, 0 },
+ /* trans=4 y0=1 */
+ { 0, 0, 1, 0 },
+ { 0, 0, 3, 2 },
+ { 0, 2, 1, 2 },
+ { 0, 2, 3, 0 },
+ { 1, 1, 0, 1 },
+ { 1, 1, 2, 3 },
+ { 1, 3, 0, 3 },
+ { 1, 3, 2, 1 },
+ { 2, 0, 1, 2 },
+ { 2, 0, 3, 0 },
+ { 2, 2, 1, 0 },
+ { 2, 2, 3, 2 },
+ { 3, 1, 0, 3 },
+ { 3, 1, 2, 1 },
+ { 3, 3, 0, 1 },
+ { 3, 3, 2, 3 },
+ /* trans=5 y0=1 */
+ { 0, 0, 0, 1 },
+ { 0, 0, 2, 3 },
+ { 0, 2, 0, 3 },
+ { 0, 2, 2, 1 },
+ { 1, 1, 1, 0 },
+ { 1, 1, 3, 2 },
+ { 1, 3, 1, 2 },
+ { 1, 3, 3, 0 },
+ { 2, 0, 0, 3 },
+ { 2, 0, 2, 1 },
+ { 2, 2, 0, 1 },
+ { 2, 2, 2, 3 },
+ { 3, 1, 1, 2 },
+ { 3, 1, 3, 0 },
+ { 3, 3, 1, 0 },
+ { 3, 3, 3, 2 },
+ /* trans=6 y0=1 */
+ { 0, 1, 0, 0 },
+ { 0, 1, 2, 2 },
+ { 0, 3, 0, 2 },
+ { 0, 3, 2, 0 },
+ { 1, 0, 1, 1 },
+ { 1, 0, 3, 3 },
+ { 1, 2, 1, 3 },
+ { 1, 2, 3, 1 },
+ { 2, 1, 0, 2 },
+ { 2, 1, 2, 0 },
+ { 2, 3, 0, 0 },
+ { 2, 3, 2, 2 },
+ { 3, 0, 1, 3 },
+ { 3, 0, 3, 1 },
+ { 3, 2, 1, 1 },
+ { 3, 2, 3, 3 },
+ /* trans=7 y0=1 */
+ { 0, 1, 1, 1 },
+ { 0, 1, 3, 3 },
+ { 0, 3, 1, 3 },
+ { 0, 3, 3, 1 },
+ { 1, 0, 0, 0 },
+ { 1, 0, 2, 2 },
+ { 1, 2, 0, 2 },
+ { 1, 2, 2, 0 },
+ { 2, 1, 1, 3 },
+ { 2, 1, 3, 1 },
+ { 2, 3, 1, 1 },
+ { 2, 3, 3, 3 },
+ { 3, 0, 0, 2 },
+ { 3, 0, 2, 0 },
+ { 3, 2, 0, 0 },
+ { 3, 2, 2, 2 },
+};
+u8 trellis_trans_16[256][4] = {
+ /* trans=0 y0=0 */
+ { 0, 0, 0, 0 },
+ { 0, 0, 2, 2 },
+ { 0, 2, 0, 2 },
+ { 0, 2, 2, 0 },
+ { 2, 0, 0, 2 },
+ { 2, 0, 2, 0 },
+ { 2, 2, 0, 0 },
+ { 2, 2, 2, 2 },
+ /* trans=1 y0=0 */
+ { 0, 0, 1, 1 },
+ { 0, 0, 3, 3 },
+ { 0, 2, 1, 3 },
+ { 0, 2, 3, 1 },
+ { 2, 0, 1, 3 },
+ { 2, 0, 3, 1 },
+ { 2, 2, 1, 1 },
+ { 2, 2, 3, 3 },
+ /* trans=2 y0=0 */
+ { 1, 0, 1, 0 },
+ { 1, 0, 3, 2 },
+ { 1, 2, 1, 2 },
+ { 1, 2, 3, 0 },
+ { 3, 0, 1, 2 },
+ { 3, 0, 3, 0 },
+ { 3, 2, 1, 0 },
+ { 3, 2, 3, 2 },
+ /* trans=3 y0=0 */
+ { 1, 0, 0, 1 },
+ { 1, 0, 2, 3 },
+ { 1, 2, 0, 3 },
+ { 1, 2, 2, 1 },
+ { 3, 0, 0, 3 },
+ { 3, 0, 2, 1 },
+ { 3, 2, 0, 1 },
+ { 3, 2, 2, 3 },
+ /* trans=4 y0=0 */
+ { 0, 0, 0, 2 },
+ { 0, 0, 2, 0 },
+ { 0, 2, 0, 0 },
+ { 0, 2, 2, 2 },
+ { 2, 0, 0, 0 },
+ { 2, 0, 2, 2 },
+ { 2, 2, 0, 2 },
+ { 2, 2, 2, 0 },
+ /* trans=5 y0=0 */
+ { 0, 0, 1, 3 },
+ { 0, 0, 3, 1 },
+ { 0, 2, 1, 1 },
+ { 0, 2, 3, 3 },
+ { 2, 0, 1, 1 },
+ { 2, 0, 3, 3 },
+ { 2, 2, 1, 3 },
+ { 2, 2, 3, 1 },
+ /* trans=6 y0=0 */
+ { 1, 0, 1, 2 },
+ { 1, 0, 3, 0 },
+ { 1, 2, 1, 0 },
+ { 1, 2, 3, 2 },
+ { 3, 0, 1, 0 },
+ { 3, 0, 3, 2 },
+ { 3, 2, 1, 2 },
+ { 3, 2, 3, 0 },
+ /* trans=7 y0=0 */
+ { 1, 0, 0, 3 },
+ { 1, 0, 2, 1 },
+ { 1, 2, 0, 1 },
+ { 1, 2, 2, 3 },
+ { 3, 0, 0, 1 },
+ { 3, 0, 2, 3 },
+ { 3, 2, 0, 3 },
+ { 3, 2, 2, 1 },
+ /* trans=8 y0=0 */
+ { 1, 1, 1, 1 },
+ { 1, 1, 3, 3 },
+ { 1, 3, 1, 3 },
+ { 1, 3, 3, 1 },
+ { 3, 1, 1, 3 },
+ { 3, 1, 3, 1 },
+ { 3, 3, 1, 1 },
+ { 3, 3, 3, 3 },
+ /* trans=9 y0=0 */
+ { 1, 1, 0, 0 },
+ { 1, 1, 2, 2 },
+ { 1, 3, 0, 2 },
+ { 1, 3, 2, 0 },
+ { 3, 1, 0, 2 },
+ { 3, 1, 2, 0 },
+ { 3, 3, 0, 0 },
+ { 3, 3, 2, 2 },
+ /* trans=10 y0=0 */
+ { 0, 1, 0, 1 },
+ { 0, 1, 2, 3 },
+ { 0, 3, 0, 3 },
+ { 0, 3, 2, 1 },
+ { 2, 1, 0, 3 },
+ { 2, 1, 2, 1 },
+ { 2, 3, 0, 1 },
+ { 2, 3, 2, 3 },
+ /* trans=11 y0=0 */
+ { 0, 1, 1, 0 },
+ { 0, 1, 3, 2 },
+ { 0, 3, 1, 2 },
+ { 0, 3, 3, 0 },
+ { 2, 1, 1, 2 },
+ { 2, 1, 3, 0 },
+ { 2, 3, 1, 0 },
+ { 2, 3, 3, 2 },
+ /* trans=12 y0=0 */
+ { 1, 1, 1, 3 },
+ { 1, 1, 3, 1 },
+ { 1, 3, 1, 1 },
+ { 1, 3, 3, 3 },
+ { 3, 1, 1, 1 },
+ { 3, 1, 3, 3 },
+ { 3, 3, 1, 3 },
+ { 3, 3, 3, 1 },
+ /* trans=13 y0=0 */
+ { 1, 1, 0, 2 },
+ { 1, 1, 2, 0 },
+ { 1, 3, 0, 0 },
+ { 1, 3, 2, 2 },
+ { 3, 1, 0, 0 },
+ { 3, 1, 2, 2 },
+ { 3, 3, 0, 2 },
+ { 3, 3, 2, 0 },
+ /* trans=14 y0=0 */
+ { 0, 1, 0, 3 },
+ { 0, 1, 2, 1 },
+ { 0, 3, 0, 1 },
+ { 0, 3, 2, 3 },
+ { 2, 1, 0, 1 },
+ { 2, 1, 2, 3 },
+ { 2, 3, 0, 3 },
+ { 2, 3, 2, 1 },
+ /* trans=15 y0=0 */
+ { 0, 1, 1, 2 },
+ { 0, 1, 3, 0 },
+ { 0, 3, 1, 0 },
+ { 0, 3, 3, 2 },
+ { 2, 1, 1, 0 },
+ { 2, 1, 3, 2 },
+ { 2, 3, 1, 2 },
+ { 2, 3, 3, 0 },
+ /* trans=0 y0=1 */
+ { 0, 0, 1, 2 },
+ { 0, 0, 3, 0 },
+ { 0, 2, 1, 0 },
+ { 0, 2, 3, 2 },
+ { 2, 0, 1, 0 },
+ { 2, 0, 3, 2 },
+ { 2, 2, 1, 2 },
+ { 2, 2, 3, 0 },
+ /* trans=1 y0=1 */
+ { 0, 0, 0, 3 },
+ { 0, 0, 2, 1 },
+ { 0, 2, 0, 1 },
+ { 0, 2, 2, 3 },
+ { 2, 0, 0, 1 },
+ { 2, 0, 2, 3 },
+ { 2, 2, 0, 3 },
+ { 2, 2, 2, 1 },
+ /* trans=2 y0=1 */
+ { 1, 0, 1, 3 },
+ { 1, 0, 3, 1 },
+ { 1, 2, 1, 1 },
+ { 1, 2, 3, 3 },
+ { 3, 0, 1, 1 },
+ { 3, 0, 3, 3 },
+ { 3, 2, 1, 3 },
+ { 3, 2, 3, 1 },
+ /* trans=3 y0=1 */
+ { 1, 0, 0, 2 },
+ { 1, 0, 2, 0 },
+ { 1, 2, 0, 0 },
+ { 1, 2, 2, 2 },
+ { 3, 0, 0, 0 },
+ { 3, 0, 2, 2 },
+ { 3, 2, 0, 2 },
+ { 3, 2, 2, 0 },
+ /* trans=4 y0=1 */
+ { 0, 0, 1, 0 },
+ { 0, 0, 3, 2 },
+ { 0, 2, 1, 2 },
+ { 0, 2, 3, 0 },
+ { 2, 0, 1, 2 },
+ { 2, 0, 3, 0 },
+ { 2, 2, 1, 0 },
+ { 2, 2, 3, 2 },
+ /* trans=5 y0=1 */
+ { 0, 0, 0, 1 },
+ { 0, 0, 2, 3 },
+ { 0, 2, 0, 3 },
+ { 0, 2, 2, 1 },
+ { 2, 0, 0, 3 },
+ { 2, 0, 2, 1 },
+ { 2, 2, 0, 1 },
+ { 2, 2, 2, 3 },
+ /* trans=6 y0=1 */
+ { 1, 0, 1, 1 },
+ { 1, 0, 3, 3 },
+ { 1, 2, 1, 3 },
+ { 1, 2, 3, 1 },
+ { 3, 0, 1, 3 },
+ { 3, 0, 3, 1 },
+ { 3, 2, 1, 1 },
+ { 3, 2, 3, 3 },
+ /* trans=7 y0=1 */
+ { 1, 0, 0, 0 },
+ { 1, 0, 2, 2 },
+ { 1, 2, 0, 2 },
+ { 1, 2, 2, 0 },
+ { 3, 0, 0, 2 },
+ { 3, 0, 2, 0 },
+ { 3, 2, 0, 0 },
+ { 3, 2, 2, 2 },
+ /* trans=8 y0=1 */
+ { 1, 1, 0, 3 },
+ { 1, 1, 2, 1 },
+ { 1, 3, 0, 1 },
+ { 1, 3, 2, 3 },
+ { 3, 1, 0, 1 },
+ { 3, 1, 2, 3 },
+ { 3, 3, 0, 3 },
+ { 3, 3, 2, 1 },
+ /* trans=9 y0=1 */
+ { 1, 1, 1, 2 },
+ { 1, 1, 3, 0 },
+ { 1, 3, 1, 0 },
+ { 1, 3, 3, 2 },
+ { 3, 1, 1, 0 },
+ { 3, 1, 3, 2 },
+ { 3, 3, 1, 2 },
+ { 3, 3, 3, 0 },
+ /* trans=10 y0=1 */
+ { 0, 1, 0, 2 },
+ { 0, 1, 2, 0 },
+ { 0, 3, 0, 0 },
+ { 0, 3, 2, 2 },
+ { 2, 1, 0, 0 },
+ { 2, 1, 2, 2 },
+ { 2, 3, 0, 2 },
+ { 2, 3, 2, 0 },
+ /* trans=11 y0=1 */
+ { 0, 1, 1, 3 },
+ { 0, 1, 3, 1 },
+ { 0, 3, 1, 1 },
+ { 0, 3, 3, 3 },
+ { 2, 1, 1, 1 },
+ { 2, 1, 3, 3 },
+ { 2, 3, 1, 3 },
+ { 2, 3, 3, 1 },
+ /* trans=12 y0=1 */
+ { 1, 1, 0, 1 },
+ { 1, 1, 2, 3 },
+ { 1, 3, 0, 3 },
+ { 1, 3, 2, 1 },
+ { 3, 1, 0, 3 },
+ { 3, 1, 2, 1 },
+ { 3, 3, 0, 1 },
+ { 3, 3, 2, 3 },
+ /* trans=13 y0=1 */
+ { 1, 1, 1, 0 },
+ { 1, 1, 3, 2 },
+ { 1, 3, 1, 2 },
+ { 1, 3, 3, 0 },
+ { 3, 1, 1, 2 },
+ { 3, 1, 3, 0 },
+ { 3, 3, 1, 0 },
+ { 3, 3, 3, 2 },
+ /* trans=14 y0=1 */
+ { 0, 1, 0, 0 },
+ { 0, 1, 2, 2 },
+ { 0, 3, 0, 2 },
+ { 0, 3, 2, 0 },
+ { 2, 1, 0, 2 },
+ { 2, 1, 2, 0 },
+ { 2, 3, 0, 0 },
+ { 2, 3, 2, 2 },
+ /* trans=15 y0=1 */
+ { 0, 1, 1, 1 },
+ { 0, 1, 3, 3 },
+ { 0, 3, 1, 3 },
+ { 0, 3, 3, 1 },
+ { 2, 1, 1, 3 },
+ { 2, 1, 3, 1 },
+ { 2, 3, 1, 1 },
+ { 2, 3, 3, 3 },
+};
+/* S=2400 carrier=1600 alpha=0.016667 beta=0.100000 f0=0.022222 */
+s16 v34_rx_filter_2400_1600[480] __attribute__((aligned(16))) =
+{
+ /* phase 0 */
+  -163,     17,    383,    -63,    382,    588,      0,    703, 
+   522,   -165,    760,    -46,   -674,    458,  -1208,  -1398, 
+   -24,  -2932,  -1834,    -75,  -6118,    458,  16047,   8539, 
+ -5934,  -2554,    -78,  -3405,  -1035,   -415,  -1874,     51, 
+   -70,   -681,    722,    198,     26,    888,    189,    257, 
+   661,    -12,    196,    288,      0,      0,      0,      0, 
+ /* phase 1 */
+  -196,     89,    353,    -78,    469,    516,     12,    784, 
+   395,   -111,    807,   -232,   -553,    435,  -1442,  -1161, 
+  -170,  -3190,  -1354,   -517,  -6445,   2386,  16628,   6493, 
+ -6379,  -1784,   -446,  -3437,   -687,   -652,  -1785,    228, 
+  -240,   -559,    789,     76,    139,    880,    109,    345, 
+   613,    -53,    257,    228,      0,      0,      0,      0, 
+ /* phase 2 */
+  -217,    160,    310,    -75,    548,    433,     49,    845, 
+   265,    -28,    817,   -406,   -405,    358,  -1638,   -907, 
+  -394,  -3363,   -882,  -1094,  -6543,   4419,  16824,   4419, 
+ -6543,  -1094,   -882,  -3363,   -394,   -907,  -1638,    358, 
+  -405,   -406,    817,    -28,    265,    845,     49,    433, 
+   548,    -75,    310,    160,      0,      0,      0,      0, 
+ /* phase 3 */
+  -224,    228,    257,    -53,    613,    345,    109,    880, 
+   139,     76,    789,   -559,   -240,    228,  -1785,   -652, 
+  -687,  -3437,   -446,  -1784,  -6379,   6493,  16628,   2386, 
+ -6445,   -517,  -1354,  -3190,   -170,  -1161,  -1442,    435, 
+  -553,   -232,    807,   -111,    395,    784,     12,    516, 
+   469,    -78,    353,     89,      0,      0,      0,      0, 
+ /* phase 4 */
+  -217,    288,    196,    -12,    661,    257,    189,    888, 
+    26,    198,    722,   -681,    -70,     51,  -1874,   -415, 
+ -1035,  -3405,    -78,  -2554,  -5934,   8539,  16047,    458, 
+ -6118,    -75,  -1834,  -2932,    -24,  -1398,  -1208,    458, 
+  -674,    -46,    760,   -165,    522,    703,      0,    588, 
+   382,    -63,    383,     17,      0,      0,      0,      0, 
+ /* phase 5 */
+  -195,    338,    132,     45,    690,    174,    284,    866, 
+   -68,    328,    618,   -765,     93,   -166,  -1899,   -212, 
+ -1422,  -3266,    193,  -3366,  -5196,  10487,  15103,  -1307, 
+ -5601,    218,  -2289,  -2605,     41,  -1602,   -949,    429, 
+  -760,    141,    682,   -189,    638,    605,     11,    643, 
+   291,    -31,    396,    -50,      0,      0,      0,      0, 
+ /* phase 6 */
+  -159,    373,     70,    118,    696,    102,    390,    815, 
+  -138,    458,    482,   -808,    238,   -414,  -1860,    -60, 
+ -1827,  -3025,    344,  -4176,  -4167,  12272,  13829,  -2862, 
+ -4937,    356,  -2694,  -2229,     27,  -1759,   -680,    353, 
+  -806,    320,    579,   -179,    738,    499,     47,    680, 
+   201,     14,    393,   -109,      0,      0,      0,      0, 
+ /* phase 7 */
+  -109,    393,     14,    201,    680,     47,    499,    738, 
+  -179,    579,    320,   -806,    353,   -680,  -1759,     27, 
+ -2229,  -2694,    356,  -4937,  -2862,  13829,  12272,  -4167, 
+ -4176,    344,  -3025,  -1827,    -60,  -1860,   -414,    238, 
+  -808,    482,    458,   -138,    815,    390,    102,    696, 
+   118,     70,    373,   -159,      0,      0,      0,      0, 
+ /* phase 8 */
+   -50,    396,    -31,    291,    643,     11,    605,    638, 
+  -189,    682,    141,   -760,    429,   -949,  -1602,     41, 
+ -2605,  -2289,    218,  -5601,  -1307,  15103,  10488,  -5196, 
+ -3366,    193,  -3266,  -1422,   -212,  -1899,   -166,     93, 
+  -765,    618,    328,    -68,    866,    284,    174,    690, 
+    45,    132,    338,   -195,      0,      0,      0,      0, 
+ /* phase 9 */
+    17,    383,    -63,    382,    588,      0,    703,    522, 
+  -165,    760,    -46,   -674,    458,  -1208,  -1398,    -24, 
+ -2932,  -1834,    -75,  -6118,    458,  16047,   8539,  -5934, 
+ -2554,    -78,  -3405,  -1035,   -415,  -1874,     51,    -70, 
+  -681,    722,    198,     26,    888,    189,    257,    661, 
+   -12,    196,    288,   -217,      0,      0,      0,      0, 
+};
+/* S=2400 carrier=1800 alpha=0.016667 beta=0.100000 f0=0.025000 */
+s16 v34_rx_filter_2400_1800[480] __attribute__((aligned(16))) =
+{
+ /* phase 0 */
+   169,     77,   -375,     50,   -494,   -438,     16,   -644, 
+   287,    270,      0,   1331,    217,    722,   1150,  -1055, 
+   550,  -1383,  -3121,    -17,  -6505,  -2056,  15885,   6936, 
+ -7795,  -1915,  -1316,  -3155,    569,   -672,      0,   1436, 
+   -25,   1084,    684,   -144,    596,   -415,   -313,    -64, 
+  -696,    -55,   -193,   -230,      0,      0,      0,      0, 
+ /* phase 1 */
+   214,      0,   -349,     55,   -573,   -341,    -43,   -634, 
+   408,    152,    141,   1340,     87,    935,    908,  -1068, 
+   689,  -1891,  -2756,   -219,  -7204,      0,  16594,   4580, 
+ -7898,  -1182,  -1819,  -2806,    707,   -868,    315,   1307, 
+   -40,   1212,    494,    -65,    567,   -518,   -214,   -146, 
+  -678,      1,   -254,   -158,      0,      0,      0,      0, 
+ /* phase 2 */
+   249,    -79,   -308,     38,   -636,   -241,   -122,   -591, 
+   503,     36,    309,   1299,     -1,   1136,    624,  -1004, 
+   745,  -2376,  -2311,   -610,  -7687,   2239,  16834,   2239, 
+ -7687,   -610,  -2311,  -2376,    745,  -1004,    624,   1136, 
+    -1,   1299,    309,     36,    503,   -591,   -122,   -241, 
+  -636,     38,   -308,    -79,      0,      0,      0,      0, 
+ /* phase 3 */
+   273,   -158,   -254,      1,   -678,   -146,   -214,   -518, 
+   567,    -65,    494,   1212,    -40,   1307,    315,   -868, 
+   707,  -2806,  -1819,  -1182,  -7898,   4580,  16594,      0, 
+ -7204,   -219,  -2756,  -1891,    689,  -1068,    908,    935, 
+    87,   1340,    141,    152,    408,   -634,    -43,   -341, 
+  -573,     55,   -349,      0,      0,      0,      0,      0, 
+ /* phase 4 */
+   281,   -230,   -193,    -55,   -696,    -64,   -313,   -415, 
+   596,   -144,    684,   1084,    -25,   1436,      0,   -672, 
+   569,  -3155,  -1316,  -1915,  -7795,   6936,  15886,  -2056, 
+ -6505,    -17,  -3121,  -1383,    550,  -1055,   1150,    722, 
+   217,   1331,      0,    270,    287,   -644,     16,   -438, 
+  -494,     50,   -375,     77,      0,      0,      0,      0, 
+ /* phase 5 */
+   272,   -292,   -129,   -129,   -689,      1,   -411,   -290, 
+   589,   -193,    869,    925,     42,   1510,   -304,   -432, 
+   331,  -3400,   -844,  -2777,  -7346,   9217,  14738,  -3864, 
+ -5649,      0,  -3380,   -879,    347,   -965,   1339,    511, 
+   378,   1275,   -108,    382,    148,   -622,     51,   -528, 
+  -404,     26,   -382,    146,      0,      0,      0,      0, 
+ /* phase 6 */
+   246,   -340,    -67,   -216,   -657,     43,   -500,   -149, 
+   549,   -205,   1036,    746,    159,   1521,   -577,   -167, 
+     0,  -3524,   -442,  -3723,  -6538,  11334,  13200,  -5370, 
+ -4700,   -149,  -3518,   -410,    100,   -802,   1464,    319, 
+   559,   1174,   -177,    477,      0,   -573,     61,   -602, 
+  -309,    -14,   -370,    203,      0,      0,      0,      0, 
+ /* phase 7 */
+   203,   -370,    -14,   -309,   -602,     61,   -573,      0, 
+   477,   -177,   1174,    559,    319,   1464,   -802,    100, 
+  -410,  -3518,   -149,  -4700,  -5370,  13199,  11334,  -6537, 
+ -3723,   -442,  -3524,      0,   -167,   -577,   1521,    159, 
+   746,   1036,   -205,    549,   -149,   -500,     43,   -657, 
+  -216,    -67,   -340,    246,      0,      0,      0,      0, 
+ /* phase 8 */
+   146,   -382,     26,   -404,   -528,     51,   -622,    148, 
+   382,   -108,   1275,    378,    511,   1339,   -965,    347, 
+  -879,  -3380,      0,  -5649,  -3864,  14738,   9218,  -7346, 
+ -2777,   -844,  -3400,    331,   -432,   -304,   1510,     42, 
+   925,    869,   -193,    589,   -290,   -411,      1,   -689, 
+  -129,   -129,   -292,    272,      0,      0,      0,      0, 
+ /* phase 9 */
+    77,   -375,     50,   -494,   -438,     16,   -644,    287, 
+   270,      0,   1331,    217,    722,   1150,  -1055,    550, 
+ -1383,  -3121,    -17,  -6505,  -2056,  15885,   6936,  -7795, 
+ -1915,  -1316,  -3155,    569,   -672,      0,   1436,    -25, 
+  1084,    684,   -144,    596,   -415,   -313,    -64,   -696, 
+   -55,   -193,   -230,    281,      0,      0,      0,      0, 
+};
+/* S=2743 carrier=1646 alpha=0.004762 beta=0.100000 f0=0.005714 */
+s16 v34_rx_filter_2743_1646[1480] __attribute__((aligned(16))) =
+{
+ /* phase 0 */
+   193,    158,   -185,    249,   -267,   -236,     50,   -838, 
+  -119,   -622,  -1172,    -55,  -1724,   -833,   -524,  -2842, 
+   628,  -2632,  -3138,  13523,  11840,  -4173,  -1818,    277, 
+ -2869,   -252,  -1112,  -1533,    -56,  -1272,   -451,   -224, 
+  -795,    112,   -317,   -180,    224,   -198,      0,      0, 
+ /* phase 1 */
+   204,    143,   -179,    253,   -288,   -215,     31,   -844, 
+   -97,   -665,  -1141,    -64,  -1765,   -764,   -602,  -2816, 
+   698,  -2835,  -2831,  13901,  11381,  -4382,  -1619,    175, 
+ -2858,   -195,  -1180,  -1480,    -65,  -1291,   -410,   -252, 
+  -780,    123,   -335,   -158,    215,   -199,      0,      0, 
+ /* phase 2 */
+   214,    128,   -172,    255,   -307,   -193,     10,   -848, 
+   -75,   -709,  -1108,    -76,  -1802,   -695,   -683,  -2784, 
+   760,  -3037,  -2505,  14259,  10909,  -4570,  -1423,     67, 
+ -2840,   -143,  -1247,  -1424,    -77,  -1307,   -370,   -282, 
+  -763,    132,   -352,   -135,    205,   -198,      0,      0, 
+ /* phase 3 */
+   225,    112,   -164,    256,   -326,   -171,    -11,   -849, 
+   -56,   -753,  -1073,    -92,  -1836,   -627,   -768,  -2744, 
+   813,  -3237,  -2161,  14596,  10426,  -4739,  -1231,    -44, 
+ -2815,    -96,  -1312,  -1367,    -92,  -1320,   -332,   -312, 
+  -744,    140,   -369,   -112,    194,   -197,      0,      0, 
+ /* phase 4 */
+   235,     96,   -156,    255,   -344,   -149,    -35,   -848, 
+   -38,   -796,  -1036,   -111,  -1866,   -560,   -855,  -2697, 
+   858,  -3433,  -1799,  14913,   9932,  -4887,  -1044,   -160, 
+ -2784,    -55,  -1375,  -1308,   -111,  -1330,   -295,   -342, 
+  -723,    146,   -384,    -89,    183,   -194,      0,      0, 
+ /* phase 5 */
+   244,     80,   -146,    254,   -361,   -127,    -60,   -846, 
+   -22,   -839,   -997,   -134,  -1893,   -496,   -945,  -2643, 
+   894,  -3624,  -1420,  15207,   9429,  -5015,   -863,   -280, 
+ -2746,    -18,  -1437,  -1248,   -132,  -1337,   -259,   -373, 
+  -701,    150,   -399,    -66,    170,   -191,      0,      0, 
+ /* phase 6 */
+   253,     64,   -135,    251,   -377,   -105,    -86,   -841, 
+    -9,   -881,   -957,   -160,  -1916,   -433,  -1037,  -2582, 
+   920,  -3810,  -1024,  15478,   8918,  -5123,   -687,   -402, 
+ -2701,     11,  -1496,  -1187,   -156,  -1342,   -225,   -404, 
+  -678,    152,   -412,    -44,    157,   -186,      0,      0, 
+ /* phase 7 */
+   262,     48,   -124,    247,   -392,    -83,   -113,   -834, 
+     2,   -922,   -916,   -190,  -1934,   -372,  -1130,  -2514, 
+   937,  -3990,   -613,  15726,   8401,  -5212,   -519,   -526, 
+ -2651,     37,  -1553,  -1126,   -183,  -1343,   -193,   -435, 
+  -653,    152,   -424,    -21,    143,   -180,      0,      0, 
+ /* phase 8 */
+   270,     32,   -112,    241,   -406,    -62,   -141,   -825, 
+    11,   -962,   -873,   -222,  -1949,   -314,  -1225,  -2440, 
+   943,  -4163,   -186,  15949,   7878,  -5281,   -357,   -652, 
+ -2595,     57,  -1606,  -1064,   -213,  -1341,   -162,   -465, 
+  -627,    151,   -434,      0,    129,   -173,      0,      0, 
+ /* phase 9 */
+   277,     16,    -99,    234,   -418,    -41,   -170,   -815, 
+    18,  -1001,   -830,   -258,  -1959,   -259,  -1321,  -2359, 
+   940,  -4328,    254,  16148,   7351,  -5331,   -203,   -779, 
+ -2534,     71,  -1657,  -1002,   -245,  -1337,   -134,   -496, 
+  -599,    148,   -443,     21,    114,   -166,      0,      0, 
+ /* phase 10 */
+   284,      0,    -86,    226,   -429,    -21,   -200,   -802, 
+    23,  -1039,   -786,   -297,  -1965,   -207,  -1418,  -2273, 
+   926,  -4484,    708,  16321,   6822,  -5362,    -58,   -906, 
+ -2468,     80,  -1704,   -940,   -279,  -1329,   -108,   -526, 
+  -571,    143,   -451,     42,     99,   -157,      0,      0, 
+ /* phase 11 */
+   289,    -15,    -72,    217,   -439,     -1,   -231,   -787, 
+    26,  -1075,   -741,   -339,  -1967,   -159,  -1514,  -2181, 
+   901,  -4630,   1174,  16469,   6291,  -5375,     78,  -1033, 
+ -2397,     84,  -1748,   -879,   -315,  -1319,    -83,   -555, 
+  -542,    137,   -457,     63,     84,   -148,      0,      0, 
+ /* phase 12 */
+   294,    -30,    -57,    206,   -448,     17,   -262,   -771, 
+    26,  -1109,   -696,   -384,  -1964,   -114,  -1611,  -2083, 
+   866,  -4766,   1652,  16590,   5759,  -5370,    206,  -1159, 
+ -2322,     82,  -1788,   -818,   -352,  -1306,    -62,   -584, 
+  -512,    129,   -462,     82,     68,   -137,      0,      0, 
+ /* phase 13 */
+   299,    -46,    -42,    195,   -455,     35,   -293,   -752, 
+    23,  -1141,   -651,   -431,  -1957,    -73,  -1707,  -1981, 
+   820,  -4890,   2141,  16684,   5229,  -5348,    324,  -1285, 
+ -2243,     74,  -1825,   -758,   -392,  -1290,    -42,   -611, 
+  -482,    120,   -466,    101,     52,   -126,      0,      0, 
+ /* phase 14 */
+   302,    -60,    -27,    182,   -460,     52,   -324,   -732, 
+    19,  -1172,   -606,   -481,  -1946,    -37,  -1801,  -1874, 
+   764,  -5002,   2638,  16752,   4701,  -5309,    432,  -1408, 
+ -2160,     62,  -1857,   -699,   -433,  -1271,    -25,   -638, 
+  -451,    109,   -468,    119,     36,   -114,      0,      0, 
+ /* phase 15 */
+   305,    -75,    -11,    168,   -464,     68,   -356,   -711, 
+    11,  -1200,   -562,   -532,  -1930,     -5,  -1894,  -1762, 
+   697,  -5100,   3144,  16793,   4177,  -5255,    531,  -1529, 
+ -2074,     44,  -1886,   -642,   -475,  -1250,    -10,   -664, 
+  -419,     96,   -468,    136,     20,   -102,      0,      0, 
+ /* phase 16 */
+   306,    -89,      4,    153,   -467,     83,   -388,   -688, 
+     1,  -1226,   -518,   -586,  -1910,     22,  -1985,  -1647, 
+   619,  -5185,   3658,  16806,   3658,  -5185,    619,  -1647, 
+ -1985,     22,  -1910,   -586,   -518,  -1226,      1,   -688, 
+  -388,     83,   -467,    153,      4,    -89,      0,      0, 
+ /* phase 17 */
+   307,   -102,     20,    136,   -468,     96,   -419,   -664, 
+   -10,  -1250,   -475,   -642,  -1886,     44,  -2074,  -1529, 
+   531,  -5255,   4177,  16793,   3145,  -5100,    697,  -1762, 
+ -1894,     -5,  -1930,   -532,   -562,  -1200,     11,   -711, 
+  -356,     68,   -464,    168,    -11,    -75,      0,      0, 
+ /* phase 18 */
+   307,   -114,     36,    119,   -468,    109,   -451,   -638, 
+   -25,  -1271,   -433,   -699,  -1857,     62,  -2160,  -1408, 
+   432,  -5310,   4701,  16752,   2638,  -5002,    764,  -1874, 
+ -1801,    -37,  -1946,   -481,   -606,  -1172,     19,   -732, 
+  -324,     52,   -460,    182,    -27,    -60,      0,      0, 
+ /* phase 19 */
+   306,   -126,     52,    101,   -466,    120,   -482,   -611, 
+   -42,  -1290,   -392,   -758,  -1825,     74,  -2243,  -1285, 
+   324,  -5348,   5229,  16684,   2141,  -4890,    820,  -1981, 
+ -1707,    -73,  -1957,   -431,   -651,  -1141,     23,   -752, 
+  -293,     35,   -455,    195,    -42,    -46,      0,      0, 
+ /* phase 20 */
+   304,   -137,     68,     82,   -462,    129,   -512,   -584, 
+   -62,  -1306,   -352,   -818,  -1788,     82,  -2322,  -1160, 
+   206,  -5370,   5759,  16590,   1652,  -4766,    866,  -2083, 
+ -1611,   -114,  -1964,   -384,   -696,  -1109,     26,   -771, 
+  -262,     17,   -448,    206,    -57,    -30,      0,      0, 
+ /* phase 21 */
+   301,   -148,     84,     63,   -457,    137,   -542,   -555, 
+   -83,  -1319,   -315,   -879,  -1748,     84,  -2397,  -1033, 
+    78,  -5375,   6290,  16469,   1174,  -4630,    901,  -2181, 
+ -1515,   -159,  -1967,   -339,   -741,  -1075,     26,   -787, 
+  -231,     -1,   -439,    217,    -72,    -15,      0,      0, 
+ /* phase 22 */
+   297,   -157,     99,     42,   -451,    143,   -571,   -526, 
+  -108,  -1329,   -279,   -940,  -1704,     80,  -2468,   -906, 
+   -58,  -5362,   6821,  16321,    708,  -4484,    926,  -2273, 
+ -1418,   -207,  -1965,   -297,   -786,  -1039,     23,   -802, 
+  -200,    -21,   -429,    226,    -86,      0,      0,      0, 
+ /* phase 23 */
+   293,   -166,    114,     21,   -443,    148,   -599,   -496, 
+  -134,  -1337,   -245,  -1002,  -1657,     71,  -2534,   -779, 
+  -203,  -5331,   7351,  16148,    254,  -4328,    940,  -2359, 
+ -1321,   -259,  -1959,   -258,   -830,  -1001,     18,   -815, 
+  -170,    -41,   -418,    234,    -99,     16,      0,      0, 
+ /* phase 24 */
+   287,   -173,    129,      0,   -434,    151,   -627,   -465, 
+  -162,  -1341,   -213,  -1064,  -1606,     57,  -2595,   -652, 
+  -357,  -5281,   7878,  15949,   -186,  -4163,    944,  -2440, 
+ -1225,   -314,  -1949,   -222,   -873,   -962,     11,   -825, 
+  -141,    -62,   -406,    241,   -112,     32,      0,      0, 
+ /* phase 25 */
+   281,   -180,    143,    -21,   -424,    152,   -653,   -435, 
+  -193,  -1343,   -183,  -1126,  -1553,     37,  -2651,   -526, 
+  -519,  -5212,   8401,  15726,   -612,  -3990,    937,  -2514, 
+ -1130,   -372,  -1934,   -190,   -916,   -922,      2,   -834, 
+  -113,    -83,   -392,    247,   -124,     48,      0,      0, 
+ /* phase 26 */
+   273,   -186,    157,    -44,   -412,    152,   -678,   -404, 
+  -225,  -1342,   -156,  -1187,  -1496,     11,  -2701,   -402, 
+  -687,  -5123,   8918,  15478,  -1024,  -3810,    920,  -2582, 
+ -1037,   -433,  -1916,   -160,   -957,   -881,     -9,   -841, 
+   -86,   -105,   -377,    251,   -135,     64,      0,      0, 
+ /* phase 27 */
+   265,   -191,    170,    -66,   -399,    150,   -701,   -373, 
+  -259,  -1337,   -132,  -1248,  -1437,    -18,  -2746,   -280, 
+  -863,  -5015,   9429,  15207,  -1419,  -3624,    894,  -2643, 
+  -945,   -496,  -1893,   -134,   -997,   -839,    -22,   -846, 
+   -60,   -127,   -361,    254,   -146,     80,      0,      0, 
+ /* phase 28 */
+   256,   -194,    183,    -89,   -384,    146,   -723,   -342, 
+  -295,  -1330,   -111,  -1308,  -1375,    -55,  -2784,   -160, 
+ -1044,  -4887,   9932,  14913,  -1799,  -3433,    858,  -2697, 
+  -855,   -560,  -1866,   -111,  -1036,   -796,    -38,   -848, 
+   -35,   -149,   -344,    255,   -156,     96,      0,      0, 
+ /* phase 29 */
+   246,   -197,    194,   -112,   -369,    140,   -744,   -312, 
+  -332,  -1320,    -92,  -1367,  -1312,    -96,  -2815,    -44, 
+ -1231,  -4739,  10426,  14596,  -2161,  -3237,    814,  -2744, 
+  -768,   -627,  -1836,    -92,  -1073,   -753,    -56,   -849, 
+   -11,   -171,   -326,    256,   -164,    112,      0,      0, 
+ /* phase 30 */
+   235,   -198,    205,   -135,   -352,    132,   -763,   -282, 
+  -370,  -1307,    -77,  -1424,  -1247,   -143,  -2840,     67, 
+ -1423,  -4570,  10909,  14259,  -2505,  -3037,    760,  -2784, 
+  -683,   -695,  -1802,    -76,  -1108,   -709,    -75,   -848, 
+    10,   -193,   -307,    255,   -172,    128,      0,      0, 
+ /* phase 31 */
+   224,   -199,    215,   -158,   -335,    123,   -780,   -252, 
+  -410,  -1291,    -65,  -1480,  -1180,   -195,  -2858,    175, 
+ -1619,  -4382,  11381,  13901,  -2831,  -2835,    698,  -2816, 
+  -602,   -764,  -1765,    -64,  -1141,   -665,    -97,   -844, 
+    31,   -215,   -288,    253,   -179,    143,      0,      0, 
+ /* phase 32 */
+   212,   -198,    224,   -180,   -317,    112,   -795,   -224, 
+  -451,  -1272,    -56,  -1534,  -1112,   -252,  -2869,    277, 
+ -1818,  -4173,  11840,  13523,  -3138,  -2632,    628,  -2842, 
+  -524,   -833,  -1724,    -55,  -1172,   -622,   -119,   -838, 
+    50,   -236,   -267,    249,   -185,    158,      0,      0, 
+ /* phase 33 */
+   199,   -197,    232,   -203,   -298,     99,   -809,   -196, 
+  -493,  -1251,    -51,  -1585,  -1043,   -313,  -2873,    375, 
+ -2020,  -3944,  12285,  13128,  -3426,  -2428,    550,  -2859, 
+  -449,   -903,  -1681,    -50,  -1201,   -578,   -144,   -831, 
+    68,   -257,   -246,    245,   -190,    172,      0,      0, 
+ /* phase 34 */
+   186,   -194,    239,   -225,   -278,     84,   -821,   -169, 
+  -535,  -1227,    -49,  -1634,   -973,   -379,  -2870,    466, 
+ -2223,  -3695,  12714,  12714,  -3695,  -2223,    466,  -2870, 
+  -379,   -973,  -1634,    -49,  -1227,   -535,   -169,   -821, 
+    84,   -278,   -225,    239,   -194,    186,      0,      0, 
+ /* phase 35 */
+   172,   -190,    245,   -246,   -257,     68,   -830,   -144, 
+  -578,  -1201,    -50,  -1681,   -903,   -449,  -2859,    550, 
+ -2428,  -3426,  13127,  12285,  -3944,  -2020,    375,  -2873, 
+  -313,  -1043,  -1585,    -51,  -1251,   -493,   -196,   -809, 
+    99,   -298,   -203,    232,   -197,    199,      0,      0, 
+ /* phase 36 */
+   158,   -185,    249,   -267,   -236,     50,   -838,   -119, 
+  -622,  -1172,    -55,  -1724,   -833,   -524,  -2842,    628, 
+ -2632,  -3138,  13523,  11840,  -4173,  -1818,    277,  -2869, 
+  -252,  -1112,  -1533,    -56,  -1272,   -451,   -224,   -795, 
+   112,   -317,   -180,    224,   -198,    212,      0,      0, 
+};
+/* S=2743 carrier=1829 alpha=0.004762 beta=0.100000 f0=0.006349 */
+s16 v34_rx_filter_2743_1829[1480] __attribute__((aligned(16))) =
+{
+ /* phase 0 */
+  -116,    105,    315,    -18,    697,     87,    552,    532, 
+  -122,    794,   -682,     80,   -525,  -1682,    -22,  -3247, 
+  -632,  -2410,  -5066,  12998,  11039,  -5931,  -1547,  -1159, 
+ -2967,     40,  -1838,   -233,   -108,   -529,    799,   -187, 
+   663,    427,    168,    661,    -54,    366,      0,      0, 
+ /* phase 1 */
+  -127,    126,    300,     -5,    702,     70,    582,    496, 
+  -100,    785,   -713,    124,   -602,  -1632,    -54,  -3300, 
+  -510,  -2638,  -4790,  13439,  10509,  -6087,  -1348,  -1297, 
+ -2882,     39,  -1865,   -165,   -157,   -485,    792,   -197, 
+   692,    395,    191,    648,    -59,    377,      0,      0, 
+ /* phase 2 */
+  -137,    146,    284,      8,    704,     55,    612,    460, 
+   -76,    772,   -741,    166,   -679,  -1579,    -93,  -3344, 
+  -392,  -2869,  -4490,  13858,   9964,  -6219,  -1158,  -1435, 
+ -2791,     32,  -1887,   -100,   -206,   -438,    782,   -204, 
+   720,    364,    215,    633,    -62,    386,      0,      0, 
+ /* phase 3 */
+  -147,    166,    267,     23,    705,     41,    641,    423, 
+   -49,    757,   -766,    206,   -757,  -1522,   -139,  -3381, 
+  -281,  -3102,  -4168,  14254,   9408,  -6328,   -976,  -1573, 
+ -2695,     18,  -1904,    -37,   -255,   -390,    770,   -209, 
+   745,    334,    240,    617,    -64,    394,      0,      0, 
+ /* phase 4 */
+  -156,    186,    250,     40,    704,     29,    669,    385, 
+   -21,    738,   -787,    244,   -834,  -1461,   -191,  -3410, 
+  -176,  -3336,  -3822,  14626,   8842,  -6413,   -804,  -1711, 
+ -2595,      0,  -1915,     21,   -304,   -340,    754,   -211, 
+   769,    303,    265,    599,    -64,    401,      0,      0, 
+ /* phase 5 */
+  -164,    206,    233,     58,    702,     19,    695,    347, 
+     8,    716,   -805,    279,   -912,  -1397,   -250,  -3430, 
+   -78,  -3571,  -3455,  14972,   8267,  -6475,   -642,  -1847, 
+ -2491,    -25,  -1921,     77,   -352,   -289,    736,   -210, 
+   791,    274,    290,    580,    -63,    406,      0,      0, 
+ /* phase 6 */
+  -172,    225,    215,     78,    697,     10,    721,    310, 
+    40,    691,   -820,    311,   -988,  -1331,   -314,  -3442, 
+    11,  -3804,  -3065,  15292,   7684,  -6515,   -490,  -1981, 
+ -2383,    -56,  -1922,    130,   -399,   -237,    716,   -206, 
+   811,    246,    316,    560,    -60,    410,      0,      0, 
+ /* phase 7 */
+  -178,    244,    197,     98,    691,      3,    745,    272, 
+    73,    663,   -831,    340,  -1064,  -1263,   -385,  -3445, 
+    93,  -4035,  -2655,  15584,   7097,  -6533,   -350,  -2112, 
+ -2273,    -93,  -1918,    179,   -445,   -184,    692,   -200, 
+   828,    218,    342,    539,    -56,    413,      0,      0, 
+ /* phase 8 */
+  -183,    262,    178,    120,    683,      0,    767,    234, 
+   107,    632,   -838,    366,  -1139,  -1192,   -461,  -3439, 
+   165,  -4262,  -2225,  15848,   6505,  -6529,   -222,  -2241, 
+ -2160,   -134,  -1908,    224,   -490,   -130,    667,   -191, 
+   843,    192,    368,    517,    -50,    414,      0,      0, 
+ /* phase 9 */
+  -187,    279,    160,    142,    673,     -3,    788,    197, 
+   143,    598,   -841,    388,  -1212,  -1120,   -542,  -3424, 
+   228,  -4485,  -1775,  16082,   5911,  -6505,   -105,  -2365, 
+ -2046,   -180,  -1893,    266,   -532,    -75,    640,   -180, 
+   856,    167,    394,    494,    -43,    414,      0,      0, 
+ /* phase 10 */
+  -190,    296,    142,    165,    661,     -4,    807,    161, 
+   179,    562,   -841,    407,  -1282,  -1047,   -629,  -3400, 
+   281,  -4702,  -1307,  16287,   5317,  -6461,      0,  -2484, 
+ -1930,   -231,  -1872,    303,   -573,    -21,    610,   -166, 
+   867,    143,    419,    470,    -35,    413,      0,      0, 
+ /* phase 11 */
+  -192,    312,    123,    189,    648,     -2,    824,    125, 
+   216,    523,   -837,    422,  -1351,   -973,   -721,  -3368, 
+   323,  -4913,   -822,  16462,   4723,  -6397,     91,  -2599, 
+ -1814,   -286,  -1847,    335,   -612,     33,    579,   -149, 
+   875,    121,    445,    445,    -25,    410,      0,      0, 
+ /* phase 12 */
+  -193,    327,    106,    214,    633,      0,    840,     91, 
+   254,    481,   -830,    433,  -1417,   -899,   -817,  -3327, 
+   354,  -5115,   -320,  16605,   4132,  -6316,    170,  -2708, 
+ -1697,   -344,  -1817,    364,   -648,     87,    547,   -130, 
+   880,    100,    469,    420,    -14,    406,      0,      0, 
+ /* phase 13 */
+  -192,    340,     88,    239,    617,      6,    853,     57, 
+   291,    438,   -819,    439,  -1480,   -825,   -917,  -3277, 
+   374,  -5309,    196,  16717,   3546,  -6216,    237,  -2811, 
+ -1580,   -406,  -1781,    388,   -681,    140,    513,   -109, 
+   884,     81,    493,    395,     -2,    400,      0,      0, 
+ /* phase 14 */
+  -191,    353,     71,    265,    599,     13,    864,     25, 
+   329,    392,   -804,    442,  -1540,   -752,  -1021,  -3219, 
+   382,  -5492,    727,  16797,   2965,  -6101,    291,  -2907, 
+ -1465,   -471,  -1742,    408,   -712,    193,    477,    -86, 
+   884,     64,    517,    369,     10,    393,      0,      0, 
+ /* phase 15 */
+  -188,    365,     55,    291,    580,     23,    872,     -4, 
+   367,    345,   -786,    440,  -1596,   -679,  -1128,  -3153, 
+   378,  -5664,   1271,  16845,   2391,  -5969,    333,  -2996, 
+ -1351,   -538,  -1697,    423,   -740,    245,    441,    -61, 
+   883,     48,    539,    343,     24,    385,      0,      0, 
+ /* phase 16 */
+  -184,    376,     39,    317,    560,     35,    879,    -34, 
+   404,    296,   -765,    433,  -1649,   -608,  -1238,  -3079, 
+   362,  -5823,   1826,  16862,   1826,  -5823,    362,  -3079, 
+ -1238,   -608,  -1649,    433,   -765,    296,    404,    -34, 
+   879,     35,    560,    317,     39,    376,      0,      0, 
+ /* phase 17 */
+  -178,    385,     24,    343,    539,     48,    883,    -61, 
+   441,    245,   -740,    423,  -1697,   -538,  -1351,  -2997, 
+   333,  -5969,   2391,  16845,   1271,  -5664,    378,  -3153, 
+ -1128,   -679,  -1596,    440,   -786,    345,    367,     -5, 
+   872,     23,    580,    291,     55,    365,      0,      0, 
+ /* phase 18 */
+  -172,    393,     10,    369,    517,     64,    884,    -86, 
+   477,    193,   -712,    408,  -1742,   -471,  -1465,  -2907, 
+   291,  -6101,   2965,  16797,    727,  -5492,    382,  -3219, 
+ -1021,   -752,  -1540,    442,   -804,    392,    329,     25, 
+   864,     13,    599,    265,     71,    353,      0,      0, 
+ /* phase 19 */
+  -164,    400,     -2,    395,    493,     81,    884,   -109, 
+   513,    140,   -681,    388,  -1781,   -406,  -1580,  -2811, 
+   237,  -6217,   3546,  16717,    196,  -5309,    374,  -3277, 
+  -917,   -825,  -1480,    439,   -819,    438,    291,     57, 
+   853,      6,    617,    239,     88,    340,      0,      0, 
+ /* phase 20 */
+  -155,    406,    -14,    420,    469,    100,    880,   -130, 
+   547,     87,   -648,    364,  -1817,   -344,  -1697,  -2708, 
+   170,  -6316,   4132,  16605,   -320,  -5115,    354,  -3327, 
+  -817,   -899,  -1417,    433,   -830,    481,    254,     91, 
+   840,      0,    633,    214,    106,    327,      0,      0, 
+ /* phase 21 */
+  -145,    410,    -25,    445,    445,    121,    875,   -149, 
+   579,     33,   -612,    335,  -1847,   -286,  -1813,  -2599, 
+    91,  -6398,   4723,  16462,   -822,  -4913,    323,  -3368, 
+  -721,   -973,  -1351,    422,   -837,    523,    216,    125, 
+   824,     -2,    648,    189,    123,    312,      0,      0, 
+ /* phase 22 */
+  -134,    413,    -35,    470,    419,    143,    867,   -166, 
+   610,    -21,   -573,    303,  -1872,   -231,  -1930,  -2484, 
+     0,  -6461,   5317,  16287,  -1307,  -4702,    281,  -3400, 
+  -629,  -1047,  -1282,    407,   -841,    562,    179,    161, 
+   807,     -4,    661,    165,    142,    296,      0,      0, 
+ /* phase 23 */
+  -122,    414,    -43,    494,    394,    167,    856,   -180, 
+   640,    -75,   -532,    266,  -1893,   -180,  -2046,  -2365, 
+  -105,  -6505,   5911,  16083,  -1775,  -4485,    228,  -3424, 
+  -543,  -1120,  -1212,    388,   -841,    598,    143,    197, 
+   788,     -3,    673,    142,    160,    279,      0,      0, 
+ /* phase 24 */
+  -109,    414,    -50,    517,    368,    192,    843,   -191, 
+   667,   -130,   -490,    224,  -1908,   -134,  -2160,  -2241, 
+  -222,  -6529,   6505,  15848,  -2225,  -4262,    165,  -3439, 
+  -461,  -1192,  -1139,    366,   -838,    632,    107,    234, 
+   767,      0,    683,    120,    178,    262,      0,      0, 
+ /* phase 25 */
+   -95,    413,    -56,    539,    342,    218,    828,   -200, 
+   692,   -184,   -445,    179,  -1918,    -93,  -2273,  -2113, 
+  -350,  -6533,   7096,  15584,  -2655,  -4035,     93,  -3445, 
+  -385,  -1263,  -1064,    340,   -831,    663,     73,    272, 
+   745,      3,    691,     98,    197,    244,      0,      0, 
+ /* phase 26 */
+   -80,    410,    -60,    560,    316,    246,    811,   -206, 
+   716,   -237,   -399,    130,  -1922,    -56,  -2383,  -1981, 
+  -490,  -6515,   7684,  15292,  -3065,  -3804,     11,  -3442, 
+  -314,  -1331,   -988,    311,   -820,    691,     40,    310, 
+   721,     10,    697,     78,    215,    225,      0,      0, 
+ /* phase 27 */
+   -64,    406,    -63,    580,    290,    274,    791,   -210, 
+   736,   -289,   -352,     77,  -1921,    -25,  -2491,  -1847, 
+  -642,  -6475,   8266,  14972,  -3454,  -3571,    -78,  -3430, 
+  -250,  -1397,   -912,    279,   -805,    716,      8,    347, 
+   695,     19,    702,     58,    233,    206,      0,      0, 
+ /* phase 28 */
+   -47,    401,    -64,    599,    265,    303,    769,   -211, 
+   754,   -340,   -304,     21,  -1915,      0,  -2595,  -1711, 
+  -804,  -6413,   8842,  14626,  -3822,  -3336,   -176,  -3410, 
+  -191,  -1461,   -834,    244,   -787,    738,    -21,    385, 
+   669,     29,    704,     40,    250,    186,      0,      0, 
+ /* phase 29 */
+   -29,    394,    -64,    617,    240,    334,    745,   -209, 
+   770,   -390,   -255,    -37,  -1904,     18,  -2695,  -1573, 
+  -976,  -6328,   9408,  14254,  -4168,  -3102,   -281,  -3381, 
+  -139,  -1522,   -757,    206,   -766,    757,    -49,    423, 
+   641,     41,    705,     23,    267,    166,      0,      0, 
+ /* phase 30 */
+   -11,    386,    -62,    633,    215,    364,    720,   -204, 
+   782,   -438,   -206,   -100,  -1887,     32,  -2791,  -1435, 
+ -1158,  -6219,   9964,  13858,  -4490,  -2869,   -392,  -3344, 
+   -93,  -1579,   -679,    166,   -741,    772,    -76,    460, 
+   612,     55,    704,      8,    284,    146,      0,      0, 
+ /* phase 31 */
+     6,    377,    -59,    648,    191,    395,    692,   -197, 
+   792,   -485,   -157,   -165,  -1865,     39,  -2882,  -1297, 
+ -1348,  -6087,  10508,  13439,  -4790,  -2638,   -510,  -3300, 
+   -54,  -1632,   -602,    124,   -713,    785,   -100,    496, 
+   582,     70,    702,     -5,    300,    126,      0,      0, 
+ /* phase 32 */
+    26,    366,    -54,    661,    168,    427,    663,   -187, 
+   799,   -529,   -108,   -233,  -1838,     40,  -2967,  -1159, 
+ -1547,  -5931,  11039,  12998,  -5066,  -2410,   -632,  -3247, 
+   -22,  -1682,   -525,     80,   -682,    794,   -122,    532, 
+   552,     87,    697,    -18,    315,    105,      0,      0, 
+ /* phase 33 */
+    45,    355,    -47,    672,    146,    458,    632,   -174, 
+   802,   -571,    -59,   -304,  -1806,     34,  -3047,  -1024, 
+ -1754,  -5751,  11555,  12536,  -5318,  -2186,   -759,  -3187, 
+     3,  -1728,   -450,     35,   -648,    800,   -142,    566, 
+   521,    106,    691,    -29,    329,     85,      0,      0, 
+ /* phase 34 */
+    65,    343,    -39,    682,    125,    490,    600,   -159, 
+   803,   -611,    -11,   -376,  -1769,     22,  -3121,   -890, 
+ -1967,  -5546,  12054,  12054,  -5546,  -1967,   -890,  -3121, 
+    22,  -1769,   -376,    -11,   -611,    803,   -159,    600, 
+   490,    125,    682,    -39,    343,     65,      0,      0, 
+ /* phase 35 */
+    85,    329,    -29,    691,    106,    521,    566,   -142, 
+   800,   -648,     35,   -450,  -1728,      3,  -3187,   -759, 
+ -2186,  -5318,  12535,  11555,  -5750,  -1754,  -1023,  -3047, 
+    34,  -1806,   -304,    -59,   -571,    802,   -175,    632, 
+   458,    146,    672,    -47,    355,     45,      0,      0, 
+ /* phase 36 */
+   105,    315,    -18,    697,     87,    552,    532,   -122, 
+   794,   -682,     80,   -525,  -1682,    -22,  -3247,   -632, 
+ -2410,  -5066,  12998,  11039,  -5931,  -1547,  -1159,  -2967, 
+    40,  -1838,   -233,   -108,   -529,    799,   -187,    663, 
+   427,    168,    661,    -54,    366,     26,      0,      0, 
+};
+/* S=2800 carrier=1680 alpha=0.008333 beta=0.100000 f0=0.010000 */
+s16 v34_rx_filter_2800_1680[880] __attribute__((aligned(16))) =
+{
+ /* phase 0 */
+   176,    124,   -218,    272,   -367,   -140,    -45,   -856, 
+    35,   -920,   -851,   -198,  -1939,   -152,  -1444,  -2091, 
+   918,  -4817,   2466,  16798,   4251,  -5155,    705,  -1720, 
+ -1780,      1,  -1934,   -345,   -692,  -1057,     64,   -822, 
+  -146,    -57,   -427,    266,   -181,     62,      0,      0, 
+ /* phase 1 */
+   199,     93,   -201,    271,   -399,    -98,    -94,   -842, 
+    53,   -991,   -772,   -267,  -1943,    -69,  -1614,  -1913, 
+   828,  -5007,   3348,  16840,   3348,  -5007,    828,  -1913, 
+ -1614,    -69,  -1943,   -267,   -772,   -991,     53,   -842, 
+   -94,    -98,   -399,    271,   -201,     93,      0,      0, 
+ /* phase 2 */
+   220,     62,   -181,    266,   -427,    -57,   -146,   -822, 
+    64,  -1057,   -692,   -345,  -1934,      1,  -1780,  -1720, 
+   705,  -5155,   4251,  16798,   2466,  -4817,    918,  -2091, 
+ -1444,   -152,  -1939,   -198,   -851,   -920,     35,   -856, 
+   -45,   -140,   -367,    272,   -218,    124,      0,      0, 
+ /* phase 3 */
+   240,     30,   -158,    256,   -451,    -17,   -201,   -795, 
+    67,  -1118,   -611,   -432,  -1912,     58,  -1941,  -1517, 
+   550,  -5258,   5169,  16674,   1610,  -4590,    975,  -2254, 
+ -1275,   -245,  -1921,   -138,   -927,   -846,     10,   -864, 
+     0,   -182,   -333,    268,   -232,    153,      0,      0, 
+ /* phase 4 */
+   258,     -1,   -133,    242,   -471,     19,   -257,   -762, 
+    62,  -1173,   -530,   -525,  -1876,    101,  -2096,  -1304, 
+   365,  -5312,   6095,  16469,    787,  -4330,   1000,  -2399, 
+ -1106,   -348,  -1890,    -88,   -999,   -769,    -20,   -864, 
+    41,   -224,   -295,    260,   -242,    180,      0,      0, 
+ /* phase 5 */
+   274,    -32,   -105,    224,   -486,     54,   -315,   -725, 
+    49,  -1221,   -451,   -624,  -1827,    129,  -2240,  -1085, 
+   149,  -5313,   7022,  16184,      1,  -4042,    994,  -2525, 
+  -942,   -459,  -1846,    -49,  -1066,   -691,    -57,   -858, 
+    77,   -264,   -255,    249,   -249,    206,      0,      0, 
+ /* phase 6 */
+   287,    -63,    -76,    202,   -497,     86,   -373,   -682, 
+    29,  -1262,   -376,   -728,  -1766,    140,  -2373,   -862, 
+   -93,  -5260,   7943,  15822,   -740,  -3730,    957,  -2630, 
+  -783,   -575,  -1791,    -21,  -1128,   -613,    -99,   -846, 
+   108,   -303,   -214,    233,   -252,    229,      0,      0, 
+ /* phase 7 */
+   298,    -93,    -45,    176,   -502,    114,   -431,   -635, 
+     0,  -1294,   -304,   -835,  -1693,    135,  -2492,   -639, 
+  -362,  -5149,   8852,  15385,  -1437,  -3400,    891,  -2714, 
+  -633,   -696,  -1725,     -4,  -1182,   -534,   -146,   -827, 
+   134,   -340,   -171,    215,   -251,    250,      0,      0, 
+ /* phase 8 */
+   305,   -121,    -13,    146,   -503,    137,   -488,   -584, 
+   -35,  -1318,   -238,   -944,  -1609,    113,  -2596,   -419, 
+  -654,  -4978,   9741,  14877,  -2082,  -3056,    797,  -2776, 
+  -492,   -819,  -1649,      1,  -1230,   -458,   -196,   -801, 
+   155,   -374,   -128,    193,   -246,    268,      0,      0, 
+ /* phase 9 */
+   310,   -147,     18,    113,   -498,    156,   -543,   -531, 
+   -78,  -1333,   -178,  -1054,  -1515,     74,  -2683,   -204, 
+  -967,  -4747,  10605,  14302,  -2673,  -2703,    679,  -2815, 
+  -362,   -943,  -1565,     -3,  -1269,   -383,   -250,   -770, 
+   169,   -405,    -85,    168,   -238,    283,      0,      0, 
+ /* phase 10 */
+   311,   -171,     50,     78,   -489,    170,   -596,   -476, 
+  -128,  -1338,   -125,  -1163,  -1412,     18,  -2751,      1, 
+ -1296,  -4454,  11435,  13666,  -3208,  -2346,    537,  -2832, 
+  -245,  -1066,  -1473,    -19,  -1300,   -313,   -305,   -733, 
+   178,   -433,    -42,    141,   -226,    295,      0,      0, 
+ /* phase 11 */
+   309,   -192,     81,     39,   -475,    178,   -646,   -419, 
+  -184,  -1335,    -81,  -1270,  -1303,    -53,  -2799,    196, 
+ -1638,  -4100,  12226,  12972,  -3684,  -1990,    375,  -2827, 
+  -141,  -1187,  -1374,    -45,  -1322,   -246,   -362,   -692, 
+   181,   -456,      0,    112,   -211,    304,      0,      0, 
+ /* phase 12 */
+   304,   -211,    112,      0,   -456,    181,   -692,   -362, 
+  -246,  -1322,    -45,  -1374,  -1187,   -141,  -2827,    375, 
+ -1990,  -3684,  12972,  12226,  -4100,  -1638,    196,  -2799, 
+   -53,  -1302,  -1270,    -81,  -1335,   -184,   -419,   -646, 
+   178,   -475,     39,     81,   -192,    309,      0,      0, 
+ /* phase 13 */
+   295,   -226,    141,    -42,   -433,    178,   -733,   -305, 
+  -312,  -1300,    -19,  -1472,  -1066,   -245,  -2832,    537, 
+ -2346,  -3208,  13665,  11435,  -4454,  -1296,      1,  -2751, 
+    18,  -1412,  -1163,   -125,  -1338,   -128,   -476,   -596, 
+   170,   -489,     78,     50,   -171,    311,      0,      0, 
+ /* phase 14 */
+   283,   -238,    168,    -85,   -405,    169,   -770,   -250, 
+  -383,  -1269,     -3,  -1565,   -943,   -362,  -2815,    679, 
+ -2703,  -2674,  14302,  10605,  -4747,   -967,   -204,  -2683, 
+    74,  -1515,  -1054,   -178,  -1333,    -78,   -531,   -543, 
+   156,   -498,    113,     18,   -147,    310,      0,      0, 
+ /* phase 15 */
+   268,   -246,    193,   -128,   -374,    155,   -801,   -196, 
+  -458,  -1230,      1,  -1649,   -819,   -492,  -2776,    797, 
+ -3056,  -2082,  14877,   9742,  -4978,   -654,   -419,  -2596, 
+   113,  -1609,   -944,   -238,  -1318,    -35,   -584,   -488, 
+   137,   -503,    146,    -13,   -121,    305,      0,      0, 
+ /* phase 16 */
+   250,   -251,    215,   -171,   -340,    134,   -827,   -146, 
+  -534,  -1182,     -4,  -1725,   -696,   -633,  -2714,    891, 
+ -3400,  -1437,  15385,   8852,  -5149,   -362,   -639,  -2492, 
+   135,  -1693,   -835,   -304,  -1294,      0,   -635,   -431, 
+   114,   -502,    176,    -45,    -93,    298,      0,      0, 
+ /* phase 17 */
+   229,   -252,    233,   -214,   -303,    108,   -846,    -99, 
+  -613,  -1128,    -21,  -1791,   -575,   -783,  -2630,    957, 
+ -3730,   -741,  15822,   7943,  -5260,    -93,   -862,  -2373, 
+   140,  -1766,   -728,   -376,  -1262,     29,   -682,   -373, 
+    86,   -497,    202,    -76,    -63,    287,      0,      0, 
+ /* phase 18 */
+   206,   -249,    249,   -255,   -264,     77,   -858,    -57, 
+  -691,  -1066,    -49,  -1846,   -459,   -942,  -2525,    994, 
+ -4042,      1,  16184,   7022,  -5313,    149,  -1085,  -2240, 
+   129,  -1827,   -624,   -451,  -1221,     49,   -725,   -315, 
+    54,   -486,    224,   -105,    -32,    274,      0,      0, 
+ /* phase 19 */
+   180,   -242,    261,   -295,   -224,     41,   -864,    -20, 
+  -769,   -999,    -88,  -1890,   -348,  -1106,  -2399,   1000, 
+ -4330,    787,  16469,   6095,  -5312,    365,  -1304,  -2096, 
+   101,  -1876,   -525,   -530,  -1173,     62,   -762,   -257, 
+    19,   -471,    242,   -133,     -1,    258,      0,      0, 
+ /* phase 20 */
+   153,   -232,    268,   -333,   -182,      0,   -864,     10, 
+  -846,   -927,   -138,  -1921,   -245,  -1275,  -2254,    975, 
+ -4590,   1610,  16674,   5169,  -5258,    550,  -1517,  -1941, 
+    59,  -1912,   -432,   -610,  -1118,     67,   -795,   -201, 
+   -17,   -451,    256,   -158,     30,    240,      0,      0, 
+ /* phase 21 */
+   124,   -218,    272,   -367,   -140,    -45,   -856,     35, 
+  -920,   -851,   -198,  -1939,   -152,  -1444,  -2091,    918, 
+ -4817,   2466,  16798,   4251,  -5155,    705,  -1720,  -1780, 
+     1,  -1934,   -345,   -692,  -1057,     64,   -822,   -146, 
+   -57,   -427,    266,   -181,     62,    220,      0,      0, 
+};
+/* S=2800 carrier=1867 alpha=0.008333 beta=0.100000 f0=0.011111 */
+s16 v34_rx_filter_2800_1867[880] __attribute__((aligned(16))) =
+{
+ /* phase 0 */
+  -155,    118,    261,     28,    696,     52,    704,    353, 
+    85,    683,   -791,    391,  -1193,  -1046,   -684,  -3357, 
+   332,  -5287,    435,  16774,   2365,  -5886,    347,  -3170, 
+ -1030,   -791,  -1428,    446,   -792,    566,    204,    226, 
+   785,     28,    682,     91,    204,    186,      0,      0, 
+ /* phase 1 */
+  -171,    153,    233,     58,    692,     37,    746,    289, 
+   143,    629,   -797,    424,  -1315,   -919,   -851,  -3276, 
+   357,  -5605,   1383,  16824,   1383,  -5605,    357,  -3276, 
+  -851,   -919,  -1315,    424,   -797,    629,    143,    289, 
+   746,     37,    692,     58,    233,    153,      0,      0, 
+ /* phase 2 */
+  -185,    186,    204,     91,    682,     28,    785,    226, 
+   204,    566,   -792,    446,  -1428,   -791,  -1030,  -3170, 
+   347,  -5886,   2364,  16774,    435,  -5287,    332,  -3357, 
+  -684,  -1046,  -1193,    391,   -791,    683,     85,    353, 
+   704,     52,    696,     28,    261,    118,      0,      0, 
+ /* phase 3 */
+  -197,    218,    174,    127,    668,     24,    818,    165, 
+   267,    496,   -777,    455,  -1532,   -665,  -1219,  -3038, 
+   298,  -6125,   3373,  16627,   -471,  -4939,    271,  -3412, 
+  -531,  -1172,  -1066,    347,   -774,    729,     32,    417, 
+   657,     73,    694,      2,    287,     84,      0,      0, 
+ /* phase 4 */
+  -205,    249,    144,    166,    649,     26,    845,    107, 
+   331,    419,   -750,    451,  -1625,   -544,  -1415,  -2884, 
+   211,  -6316,   4399,  16383,  -1331,  -4567,    178,  -3440, 
+  -393,  -1292,   -935,    294,   -746,    766,    -16,    480, 
+   608,     98,    687,    -18,    311,     49,      0,      0, 
+ /* phase 5 */
+  -211,    277,    114,    207,    625,     34,    867,     52, 
+   396,    337,   -714,    434,  -1706,   -428,  -1617,  -2709, 
+    85,  -6455,   5436,  16045,  -2137,  -4176,     54,  -3440, 
+  -274,  -1406,   -801,    232,   -708,    794,    -59,    541, 
+   556,    128,    675,    -35,    332,     15,      0,      0, 
+ /* phase 6 */
+  -213,    303,     85,    250,    596,     49,    882,      2, 
+   459,    250,   -667,    404,  -1774,   -321,  -1820,  -2516, 
+   -79,  -6536,   6475,  15616,  -2886,  -3773,    -95,  -3415, 
+  -172,  -1511,   -666,    162,   -660,    811,    -95,    599, 
+   503,    161,    658,    -48,    350,    -17,      0,      0, 
+ /* phase 7 */
+  -211,    325,     58,    294,    564,     69,    890,    -41, 
+   520,    159,   -612,    360,  -1827,   -225,  -2023,  -2307, 
+  -281,  -6555,   7507,  15099,  -3571,  -3365,   -270,  -3363, 
+   -90,  -1607,   -532,     87,   -602,    819,   -124,    654, 
+   450,    198,    636,    -56,    365,    -48,      0,      0, 
+ /* phase 8 */
+  -206,    345,     32,    338,    528,     95,    891,    -80, 
+   578,     67,   -549,    303,  -1866,   -141,  -2222,  -2084, 
+  -519,  -6509,   8524,  14499,  -4190,  -2956,   -465,  -3287, 
+   -28,  -1690,   -402,      7,   -537,    818,   -146,    705, 
+   397,    237,    609,    -59,    376,    -78,      0,      0, 
+ /* phase 9 */
+  -198,    361,      9,    382,    490,    126,    885,   -112, 
+   632,    -26,   -480,    233,  -1888,    -72,  -2415,  -1853, 
+  -791,  -6395,   9516,  13823,  -4739,  -2552,   -676,  -3188, 
+    12,  -1761,   -276,    -74,   -464,    807,   -160,    750, 
+   345,    279,    579,    -58,    384,   -105,      0,      0, 
+ /* phase 10 */
+  -186,    374,    -11,    425,    449,    162,    872,   -137, 
+   681,   -119,   -405,    151,  -1894,    -18,  -2599,  -1615, 
+ -1095,  -6210,  10476,  13075,  -5217,  -2160,   -901,  -3067, 
+    34,  -1817,   -156,   -158,   -384,    787,   -167,    790, 
+   294,    321,    545,    -52,    387,   -130,      0,      0, 
+ /* phase 11 */
+  -170,    382,    -29,    467,    407,    202,    851,   -155, 
+   724,   -210,   -325,     58,  -1885,     17,  -2770,  -1374, 
+ -1427,  -5952,  11394,  12263,  -5621,  -1783,  -1135,  -2927, 
+    35,  -1859,    -44,   -242,   -299,    759,   -165,    824, 
+   247,    364,    507,    -42,    387,   -151,      0,      0, 
+ /* phase 12 */
+  -151,    387,    -42,    507,    364,    247,    824,   -165, 
+   759,   -299,   -242,    -44,  -1859,     35,  -2927,  -1135, 
+ -1783,  -5621,  12263,  11394,  -5952,  -1426,  -1374,  -2770, 
+    17,  -1885,     58,   -325,   -210,    724,   -155,    851, 
+   202,    407,    467,    -29,    382,   -170,      0,      0, 
+ /* phase 13 */
+  -130,    387,    -52,    545,    321,    294,    790,   -167, 
+   787,   -384,   -158,   -156,  -1817,     34,  -3067,   -901, 
+ -2160,  -5217,  13075,  10476,  -6210,  -1095,  -1615,  -2599, 
+   -18,  -1894,    151,   -405,   -119,    681,   -137,    872, 
+   162,    449,    425,    -11,    374,   -186,      0,      0, 
+ /* phase 14 */
+  -105,    384,    -58,    579,    279,    345,    750,   -160, 
+   807,   -464,    -74,   -276,  -1761,     12,  -3188,   -676, 
+ -2552,  -4739,  13823,   9516,  -6395,   -791,  -1853,  -2415, 
+   -72,  -1888,    233,   -480,    -26,    632,   -112,    885, 
+   126,    490,    382,      8,    361,   -198,      0,      0, 
+ /* phase 15 */
+   -78,    376,    -59,    609,    237,    397,    704,   -146, 
+   818,   -537,      7,   -402,  -1690,    -28,  -3287,   -465, 
+ -2956,  -4190,  14499,   8524,  -6509,   -519,  -2084,  -2222, 
+  -141,  -1866,    303,   -549,     67,    578,    -80,    891, 
+    95,    528,    338,     32,    345,   -206,      0,      0, 
+ /* phase 16 */
+   -48,    365,    -56,    636,    198,    450,    654,   -124, 
+   819,   -602,     87,   -532,  -1607,    -90,  -3363,   -270, 
+ -3365,  -3571,  15099,   7508,  -6555,   -281,  -2307,  -2023, 
+  -225,  -1827,    360,   -612,    159,    520,    -41,    890, 
+    69,    564,    294,     58,    325,   -211,      0,      0, 
+ /* phase 17 */
+   -17,    350,    -48,    658,    161,    503,    599,    -95, 
+   811,   -660,    162,   -666,  -1511,   -172,  -3415,    -95, 
+ -3773,  -2886,  15615,   6475,  -6536,    -79,  -2516,  -1820, 
+  -321,  -1774,    404,   -667,    250,    459,      2,    882, 
+    49,    596,    250,     85,    303,   -213,      0,      0, 
+ /* phase 18 */
+    15,    332,    -35,    675,    128,    556,    541,    -59, 
+   794,   -708,    232,   -801,  -1406,   -274,  -3440,     54, 
+ -4176,  -2138,  16045,   5437,  -6455,     85,  -2709,  -1617, 
+  -428,  -1706,    434,   -714,    337,    396,     52,    867, 
+    34,    625,    207,    114,    277,   -211,      0,      0, 
+ /* phase 19 */
+    49,    311,    -18,    687,     98,    608,    480,    -16, 
+   766,   -746,    294,   -935,  -1292,   -393,  -3440,    178, 
+ -4567,  -1331,  16383,   4399,  -6316,    211,  -2884,  -1415, 
+  -543,  -1625,    451,   -750,    419,    331,    107,    845, 
+    26,    649,    166,    144,    249,   -205,      0,      0, 
+ /* phase 20 */
+    84,    287,      2,    694,     73,    657,    417,     32, 
+   729,   -774,    347,  -1066,  -1172,   -531,  -3412,    271, 
+ -4939,   -471,  16627,   3373,  -6125,    298,  -3038,  -1219, 
+  -665,  -1532,    455,   -777,    496,    267,    165,    818, 
+    24,    668,    127,    174,    218,   -197,      0,      0, 
+ /* phase 21 */
+   118,    261,     28,    696,     52,    704,    353,     85, 
+   683,   -791,    391,  -1193,  -1046,   -684,  -3357,    332, 
+ -5287,    435,  16774,   2365,  -5886,    347,  -3170,  -1030, 
+  -791,  -1428,    446,   -792,    566,    204,    226,    785, 
+    28,    682,     91,    204,    186,   -185,      0,      0, 
+};
+/* S=3000 carrier=1800 alpha=0.020833 beta=0.100000 f0=0.025000 */
+s16 v34_rx_filter_3000_1800[400] __attribute__((aligned(16))) =
+{
+ /* phase 0 */
+   170,     79,   -167,    235,   -504,    125,   -548,   -451, 
+  -248,  -1291,      0,  -1766,   -459,  -1197,  -2093,    765, 
+ -5263,   6556,  15814,  -1766,  -2711,    457,  -2805,     45, 
+ -1612,   -786,   -452,  -1153,     64,   -857,      0,   -250, 
+  -216,    201,   -244,      0,      0,      0,      0,      0, 
+ /* phase 1 */
+   227,     -1,    -98,    177,   -509,    169,   -675,   -307, 
+  -423,  -1187,    -35,  -1896,   -197,  -1621,  -1621,    358, 
+ -5297,   8848,  14590,  -3209,  -1821,      1,  -2649,    133, 
+ -1802,   -529,   -652,   -997,     23,   -871,     94,   -347, 
+  -108,    137,   -207,      0,      0,      0,      0,      0, 
+ /* phase 2 */
+   272,    -80,    -20,     97,   -483,    181,   -776,   -172, 
+  -617,  -1037,   -140,  -1948,      1,  -2027,  -1085,   -232, 
+ -4981,  11019,  12965,  -4286,   -975,   -529,  -2380,    116, 
+ -1917,   -308,   -853,   -813,    -57,   -844,    155,   -427, 
+     0,     60,   -150,      0,      0,      0,      0,      0, 
+ /* phase 3 */
+   302,   -150,     60,      0,   -427,    155,   -844,    -57, 
+  -813,   -853,   -308,  -1917,    116,  -2380,   -529,   -975, 
+ -4287,  12965,  11020,  -4981,   -232,  -1085,  -2027,      1, 
+ -1948,   -140,  -1037,   -617,   -172,   -776,    181,   -483, 
+    97,    -20,    -80,      0,      0,      0,      0,      0, 
+ /* phase 4 */
+   312,   -207,    137,   -108,   -347,     94,   -871,     23, 
+  -997,   -652,   -529,  -1802,    133,  -2649,      1,  -1821, 
+ -3209,  14590,   8848,  -5297,    358,  -1621,  -1621,   -197, 
+ -1896,    -35,  -1187,   -423,   -307,   -675,    169,   -509, 
+   177,    -98,     -1,      0,      0,      0,      0,      0, 
+ /* phase 5 */
+   302,   -244,    201,   -216,   -250,      0,   -857,     64, 
+ -1153,   -452,   -786,  -1612,     45,  -2805,    457,  -2711, 
+ -1767,  15813,   6556,  -5263,    765,  -2093,  -1197,   -459, 
+ -1766,      0,  -1291,   -248,   -451,   -548,    125,   -504, 
+   235,   -167,     79,      0,      0,      0,      0,      0, 
+ /* phase 6 */
+   271,   -259,    248,   -318,   -145,   -121,   -801,     57, 
+ -1268,   -270,  -1060,  -1360,   -146,  -2831,    795,  -3575, 
+     1,  16573,   4250,  -4923,    971,  -2467,   -790,   -758, 
+ -1571,    -31,  -1341,   -103,   -589,   -406,     52,   -468, 
+   267,   -219,    155,      0,      0,      0,      0,      0, 
+ /* phase 7 */
+   221,   -251,    270,   -404,    -40,   -259,   -709,      0, 
+ -1333,   -125,  -1329,  -1067,   -431,  -2718,    976,  -4337, 
+  2033,  16831,   2033,  -4337,    976,  -2718,   -431,  -1067, 
+ -1329,   -125,  -1333,      0,   -709,   -259,    -40,   -404, 
+   270,   -251,    221,      0,      0,      0,      0,      0, 
+ /* phase 8 */
+   155,   -219,    267,   -468,     52,   -406,   -589,   -103, 
+ -1341,    -31,  -1571,   -758,   -790,  -2467,    971,  -4923, 
+  4250,  16573,      1,  -3575,    795,  -2831,   -146,  -1360, 
+ -1060,   -270,  -1268,     57,   -801,   -121,   -145,   -318, 
+   248,   -259,    271,      0,      0,      0,      0,      0, 
+ /* phase 9 */
+    79,   -167,    235,   -504,    125,   -548,   -451,   -248, 
+ -1291,      0,  -1766,   -459,  -1197,  -2093,    765,  -5263, 
+  6556,  15814,  -1766,  -2711,    457,  -2805,     45,  -1612, 
+  -786,   -452,  -1153,     64,   -857,      0,   -250,   -216, 
+   201,   -244,    302,      0,      0,      0,      0,      0, 
+};
+/* S=3000 carrier=2000 alpha=0.020833 beta=0.100000 f0=0.027778 */
+s16 v34_rx_filter_3000_2000[400] __attribute__((aligned(16))) =
+{
+ /* phase 0 */
+  -160,    176,    165,    178,    586,     61,    877,   -171, 
+   756,   -445,      9,   -611,  -1400,   -460,  -3349,    368, 
+ -6116,   4936,  15622,  -3867,  -2550,   -999,  -2773,    -34, 
+ -1873,    381,   -723,    444,    195,    298,    652,     88, 
+   658,    -76,    389,      0,      0,      0,      0,      0, 
+ /* phase 1 */
+  -199,    257,     87,    288,    496,    145,    828,   -188, 
+   809,   -623,    200,   -947,  -1101,   -853,  -3095,    219, 
+ -6491,   7524,  14179,  -5197,  -1599,  -1597,  -2323,   -215, 
+ -1752,    451,   -799,    617,     46,    460,    522,    175, 
+   595,    -71,    393,      0,      0,      0,      0,      0, 
+ /* phase 2 */
+  -219,    324,     16,    401,    390,    257,    737,   -155, 
+   805,   -747,    350,  -1267,   -781,  -1320,  -2695,   -169, 
+ -6495,  10015,  12274,  -6073,   -787,  -2181,  -1824,   -474, 
+ -1544,    438,   -807,    740,    -74,    610,    387,    279, 
+   506,    -38,    370,      0,      0,      0,      0,      0, 
+ /* phase 3 */
+  -218,    370,    -38,    506,    279,    387,    610,    -74, 
+   740,   -807,    438,  -1544,   -474,  -1824,  -2181,   -787, 
+ -6073,  12274,  10015,  -6494,   -169,  -2695,  -1320,   -781, 
+ -1267,    350,   -747,    805,   -155,    737,    257,    390, 
+   401,     16,    324,      0,      0,      0,      0,      0, 
+ /* phase 4 */
+  -193,    393,    -71,    595,    175,    523,    460,     46, 
+   617,   -799,    451,  -1752,   -215,  -2323,  -1597,  -1599, 
+ -5197,  14179,   7524,  -6491,    219,  -3095,   -853,  -1101, 
+  -947,    200,   -623,    809,   -188,    828,    145,    496, 
+   288,     87,    257,      0,      0,      0,      0,      0, 
+ /* phase 5 */
+  -146,    389,    -76,    658,     88,    652,    298,    195, 
+   444,   -723,    381,  -1873,    -33,  -2773,   -999,  -2550, 
+ -3867,  15622,   4936,  -6116,    368,  -3349,   -460,  -1400, 
+  -611,      9,   -445,    756,   -171,    877,     61,    586, 
+   178,    165,    176,      0,      0,      0,      0,      0, 
+ /* phase 6 */
+   -80,    360,    -52,    690,     28,    762,    141,    357, 
+   233,   -588,    228,  -1896,     43,  -3131,   -447,  -3566, 
+ -2115,  16523,   2385,  -5444,    285,  -3438,   -170,  -1647, 
+  -286,   -201,   -231,    654,   -105,    881,     12,    653, 
+    79,    242,     87,      0,      0,      0,      0,      0, 
+ /* phase 7 */
+     0,    310,      0,    688,      1,    841,      1,    516, 
+     1,   -408,      0,  -1818,      0,  -3361,     -1,  -4562, 
+    -1,  16829,     -1,  -4562,     -1,  -3361,      0,  -1818, 
+     0,   -408,      1,    516,      1,    841,      1,    688, 
+     0,    310,      0,      0,      0,      0,      0,      0, 
+ /* phase 8 */
+    87,    242,     79,    653,     12,    881,   -105,    654, 
+  -231,   -201,   -286,  -1647,   -170,  -3438,    285,  -5444, 
+  2385,  16523,  -2115,  -3566,   -447,  -3131,     43,  -1896, 
+   228,   -588,    233,    357,    141,    762,     28,    690, 
+   -52,    360,    -80,      0,      0,      0,      0,      0, 
+ /* phase 9 */
+   176,    165,    178,    586,     61,    877,   -171,    756, 
+  -445,      9,   -611,  -1400,   -460,  -3349,    368,  -6116, 
+  4936,  15622,  -3867,  -2550,   -999,  -2773,    -34,  -1873, 
+   381,   -723,    444,    195,    298,    652,     88,    658, 
+   -76,    389,   -146,      0,      0,      0,      0,      0, 
+};
+/* S=3200 carrier=1829 alpha=0.033333 beta=0.100000 f0=0.038095 */
+s16 v34_rx_filter_3200_1829[280] __attribute__((aligned(16))) =
+{
+ /* phase 0 */
+    62,   -451,    -50,   -438,   -378,   -251,   -861,    -20, 
+ -1274,    -10,  -1296,   -523,   -624,  -1824,   1105,  -4770, 
+  8528,  14478,  -3251,   -697,   -263,  -1843,    254,  -1715, 
+    34,  -1108,   -384,   -476,   -663,    -81,   -668,     28, 
+  -460,      0,      0,      0,      0,      0,      0,      0, 
+ /* phase 1 */
+    35,   -482,     17,   -577,   -216,   -454,   -692,   -156, 
+ -1257,     90,  -1585,    -73,  -1251,  -1105,    398,  -4453, 
+ 11807,  11807,  -4453,    398,  -1105,  -1251,    -73,  -1585, 
+    90,  -1257,   -156,   -692,   -454,   -216,   -577,     17, 
+  -482,      0,      0,      0,      0,      0,      0,      0, 
+ /* phase 2 */
+   -36,   -460,     28,   -668,    -81,   -663,   -476,   -384, 
+ -1108,     34,  -1715,    254,  -1843,   -263,   -697,  -3251, 
+ 14478,   8528,  -4770,   1105,  -1824,   -624,   -523,  -1296, 
+   -10,  -1274,    -20,   -861,   -251,   -378,   -438,    -50, 
+  -451,      0,      0,      0,      0,      0,      0,      0, 
+ /* phase 3 */
+  -141,   -387,    -23,   -692,     -4,   -836,   -258,   -664, 
+  -853,   -178,  -1652,    382,  -2275,    537,  -2014,  -1163, 
+ 16223,   5023,  -4319,   1342,  -2293,    -86,   -997,   -913, 
+  -239,  -1159,      2,   -949,    -93,   -532,   -279,   -157, 
+  -371,      0,      0,      0,      0,      0,      0,      0, 
+ /* phase 4 */
+  -261,   -278,   -132,   -644,     -7,   -939,    -85,   -941, 
+  -542,   -514,  -1398,    267,  -2445,   1122,  -3312,   1678, 
+ 16830,   1678,  -3312,   1122,  -2445,    267,  -1398,   -514, 
+  -542,   -941,    -85,   -939,     -7,   -644,   -132,   -278, 
+  -261,      0,      0,      0,      0,      0,      0,      0, 
+ /* phase 5 */
+  -371,   -157,   -279,   -532,    -93,   -949,      2,  -1159, 
+  -239,   -913,   -997,    -86,  -2293,   1342,  -4319,   5023, 
+ 16224,  -1163,  -2014,    537,  -2275,    382,  -1652,   -178, 
+  -853,   -664,   -258,   -836,     -4,   -692,    -23,   -387, 
+  -141,      0,      0,      0,      0,      0,      0,      0, 
+ /* phase 6 */
+  -451,    -50,   -438,   -378,   -251,   -861,    -20,  -1274, 
+   -10,  -1296,   -523,   -624,  -1824,   1105,  -4770,   8528, 
+ 14478,  -3251,   -697,   -263,  -1843,    254,  -1715,     34, 
+ -1108,   -384,   -476,   -663,    -81,   -668,     28,   -460, 
+   -36,      0,      0,      0,      0,      0,      0,      0, 
+};
+/* S=3200 carrier=1920 alpha=0.033333 beta=0.100000 f0=0.040000 */
+s16 v34_rx_filter_3200_1920[280] __attribute__((aligned(16))) =
+{
+ /* phase 0 */
+   171,     32,    -83,    115,   -464,    156,   -865,     35, 
+ -1125,   -376,  -1061,  -1188,   -498,  -2528,    912,  -5264, 
+  7939,  14295,  -4102,   -663,  -1086,  -1788,   -246,  -1798, 
+    -4,  -1341,    -35,   -730,   -147,   -187,   -216,    165, 
+  -196,      0,      0,      0,      0,      0,      0,      0, 
+ /* phase 1 */
+   256,    -94,     44,    -42,   -347,     41,   -849,     62, 
+ -1301,   -125,  -1480,   -697,  -1114,  -1915,    357,  -5152, 
+ 11429,  11429,  -5152,    357,  -1915,  -1114,   -697,  -1480, 
+  -125,  -1301,     62,   -849,     41,   -347,    -42,     44, 
+   -94,      0,      0,      0,      0,      0,      0,      0, 
+ /* phase 2 */
+   306,   -196,    165,   -216,   -187,   -147,   -730,    -35, 
+ -1341,     -4,  -1798,   -246,  -1788,  -1086,   -663,  -4102, 
+ 14294,   7939,  -5264,    912,  -2528,   -498,  -1188,  -1061, 
+  -376,  -1125,     35,   -865,    156,   -464,    115,    -83, 
+    32,      0,      0,      0,      0,      0,      0,      0, 
+ /* phase 3 */
+   306,   -253,    248,   -372,    -20,   -376,   -535,   -248, 
+ -1235,    -51,  -1945,     57,  -2381,   -205,  -1999,  -2083, 
+ 16175,   4249,  -4597,    953,  -2820,    -58,  -1612,   -629, 
+  -693,   -851,   -100,   -776,    178,   -510,    226,   -189, 
+   156,      0,      0,      0,      0,      0,      0,      0, 
+ /* phase 4 */
+   254,   -250,    272,   -477,    112,   -601,   -307,   -538, 
+ -1002,   -270,  -1881,    133,  -2758,    535,  -3409,    786, 
+ 16830,    786,  -3409,    535,  -2758,    133,  -1881,   -270, 
+ -1002,   -538,   -307,   -601,    112,   -477,    272,   -250, 
+   254,      0,      0,      0,      0,      0,      0,      0, 
+ /* phase 5 */
+   156,   -189,    226,   -510,    178,   -776,   -100,   -851, 
+  -693,   -629,  -1612,    -58,  -2820,    953,  -4597,   4249, 
+ 16175,  -2083,  -1999,   -205,  -2381,     57,  -1945,    -51, 
+ -1235,   -248,   -535,   -376,    -20,   -372,    248,   -253, 
+   306,      0,      0,      0,      0,      0,      0,      0, 
+ /* phase 6 */
+    32,    -83,    115,   -464,    156,   -865,     35,  -1125, 
+  -376,  -1061,  -1188,   -498,  -2528,    912,  -5264,   7939, 
+ 14295,  -4102,   -663,  -1086,  -1788,   -246,  -1798,     -4, 
+ -1341,    -35,   -730,   -147,   -187,   -216,    165,   -196, 
+   306,      0,      0,      0,      0,      0,      0,      0, 
+};
+/* S=3429 carrier=1959 alpha=0.023810 beta=0.100000 f0=0.027211 */
+s16 v34_rx_filter_3429_1959[320] __attribute__((aligned(16))) =
+{
+ /* phase 0 */
+    60,   -470,      9,   -608,   -117,   -690,   -350,   -663, 
+  -725,   -461,  -1297,     37,  -2245,   1265,  -4770,   9983, 
+ 12234,  -4632,    949,  -1909,   -298,   -998,   -739,   -499, 
+  -864,   -203,   -814,    -41,   -667,     29,   -482,      0, 
+ /* phase 1 */
+    46,   -482,     29,   -667,    -41,   -814,   -203,   -864, 
+  -499,   -739,   -998,   -298,  -1909,    949,  -4632,  12234, 
+  9983,  -4770,   1265,  -2245,     37,  -1297,   -461,   -725, 
+  -663,   -350,   -690,   -117,   -608,      9,   -470,      0, 
+ /* phase 2 */
+     8,   -466,     18,   -692,     -1,   -905,    -86,  -1044, 
+  -281,  -1027,   -662,   -710,  -1438,    398,  -4051,  14147, 
+  7531,  -4515,   1337,  -2421,    267,  -1529,   -220,   -935, 
+  -461,   -509,   -545,   -218,   -521,    -39,   -431,      0, 
+ /* phase 3 */
+   -51,   -423,    -24,   -680,     -3,   -951,    -13,  -1182, 
+   -97,  -1295,   -323,  -1160,   -872,   -352,  -3007,  15606, 
+  5021,  -3940,   1177,  -2427,    374,  -1673,    -39,  -1109, 
+  -278,   -664,   -394,   -333,   -415,   -109,   -371,      0, 
+ /* phase 4 */
+  -126,   -359,    -96,   -631,    -47,   -948,      5,  -1265, 
+    31,  -1515,    -19,  -1601,   -264,  -1246,  -1513,  16520, 
+  2594,  -3137,    822,  -2275,    354,  -1718,     66,  -1227, 
+  -131,   -797,   -252,   -448,   -302,   -192,   -294,      0, 
+ /* phase 5 */
+  -210,   -279,   -192,   -551,   -133,   -895,    -34,  -1281, 
+    89,  -1662,    216,  -1987,    321,  -2206,    380,  16831, 
+   380,  -2206,    321,  -1987,    216,  -1662,     89,  -1281, 
+   -34,   -895,   -133,   -551,   -192,   -279,   -210,      0, 
+ /* phase 6 */
+  -294,   -193,   -302,   -448,   -252,   -797,   -131,  -1227, 
+    66,  -1718,    354,  -2275,    822,  -3137,   2594,  16520, 
+ -1513,  -1246,   -264,  -1601,    -19,  -1515,     31,  -1265, 
+     5,   -948,    -47,   -631,    -96,   -359,   -126,      0, 
+ /* phase 7 */
+  -371,   -109,   -415,   -333,   -394,   -664,   -278,  -1109, 
+   -39,  -1673,    374,  -2427,   1177,  -3940,   5021,  15606, 
+ -3006,   -352,   -872,  -1159,   -323,  -1295,    -97,  -1182, 
+   -13,   -951,     -3,   -680,    -24,   -423,    -51,      0, 
+ /* phase 8 */
+  -431,    -39,   -521,   -218,   -545,   -509,   -461,   -935, 
+  -220,  -1529,    267,  -2421,   1337,  -4515,   7531,  14147, 
+ -4051,    398,  -1438,   -710,   -662,  -1027,   -281,  -1044, 
+   -86,   -905,     -1,   -692,     18,   -466,      8,      0, 
+ /* phase 9 */
+  -470,      9,   -608,   -117,   -690,   -350,   -663,   -725, 
+  -461,  -1297,     37,  -2245,   1265,  -4770,   9983,  12234, 
+ -4632,    949,  -1909,   -298,   -998,   -739,   -499,   -864, 
+  -203,   -814,    -41,   -667,     29,   -482,     46,      0, 
+};
+s16 v34_rc_10_filter[401]=
+{
+   -32,    -29,    -23,    -14,     -2,      9,     21,     30, 
+    36,     38,     36,     29,     18,      5,     -8,    -22, 
+   -33,    -41,    -44,    -43,    -36,    -25,    -10,      5, 
+    20,     34,     44,     50,     49,     43,     32,     17, 
+     0,    -18,    -34,    -46,    -54,    -55,    -50,    -39, 
+   -23,     -5,     14,     32,     46,     56,     58,     55, 
+    44,     29,      9,    -10,    -30,    -46,    -56,    -61, 
+   -57,    -47,    -31,    -12,      9,     29,     46,     58, 
+    62,     59,     48,     31,     10,    -12,    -34,    -52, 
+   -63,    -67,    -62,    -48,    -28,     -4,     21,     45, 
+    64,     76,     78,     70,     52,     26,     -3,    -35, 
+   -64,    -86,    -99,   -100,    -88,    -64,    -30,      9, 
+    51,     90,    119,    137,    138,    123,     91,     46, 
+    -7,    -64,   -118,   -161,   -189,   -196,   -180,   -142, 
+   -85,    -13,     64,    141,    206,    253,    273,    264, 
+   223,    155,     64,    -40,   -147,   -245,   -322,   -368, 
+  -375,   -341,   -267,   -157,    -23,    121,    263,    385, 
+   472,    513,    499,    430,    308,    145,    -44,   -241, 
+  -425,   -574,   -670,   -699,   -654,   -533,   -347,   -111, 
+   153,    418,    656,    838,    941,    950,    855,    661, 
+   381,     40,   -329,   -690,  -1003,  -1231,  -1342,  -1316, 
+ -1144,   -835,   -409,     96,    635,   1152,   1590,   1895, 
+  2023,   1942,   1639,   1125,    430,   -391,  -1270,  -2119, 
+ -2847,  -3360,  -3575,  -3422,  -2856,  -1859,   -443,   1346, 
+  3434,   5720,   8083,  10391,  12508,  14307,  15680,  16539, 
+ 16832,  16539,  15680,  14308,  12508,  10391,   8083,   5721, 
+  3434,   1346,   -443,  -1859,  -2856,  -3422,  -3575,  -3360, 
+ -2847,  -2119,  -1270,   -391,    430,   1125,   1639,   1942, 
+  2023,   1895,   1590,   1152,    635,     96,   -409,   -835, 
+ -1144,  -1316,  -1342,  -1231,  -1003,   -690,   -329,     40, 
+   381,    661,    855,    950,    941,    838,    656,    418, 
+   153,   -111,   -347,   -533,   -654,   -699,   -670,   -574, 
+  -425,   -241,    -44,    145,    309,    430,    499,    513, 
+   472,    385,    263,    121,    -23,   -157,   -267,   -341, 
+  -375,   -368,   -322,   -245,   -147,    -40,     64,    155, 
+   223,    264,    273,    253,    206,    141,     64,    -13, 
+   -85,   -142,   -180,   -196,   -189,   -161,   -118,    -64, 
+    -7,     46,     91,    123,    138,    137,    119,     90, 
+    51,      9,    -30,    -64,    -88,   -100,    -99,    -86, 
+   -64,    -35,     -3,     26,     52,     70,     78,     76, 
+    64,     45,     21,     -4,    -28,    -48,    -62,    -67, 
+   -63,    -52,    -34,    -12,     10,     31,     48,     59, 
+    62,     58,     46,     29,      9,    -12,    -31,    -47, 
+   -57,    -61,    -56,    -46,    -30,    -10,      9,     29, 
+    44,     55,     58,     56,     46,     32,     14,     -5, 
+   -23,    -39,    -50,    -55,    -54,    -46,    -34,    -18, 
+     0,     17,     32,     43,     49,     50,     44,     34, 
+    20,      5,    -10,    -25,    -36,    -43,    -44,    -41, 
+   -33,    -22,     -8,      5,     18,     29,     36,     38, 
+    36,     30,     21,      9,     -2,    -14,    -23,    -29, 
+   -32, 
+};
+s16 v34_rc_35_filter[1401]=
+{
+   -36,    -35,    -33,    -31,    -29,    -27,    -24,    -21, 
+   -18,    -15,    -11,     -8,     -4,      0,      3,      7, 
+    10,     14,     18,     21,     25,     28,     31,     33, 
+    36,     38,     39,     41,     42,     42,     42,     42, 
+    41,     40,     39,     37,     35,     32,     29,     26, 
+    23,     19,     15,     11,      7,      2,     -1,     -5, 
+   -10,    -14,    -18,    -22,    -26,    -30,    -33,    -36, 
+   -39,    -42,    -44,    -45,    -46,    -47,    -48,    -48, 
+   -47,    -46,    -45,    -43,    -41,    -38,    -35,    -32, 
+   -28,    -24,    -20,    -15,    -11,     -6,     -1,      3, 
+     8,     12,     17,     22,     26,     30,     34,     38, 
+    41,     44,     47,     49,     51,     52,     53,     53, 
+    53,     52,     51,     49,     47,     44,     41,     38, 
+    34,     30,     25,     20,     15,     10,      5,      0, 
+    -5,    -10,    -15,    -20,    -25,    -30,    -35,    -39, 
+   -43,    -46,    -49,    -52,    -54,    -55,    -56,    -57, 
+   -57,    -57,    -55,    -54,    -52,    -49,    -46,    -43, 
+   -39,    -35,    -30,    -25,    -20,    -14,     -9,     -3, 
+     2,      7,     13,     18,     24,     29,     34,     39, 
+    43,     47,     50,     53,     56,     57,     59,     60, 
+    60,     60,     59,     57,     55,     53,     50,     46, 
+    42,     38,     33,     28,     23,     17,     11,      5, 
+     0,     -6,    -12,    -18,    -23,    -29,    -34,    -39, 
+   -43,    -48,    -51,    -54,    -57,    -59,    -61,    -61, 
+   -62,    -61,    -61,    -59,    -57,    -54,    -51,    -47, 
+   -43,    -39,    -34,    -28,    -23,    -17,    -11,     -4, 
+     1,      7,     13,     20,     25,     31,     36,     41, 
+    46,     50,     54,     57,     60,     62,     63,     64, 
+    64,     63,     62,     60,     57,     54,     51,     46, 
+    42,     37,     31,     25,     19,     12,      6,      0, 
+    -7,    -13,    -20,    -26,    -32,    -38,    -44,    -49, 
+   -53,    -57,    -61,    -64,    -66,    -68,    -68,    -68, 
+   -68,    -67,    -65,    -62,    -58,    -54,    -50,    -44, 
+   -39,    -32,    -26,    -19,    -12,     -4,      2,     10, 
+    18,     25,     32,     39,     46,     52,     58,     63, 
+    68,     72,     75,     78,     79,     80,     80,     79, 
+    78,     75,     72,     68,     63,     57,     51,     44, 
+    36,     28,     20,     11,      2,     -6,    -16,    -25, 
+   -34,    -43,    -52,    -60,    -68,    -75,    -82,    -88, 
+   -93,    -97,   -100,   -102,   -104,   -104,   -103,   -101, 
+   -98,    -94,    -89,    -83,    -76,    -68,    -59,    -49, 
+   -39,    -28,    -17,     -5,      6,     18,     30,     43, 
+    55,     66,     77,     88,     98,    107,    116,    123, 
+   129,    134,    138,    141,    142,    142,    140,    137, 
+   133,    127,    120,    112,    102,     91,     79,     66, 
+    52,     38,     22,      6,     -9,    -26,    -42,    -59, 
+   -75,    -91,   -106,   -121,   -135,   -148,   -159,   -169, 
+  -178,   -186,   -192,   -196,   -198,   -198,   -197,   -194, 
+  -188,   -181,   -172,   -162,   -149,   -135,   -119,   -102, 
+   -84,    -64,    -44,    -22,      0,     21,     44,     67, 
+    89,    112,    133,    154,    174,    192,    209,    225, 
+   238,    250,    260,    267,    272,    275,    275,    273, 
+   268,    261,    251,    239,    224,    207,    187,    166, 
+   142,    117,     90,     62,     33,      3,    -27,    -57, 
+   -89,   -119,   -150,   -179,   -208,   -235,   -260,   -284, 
+  -305,   -324,   -341,   -355,   -365,   -373,   -378,   -379, 
+  -377,   -371,   -362,   -349,   -333,   -314,   -292,   -266, 
+  -238,   -207,   -174,   -138,   -101,    -62,    -22,     19, 
+    61,    103,    144,    186,    226,    265,    303,    339, 
+   372,    402,    429,    454,    474,    491,    503,    512, 
+   515,    515,    510,    500,    486,    467,    443,    415, 
+   383,    347,    308,    265,    218,    169,    118,     64, 
+     9,    -46,   -102,   -159,   -215,   -271,   -325,   -377, 
+  -427,   -474,   -518,   -558,   -593,   -624,   -651,   -672, 
+  -687,   -697,   -700,   -698,   -689,   -675,   -654,   -626, 
+  -593,   -554,   -510,   -460,   -405,   -346,   -282,   -215, 
+  -145,    -72,      2,     78,    155,    232,    308,    383, 
+   456,    527,    594,    657,    716,    770,    818,    859, 
+   894,    922,    942,    955,    959,    955,    942,    922, 
+   892,    854,    809,    755,    693,    625,    549,    467, 
+   380,    287,    190,     90,    -13,   -118,   -224,   -331, 
+  -437,   -541,   -642,   -740,   -834,   -922,  -1005,  -1080, 
+ -1147,  -1206,  -1255,  -1295,  -1324,  -1342,  -1349,  -1344, 
+ -1328,  -1300,  -1259,  -1207,  -1143,  -1068,   -982,   -886, 
+  -779,   -663,   -539,   -408,   -269,   -125,     22,    174, 
+   327,    482,    636,    789,    938,   1083,   1222,   1354, 
+  1477,   1591,   1694,   1785,   1862,   1926,   1974,   2007, 
+  2023,   2022,   2003,   1966,   1911,   1838,   1747,   1638, 
+  1512,   1368,   1209,   1034,    845,    643,    428,    204, 
+   -29,   -270,   -517,   -767,  -1020,  -1271,  -1521,  -1766, 
+ -2004,  -2234,  -2452,  -2658,  -2847,  -3020,  -3172,  -3303, 
+ -3411,  -3493,  -3548,  -3574,  -3571,  -3535,  -3468,  -3367, 
+ -3231,  -3061,  -2855,  -2614,  -2338,  -2026,  -1680,  -1300, 
+  -887,   -441,     34,    539,   1072,   1630,   2211,   2814, 
+  3436,   4074,   4725,   5387,   6057,   6732,   7409,   8084, 
+  8755,   9418,  10070,  10708,  11329,  11930,  12507,  13059, 
+ 13582,  14073,  14531,  14952,  15335,  15678,  15979,  16236, 
+ 16448,  16614,  16734,  16806,  16830,  16806,  16734,  16614, 
+ 16448,  16236,  15979,  15678,  15335,  14952,  14531,  14073, 
+ 13582,  13059,  12507,  11930,  11329,  10708,  10070,   9418, 
+  8755,   8084,   7409,   6732,   6058,   5388,   4725,   4074, 
+  3436,   2814,   2211,   1630,   1072,    539,     34,   -441, 
+  -887,  -1300,  -1680,  -2026,  -2338,  -2614,  -2855,  -3061, 
+ -3231,  -3366,  -3468,  -3535,  -3571,  -3574,  -3548,  -3493, 
+ -3411,  -3303,  -3172,  -3020,  -2847,  -2658,  -2452,  -2234, 
+ -2004,  -1766,  -1521,  -1271,  -1020,   -767,   -517,   -270, 
+   -29,    204,    428,    643,    845,   1034,   1209,   1369, 
+  1512,   1638,   1747,   1838,   1911,   1966,   2003,   2022, 
+  2023,   2007,   1974,   1926,   1862,   1785,   1694,   1591, 
+  1477,   1354,   1222,   1083,    938,    789,    636,    482, 
+   328,    174,     22,   -125,   -269,   -408,   -539,   -663, 
+  -779,   -886,   -982,  -1068,  -1143,  -1207,  -1259,  -1300, 
+ -1328,  -1344,  -1349,  -1342,  -1324,  -1295,  -1255,  -1206, 
+ -1147,  -1080,  -1004,   -922,   -834,   -740,   -642,   -541, 
+  -437,   -331,   -224,   -118,    -13,     90,    190,    287, 
+   380,    467,    549,    625,    693,    755,    809,    855, 
+   892,    922,    942,    955,    959,    955,    942,    922, 
+   894,    859,    818,    770,    716,    657,    594,    527, 
+   456,    383,    308,    232,    155,     78,      2,    -72, 
+  -145,   -215,   -282,   -346,   -405,   -460,   -510,   -554, 
+  -593,   -626,   -654,   -675,   -689,   -698,   -700,   -697, 
+  -687,   -672,   -651,   -624,   -593,   -558,   -518,   -474, 
+  -427,   -377,   -325,   -271,   -215,   -159,   -102,    -46, 
+     9,     64,    118,    169,    218,    265,    308,    347, 
+   383,    415,    443,    467,    486,    500,    510,    515, 
+   516,    512,    503,    491,    474,    454,    430,    402, 
+   372,    339,    303,    266,    226,    186,    144,    103, 
+    61,     19,    -22,    -62,   -101,   -138,   -174,   -207, 
+  -238,   -266,   -292,   -314,   -333,   -349,   -362,   -371, 
+  -377,   -379,   -378,   -373,   -365,   -355,   -341,   -324, 
+  -305,   -284,   -260,   -235,   -208,   -179,   -150,   -119, 
+   -88,    -57,    -26,      3,     33,     62,     90,    117, 
+   142,    166,    187,    207,    224,    239,    251,    261, 
+   268,    273,    275,    275,    272,    267,    260,    250, 
+   238,    225,    209,    192,    174,    154,    133,    112, 
+    89,     67,     44,     21,      0,    -22,    -44,    -64, 
+   -84,   -102,   -119,   -135,   -149,   -162,   -172,   -181, 
+  -188,   -194,   -197,   -198,   -198,   -196,   -192,   -186, 
+  -178,   -169,   -159,   -148,   -135,   -121,   -106,    -91, 
+   -75,    -59,    -42,    -26,     -9,      6,     22,     38, 
+    52,     66,     79,     91,    102,    112,    120,    127, 
+   133,    137,    140,    142,    142,    141,    138,    134, 
+   129,    123,    116,    107,     98,     88,     77,     66, 
+    55,     43,     30,     18,      6,     -5,    -17,    -28, 
+   -39,    -49,    -59,    -68,    -76,    -83,    -89,    -94, 
+   -98,   -101,   -103,   -104,   -104,   -102,   -100,    -97, 
+   -93,    -88,    -82,    -75,    -68,    -60,    -52,    -43, 
+   -34,    -25,    -16,     -6,      2,     11,     20,     28, 
+    36,     44,     51,     57,     63,     68,     72,     75, 
+    78,     80,     80,     80,     79,     78,     75,     72, 
+    68,     63,     58,     52,     46,     39,     32,     25, 
+    18,     10,      2,     -4,    -12,    -19,    -26,    -32, 
+   -39,    -44,    -50,    -54,    -58,    -62,    -64,    -67, 
+   -68,    -68,    -68,    -68,    -66,    -64,    -61,    -57, 
+   -53,    -49,    -44,    -38,    -32,    -26,    -20,    -13, 
+    -7,      0,      6,     12,     19,     25,     31,     37, 
+    42,     46,     51,     54,     57,     60,     62,     63, 
+    64,     64,     63,     62,     60,     57,     54,     50, 
+    46,     42,     36,     31,     25,     20,     13,      7, 
+     1,     -4,    -11,    -17,    -23,    -28,    -34,    -39, 
+   -43,    -47,    -51,    -54,    -57,    -59,    -61,    -61, 
+   -62,    -61,    -61,    -59,    -57,    -54,    -51,    -48, 
+   -43,    -39,    -34,    -29,    -23,    -18,    -12,     -6, 
+     0,      5,     11,     17,     23,     28,     33,     38, 
+    42,     46,     50,     53,     55,     57,     59,     60, 
+    60,     60,     59,     57,     56,     53,     50,     47, 
+    43,     39,     34,     29,     24,     18,     13,      7, 
+     2,     -3,     -9,    -14,    -20,    -25,    -30,    -35, 
+   -39,    -43,    -46,    -49,    -52,    -54,    -55,    -57, 
+   -57,    -57,    -56,    -55,    -54,    -52,    -49,    -46, 
+   -43,    -39,    -35,    -30,    -25,    -20,    -15,    -10, 
+    -5,      0,      5,     10,     15,     20,     25,     30, 
+    34,     38,     41,     44,     47,     49,     51,     52, 
+    53,     53,     53,     52,     51,     49,     47,     44, 
+    41,     38,     34,     30,     26,     22,     17,     12, 
+     8,      3,     -1,     -6,    -11,    -15,    -20,    -24, 
+   -28,    -32,    -35,    -38,    -41,    -43,    -45,    -46, 
+   -47,    -48,    -48,    -47,    -46,    -45,    -44,    -42, 
+   -39,    -36,    -33,    -30,    -26,    -22,    -18,    -14, 
+   -10,     -5,     -1,      2,      7,     11,     15,     19, 
+    23,     26,     29,     32,     35,     37,     39,     40, 
+    41,     42,     42,     42,     42,     41,     39,     38, 
+    36,     33,     31,     28,     25,     21,     18,     14, 
+    10,      7,      3,      0,     -4,     -8,    -11,    -15, 
+   -18,    -21,    -24,    -27,    -29,    -31,    -33,    -35, 
+   -36, 
+};
+s16 v34_rc_20_filter[801]=
+{
+   -31,    -30,    -28,    -25,    -22,    -17,    -12,     -7, 
+    -1,      4,     10,     16,     21,     26,     30,     33, 
+    36,     37,     37,     36,     34,     31,     27,     23, 
+    17,     11,      4,     -2,     -9,    -15,    -22,    -28, 
+   -33,    -37,    -40,    -42,    -43,    -43,    -41,    -39, 
+   -35,    -29,    -23,    -17,     -9,     -2,      5,     13, 
+    21,     28,     34,     40,     44,     47,     49,     49, 
+    48,     46,     42,     37,     31,     24,     16,      7, 
+     0,     -9,    -18,    -26,    -34,    -40,    -46,    -50, 
+   -53,    -54,    -54,    -52,    -49,    -44,    -38,    -31, 
+   -22,    -13,     -4,      4,     14,     23,     32,     39, 
+    46,     51,     55,     57,     57,     56,     53,     49, 
+    43,     36,     28,     19,      9,      0,    -10,    -20, 
+   -29,    -38,    -45,    -51,    -56,    -58,    -59,    -59, 
+   -56,    -52,    -46,    -39,    -30,    -21,    -11,      0, 
+     9,     20,     29,     38,     46,     52,     57,     60, 
+    61,     61,     58,     53,     47,     39,     30,     20, 
+     9,     -1,    -12,    -24,    -34,    -43,    -51,    -58, 
+   -62,    -65,    -66,    -64,    -61,    -55,    -47,    -38, 
+   -28,    -16,     -3,      8,     21,     34,     45,     55, 
+    64,     70,     75,     77,     77,     74,     69,     61, 
+    51,     39,     25,     11,     -4,    -20,    -35,    -50, 
+   -64,    -76,    -86,    -94,    -99,   -100,    -99,    -95, 
+   -87,    -76,    -63,    -47,    -29,     -9,     10,     31, 
+    51,     71,     89,    106,    119,    129,    136,    139, 
+   137,    132,    122,    108,     90,     69,     45,     19, 
+    -7,    -36,    -64,    -92,   -118,   -141,   -161,   -177, 
+  -188,   -194,   -195,   -190,   -179,   -163,   -141,   -115, 
+   -84,    -49,    -12,     25,     65,    103,    141,    175, 
+   206,    232,    252,    266,    272,    271,    263,    246, 
+   222,    191,    154,    111,     63,     12,    -40,    -94, 
+  -147,   -198,   -245,   -286,   -321,   -348,   -367,   -376, 
+  -374,   -363,   -340,   -308,   -266,   -215,   -157,    -92, 
+   -23,     48,    121,    194,    263,    327,    384,    433, 
+   471,    498,    512,    512,    498,    471,    429,    375, 
+   308,    231,    145,     52,    -44,   -143,   -241,   -336, 
+  -424,   -504,   -573,   -629,   -669,   -693,   -698,   -685, 
+  -653,   -602,   -533,   -447,   -347,   -234,   -111,     18, 
+   152,    287,    417,    541,    655,    754,    837,    900, 
+   941,    957,    949,    915,    855,    769,    661,    530, 
+   381,    217,     41,   -142,   -328,   -512,   -689,   -854, 
+ -1002,  -1129,  -1230,  -1302,  -1341,  -1346,  -1315,  -1248, 
+ -1144,  -1006,   -835,   -635,   -410,   -164,     95,    363, 
+   634,    899,   1151,   1383,   1589,   1761,   1895,   1983, 
+  2022,   2009,   1941,   1818,   1639,   1408,   1125,    798, 
+   431,     32,   -390,   -828,  -1269,  -1703,  -2118,  -2503, 
+ -2846,  -3135,  -3359,  -3509,  -3575,  -3548,  -3422,  -3193, 
+ -2857,  -2412,  -1860,  -1202,   -444,    407,   1345,   2357, 
+  3433,   4559,   5720,   6900,   8083,   9252,  10390,  11481, 
+ 12508,  13455,  14308,  15053,  15680,  16178,  16540,  16759, 
+ 16832,  16759,  16540,  16178,  15680,  15054,  14308,  13455, 
+ 12508,  11481,  10391,   9252,   8083,   6900,   5720,   4559, 
+  3433,   2358,   1345,    407,   -444,  -1202,  -1860,  -2412, 
+ -2857,  -3193,  -3422,  -3548,  -3574,  -3509,  -3359,  -3135, 
+ -2846,  -2503,  -2118,  -1703,  -1269,   -828,   -390,     32, 
+   431,    798,   1126,   1408,   1640,   1818,   1941,   2009, 
+  2022,   1983,   1895,   1762,   1589,   1383,   1151,    899, 
+   634,    364,     95,   -164,   -410,   -635,   -835,  -1006, 
+ -1144,  -1248,  -1315,  -1346,  -1341,  -1301,  -1230,  -1129, 
+ -1002,   -854,   -689,   -512,   -328,   -142,     41,    217, 
+   381,    530,    661,    769,    855,    915,    949,    957, 
+   941,    900,    837,    754,    655,    541,    417,    287, 
+   152,     18,   -111,   -234,   -347,   -447,   -533,   -602, 
+  -653,   -685,   -698,   -693,   -669,   -629,   -573,   -504, 
+  -424,   -336,   -241,   -143,    -44,     52,    145,    231, 
+   308,    375,    429,    471,    498,    512,    512,    498, 
+   471,    433,    384,    327,    263,    194,    121,     48, 
+   -23,    -92,   -157,   -215,   -266,   -308,   -340,   -363, 
+  -374,   -376,   -367,   -348,   -321,   -286,   -245,   -198, 
+  -147,    -94,    -40,     12,     63,    111,    154,    191, 
+   222,    246,    263,    271,    272,    266,    252,    232, 
+   206,    175,    141,    103,     65,     25,    -12,    -49, 
+   -84,   -115,   -141,   -163,   -179,   -190,   -195,   -194, 
+  -188,   -177,   -161,   -141,   -118,    -92,    -64,    -36, 
+    -7,     19,     45,     69,     90,    108,    122,    132, 
+   137,    139,    136,    129,    119,    106,     89,     71, 
+    51,     31,     10,     -9,    -29,    -47,    -63,    -76, 
+   -87,    -95,    -99,   -100,    -99,    -94,    -86,    -76, 
+   -64,    -50,    -35,    -20,     -4,     11,     25,     39, 
+    51,     61,     69,     74,     77,     77,     75,     70, 
+    64,     55,     45,     34,     21,      9,     -3,    -16, 
+   -27,    -38,    -47,    -55,    -61,    -64,    -66,    -65, 
+   -62,    -58,    -51,    -43,    -34,    -23,    -12,     -1, 
+     9,     20,     30,     39,     47,     53,     58,     61, 
+    61,     60,     57,     52,     46,     38,     29,     20, 
+     9,      0,    -11,    -21,    -30,    -39,    -46,    -52, 
+   -56,    -59,    -59,    -58,    -56,    -51,    -45,    -38, 
+   -29,    -20,    -10,      0,      9,     19,     28,     36, 
+    43,     49,     53,     56,     57,     57,     55,     51, 
+    46,     39,     32,     23,     14,      4,     -4,    -13, 
+   -22,    -30,    -38,    -44,    -49,    -52,    -54,    -54, 
+   -53,    -50,    -46,    -40,    -34,    -26,    -18,     -9, 
+     0,      7,     16,     24,     31,     37,     42,     46, 
+    48,     49,     49,     47,     44,     40,     34,     28, 
+    21,     13,      5,     -2,     -9,    -17,    -23,    -29, 
+   -35,    -39,    -41,    -43,    -43,    -42,    -40,    -37, 
+   -33,    -28,    -22,    -15,     -9,     -2,      4,     11, 
+    17,     23,     27,     31,     34,     36,     37,     37, 
+    36,     33,     30,     26,     21,     16,     10,      4, 
+    -1,     -7,    -12,    -17,    -22,    -25,    -28,    -30, 
+   -31, 
+};
+s16 v34_rc_8_filter[321]=
+{
+   -33,    -29,    -19,     -5,      9,     24,     34,     38, 
+    36,     27,     12,     -4,    -22,    -36,    -44,    -44, 
+   -36,    -21,     -2,     17,     35,     47,     51,     46, 
+    32,     13,     -9,    -30,    -47,    -55,    -53,    -42, 
+   -23,      0,     23,     43,     56,     59,     51,     33, 
+     9,    -15,    -38,    -55,    -61,    -56,    -40,    -17, 
+     9,     34,     53,     62,     59,     45,     21,     -6, 
+   -34,    -56,    -66,    -64,    -49,    -23,      8,     40, 
+    64,     77,     75,     57,     26,    -11,    -50,    -82, 
+  -100,    -99,    -78,    -39,      9,     61,    106,    134, 
+   139,    117,     70,      6,    -64,   -130,   -178,   -196, 
+  -180,   -130,    -50,     45,    141,    220,    267,    269, 
+   224,    134,     12,   -121,   -245,   -337,   -377,   -354, 
+  -267,   -126,     48,    229,    385,    488,    513,    453, 
+   309,     99,   -143,   -382,   -575,   -685,   -686,   -570, 
+  -347,    -46,    287,    601,    838,    953,    915,    718, 
+   381,    -50,   -513,   -932,  -1231,  -1349,  -1248,   -924, 
+  -409,    230,    900,   1491,   1896,   2023,   1818,   1272, 
+   430,   -609,  -1704,  -2682,  -3360,  -3573,  -3193,  -2149, 
+  -443,   1844,   4560,   7493,  10391,  12992,  15053,  16375, 
+ 16831,  16375,  15053,  12992,  10391,   7493,   4560,   1844, 
+  -443,  -2148,  -3193,  -3573,  -3360,  -2682,  -1704,   -609, 
+   430,   1272,   1818,   2023,   1896,   1491,    900,    230, 
+  -409,   -924,  -1248,  -1349,  -1231,   -932,   -513,    -50, 
+   381,    718,    915,    953,    838,    601,    287,    -46, 
+  -347,   -570,   -686,   -685,   -575,   -382,   -143,     99, 
+   309,    453,    513,    488,    385,    229,     48,   -126, 
+  -267,   -354,   -377,   -337,   -245,   -121,     12,    134, 
+   224,    269,    267,    220,    141,     45,    -50,   -130, 
+  -180,   -196,   -178,   -130,    -64,      6,     70,    117, 
+   139,    134,    106,     61,      9,    -39,    -78,    -99, 
+  -100,    -82,    -50,    -11,     26,     57,     75,     77, 
+    64,     40,      8,    -23,    -49,    -64,    -66,    -56, 
+   -34,     -6,     21,     45,     59,     62,     53,     34, 
+     9,    -17,    -40,    -56,    -61,    -55,    -38,    -15, 
+     9,     33,     51,     59,     56,     43,     23,      0, 
+   -23,    -42,    -53,    -55,    -47,    -30,     -9,     13, 
+    32,     46,     51,     47,     35,     17,     -2,    -21, 
+   -36,    -44,    -44,    -36,    -22,     -4,     12,     27, 
+    36,     38,     34,     24,      9,     -5,    -19,    -29, 
+   -33, 
+};
+s16 v34_rc_5_filter[201]=
+{
+   -33,    -23,     -2,     21,     37,     36,     18,     -8, 
+   -33,    -45,    -36,    -10,     21,     45,     50,     32, 
+     0,    -34,    -54,    -50,    -23,     14,     47,     59, 
+    44,      9,    -30,    -57,    -58,    -32,      9,     47, 
+    63,     48,     10,    -34,    -63,    -62,    -29,     21, 
+    64,     78,     52,     -3,    -64,   -100,    -88,    -30, 
+    51,    120,    139,     91,     -7,   -118,   -189,   -180, 
+   -85,     64,    207,    273,    224,     64,   -147,   -322, 
+  -376,   -267,    -23,    263,    473,    500,    309,    -44, 
+  -425,   -671,   -654,   -347,    153,    656,    942,    855, 
+   381,   -329,  -1004,  -1342,  -1144,   -409,    635,   1590, 
+  2023,   1639,    430,  -1270,  -2847,  -3575,  -2856,   -443, 
+  3435,   8084,  12508,  15679,  16831,  15679,  12508,   8084, 
+  3435,   -443,  -2856,  -3575,  -2847,  -1270,    430,   1639, 
+  2023,   1590,    635,   -409,  -1144,  -1342,  -1003,   -329, 
+   381,    855,    942,    656,    153,   -347,   -654,   -671, 
+  -425,    -44,    309,    500,    473,    263,    -23,   -267, 
+  -376,   -322,   -147,     64,    224,    273,    207,     64, 
+   -85,   -180,   -189,   -118,     -7,     91,    139,    120, 
+    51,    -30,    -88,   -100,    -64,     -3,     52,     78, 
+    64,     21,    -28,    -62,    -63,    -34,     10,     48, 
+    63,     47,      9,    -32,    -58,    -57,    -30,      9, 
+    44,     59,     47,     14,    -23,    -50,    -54,    -34, 
+     0,     32,     50,     45,     21,    -10,    -36,    -45, 
+   -33,     -8,     18,     36,     37,     21,     -2,    -23, 
+   -33, 
+};
+s16 v34_rc_7_filter[281]=
+{
+   -33,    -28,    -15,      0,     18,     32,     38,     36, 
+    25,      7,    -12,    -31,    -42,    -45,    -36,    -19, 
+     2,     25,     43,     51,     47,     32,      9,    -15, 
+   -38,    -53,    -55,    -45,    -23,      3,     30,     50, 
+    59,     54,     36,      9,    -19,    -44,    -59,    -60, 
+   -46,    -21,      9,     38,     57,     63,     52,     28, 
+    -2,    -34,    -58,    -67,    -59,    -35,      0,     35, 
+    65,     78,     72,     46,      5,    -39,    -78,   -100, 
+   -97,    -68,    -19,     39,     95,    132,    139,    112, 
+    54,    -23,   -103,   -167,   -196,   -181,   -120,    -24, 
+    87,    190,    258,    272,    224,    118,    -25,   -177, 
+  -303,   -372,   -362,   -267,   -102,    101,    301,    452, 
+   515,    467,    309,     66,   -214,   -473,   -650,   -698, 
+  -594,   -347,      0,    382,    715,    922,    943,    756, 
+   381,   -116,   -641,  -1079,  -1324,  -1300,   -983,   -409, 
+   326,   1082,   1693,   2007,   1912,   1370,    430,   -766, 
+ -2004,  -3019,  -3548,  -3367,  -2339,   -443,   2210,   5387, 
+  8754,  11930,  14532,  16237,  16831,  16237,  14532,  11930, 
+  8755,   5387,   2210,   -443,  -2339,  -3367,  -3548,  -3019, 
+ -2004,   -766,    430,   1370,   1912,   2007,   1693,   1082, 
+   326,   -409,   -983,  -1300,  -1324,  -1079,   -641,   -116, 
+   381,    756,    943,    922,    715,    382,      0,   -347, 
+  -594,   -698,   -650,   -473,   -214,     66,    309,    467, 
+   515,    452,    301,    101,   -102,   -267,   -361,   -372, 
+  -303,   -177,    -25,    118,    224,    272,    258,    190, 
+    87,    -24,   -120,   -181,   -196,   -167,   -103,    -23, 
+    54,    112,    139,    132,     95,     39,    -19,    -68, 
+   -97,   -100,    -78,    -39,      5,     46,     72,     78, 
+    65,     35,      0,    -35,    -59,    -67,    -58,    -34, 
+    -2,     28,     52,     63,     57,     38,      9,    -21, 
+   -46,    -60,    -59,    -44,    -19,      9,     36,     54, 
+    59,     50,     30,      3,    -23,    -45,    -55,    -53, 
+   -38,    -15,      9,     32,     47,     51,     43,     25, 
+     2,    -19,    -36,    -45,    -42,    -31,    -12,      7, 
+    25,     36,     38,     32,     18,      0,    -15,    -28, 
+   -33, 
+};
+s16 v22_tx_filter[800]=
+{
+     1,      3,      6,      8,     10,     12,     13,     15, 
+    16,     17,     17,     17,     17,     17,     16,     15, 
+    13,     11,      9,      7,      4,      2,      0,     -3, 
+    -5,     -8,    -11,    -13,    -15,    -17,    -18,    -20, 
+   -20,    -21,    -21,    -21,    -20,    -19,    -18,    -16, 
+   -14,    -11,     -9,     -6,     -3,      0,      2,      6, 
+     8,     11,     14,     16,     18,     20,     21,     22, 
+    23,     23,     23,     22,     20,     19,     17,     14, 
+    11,      8,      5,      2,     -1,     -4,     -8,    -11, 
+   -14,    -17,    -20,    -22,    -24,    -25,    -26,    -27, 
+   -27,    -26,    -25,    -24,    -21,    -19,    -16,    -13, 
+    -9,     -5,     -1,      2,      6,     10,     14,     17, 
+    21,     24,     26,     29,     30,     31,     32,     32, 
+    31,     30,     28,     25,     23,     19,     15,     11, 
+     7,      2,     -1,     -6,    -11,    -15,    -19,    -23, 
+   -27,    -30,    -32,    -34,    -35,    -35,    -35,    -34, 
+   -32,    -30,    -27,    -23,    -19,    -15,    -10,     -4, 
+     0,      6,     11,     17,     22,     27,     32,     36, 
+    39,     42,     44,     46,     46,     46,     45,     43, 
+    40,     36,     32,     27,     21,     15,      9,      3, 
+    -3,    -10,    -16,    -23,    -29,    -34,    -39,    -43, 
+   -46,    -48,    -50,    -50,    -49,    -48,    -45,    -42, 
+   -37,    -32,    -25,    -19,    -11,     -3,      4,     12, 
+    20,     28,     36,     43,     50,     55,     60,     64, 
+    67,     69,     69,     68,     66,     63,     58,     52, 
+    46,     38,     29,     20,     10,      0,     -9,    -20, 
+   -30,    -39,    -48,    -57,    -64,    -70,    -75,    -78, 
+   -80,    -81,    -80,    -77,    -73,    -67,    -59,    -51, 
+   -41,    -30,    -18,     -5,      7,     20,     33,     46, 
+    58,     69,     80,     89,     97,    103,    107,    109, 
+   109,    107,    103,     97,     89,     79,     67,     53, 
+    38,     22,      5,    -12,    -30,    -48,    -66,    -83, 
+   -99,   -113,   -126,   -137,   -146,   -152,   -156,   -156, 
+  -154,   -149,   -142,   -131,   -118,   -102,    -83,    -63, 
+   -41,    -18,      5,     29,     54,     78,    101,    122, 
+   142,    159,    174,    185,    193,    196,    196,    192, 
+   183,    170,    153,    131,    106,     77,     45,     11, 
+   -25,    -64,   -103,   -143,   -182,   -220,   -256,   -289, 
+  -319,   -345,   -366,   -382,   -391,   -395,   -392,   -382, 
+  -366,   -342,   -312,   -275,   -232,   -184,   -131,    -74, 
+   -14,     47,    110,    172,    233,    291,    345,    393, 
+   434,    467,    491,    504,    505,    495,    471,    433, 
+   382,    316,    237,    144,     38,    -79,   -208,   -346, 
+  -492,   -644,   -799,   -955,  -1110,  -1261,  -1405,  -1538, 
+ -1657,  -1760,  -1843,  -1902,  -1935,  -1938,  -1909,  -1843, 
+ -1740,  -1596,  -1410,  -1179,   -902,   -578,   -207,    210, 
+   676,   1188,   1746,   2347,   2989,   3670,   4387,   5137, 
+  5914,   6715,   7535,   8370,   9214,  10061,  10906,  11743, 
+ 12567,  13371,  14150,  14898,  15609,  16278,  16901,  17471, 
+ 17986,  18440,  18831,  19155,  19410,  19593,  19704,  19741, 
+ 19704,  19593,  19410,  19155,  18831,  18441,  17986,  17472, 
+ 16901,  16278,  15609,  14898,  14150,  13371,  12567,  11743, 
+ 10906,  10061,   9214,   8370,   7535,   6715,   5914,   5137, 
+  4388,   3671,   2989,   2347,   1746,   1188,    676,    210, 
+  -207,   -578,   -902,  -1179,  -1409,  -1596,  -1740,  -1843, 
+ -1909,  -1938,  -1935,  -1902,  -1843,  -1760,  -1657,  -1538, 
+ -1404,  -1261,  -1110,   -955,   -799,   -644,   -492,   -346, 
+  -208,    -79,     38,    144,    237,    316,    382,    433, 
+   471,    495,    506,    504,    491,    467,    434,    393, 
+   345,    291,    233,    172,    110,     47,    -14,    -74, 
+  -131,   -184,   -232,   -275,   -312,   -342,   -365,   -382, 
+  -392,   -395,   -391,   -381,   -366,   -345,   -319,   -289, 
+  -256,   -220,   -182,   -143,   -103,    -64,    -25,     11, 
+    45,     77,    106,    131,    153,    170,    183,    192, 
+   196,    197,    193,    185,    174,    159,    142,    122, 
+   101,     78,     54,     29,      5,    -18,    -41,    -63, 
+   -83,   -102,   -117,   -131,   -141,   -149,   -154,   -156, 
+  -156,   -152,   -146,   -137,   -126,   -113,    -99,    -83, 
+   -66,    -48,    -30,    -12,      5,     22,     38,     53, 
+    67,     79,     89,     97,    103,    107,    109,    109, 
+   107,    103,     97,     89,     80,     69,     58,     46, 
+    33,     20,      7,     -5,    -18,    -30,    -41,    -51, 
+   -59,    -67,    -73,    -77,    -80,    -81,    -80,    -78, 
+   -75,    -70,    -64,    -57,    -48,    -39,    -30,    -20, 
+    -9,      0,     10,     20,     29,     38,     46,     52, 
+    58,     63,     66,     68,     69,     69,     67,     64, 
+    60,     55,     50,     43,     36,     28,     20,     12, 
+     4,     -3,    -11,    -19,    -25,    -32,    -37,    -42, 
+   -45,    -48,    -49,    -50,    -50,    -48,    -46,    -43, 
+   -39,    -34,    -28,    -23,    -16,    -10,     -3,      3, 
+     9,     15,     21,     27,     32,     36,     40,     43, 
+    45,     46,     46,     46,     44,     42,     39,     36, 
+    32,     27,     22,     17,     11,      6,      0,     -4, 
+   -10,    -15,    -19,    -23,    -27,    -30,    -32,    -34, 
+   -35,    -35,    -35,    -34,    -32,    -30,    -27,    -23, 
+   -19,    -15,    -11,     -6,     -1,      2,      7,     11, 
+    15,     19,     23,     25,     28,     30,     31,     32, 
+    32,     31,     30,     29,     26,     24,     21,     17, 
+    14,     10,      6,      2,     -1,     -5,     -9,    -13, 
+   -16,    -19,    -21,    -24,    -25,    -26,    -27,    -27, 
+   -26,    -25,    -24,    -22,    -20,    -17,    -14,    -11, 
+    -8,     -4,     -1,      2,      5,      8,     11,     14, 
+    17,     19,     20,     22,     23,     23,     23,     22, 
+    21,     20,     18,     16,     14,     11,      8,      6, 
+     2,      0,     -3,     -6,     -9,    -11,    -14,    -16, 
+   -18,    -19,    -20,    -21,    -21,    -21,    -20,    -20, 
+   -18,    -17,    -15,    -13,    -11,     -8,     -5,     -3, 
+     0,      2,      4,      7,      9,     11,     13,     15, 
+    16,     17,     17,     17,     17,     17,     16,     15, 
+    13,     12,     10,      8,      6,      3,      1,     -1, 
+
+};
+/* V22 rx carrier=1200 alpha=0.003125 beta=0.750000 */
+s16 v22_rx_filter_1200[1872] __attribute__((aligned(16))) =
+{
+ /* phase 0 */
+   -15,      0,     -9,    -27,    -13,     32,     59,     32, 
+   -12,    -17,      6,      0,    -48,    -70,    -23,     33, 
+    21,    -18,     30,    159,    187,      0,   -236,   -249, 
+   -54,     18,   -179,   -264,    239,   1079,   1225,      0, 
+ -1814,  -2420,   -858,   1718,   2972,   1718,   -858,  -2420, 
+ -1814,      0,   1225,   1079,    239,   -264,   -179,     18, 
+   -54,   -248,   -236,      0,    187,    159,     30,    -18, 
+    21,     33,    -23,    -70,    -48,      0,      6,    -17, 
+   -12,     32,     59,     32,    -13,    -27,     -9,      0, 
+    11,      5,     -6,      8,     42,     45,      0,    -44, 
+   -38,     -5,     -4,    -36,    -35,     22,     70,     46, 
+     0,     25,     92,     51,   -136,   -277,   -171,     80, 
+   168,     24,      0,    364,    735,    350,   -890,  -1892, 
+ -1318,    786,   2640,   2364,      0,  -2364,  -2640,   -786, 
+  1318,   1892,    890,   -350,   -736,   -364,      0,    -24, 
+  -168,    -80,    171,    277,    136,    -51,    -92,    -25, 
+     0,    -46,    -70,    -22,     35,     36,      4,      5, 
+    38,     44,      0,    -45,    -42,     -8,      6,     -5, 
+ /* phase 1 */
+   -13,      0,    -10,    -27,    -10,     36,     59,     28, 
+   -14,    -16,      7,     -3,    -52,    -69,    -17,     35, 
+    17,    -19,     39,    168,    180,    -21,   -248,   -237, 
+   -39,     10,   -199,   -248,    307,   1134,   1176,   -150, 
+ -1936,  -2371,   -651,   1903,   2963,   1522,  -1056,  -2452, 
+ -1684,    146,   1264,   1019,    173,   -276,   -159,     23, 
+   -71,   -258,   -222,     21,    193,    149,     21,    -17, 
+    24,     31,    -28,    -71,    -44,      2,      4,    -19, 
+    -9,     36,     59,     28,    -16,    -26,     -7,      0, 
+    11,      4,     -6,     11,     44,     42,     -4,    -45, 
+   -36,     -3,     -6,    -38,    -32,     28,     71,     41, 
+    -1,     31,     95,     40,   -153,   -279,   -152,     98, 
+   162,     11,     15,    405,    741,    272,  -1004,  -1917, 
+ -1186,    982,   2715,   2228,   -233,  -2484,  -2550,   -588, 
+  1439,   1856,    775,   -422,   -724,   -323,     12,    -38, 
+  -172,    -62,    189,    274,    118,    -62,    -89,    -20, 
+    -1,    -50,    -69,    -17,     37,     33,      3,      7, 
+    41,     42,     -4,    -46,    -40,     -6,      6,     -6, 
+ /* phase 2 */
+   -11,      0,    -12,    -28,     -7,     40,     58,     24, 
+   -17,    -14,      9,     -6,    -56,    -67,    -11,     37, 
+    13,    -19,     49,    177,    170,    -44,   -258,   -224, 
+   -24,      0,   -217,   -227,    377,   1182,   1116,   -305, 
+ -2047,  -2306,   -439,   2077,   2934,   1318,  -1245,  -2468, 
+ -1547,    286,   1293,    956,    112,   -283,   -138,     27, 
+   -88,   -267,   -206,     42,    198,    139,     13,    -15, 
+    28,     27,    -34,    -71,    -39,      4,      3,    -20, 
+    -6,     39,     58,     24,    -19,    -25,     -5,     -1, 
+    11,      2,     -6,     14,     46,     40,     -9,    -47, 
+   -33,     -2,     -9,    -39,    -28,     34,     71,     37, 
+    -2,     37,     97,     28,   -170,   -279,   -131,    114, 
+   155,      0,     34,    446,    741,    187,  -1116,  -1929, 
+ -1043,   1175,   2772,   2077,   -464,  -2588,  -2444,   -390, 
+  1547,   1808,    658,   -487,   -708,   -283,     21,    -53, 
+  -174,    -42,    206,    268,    100,    -70,    -85,    -15, 
+    -4,    -54,    -67,    -11,     39,     31,      1,     10, 
+    43,     39,     -9,    -48,    -37,     -4,      5,     -7, 
+ /* phase 3 */
+   -10,      0,    -14,    -28,     -3,     43,     57,     19, 
+   -18,    -12,      9,     -9,    -59,    -64,     -5,     37, 
+     9,    -18,     60,    184,    159,    -66,   -266,   -209, 
+   -11,    -11,   -235,   -201,    450,   1225,   1046,   -463, 
+ -2147,  -2225,   -221,   2239,   2887,   1107,  -1424,  -2467, 
+ -1402,    420,   1311,    888,     54,   -287,   -117,     28, 
+  -106,   -273,   -189,     62,    200,    128,      6,    -13, 
+    30,     24,    -39,    -71,    -35,      6,      1,    -21, 
+    -3,     43,     57,     20,    -21,    -24,     -4,     -2, 
+    12,      1,     -5,     17,     47,     37,    -13,    -48, 
+   -30,      0,    -11,    -41,    -24,     39,     71,     32, 
+    -2,     43,     98,     14,   -186,   -276,   -110,    128, 
+   146,    -10,     56,    486,    734,     96,  -1224,  -1928, 
+  -889,   1363,   2813,   1912,   -693,  -2674,  -2324,   -194, 
+  1642,   1750,    543,   -544,   -686,   -245,     28,    -67, 
+  -173,    -21,    222,    261,     83,    -78,    -80,    -11, 
+    -7,    -58,    -64,     -5,     41,     28,      0,     13, 
+    44,     36,    -13,    -49,    -34,     -1,      5,     -9, 
+ /* phase 4 */
+    -8,      0,    -16,    -27,      0,     46,     56,     15, 
+   -20,    -10,     10,    -13,    -62,    -61,      0,     38, 
+     4,    -16,     71,    190,    146,    -88,   -273,   -194, 
+     0,    -26,   -250,   -170,    523,   1260,    965,   -622, 
+ -2235,  -2128,      0,   2387,   2821,    891,  -1592,  -2451, 
+ -1252,    546,   1319,    818,      0,   -286,    -97,     26, 
+  -124,   -277,   -171,     82,    201,    116,      0,    -10, 
+    33,     20,    -44,    -70,    -30,      8,     -1,    -21, 
+     0,     46,     56,     16,    -23,    -22,     -3,     -3, 
+    12,      0,     -5,     20,     49,     34,    -18,    -48, 
+   -27,      0,    -14,    -42,    -20,     44,     70,     27, 
+    -1,     50,     97,      0,   -202,   -272,    -88,    141, 
+   135,    -18,     81,    526,    720,      0,  -1328,  -1915, 
+  -726,   1546,   2835,   1734,   -916,  -2743,  -2191,      0, 
+  1723,   1681,    428,   -594,   -661,   -208,     31,    -82, 
+  -171,      0,    235,    252,     65,    -84,    -74,     -7, 
+   -10,    -61,    -61,      0,     42,     25,      0,     15, 
+    46,     33,    -18,    -50,    -32,      0,      4,     -9, 
+ /* phase 5 */
+    -7,      0,    -18,    -27,      3,     49,     54,     11, 
+   -21,     -7,     10,    -17,    -65,    -58,      5,     37, 
+     0,    -13,     82,    195,    132,   -110,   -277,   -177, 
+     9,    -41,   -263,   -135,    597,   1288,    874,   -781, 
+ -2310,  -2015,    223,   2520,   2738,    670,  -1746,  -2419, 
+ -1098,    664,   1318,    746,    -49,   -281,    -77,     23, 
+  -142,   -279,   -151,    100,    201,    105,     -5,     -6, 
+    35,     15,    -49,    -69,    -26,      9,     -3,    -21, 
+     3,     49,     54,     12,    -24,    -21,     -2,     -4, 
+    11,     -1,     -4,     23,     49,     30,    -22,    -48, 
+   -24,      0,    -17,    -43,    -15,     49,     69,     23, 
+     0,     56,     96,    -15,   -216,   -266,    -66,    151, 
+   123,    -25,    109,    563,    700,   -101,  -1427,  -1887, 
+  -554,   1721,   2840,   1544,  -1134,  -2793,  -2045,    190, 
+  1792,   1604,    316,   -637,   -631,   -172,     32,    -96, 
+  -166,     22,    247,    241,     48,    -90,    -69,     -4, 
+   -14,    -64,    -58,      5,     43,     22,      0,     18, 
+    47,     30,    -22,    -50,    -29,      1,      3,    -10, 
+ /* phase 6 */
+    -5,     -1,    -19,    -26,      7,     52,     51,      7, 
+   -21,     -5,     10,    -22,    -67,    -54,     10,     36, 
+    -3,     -9,     93,    198,    117,   -131,   -279,   -160, 
+    17,    -59,   -274,    -94,    672,   1307,    774,   -941, 
+ -2372,  -1888,    447,   2637,   2637,    447,  -1888,  -2372, 
+  -941,    774,   1307,    672,    -94,   -274,    -59,     17, 
+  -160,   -279,   -131,    117,    198,     93,     -9,     -3, 
+    36,     10,    -54,    -67,    -22,     10,     -5,    -21, 
+     7,     51,     52,      7,    -26,    -19,     -1,     -5, 
+    11,     -2,     -3,     26,     50,     26,    -26,    -48, 
+   -21,      0,    -19,    -43,    -10,     54,     67,     18, 
+     1,     63,     93,    -31,   -229,   -258,    -44,    160, 
+   110,    -30,    139,    599,    672,   -207,  -1519,  -1846, 
+  -375,   1888,   2826,   1343,  -1343,  -2826,  -1888,    375, 
+  1846,   1519,    207,   -672,   -599,   -139,     30,   -110, 
+  -160,     44,    258,    229,     31,    -93,    -62,     -1, 
+   -18,    -67,    -54,     10,     43,     19,      0,     21, 
+    48,     26,    -26,    -50,    -26,      3,      2,    -11, 
+ /* phase 7 */
+    -4,     -2,    -21,    -24,     12,     54,     49,      3, 
+   -21,     -3,      9,    -26,    -69,    -49,     15,     35, 
+    -6,     -5,    105,    201,    100,   -151,   -279,   -142, 
+    23,    -77,   -281,    -49,    745,   1318,    664,  -1098, 
+ -2419,  -1746,    670,   2738,   2520,    223,  -2015,  -2310, 
+  -781,    874,   1288,    597,   -135,   -263,    -41,      9, 
+  -177,   -277,   -110,    132,    195,     82,    -13,      0, 
+    37,      5,    -58,    -65,    -17,     10,     -7,    -21, 
+    11,     54,     49,      3,    -27,    -18,      0,     -7, 
+    10,     -3,     -1,     29,     50,     22,    -30,    -47, 
+   -18,      0,    -22,    -43,     -5,     58,     64,     14, 
+     4,     69,     90,    -48,   -241,   -247,    -22,    166, 
+    96,    -32,    172,    631,    637,   -316,  -1604,  -1792, 
+  -190,   2045,   2793,   1134,  -1544,  -2840,  -1721,    554, 
+  1887,   1427,    101,   -700,   -563,   -109,     25,   -123, 
+  -151,     66,    266,    216,     15,    -96,    -56,      0, 
+   -23,    -69,    -49,     15,     43,     17,      0,     24, 
+    48,     22,    -30,    -49,    -23,      4,      1,    -11, 
+ /* phase 8 */
+    -3,     -3,    -22,    -23,     16,     56,     46,      0, 
+   -21,     -1,      8,    -30,    -70,    -44,     20,     33, 
+   -10,      0,    116,    201,     82,   -171,   -277,   -124, 
+    26,    -97,   -286,      0,    818,   1319,    546,  -1252, 
+ -2451,  -1591,    891,   2821,   2387,      0,  -2128,  -2235, 
+  -622,    965,   1260,    523,   -170,   -250,    -26,      0, 
+  -194,   -273,    -88,    146,    190,     71,    -16,      4, 
+    38,      0,    -61,    -62,    -13,     10,    -10,    -20, 
+    15,     56,     46,      0,    -27,    -16,      0,     -8, 
+     9,     -4,      0,     32,     50,     18,    -33,    -46, 
+   -15,      0,    -25,    -42,      0,     61,     61,     10, 
+     7,     74,     84,    -65,   -252,   -235,      0,    171, 
+    82,    -31,    208,    661,    594,   -428,  -1681,  -1723, 
+     0,   2191,   2743,    916,  -1734,  -2835,  -1546,    726, 
+  1915,   1328,      0,   -720,   -526,    -81,     18,   -135, 
+  -141,     88,    272,    202,      0,    -97,    -50,      1, 
+   -27,    -70,    -44,     20,     42,     14,      0,     27, 
+    48,     18,    -34,    -49,    -20,      5,      0,    -12, 
+ /* phase 9 */
+    -2,     -4,    -24,    -21,     20,     57,     43,     -3, 
+   -21,      1,      6,    -35,    -71,    -39,     24,     30, 
+   -13,      6,    128,    200,     62,   -189,   -273,   -106, 
+    28,   -117,   -287,     54,    888,   1311,    420,  -1402, 
+ -2467,  -1424,   1107,   2887,   2239,   -221,  -2225,  -2147, 
+  -463,   1046,   1225,    450,   -201,   -235,    -12,    -11, 
+  -209,   -266,    -66,    159,    184,     60,    -18,      9, 
+    37,     -5,    -64,    -59,     -9,      9,    -12,    -18, 
+    19,     57,     43,     -3,    -28,    -14,      0,    -10, 
+     9,     -5,      1,     34,     49,     13,    -36,    -44, 
+   -13,      0,    -28,    -41,      5,     64,     58,      7, 
+    11,     80,     78,    -83,   -261,   -222,     21,    173, 
+    67,    -28,    245,    686,    544,   -543,  -1750,  -1642, 
+   194,   2324,   2674,    693,  -1912,  -2813,  -1363,    889, 
+  1928,   1224,    -96,   -734,   -486,    -56,     10,   -146, 
+  -128,    110,    276,    186,    -14,    -98,    -43,      2, 
+   -32,    -71,    -39,     24,     41,     11,      0,     30, 
+    48,     13,    -37,    -47,    -17,      5,     -1,    -12, 
+ /* phase 10 */
+    -1,     -5,    -25,    -19,     24,     58,     39,     -6, 
+   -20,      3,      4,    -39,    -71,    -34,     27,     28, 
+   -15,     13,    139,    198,     42,   -206,   -267,    -88, 
+    27,   -138,   -283,    112,    955,   1293,    286,  -1546, 
+ -2468,  -1245,   1318,   2934,   2077,   -439,  -2306,  -2047, 
+  -305,   1116,   1182,    377,   -227,   -217,      0,    -24, 
+  -224,   -258,    -44,    170,    177,     49,    -19,     13, 
+    37,    -11,    -67,    -56,     -6,      9,    -14,    -17, 
+    24,     58,     40,     -7,    -28,    -12,      0,    -12, 
+     7,     -5,      4,     37,     48,      9,    -39,    -43, 
+   -10,     -1,    -31,    -39,     11,     67,     54,      4, 
+    15,     85,     70,   -100,   -268,   -206,     42,    174, 
+    53,    -21,    283,    708,    487,   -658,  -1808,  -1546, 
+   390,   2444,   2588,    464,  -2077,  -2772,  -1175,   1043, 
+  1929,   1116,   -187,   -741,   -446,    -34,      0,   -155, 
+  -114,    131,    279,    170,    -28,    -97,    -37,      2, 
+   -37,    -71,    -34,     28,     39,      9,      2,     33, 
+    47,      9,    -40,    -46,    -14,      6,     -2,    -12, 
+ /* phase 11 */
+     0,     -7,    -26,    -16,     28,     59,     36,     -9, 
+   -19,      4,      2,    -44,    -71,    -28,     30,     24, 
+   -17,     21,    149,    193,     21,   -222,   -258,    -71, 
+    23,   -159,   -276,    173,   1019,   1264,    146,  -1684, 
+ -2452,  -1056,   1522,   2963,   1903,   -651,  -2371,  -1936, 
+  -150,   1176,   1134,    307,   -248,   -199,     10,    -39, 
+  -237,   -248,    -21,    179,    168,     39,    -19,     17, 
+    35,    -17,    -69,    -52,     -3,      7,    -16,    -14, 
+    28,     59,     36,    -10,    -27,    -10,      0,    -13, 
+     6,     -6,      6,     40,     46,      4,    -42,    -41, 
+    -7,     -3,    -33,    -37,     17,     69,     50,      1, 
+    20,     89,     62,   -118,   -274,   -189,     62,    172, 
+    38,    -12,    323,    724,    422,   -775,  -1856,  -1439, 
+   588,   2550,   2484,    233,  -2228,  -2715,   -982,   1186, 
+  1917,   1004,   -272,   -741,   -405,    -15,    -11,   -162, 
+   -98,    152,    279,    153,    -40,    -95,    -31,      1, 
+   -41,    -71,    -28,     32,     38,      6,      3,     36, 
+    45,      4,    -42,    -44,    -11,      6,     -4,    -11, 
+ /* phase 12 */
+     0,     -9,    -27,    -13,     32,     59,     32,    -12, 
+   -17,      6,      0,    -48,    -70,    -23,     33,     21, 
+   -18,     30,    159,    187,      0,   -236,   -249,    -54, 
+    18,   -179,   -264,    239,   1079,   1225,      0,  -1814, 
+ -2420,   -858,   1718,   2972,   1718,   -858,  -2420,  -1814, 
+     0,   1225,   1079,    239,   -264,   -179,     18,    -54, 
+  -248,   -236,      0,    187,    159,     30,    -18,     21, 
+    33,    -23,    -70,    -48,      0,      6,    -17,    -12, 
+    32,     59,     32,    -13,    -27,     -9,      0,    -15, 
+     5,     -6,      8,     42,     45,      0,    -44,    -38, 
+    -5,     -4,    -36,    -35,     22,     70,     46,      0, 
+    25,     92,     51,   -136,   -277,   -171,     80,    168, 
+    24,      0,    364,    735,    350,   -890,  -1892,  -1318, 
+   786,   2640,   2364,      0,  -2364,  -2640,   -786,   1318, 
+  1892,    890,   -350,   -736,   -364,      0,    -24,   -168, 
+   -80,    171,    277,    136,    -51,    -92,    -25,      0, 
+   -46,    -70,    -22,     35,     36,      4,      5,     38, 
+    44,      0,    -45,    -42,     -8,      6,     -5,    -11, 
+};
+/* V22 rx carrier=2400 alpha=0.003125 beta=0.750000 */
+s16 v22_rx_filter_2400[1872] __attribute__((aligned(16))) =
+{
+ /* phase 0 */
+     5,     -5,     -3,    -23,     36,     17,    -59,     16, 
+    32,    -15,      2,    -36,     18,     60,    -60,    -17, 
+    21,      9,     79,   -135,    -71,    277,    -90,   -211, 
+   143,      9,    179,   -139,   -626,    918,    468,  -1892, 
+   693,   2058,  -2246,   -903,   2972,   -903,  -2246,   2059, 
+   693,  -1892,    468,    918,   -626,   -139,    179,      9, 
+   143,   -211,    -90,    277,    -71,   -135,     79,      9, 
+    21,    -17,    -60,     60,     18,    -36,      2,    -15, 
+    32,     16,    -59,     17,     36,    -23,     -3,     -5, 
+   -17,      0,    -10,     16,     26,    -53,      0,     52, 
+   -23,    -11,     -7,      0,     56,    -43,    -43,     54, 
+     0,     30,    -57,    -98,    220,      0,   -277,    153, 
+   104,    -29,      0,   -428,    454,    667,  -1441,      0, 
+  2133,  -1495,  -1632,   2779,      0,  -2779,   1632,   1495, 
+ -2133,      0,   1441,   -667,   -454,    428,      0,     29, 
+  -104,   -153,    277,      0,   -220,     98,     57,    -30, 
+     0,    -54,     43,     43,    -56,      0,      7,     11, 
+    23,    -52,      0,     53,    -26,    -16,     10,      0, 
+ /* phase 1 */
+     2,     -4,     -5,    -21,     40,      8,    -58,     24, 
+    27,    -14,      1,    -37,     27,     52,    -65,     -8, 
+    17,     16,     73,   -154,    -37,    276,   -132,   -181, 
+   149,      2,    197,   -215,   -567,   1039,    242,  -1899, 
+  1030,   1815,  -2488,   -458,   2935,  -1323,  -1952,   2247, 
+   346,  -1838,    673,    780,   -664,    -66,    157,     20, 
+   131,   -237,    -45,    271,   -103,   -114,     81,      4, 
+    24,    -26,    -53,     65,      9,    -33,      2,    -14, 
+    37,      8,    -58,     25,     30,    -24,     -1,     -6, 
+   -17,      0,    -11,     21,     20,    -55,      9,     48, 
+   -27,     -7,    -10,      5,     54,    -52,    -33,     54, 
+    -2,     33,    -73,    -78,    233,    -43,   -259,    181, 
+    75,    -15,    -31,   -423,    567,    529,  -1528,    300, 
+  2023,  -1815,  -1267,   2894,   -464,  -2596,   1952,   1145, 
+ -2188,    291,   1321,   -780,   -338,    420,    -24,     40, 
+  -131,   -120,    288,    -43,   -202,    114,     41,    -26, 
+    -3,    -52,     53,     33,    -57,      5,      5,     14, 
+    19,    -54,      9,     49,    -30,    -12,      9,      1, 
+ /* phase 2 */
+     0,     -2,     -8,    -18,     44,      0,    -56,     31, 
+    22,    -13,      0,    -38,     37,     44,    -69,      0, 
+    12,     24,     64,   -170,      0,    268,   -170,   -147, 
+   149,      0,    209,   -294,   -488,   1138,      0,  -1857, 
+  1350,   1521,  -2670,      0,   2825,  -1707,  -1612,   2376, 
+     0,  -1741,    853,    630,   -681,      0,    133,     35, 
+   114,   -257,      0,    258,   -130,    -91,     81,      0, 
+    26,    -36,    -44,     69,      0,    -30,      2,    -13, 
+    41,      0,    -56,     31,     24,    -24,      0,     -7, 
+   -16,      0,    -11,     25,     14,    -56,     18,     42, 
+   -30,     -4,    -12,     12,     51,    -60,    -22,     52, 
+    -4,     34,    -88,    -55,    241,    -87,   -234,    203, 
+    48,      0,    -68,   -405,    673,    370,  -1578,    603, 
+  1858,  -2094,   -867,   2938,   -918,  -2350,   2219,    772, 
+ -2187,    565,   1174,   -868,   -221,    401,    -43,     48, 
+  -158,    -83,    292,    -84,   -179,    126,     26,    -22, 
+    -8,    -49,     61,     22,    -56,      9,      2,     18, 
+    13,    -56,     18,     43,    -34,     -8,      8,      2, 
+ /* phase 3 */
+    -2,     -1,    -11,    -15,     47,     -8,    -52,     36, 
+    16,    -12,     -2,    -37,     45,     34,    -70,      7, 
+     8,     33,     52,   -182,     38,    253,   -204,   -111, 
+   144,      2,    215,   -372,   -391,   1213,   -251,  -1767, 
+  1643,   1185,  -2787,    460,   2645,  -2047,  -1237,   2444, 
+  -337,  -1603,   1003,    473,   -680,     59,    107,     51, 
+    92,   -270,     45,    239,   -153,    -68,     79,     -2, 
+    28,    -44,    -34,     70,     -8,    -26,      0,    -11, 
+    44,     -8,    -52,     37,     18,    -24,      1,     -8, 
+   -15,      0,    -11,     29,      7,    -56,     26,     36, 
+   -31,     -1,    -15,     19,     45,    -67,    -11,     49, 
+    -4,     33,   -102,    -28,    242,   -129,   -204,    219, 
+    22,     15,   -109,   -372,    767,    192,  -1590,    900, 
+  1643,  -2325,   -441,   2908,  -1348,  -2047,   2429,    387, 
+ -2132,    817,   1003,   -928,   -107,    372,    -54,     51, 
+  -181,    -42,    288,   -122,   -153,    134,     12,    -17, 
+   -14,    -44,     67,     11,    -53,     13,      0,     22, 
+     7,    -56,     26,     37,    -36,     -3,      6,      4, 
+ /* phase 4 */
+    -4,      0,    -13,    -10,     49,    -17,    -47,     41, 
+    10,    -10,     -5,    -36,     53,     23,    -70,     14, 
+     4,     42,     37,   -190,     77,    231,   -232,    -74, 
+   135,      9,    213,   -447,   -275,   1260,   -507,  -1629, 
+  1901,    813,  -2835,    911,   2400,  -2333,   -836,   2451, 
+  -658,  -1430,   1122,    312,   -661,    109,     82,     70, 
+    65,   -277,     90,    214,   -171,    -44,     74,     -3, 
+    28,    -52,    -23,     70,    -16,    -21,      0,     -8, 
+    46,    -17,    -47,     42,     12,    -22,      1,     -8, 
+   -14,      0,    -10,     32,      0,    -55,     34,     29, 
+   -32,      0,    -16,     26,     38,    -72,      0,     44, 
+    -2,     31,   -115,      0,    237,   -168,   -168,    228, 
+     0,     30,   -154,   -325,    847,      0,  -1562,   1183, 
+  1381,  -2502,      0,   2806,  -1744,  -1695,   2575,      0, 
+ -2026,   1039,    815,   -962,      0,    336,    -60,     50, 
+  -201,      0,    277,   -155,   -124,    137,      0,    -12, 
+   -20,    -38,     72,      0,    -50,     15,      0,     25, 
+     0,    -54,     34,     31,    -37,      0,      5,      6, 
+ /* phase 5 */
+    -6,      0,    -16,     -5,     49,    -26,    -41,     44, 
+     5,     -7,     -9,    -33,     59,     11,    -68,     20, 
+     0,     51,     19,   -193,    115,    203,   -254,    -36, 
+   122,     22,    201,   -516,   -144,   1276,   -760,  -1444, 
+  2117,    414,  -2813,   1341,   2095,  -2560,   -420,   2396, 
+  -954,  -1228,   1208,    153,   -625,    150,     59,     88, 
+    34,   -276,    131,    185,   -184,    -21,     68,     -3, 
+    27,    -59,    -11,     68,    -23,    -17,     -3,     -4, 
+    47,    -26,    -41,     46,      6,    -21,      1,     -8, 
+   -12,      0,     -8,     35,     -7,    -52,     41,     22, 
+   -32,      1,    -17,     33,     30,    -75,     10,     39, 
+     0,     26,   -125,     30,    226,   -203,   -129,    230, 
+   -19,     43,   -201,   -263,    909,   -202,  -1491,   1444, 
+  1078,  -2618,    445,   2633,  -2095,  -1304,   2656,   -379, 
+ -1872,   1228,    615,   -968,     99,    294,    -59,     45, 
+  -216,     43,    258,   -185,    -93,    136,    -10,     -7, 
+   -27,    -30,     75,    -10,    -45,     17,     -1,     28, 
+    -7,    -51,     41,     23,    -38,      3,      3,      8, 
+ /* phase 6 */
+    -7,      1,    -19,      0,     48,    -34,    -34,     46, 
+     0,     -5,    -13,    -28,     65,      0,    -64,     24, 
+    -2,     60,      0,   -191,    151,    170,   -269,      0, 
+   106,     39,    180,   -576,      0,   1259,  -1002,  -1218, 
+  2284,      0,  -2721,   1739,   1739,  -2721,      0,   2284, 
+ -1218,  -1002,   1259,      0,   -576,    180,     39,    106, 
+     0,   -269,    170,    151,   -191,      0,     60,     -2, 
+    24,    -64,      0,     65,    -28,    -13,     -5,      0, 
+    46,    -34,    -34,     48,      0,    -19,      1,     -7, 
+   -10,     -2,     -6,     37,    -15,    -47,     47,     15, 
+   -30,      1,    -18,     39,     21,    -76,     21,     33, 
+     2,     19,   -132,     62,    208,   -234,    -87,    226, 
+   -34,     53,   -249,   -187,    950,   -409,  -1379,   1676, 
+   742,  -2670,    884,   2394,  -2394,   -884,   2670,   -742, 
+ -1676,   1379,    409,   -950,    187,    249,    -53,     34, 
+  -226,     87,    234,   -208,    -62,    132,    -19,     -2, 
+   -33,    -21,     76,    -21,    -39,     18,     -1,     30, 
+   -15,    -47,     47,     15,    -37,      6,      2,     10, 
+ /* phase 7 */
+    -8,      1,    -21,      6,     46,    -41,    -26,     47, 
+    -4,     -3,    -17,    -23,     68,    -11,    -59,     27, 
+    -3,     68,    -21,   -184,    185,    131,   -277,     34, 
+    88,     59,    150,   -625,    153,   1208,  -1228,   -954, 
+  2396,   -420,  -2560,   2095,   1341,  -2813,    414,   2117, 
+ -1444,   -760,   1276,   -144,   -516,    201,     22,    122, 
+   -36,   -254,    203,    115,   -193,     19,     51,      0, 
+    20,    -68,     11,     59,    -33,     -9,     -7,      5, 
+    44,    -41,    -26,     49,     -5,    -16,      0,     -6, 
+    -8,     -3,     -3,     38,    -23,    -41,     51,      7, 
+   -28,      1,    -17,     45,     10,    -75,     30,     27, 
+     7,     10,   -137,     93,    185,   -258,    -43,    216, 
+   -45,     59,   -294,    -99,    968,   -615,  -1228,   1872, 
+   379,  -2656,   1304,   2095,  -2633,   -445,   2618,  -1078, 
+ -1444,   1491,    202,   -909,    263,    201,    -43,     19, 
+  -230,    129,    203,   -226,    -30,    125,    -26,      0, 
+   -39,    -10,     75,    -30,    -33,     17,     -1,     32, 
+   -22,    -41,     52,      7,    -35,      8,      0,     12, 
+ /* phase 8 */
+    -8,      1,    -22,     12,     42,    -47,    -17,     46, 
+    -8,      0,    -21,    -16,     70,    -23,    -52,     28, 
+    -3,     74,    -44,   -171,    214,     90,   -277,     65, 
+    70,     82,    109,   -661,    312,   1122,  -1430,   -658, 
+  2451,   -836,  -2333,   2400,    911,  -2835,    813,   1901, 
+ -1629,   -507,   1260,   -275,   -447,    213,      9,    135, 
+   -74,   -232,    231,     77,   -190,     37,     42,      4, 
+    14,    -70,     23,     53,    -36,     -5,    -10,     10, 
+    41,    -47,    -17,     49,    -10,    -13,      0,     -4, 
+    -6,     -5,      0,     37,    -31,    -34,     54,      0, 
+   -25,      0,    -15,     50,      0,    -72,     38,     20, 
+    12,      0,   -137,    124,    155,   -277,      0,    201, 
+   -50,     60,   -336,      0,    961,   -815,  -1039,   2026, 
+     0,  -2575,   1695,   1744,  -2806,      0,   2502,  -1381, 
+ -1183,   1562,      0,   -847,    325,    154,    -30,      0, 
+  -228,    168,    168,   -237,      0,    115,    -31,      2, 
+   -44,      0,     72,    -38,    -26,     16,      0,     32, 
+   -29,    -34,     55,      0,    -32,     10,      0,     14, 
+ /* phase 9 */
+    -8,      1,    -24,     18,     37,    -52,     -8,     44, 
+   -11,      0,    -26,     -8,     70,    -34,    -44,     28, 
+    -2,     79,    -68,   -153,    239,     45,   -270,     92, 
+    51,    107,     59,   -680,    473,   1003,  -1603,   -337, 
+  2444,  -1237,  -2047,   2645,    460,  -2787,   1185,   1643, 
+ -1767,   -251,   1213,   -391,   -372,    215,      2,    144, 
+  -111,   -204,    253,     38,   -182,     52,     33,      8, 
+     7,    -71,     34,     45,    -37,     -2,    -12,     16, 
+    36,    -52,     -8,     47,    -15,    -11,     -1,     -2, 
+    -4,     -6,      3,     36,    -37,    -26,     56,     -7, 
+   -22,      0,    -13,     53,    -11,    -67,     44,     14, 
+    17,    -12,   -134,    153,    122,   -288,     42,    181, 
+   -51,     54,   -372,    107,    928,  -1003,   -817,   2132, 
+  -387,  -2429,   2047,   1348,  -2908,    441,   2325,  -1643, 
+  -900,   1590,   -192,   -767,    372,    109,    -15,    -22, 
+  -219,    204,    129,   -242,     28,    102,    -33,      4, 
+   -49,     11,     67,    -45,    -19,     15,      1,     31, 
+   -36,    -26,     56,     -7,    -29,     11,      0,     15, 
+ /* phase 10 */
+    -7,      0,    -24,     24,     31,    -56,      0,     41, 
+   -13,      2,    -30,      0,     69,    -44,    -36,     26, 
+     0,     82,    -91,   -130,    258,      0,   -257,    114, 
+    35,    133,      0,   -681,    630,    853,  -1741,      0, 
+  2376,  -1612,  -1707,   2825,      0,  -2670,   1521,   1350, 
+ -1857,      0,   1139,   -488,   -294,    209,      0,    149, 
+  -147,   -170,    268,      0,   -170,     64,     24,     12, 
+     0,    -69,     44,     37,    -38,      0,    -13,     22, 
+    31,    -56,      0,     44,    -18,     -8,     -2,      0, 
+    -2,     -8,      8,     34,    -43,    -18,     56,    -13, 
+   -18,     -2,     -9,     56,    -22,    -61,     49,      8, 
+    22,    -26,   -126,    179,     84,   -292,     83,    158, 
+   -48,     43,   -401,    221,    868,  -1174,   -565,   2187, 
+  -772,  -2219,   2350,    918,  -2938,    867,   2094,  -1858, 
+  -603,   1578,   -370,   -673,    405,     68,      0,    -48, 
+  -203,    234,     87,   -241,     55,     88,    -34,      4, 
+   -52,     22,     61,    -51,    -12,     12,      4,     30, 
+   -42,    -18,     56,    -14,    -25,     11,      0,     16, 
+ /* phase 11 */
+    -6,     -1,    -24,     30,     25,    -58,      8,     37, 
+   -14,      2,    -33,      9,     65,    -53,    -26,     24, 
+     4,     81,   -114,   -103,    271,    -45,   -237,    131, 
+    20,    157,    -66,   -664,    780,    673,  -1838,    346, 
+  2247,  -1952,  -1323,   2935,   -458,  -2488,   1815,   1030, 
+ -1899,    242,   1039,   -567,   -215,    197,      2,    149, 
+  -181,   -132,    276,    -37,   -154,     73,     16,     17, 
+    -8,    -65,     52,     27,    -37,      1,    -14,     27, 
+    24,    -58,      8,     40,    -21,     -5,     -4,      2, 
+    -1,     -9,     12,     30,    -49,     -9,     54,    -19, 
+   -14,     -5,     -5,     57,    -33,    -53,     52,      3, 
+    26,    -41,   -114,    202,     43,   -288,    120,    131, 
+   -40,     24,   -420,    338,    780,  -1321,   -291,   2188, 
+ -1145,  -1952,   2596,    464,  -2894,   1267,   1815,  -2023, 
+  -300,   1528,   -529,   -567,    423,     31,     15,    -75, 
+  -181,    259,     43,   -233,     78,     73,    -33,      2, 
+   -54,     33,     52,    -54,     -5,     10,      7,     27, 
+   -48,     -9,     55,    -20,    -21,     11,      0,     17, 
+ /* phase 12 */
+    -5,     -3,    -23,     36,     17,    -59,     16,     32, 
+   -15,      2,    -36,     18,     60,    -60,    -17,     21, 
+     9,     79,   -135,    -71,    277,    -90,   -211,    143, 
+     9,    179,   -139,   -626,    918,    468,  -1892,    693, 
+  2058,  -2246,   -903,   2972,   -903,  -2246,   2059,    693, 
+ -1892,    468,    918,   -626,   -139,    179,      9,    143, 
+  -211,    -90,    277,    -71,   -135,     79,      9,     21, 
+   -17,    -60,     60,     18,    -36,      2,    -15,     32, 
+    16,    -59,     17,     36,    -23,     -3,     -5,      5, 
+     0,    -10,     16,     26,    -53,      0,     52,    -23, 
+   -11,     -7,      0,     56,    -43,    -43,     54,      0, 
+    30,    -57,    -98,    220,      0,   -277,    153,    104, 
+   -29,      0,   -428,    454,    667,  -1441,      0,   2133, 
+ -1495,  -1632,   2779,      0,  -2779,   1632,   1495,  -2133, 
+     0,   1441,   -667,   -454,    428,      0,     29,   -104, 
+  -153,    277,      0,   -220,     98,     57,    -30,      0, 
+   -54,     43,     43,    -56,      0,      7,     11,     23, 
+   -52,      0,     53,    -26,    -16,     10,      0,     17, 
+};
+
+const int v34_table_version = 3;
+const u32 v34_table_checksum = 0xa82fc0b0;
@@ -0,0 +1,139 @@
+#ifndef V34TABLE_H
+#define V34TABLE_H
+
+/* Constant tables of the V34 & V22 modems. v34gen computes them and
+   prints v34table.c. This file is their only description: it is
+   used by v34gen, by the modems to declare and index them, and by
+   V34_static_init() to check that v34table.c matches.
+
+   The G.711 tables of V90 (v90gen, v90table.c) are not described
+   here: they are two fixed 128 entry tables which do not depend on
+   any parameter of this file. */
+
+/* must be incremented each time a table changes, so that an old
+   v34table.c is detected */
+#define V34_TABLE_VERSION 3
+
+#define V34_SAMPLE_RATE_NUM 10
+#define V34_SAMPLE_RATE_DEN 3
+#define V34_SAMPLE_RATE ((2400*V34_SAMPLE_RATE_NUM)/V34_SAMPLE_RATE_DEN)
+
+/* size of the raised root cosine filter (for both rx & tx) */
+#define RC_FILTER_SIZE 40
+
+/* symbol rates: SYMBOL_RATE(a, c, d1, e1, d2, e2, J, P, a1, c1).
+   S = 2400 * a / c (table 1), the low and high carriers are S * d1 /
+   e1 and S * d2 / e2. The last two depend on the sample rate: S =
+   a1 / c1 * V34_SAMPLE_RATE */
+#define V34_SYMBOL_RATES \
+    SYMBOL_RATE( 1, 1, 2, 3, 3, 4, 7, 12,  3, 10) /* S=2400 */ \
+    SYMBOL_RATE( 8, 7, 3, 5, 2, 3, 8, 12, 12, 35) /* S=2743 */ \
+    SYMBOL_RATE( 7, 6, 3, 5, 2, 3, 7, 14,  7, 20) /* S=2800 */ \
+    SYMBOL_RATE( 5, 4, 3, 5, 2, 3, 7, 15,  3,  8) /* S=3000 */ \
+    SYMBOL_RATE( 4, 3, 4, 7, 3, 5, 7, 16,  2,  5) /* S=3200 */ \
+    SYMBOL_RATE(10, 7, 4, 7, 4, 7, 8, 15,  3,  7) /* S=3429 */
+
+/* trellis coded modulation: TRELLIS(n) is trellis_trans_<n>[256][4],
+   the 4D points of each subset for the codes with n transitions per
+   state (16, 32 & 64 states) */
+#define V34_TRELLIS_TABLES \
+    TRELLIS(4) \
+    TRELLIS(8) \
+    TRELLIS(16)
+
+/* rx filters: matched filter centered on the carrier which also
+   converts the sample rate to 3 * S. RX_FILTER(name, S, high) is
+   v34_rx_filter_<name> for the symbol rate index S and the low or
+   high carrier (S=3429 has only one carrier).
+
+   The filter is computed with c1 * RC_FILTER_SIZE + 1 coefficients,
+   and an output uses one coefficient every 3 * a1. It is stored in
+   polyphase layout: row p contains the coefficients p + j * 3 * a1,
+   so that the rows p and p + 1 used for an output are contiguous.
+   Each row is padded with zeros to a multiple of 8 coefficients and
+   the tables are aligned on 16 bytes for SIMD code. */
+#define V34_RX_FILTERS \
+    RX_FILTER(2400_1600, 0, 0) \
+    RX_FILTER(2400_1800, 0, 1) \
+    RX_FILTER(2743_1646, 1, 0) \
+    RX_FILTER(2743_1829, 1, 1) \
+    RX_FILTER(2800_1680, 2, 0) \
+    RX_FILTER(2800_1867, 2, 1) \
+    RX_FILTER(3000_1800, 3, 0) \
+    RX_FILTER(3000_2000, 3, 1) \
+    RX_FILTER(3200_1829, 4, 0) \
+    RX_FILTER(3200_1920, 4, 1) \
+    RX_FILTER(3429_1959, 5, 0)
+
+#define V34_RX_FILTER_PHASES(a1)     (3 * (a1) + 1)
+#define V34_RX_FILTER_TAPS(a1, c1)   (((c1) * RC_FILTER_SIZE) / (3 * (a1)))
+#define V34_RX_FILTER_STRIDE(a1, c1) ((V34_RX_FILTER_TAPS(a1, c1) + 7) & ~7)
+#define V34_RX_FILTER_SIZE(a1, c1) \
+    (V34_RX_FILTER_PHASES(a1) * V34_RX_FILTER_STRIDE(a1, c1))
+
+/* tx filters: root raised cosine. TX_FILTER(c1, S) is
+   v34_rc_<c1>_filter (RC_FILTER_SIZE * c1 + 1 coefficients) for the
+   symbol rate index S */
+#define V34_TX_FILTERS \
+    TX_FILTER(10, 0) \
+    TX_FILTER(35, 1) \
+    TX_FILTER(20, 2) \
+    TX_FILTER(8, 3) \
+    TX_FILTER(5, 4) \
+    TX_FILTER(7, 5)
+
+/* V22 tx filter v22_tx_filter: 600 symbols/s, beta = 0.75. 40
+   phases (sure too much, but we don't optimize right now) */
+#define V22_TX_FILTER_SIZE (20 * 40)
+
+/* V22 rx filters: analytic matched filter (complex coefficients,
+   beta = 0.75) centered on the carrier, which also converts the 8000
+   Hz flow to 2 complex samples per symbol (8000 * 12 / 80 = 1200
+   Hz). V22_RX_FILTER(carrier) is v22_rx_filter_<carrier>.
+
+   The filter is computed at 8000 * V22_RX_UPSAMPLE Hz with
+   V22_RX_FILTER_TAPS * V22_RX_UPSAMPLE + 1 coefficients and uses the
+   same polyphase layout as the V34 rx filters, except that each row
+   contains the real parts then the imaginary parts of its
+   coefficients. */
+#define V22_RX_FILTERS \
+    V22_RX_FILTER(1200) \
+    V22_RX_FILTER(2400)
+
+#define V22_RX_UPSAMPLE      12
+#define V22_RX_DECIM         80
+#define V22_RX_FILTER_PHASES (V22_RX_UPSAMPLE + 1)
+#define V22_RX_FILTER_TAPS   72 /* 5.4 symbols */
+#define V22_RX_FILTER_STRIDE ((V22_RX_FILTER_TAPS + 7) & ~7)
+#define V22_RX_FILTER_SIZE   (V22_RX_FILTER_PHASES * 2 * V22_RX_FILTER_STRIDE)
+
+#define TRELLIS(n) extern u8 trellis_trans_ ## n[256][4];
+V34_TRELLIS_TABLES
+#undef TRELLIS
+#define RX_FILTER(name, S, high) extern s16 v34_rx_filter_ ## name[];
+V34_RX_FILTERS
+#undef RX_FILTER
+#define TX_FILTER(c1, S) extern s16 v34_rc_ ## c1 ## _filter[];
+V34_TX_FILTERS
+#undef TX_FILTER
+extern s16 v22_tx_filter[V22_TX_FILTER_SIZE];
+#define V22_RX_FILTER(carrier) \
+    extern s16 v22_rx_filter_ ## carrier[V22_RX_FILTER_SIZE];
+V22_RX_FILTERS
+#undef V22_RX_FILTER
+
+/* V34_TABLE_VERSION and checksum of the tables when v34table.c was
+   generated */
+extern const int v34_table_version;
+extern const u32 v34_table_checksum;
+
+/* the checksum is computed on the values of the tables (FNV-1a), in
+   the order of this file */
+#define V34_TABLE_SUM_INIT 2166136261U
+
+static inline u32 v34_table_sum(u32 sum, int v)
+{
+    return (sum ^ (v & 0xffff)) * 16777619;
+}
+
+#endif
@@ -0,0 +1,779 @@
+/*
+ * V42 LAPM error correction
+ *
+ * Copyright (c) 2000 Fabrice Bellard.
+ *
+ * This code is released under the GNU General Public License version
+ * 2. Please read the file COPYING to know the exact terms of the
+ * license.
+ */
+#include <pthread.h>
+
+#include "lm.h"
+
+/*
+ * The LAPM frames are sent with HDLC framing: flags, zero bit
+ * stuffing and a FCS (16 or 32 bits). The bits of each octet are sent
+ * LSB first. The bit stuffing, the destuffing and the CRC are done one
+ * octet at a time with precomputed tables. The bit by bit code is only
+ * used for the received octets which contain a flag or an abort.
+ *
+ * XXX: no XID negotiation (default parameters are used on both
+ * sides), no SREJ, no break handling. The detection phase is replaced
+ * by the V8 negotiation.
+ */
+
+/* address field: DLCI 0, C/R bit set for the commands of the caller */
+#define ADDR_CR  0x02
+#define ADDR_EA  0x01
+
+/* control field */
+#define CTL_PF    0x10 /* P/F bit of U frames */
+#define CTL_SABME 0x6f
+#define CTL_UA    0x63
+#define CTL_DISC  0x43
+#define CTL_DM    0x0f
+
+#define CTL_RR    0x01
+#define CTL_RNR   0x05
+#define CTL_REJ   0x09
+
+#define HDLC_FLAG 0x7e
+
+#define FCS16_INIT 0xffff
+#define FCS16_GOOD 0xf0b8
+#define FCS32_INIT 0xffffffff
+#define FCS32_GOOD 0xdebb20e3
+
+/* stuffing tables: output bits | (nb bits << 16) | (ones << 24) */
+static u32 stuff_tab[5][256];
+/* destuffing tables: data bits | (nb bits << 16) | (ones << 24). If
+   a sixth one is found (flag or abort), DESTUFF_SPECIAL is set */
+#define DESTUFF_SPECIAL 0x80000000
+static u32 destuff_tab[6][256];
+static u16 fcs16_tab[256];
+static u32 fcs32_tab[256];
+static pthread_once_t v42_tables_once = PTHREAD_ONCE_INIT;
+
+static void v42_static_init(void)
+{
+    int i, j, ones0, ones, bit, n, special;
+    u32 out, c;
+
+    for(i=0;i<256;i++) {
+        c = i;
+        for(j=0;j<8;j++)
+            c = (c & 1) ? (c >> 1) ^ 0x8408 : (c >> 1);
+        fcs16_tab[i] = c;
+        c = i;
+        for(j=0;j<8;j++)
+            c = (c & 1) ? (c >> 1) ^ 0xedb88320 : (c >> 1);
+        fcs32_tab[i] = c;
+    }
+
+    for(ones0=0;ones0<5;ones0++) {
+        for(i=0;i<256;i++) {
+            ones = ones0;
+            out = 0;
+            n = 0;
+            for(j=0;j<8;j++) {
+                bit = (i >> j) & 1;
+                out |= bit << n;
+                n++;
+                if (bit) {
+                    if (++ones == 5) {
+                        /* stuffed zero */
+                        n++;
+                        ones = 0;
+                    }
+                } else {
+                    ones = 0;
+                }
+            }
+            stuff_tab[ones0][i] = out | (n << 16) | (ones << 24);
+        }
+    }
+
+    for(ones0=0;ones0<6;ones0++) {
+        for(i=0;i<256;i++) {
+            ones = ones0;
+            out = 0;
+            n = 0;
+            special = 0;
+            for(j=0;j<8;j++) {
+                bit = (i >> j) & 1;
+                if (bit) {
+                    if (++ones == 6) {
+                        special = 1;
+                        break;
+                    }
+                    out |= 1 << n;
+                    n++;
+                } else {
+                    /* a zero after five ones is a stuffed zero */
+                    if (ones != 5)
+                        n++;
+                    ones = 0;
+                }
+            }
+            destuff_tab[ones0][i] = special ? DESTUFF_SPECIAL :
+                (out | (n << 16) | (ones << 24));
+        }
+    }
+}
+
+static inline u32 fcs_update(V42State *s, u32 crc, int c)
+{
+    if (s->use_fcs32)
+        return (crc >> 8) ^ fcs32_tab[(crc ^ c) & 0xff];
+    else
+        return (crc >> 8) ^ fcs16_tab[(crc ^ c) & 0xff];
+}
+
+static void v42_rx_reset(V42State *s)
+{
+    s->rx_shift = 0;
+    s->rx_shift_cnt = 0;
+    s->rx_frame_len = 0;
+    s->rx_crc = s->use_fcs32 ? FCS32_INIT : FCS16_INIT;
+}
+
+/* 'n401' is the maximum size of the I frames sent. The rates (in
+   bits/s) of each direction are used to compute T401 */
+void v42_init(V42State *s, int calling, int use_fcs32, int n401,
+              int tx_rate, int rx_rate,
+              struct sm_fifo *rx_fifo, struct sm_fifo *tx_fifo,
+              const unsigned int *clock)
+{
+    int frame_bits;
+
+    /* the first modem computes the tables */
+    pthread_once(&v42_tables_once, v42_static_init);
+
+    memset(s, 0, sizeof(*s));
+    s->calling = calling;
+    s->use_fcs32 = use_fcs32;
+    if (n401 <= 0 || n401 > V42_N401)
+        n401 = V42_N401;
+    s->n401 = n401;
+    s->rx_fifo = rx_fifo;
+    s->tx_fifo = tx_fifo;
+    sm_timer_init(&s->t401_timer, clock);
+
+    /* T401 must be longer than a maximum size frame in each
+       direction (the ack can wait for the end of a peer I frame) */
+    frame_bits = (n401 + 3 + 4 + 2) * 10;
+    s->t401 = 1000 + (frame_bits * 1000) / tx_rate + (frame_bits * 1000) / rx_rate;
+
+    /* idle: flags */
+    s->tx_bits = HDLC_FLAG;
+    s->tx_nbits = 8;
+
+    /* hunt for the first flag */
+    v42_rx_reset(s);
+    s->rx_frame_len = -1;
+
+    /* the caller establishes the link, the answerer waits for the
+       SABME (the same timeouts are used) */
+    s->state = V42_SETUP;
+    if (calling) {
+        s->unnum_pending = 1;
+        s->unnum_cmd = CTL_SABME | CTL_PF;
+    }
+    sm_set_timer(&s->t401_timer, s->t401);
+    s->t401_running = 1;
+}
+
+/* request a disconnection */
+void v42_disconnect(V42State *s)
+{
+    if (s->state != V42_CONNECTED && s->state != V42_SETUP) {
+        s->state = V42_DISCONNECTED;
+        return;
+    }
+    s->state = V42_DISCONNECTING;
+    s->unnum_pending = 1;
+    s->unnum_cmd = CTL_DISC | CTL_PF;
+    s->retry_count = 0;
+    sm_set_timer(&s->t401_timer, s->t401);
+    s->t401_running = 1;
+}
+
+/* return true if the link is closed and the last frame sent */
+int v42_closed(V42State *s)
+{
+    return s->state == V42_FAILED ||
+        (s->state == V42_DISCONNECTED && !s->unnum_pending &&
+         s->tx_frame_ptr >= s->tx_frame_len);
+}
+
+static inline int addr_cmd(V42State *s, int command)
+{
+    /* the caller sets C/R in its commands, the answerer in its responses */
+    return ((command == s->calling) ? ADDR_CR : 0) | ADDR_EA;
+}
+
+/* handle N(R) of a received frame. Return -1 if N(R) is invalid */
+static int v42_ack(V42State *s, int nr)
+{
+    if (((nr - s->va) & 127) > ((s->vn - s->va) & 127))
+        return -1;
+
+    while (s->va != nr) {
+        s->window[s->va & (V42_NB_SLOTS-1)].len = 0;
+        s->va = (s->va + 1) & 127;
+        s->retry_count = 0;
+        if (s->va == s->vn) {
+            s->t401_running = 0;
+        } else {
+            sm_set_timer(&s->t401_timer, s->t401);
+            s->t401_running = 1;
+        }
+    }
+    /* after a go back, the retransmission may already be acked */
+    if (((s->vs - s->va) & 127) > ((s->vn - s->va) & 127))
+        s->vs = s->va;
+    return 0;
+}
+
+/* process a received frame (without FCS) */
+static void v42_rx_frame(V42State *s, u8 *f, int len)
+{
+    int command, ctl, pf, nr, ns, i;
+    struct sm_fifo *rx;
+
+    s->nb_rx_frames++;
+    /* the peer commands have our response address */
+    if (f[0] == addr_cmd(s, 0))
+        command = 1;
+    else if (f[0] == addr_cmd(s, 1))
+        command = 0;
+    else
+        return;
+    ctl = f[1];
+
+    if ((ctl & 3) == 3) {
+        /* U frames */
+        pf = ctl & CTL_PF;
+        switch(ctl & ~CTL_PF) {
+        case CTL_SABME:
+            if (!command)
+                break;
+            s->vs = s->va = s->vr = s->vn = 0;
+            for(i=0;i<V42_NB_SLOTS;i++)
+                s->window[i].len = 0;
+            s->peer_busy = s->reject_sent = s->ack_pending = 0;
+            s->own_busy = s->busy_discard = 0;
+            s->reject_pending = s->poll_pending = 0;
+            s->retry_count = 0;
+            s->t401_running = 0;
+            s->state = V42_CONNECTED;
+            s->unnum_pending = 1;
+            s->unnum_cmd = CTL_UA | pf;
+            break;
+        case CTL_UA:
+            if (s->state == V42_SETUP) {
+                s->state = V42_CONNECTED;
+                s->t401_running = 0;
+                s->retry_count = 0;
+            } else if (s->state == V42_DISCONNECTING) {
+                s->state = V42_DISCONNECTED;
+                s->t401_running = 0;
+            }
+            break;
+        case CTL_DISC:
+            if (!command)
+                break;
+            s->state = V42_DISCONNECTED;
+            s->t401_running = 0;
+            s->unnum_pending = 1;
+            s->unnum_cmd = CTL_UA | pf;
+            break;
+        case CTL_DM:
+            if (s->state != V42_DISCONNECTED) {
+                s->state = V42_DISCONNECTED;
+                s->t401_running = 0;
+            }
+            break;
+        }
+        return;
+    }
+
+    if (s->state != V42_CONNECTED || len < 3)
+        return;
+    nr = f[2] >> 1;
+    pf = f[2] & 1;
+
+    if ((ctl & 1) == 0) {
+        /* I frame */
+        ns = ctl >> 1;
+        rx = s->rx_fifo;
+        if (ns == s->vr && (rx->max_size - rx->size) >= (len - 3)) {
+            /* the frames sent before the RNR is received still fit */
+            for(i=3;i<len;i++)
+                sm_put_bit(rx, f[i]);
+            s->vr = (s->vr + 1) & 127;
+            s->reject_sent = 0;
+            s->ack_pending = 1;
+            if (!s->own_busy &&
+                (rx->max_size - rx->size) < V42_RX_BUSY * s->n401) {
+                /* the RNR is sent instead of the RR */
+                s->own_busy = 1;
+                s->nb_rnr++;
+            }
+        } else if (ns == s->vr || s->own_busy) {
+            /* no room: the peer is stopped with RNR (repeated if it
+               was lost) and retransmits after the busy condition */
+            if (!s->own_busy) {
+                s->own_busy = 1;
+                s->nb_rnr++;
+            }
+            s->busy_discard = 1;
+            s->ack_pending = 1;
+        } else if (!s->reject_sent) {
+            /* sequence error: ask for a retransmission */
+            s->reject_pending = 1;
+            s->reject_sent = 1;
+        }
+        if (pf)
+            s->poll_pending = 1;
+        v42_ack(s, nr);
+    } else {
+        /* S frames */
+        switch(ctl) {
+        case CTL_RR:
+            s->peer_busy = 0;
+            break;
+        case CTL_RNR:
+            s->peer_busy = 1;
+            break;
+        case CTL_REJ:
+            s->peer_busy = 0;
+            break;
+        }
+        if (v42_ack(s, nr) < 0)
+            return;
+        if ((ctl == CTL_REJ || (!command && pf)) && s->vs != nr) {
+            /* REJ or answer to a poll: retransmit from N(R) */
+            s->vs = nr;
+            s->nb_retrans++;
+        }
+        if (!command && pf)
+            s->retry_count = 0;
+        if (command && pf)
+            s->poll_pending = 1;
+        if (s->peer_busy && !s->t401_running) {
+            /* the RR which ends the busy condition may be lost: T401
+               sends an enquiry */
+            sm_set_timer(&s->t401_timer, s->t401);
+            s->t401_running = 1;
+        }
+    }
+}
+
+/* end of frame: check the FCS */
+static void v42_rx_flag(V42State *s)
+{
+    int fcs_len;
+
+    fcs_len = s->use_fcs32 ? 4 : 2;
+    /* the 6 first bits of the flag are in the bit buffer */
+    if (s->rx_frame_len >= 2 + fcs_len && s->rx_shift_cnt == 6) {
+        if (s->rx_crc == (s->use_fcs32 ? FCS32_GOOD : FCS16_GOOD))
+            v42_rx_frame(s, s->rx_frame, s->rx_frame_len - fcs_len);
+        else
+            s->nb_fcs_errors++;
+    }
+    v42_rx_reset(s);
+}
+
+/* add 'n' destuffed bits (LSB first) to the current frame */
+static inline void v42_rx_data(V42State *s, int bits, int n)
+{
+    int c;
+
+    if (s->rx_frame_len < 0)
+        return;
+    s->rx_shift |= bits << s->rx_shift_cnt;
+    s->rx_shift_cnt += n;
+    while (s->rx_shift_cnt >= 8) {
+        c = s->rx_shift & 0xff;
+        s->rx_shift >>= 8;
+        s->rx_shift_cnt -= 8;
+        if (s->rx_frame_len >= V42_MAX_FRAME) {
+            /* too long: wait for the next flag */
+            s->rx_frame_len = -1;
+            return;
+        }
+        s->rx_frame[s->rx_frame_len++] = c;
+        s->rx_crc = fcs_update(s, s->rx_crc, c);
+    }
+}
+
+static void v42_rx_bit(V42State *s, int bit)
+{
+    if (bit) {
+        if (++s->rx_ones < 6) {
+            v42_rx_data(s, 1, 1);
+        } else if (s->rx_ones == 7) {
+            /* abort: ignore everything until the next flag */
+            s->rx_frame_len = -1;
+        } else if (s->rx_ones > 7) {
+            s->rx_ones = 7;
+        }
+    } else {
+        if (s->rx_ones == 6)
+            v42_rx_flag(s);
+        else if (s->rx_ones != 5 && s->rx_ones < 7)
+            v42_rx_data(s, 0, 1);
+        s->rx_ones = 0;
+    }
+}
+
+/* process 8 received bits (first bit in the LSB) */
+static void v42_rx_byte(V42State *s, int c)
+{
+    u32 e;
+    int j;
+
+    if (s->rx_ones <= 5) {
+        e = destuff_tab[s->rx_ones][c];
+        if (!(e & DESTUFF_SPECIAL)) {
+            v42_rx_data(s, e & 0xffff, (e >> 16) & 0xff);
+            s->rx_ones = e >> 24;
+            return;
+        }
+    }
+    for(j=0;j<8;j++)
+        v42_rx_bit(s, (c >> j) & 1);
+}
+
+/* receive 'n' bits (n <= 31, the oldest in the MSB) */
+void v42_put_bits(void *opaque, int bits, int n)
+{
+    V42State *s = opaque;
+    u32 w;
+    int k;
+
+    /* the oldest bit goes to the LSB, as on the line */
+    w = dsp_bit_reverse32(bits) >> (32 - n);
+    while (n > 0) {
+        k = 8 - s->rx_raw_cnt;
+        if (k > n)
+            k = n;
+        s->rx_raw |= (w & ((1 << k) - 1)) << s->rx_raw_cnt;
+        w >>= k;
+        n -= k;
+        s->rx_raw_cnt += k;
+        if (s->rx_raw_cnt == 8) {
+            v42_rx_byte(s, s->rx_raw);
+            s->rx_raw = 0;
+            s->rx_raw_cnt = 0;
+        }
+    }
+}
+
+void v42_put_bit(void *opaque, int bit)
+{
+    v42_put_bits(opaque, bit & 1, 1);
+}
+
+/* clear the own receiver busy condition when the rx fifo is half
+   empty. The peer is told with RR, or with REJ if I frames were
+   discarded */
+static void v42_check_busy(V42State *s)
+{
+    struct sm_fifo *rx = s->rx_fifo;
+
+    if (!s->own_busy || rx->size > rx->max_size / 2)
+        return;
+    s->own_busy = 0;
+    if (s->busy_discard) {
+        s->busy_discard = 0;
+        s->reject_pending = 1;
+        s->reject_sent = 1;
+    } else {
+        s->ack_pending = 1;
+    }
+}
+
+static void v42_check_timer(V42State *s)
+{
+    if (!s->t401_running || !sm_check_timer(&s->t401_timer))
+        return;
+
+    if (++s->retry_count > V42_N400) {
+        s->state = V42_FAILED;
+        s->t401_running = 0;
+        return;
+    }
+    switch(s->state) {
+    case V42_SETUP:
+        if (s->calling) {
+            s->unnum_pending = 1;
+            s->unnum_cmd = CTL_SABME | CTL_PF;
+        }
+        break;
+    case V42_DISCONNECTING:
+        s->unnum_pending = 1;
+        s->unnum_cmd = CTL_DISC | CTL_PF;
+        break;
+    case V42_CONNECTED:
+        /* retransmit all the unacknowledged frames, asking for an
+           immediate ack. If the peer is busy, RR or RNR with the P
+           bit asks for its state */
+        s->vs = s->va;
+        s->poll_next = 1;
+        s->nb_retrans++;
+        break;
+    }
+    sm_set_timer(&s->t401_timer, s->t401);
+}
+
+/* build the next frame to send in tx_frame */
+static void v42_tx_frame(V42State *s)
+{
+    u8 *p;
+    V42Frame *w;
+    int i, n, crc, fcs_len;
+
+    v42_check_timer(s);
+    v42_check_busy(s);
+
+    p = s->tx_frame;
+    if (s->unnum_pending) {
+        /* SABME & DISC are commands, UA & DM responses */
+        n = s->unnum_cmd & ~CTL_PF;
+        *p++ = addr_cmd(s, n == CTL_SABME || n == CTL_DISC);
+        *p++ = s->unnum_cmd;
+        s->unnum_pending = 0;
+    } else if (s->state != V42_CONNECTED) {
+        s->tx_frame_len = 0;
+        return;
+    } else if (s->reject_pending || s->poll_pending ||
+               (s->own_busy && s->ack_pending)) {
+        /* the answer to a poll repeats the REJ condition. RNR is
+           sent before the I frames */
+        *p++ = addr_cmd(s, 0);
+        if (s->own_busy)
+            *p++ = CTL_RNR;
+        else if (s->reject_pending || s->reject_sent)
+            *p++ = CTL_REJ;
+        else
+            *p++ = CTL_RR;
+        *p++ = (s->vr << 1) | s->poll_pending;
+        s->reject_pending = 0;
+        s->poll_pending = 0;
+        s->ack_pending = 0;
+    } else if (s->peer_busy && s->poll_next) {
+        /* T401 expired while the peer is busy: enquiry */
+        *p++ = addr_cmd(s, 1);
+        *p++ = s->own_busy ? CTL_RNR : CTL_RR;
+        *p++ = (s->vr << 1) | 1;
+        s->poll_next = 0;
+        s->ack_pending = 0;
+    } else if (!s->peer_busy &&
+               (s->vs != s->vn ||
+                (((s->vn - s->va) & 127) < V42_K && sm_size(s->tx_fifo) > 0))) {
+        /* I frame: retransmission or new data */
+        w = &s->window[s->vs & (V42_NB_SLOTS-1)];
+        if (s->vs == s->vn) {
+            n = sm_size(s->tx_fifo);
+            if (n > s->n401)
+                n = s->n401;
+            for(i=0;i<n;i++)
+                w->data[i] = sm_get_bit(s->tx_fifo);
+            w->len = n;
+            s->vn = (s->vn + 1) & 127;
+        }
+        /* poll the peer when the window is full, so that a lost
+           frame or a lost REJ does not wait for T401 */
+        if (((s->vs + 1) & 127) == s->vn && ((s->vn - s->va) & 127) >= V42_K)
+            s->poll_next = 1;
+        *p++ = addr_cmd(s, 1);
+        *p++ = s->vs << 1;
+        *p++ = (s->vr << 1) | s->poll_next;
+        memcpy(p, w->data, w->len);
+        p += w->len;
+        s->vs = (s->vs + 1) & 127;
+        s->poll_next = 0;
+        s->ack_pending = 0;
+        if (!s->t401_running) {
+            sm_set_timer(&s->t401_timer, s->t401);
+            s->t401_running = 1;
+        }
+    } else if (s->ack_pending) {
+        *p++ = addr_cmd(s, 0);
+        *p++ = s->own_busy ? CTL_RNR : CTL_RR;
+        *p++ = s->vr << 1;
+        s->ack_pending = 0;
+    } else {
+        s->tx_frame_len = 0;
+        return;
+    }
+
+    /* FCS */
+    fcs_len = s->use_fcs32 ? 4 : 2;
+    crc = s->use_fcs32 ? FCS32_INIT : FCS16_INIT;
+    n = p - s->tx_frame;
+    for(i=0;i<n;i++)
+        crc = fcs_update(s, crc, s->tx_frame[i]);
+    crc = ~crc;
+    for(i=0;i<fcs_len;i++) {
+        *p++ = crc;
+        crc >>= 8;
+    }
+
+    s->tx_frame_len = p - s->tx_frame;
+    s->tx_frame_ptr = 0;
+    s->tx_ones = 0;
+    s->nb_tx_frames++;
+}
+
+/* return 'n' bits (n <= 31, the oldest in the MSB) */
+int v42_get_bits(void *opaque, int n)
+{
+    V42State *s = opaque;
+    u32 e, w;
+    int k;
+
+    w = 0;
+    while (n > 0) {
+        if (s->tx_nbits == 0) {
+            if (s->tx_frame_ptr < s->tx_frame_len) {
+                e = stuff_tab[s->tx_ones][s->tx_frame[s->tx_frame_ptr++]];
+                s->tx_bits = e & 0xffff;
+                s->tx_nbits = (e >> 16) & 0xff;
+                s->tx_ones = e >> 24;
+            } else {
+                /* closing flag, which is also the opening flag of
+                   the next frame (or an idle flag) */
+                s->tx_bits = HDLC_FLAG;
+                s->tx_nbits = 8;
+                v42_tx_frame(s);
+            }
+        }
+        k = s->tx_nbits;
+        if (k > n)
+            k = n;
+        /* tx_bits is sent LSB first */
+        w = (w << k) | 
+            (dsp_bit_reverse32(s->tx_bits & ((1 << k) - 1)) >> (32 - k));
+        s->tx_bits >>= k;
+        s->tx_nbits -= k;
+        n -= k;
+    }
+    return w;
+}
+
+int v42_get_bit(void *opaque)
+{
+    return v42_get_bits(opaque, 1);
+}
+
+/* test: two LAPM entities connected by a binary symmetric channel.
+   T401 is not tested because the time does not advance. In the slow
+   reader test, the receiver reads one byte every 64 bits, so that its
+   fifo fills up and the flow is controlled by RNR. The last tests use
+   the block bit I/O. */
+
+#define V42_TEST_BITS 2000000
+
+/* error mask of 'n' bits of a binary symmetric channel */
+static int test_flips(float pe, int n, int *nb_flips)
+{
+    int i, mask;
+
+    mask = 0;
+    if (pe > 0) {
+        for(i=0;i<n;i++) {
+            if (random_unif() < pe) {
+                mask |= 1 << i;
+                if (nb_flips)
+                    (*nb_flips)++;
+            }
+        }
+    }
+    return mask;
+}
+
+void V42_test(void)
+{
+    static const struct {
+        float pe;
+        int read_period; /* in bits, 0 = read everything */
+        int block;       /* bits per call, 1 = v42_get_bit/v42_put_bit */
+    } tests[] = {
+        { 0, 0, 1 },
+        { 1e-5, 0, 1 },
+        { 1e-4, 0, 1 },
+        { 1e-3, 0, 1 },
+        { 0, 64, 1 },
+        { 0, 0, 24 },
+        { 1e-5, 0, 24 },
+    };
+    V42State a, b;
+    u8 a_rx_buf[4096], a_tx_buf[4096], b_rx_buf[4096], b_tx_buf[4096];
+    struct sm_fifo a_rx, a_tx, b_rx, b_tx;
+    unsigned int time;
+    int i, k, n, w, c, tx_count, rx_count, nb_good, nb_bad, nb_flips;
+    float pe;
+
+    time = 0;
+    for(k=0;k<sizeof(tests)/sizeof(tests[0]);k++) {
+        pe = tests[k].pe;
+        sm_init_fifo(&a_rx, a_rx_buf, sizeof(a_rx_buf));
+        sm_init_fifo(&a_tx, a_tx_buf, sizeof(a_tx_buf));
+        sm_init_fifo(&b_rx, b_rx_buf, sizeof(b_rx_buf));
+        sm_init_fifo(&b_tx, b_tx_buf, sizeof(b_tx_buf));
+        v42_init(&a, 1, 0, V42_N401, 1200, 1200, &a_rx, &a_tx, &time);
+        v42_init(&b, 0, 0, V42_N401, 1200, 1200, &b_rx, &b_tx, &time);
+
+        n = tests[k].block;
+        tx_count = rx_count = nb_good = nb_bad = nb_flips = 0;
+        for(i=0;i<V42_TEST_BITS;i+=n) {
+            /* a sends a counter to b */
+            while (sm_size(&a_tx) < sizeof(a_tx_buf) - 1)
+                sm_put_bit(&a_tx, tx_count++ & 0xff);
+
+            if (n == 1) {
+                w = v42_get_bit(&a) ^ test_flips(pe, 1, &nb_flips);
+                v42_put_bit(&b, w);
+                w = v42_get_bit(&b) ^ test_flips(pe, 1, NULL);
+                v42_put_bit(&a, w);
+            } else {
+                w = v42_get_bits(&a, n) ^ test_flips(pe, n, &nb_flips);
+                v42_put_bits(&b, w, n);
+                w = v42_get_bits(&b, n) ^ test_flips(pe, n, NULL);
+                v42_put_bits(&a, w, n);
+            }
+
+            for(;;) {
+                if (tests[k].read_period && (i % tests[k].read_period) != 0)
+                    break;
+                c = sm_get_bit(&b_rx);
+                if (c == -1)
+                    break;
+                if (c == (rx_count & 0xff)) {
+                    nb_good++;
+                } else {
+                    nb_bad++;
+                    rx_count = c;
+                }
+                rx_count++;
+                if (tests[k].read_period)
+                    break;
+            }
+        }
+        printf("Pe=%g", pe);
+        if (tests[k].read_period)
+            printf(" slow reader");
+        if (n > 1)
+            printf(" %d bit blocks", n);
+        printf(": bit errors=%d goodput=%0.1f%% bad bytes=%d "
+               "frames=%d fcs errors=%d retransmissions=%d rnr=%d\n",
+               nb_flips, 
+               100.0 * nb_good * 8.0 / V42_TEST_BITS, nb_bad,
+               b.nb_rx_frames, b.nb_fcs_errors, a.nb_retrans, b.nb_rnr);
+    }
+}
@@ -0,0 +1,92 @@
+#ifndef V42_H
+#define V42_H
+
+/* V42 LAPM error correction (HDLC framing, modulo 128) */
+
+#define V42_N401     128  /* maximum number of octets in an I frame (default) */
+#define V42_K        15   /* window size */
+#define V42_N400     10   /* maximum number of retransmissions */
+#define V42_NB_SLOTS 16   /* >= V42_K, power of two */
+
+/* own receiver busy: RNR is sent when less than V42_RX_BUSY maximum
+   size I frames fit in the rx fifo, RR when it is half empty */
+#define V42_RX_BUSY  4
+
+/* address, 2 control octets and FCS32 */
+#define V42_MAX_FRAME (V42_N401 + 3 + 4)
+
+/* link states */
+enum {
+    V42_DISCONNECTED,
+    V42_SETUP,        /* SABME sent, waiting for UA (or for SABME) */
+    V42_CONNECTED,
+    V42_DISCONNECTING, /* DISC sent, waiting for UA */
+    V42_FAILED,       /* N400 retransmissions without answer */
+};
+
+typedef struct {
+    u8 data[V42_N401];
+    int len;
+} V42Frame;
+
+typedef struct V42State {
+    int calling;
+    int use_fcs32;
+    int n401;         /* maximum size of the transmitted I frames */
+    int state;
+    struct sm_fifo *rx_fifo, *tx_fifo;
+
+    /* state variables (modulo 128) */
+    int vs, va, vr;
+    int vn;           /* next new sequence number (vs < vn after a REJ) */
+    int peer_busy;    /* RNR received */
+    int own_busy;     /* RNR sent: the rx fifo is almost full */
+    int busy_discard; /* an I frame was discarded while busy */
+    int reject_sent;  /* REJ exception condition */
+    int reject_pending; /* a REJ must be sent */
+    int ack_pending;  /* an I frame must be acknowledged */
+    int poll_pending; /* a P bit must be answered with a F bit */
+    int poll_next;    /* set the P bit in the next I frame */
+    int unnum_pending; /* U frame to send (command or response) */
+    int unnum_cmd;
+    int retry_count;
+    int t401;         /* in ms */
+    struct sm_timer t401_timer;
+    int t401_running;
+    V42Frame window[V42_NB_SLOTS]; /* I frames waiting for an ack */
+
+    /* transmit: stuffed bits are sent LSB first */
+    u8 tx_frame[V42_MAX_FRAME];
+    int tx_frame_len, tx_frame_ptr;
+    int tx_ones;      /* consecutive ones sent in the frame */
+    unsigned int tx_bits;
+    int tx_nbits;
+
+    /* receive */
+    unsigned int rx_raw;
+    int rx_raw_cnt;
+    int rx_ones;      /* consecutive one bits received, 7 = hunting */
+    unsigned int rx_shift;
+    int rx_shift_cnt;
+    u8 rx_frame[V42_MAX_FRAME];
+    int rx_frame_len;
+    u32 rx_crc;
+
+    /* statistics */
+    int nb_tx_frames, nb_rx_frames, nb_fcs_errors, nb_retrans, nb_rnr;
+} V42State;
+
+/* the timers read the time of the modem in 'clock' */
+void v42_init(V42State *s, int calling, int use_fcs32, int n401,
+              int tx_rate, int rx_rate,
+              struct sm_fifo *rx_fifo, struct sm_fifo *tx_fifo,
+              const unsigned int *clock);
+int v42_get_bit(void *opaque);
+void v42_put_bit(void *opaque, int bit);
+int v42_get_bits(void *opaque, int n);
+void v42_put_bits(void *opaque, int bits, int n);
+void v42_disconnect(V42State *s);
+int v42_closed(V42State *s);
+void V42_test(void);
+
+#endif
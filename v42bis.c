@@ -0,0 +1,657 @@
+/*
+ * V42bis data compression
+ *
+ * Copyright (c) 2000 Fabrice Bellard.
+ *
+ * This code is released under the GNU General Public License version
+ * 2. Please read the file COPYING to know the exact terms of the
+ * license.
+ */
+#include "lm.h"
+
+/*
+ * The dictionary is a tree of strings stored in a node array indexed
+ * by codeword. The children of a node are found with a hash table on
+ * (parent, character), so that a node only uses 8 bytes and a string
+ * match is a single hash lookup per character. All the memory is
+ * allocated at init time: the codewords are recycled (leaf nodes only)
+ * when the dictionary is full.
+ *
+ * The encoder and the decoder (in transparent mode) use the same string
+ * matching function, so that they build the same dictionary.
+ *
+ * XXX: no XID negotiation (the parameters come from the modem
+ * configuration), the RESET command is ignored. A mode change or a
+ * FLUSH terminates the current string without dictionary update.
+ */
+
+/* control codewords */
+#define CW_ETM    0
+#define CW_FLUSH  1
+#define CW_STEPUP 2
+
+#define N5 259   /* first free codeword */
+
+/* transparent mode commands */
+#define CMD_ECM   0
+#define CMD_EID   1
+#define CMD_RESET 2
+
+/* number of input characters between two compressibility tests */
+#define TEST_PERIOD 256
+
+static int dict_init(V42bisDict *d, struct sm_arena *arena, int n2, int n7)
+{
+    int i, hash_size;
+
+    d->n2 = n2;
+    d->n7 = n7;
+    hash_size = 1;
+    while (hash_size < 2 * n2)
+        hash_size <<= 1;
+    d->hash_mask = hash_size - 1;
+    d->nodes = sm_arena_alloc(arena, n2 * sizeof(V42bisNode));
+    d->hash = sm_arena_alloc(arena, hash_size * sizeof(u16));
+    if (!d->nodes || !d->hash)
+        return -1;
+
+    for(i=3;i<N5;i++) {
+        d->nodes[i].ch = i - 3;
+        d->nodes[i].depth = 1;
+    }
+    d->c1 = N5;
+    d->c2 = 9;
+    d->c3 = 512;
+    d->match = 0;
+    d->last_added = 0;
+    return 0;
+}
+
+static inline int dict_hash(V42bisDict *d, int parent, int ch)
+{
+    return ((parent * 0x9e5) ^ (ch * 0x3b)) & d->hash_mask;
+}
+
+static inline int dict_lookup(V42bisDict *d, int parent, int ch)
+{
+    V42bisNode *n;
+    int c;
+
+    for(c = d->hash[dict_hash(d, parent, ch)]; c != 0; c = n->hash_next) {
+        n = &d->nodes[c];
+        if (n->parent == parent && n->ch == ch)
+            return c;
+    }
+    return 0;
+}
+
+/* remove the leaf 'c' from the dictionary */
+static void dict_delete(V42bisDict *d, int c)
+{
+    V42bisNode *n = &d->nodes[c];
+    u16 *p;
+
+    p = &d->hash[dict_hash(d, n->parent, n->ch)];
+    while (*p != c)
+        p = &d->nodes[*p].hash_next;
+    *p = n->hash_next;
+    d->nodes[n->parent].nb_children--;
+    n->depth = 0;
+}
+
+/* add the string 'parent' + 'ch'. Return its codeword, or 0 if the
+   string is too long */
+static int dict_add(V42bisDict *d, int parent, int ch)
+{
+    V42bisNode *n;
+    int c, h;
+
+    if (d->nodes[parent].depth >= d->n7)
+        return 0;
+
+    /* find a free codeword or a leaf to recycle */
+    for(;;) {
+        c = d->c1;
+        if (++d->c1 == d->n2)
+            d->c1 = N5;
+        n = &d->nodes[c];
+        if (n->depth == 0)
+            break;
+        if (n->nb_children == 0 && c != parent) {
+            dict_delete(d, c);
+            break;
+        }
+    }
+
+    n->parent = parent;
+    n->ch = ch;
+    n->depth = d->nodes[parent].depth + 1;
+    n->nb_children = 0;
+    h = dict_hash(d, parent, ch);
+    n->hash_next = d->hash[h];
+    d->hash[h] = c;
+    d->nodes[parent].nb_children++;
+    return c;
+}
+
+/* string matching: add 'ch' to the current string. Return the
+   codeword of the terminated string, or 0 if the string was
+   extended */
+static inline int dict_step(V42bisDict *d, int ch)
+{
+    int c, cw;
+
+    if (d->match == 0) {
+        d->match = ch + 3;
+        return 0;
+    }
+    c = dict_lookup(d, d->match, ch);
+    if (c != 0 && c != d->last_added) {
+        d->match = c;
+        return 0;
+    }
+    cw = d->match;
+    /* the string just added is not used by the next string, so that
+       the decoder always knows the received codewords */
+    d->last_added = c ? 0 : dict_add(d, cw, ch);
+    d->match = ch + 3;
+    return cw;
+}
+
+static inline void dict_reset_match(V42bisDict *d)
+{
+    d->match = 0;
+    d->last_added = 0;
+}
+
+/* init V42bis with 'n2' codewords and 'n7' characters max per
+   string. The dictionaries are allocated in 'arena'. Return -1 if no
+   memory. */
+int v42bis_init(V42bisState *s, struct sm_arena *arena, int n2, int n7)
+{
+    memset(s, 0, sizeof(*s));
+    if (n2 < V42BIS_MIN_N2)
+        n2 = V42BIS_MIN_N2;
+    if (n2 > V42BIS_MAX_N2)
+        n2 = V42BIS_MAX_N2;
+    if (n7 < V42BIS_MIN_N7)
+        n7 = V42BIS_MIN_N7;
+    if (n7 > V42BIS_MAX_N7)
+        n7 = V42BIS_MAX_N7;
+    if (dict_init(&s->enc, arena, n2, n7) < 0 ||
+        dict_init(&s->dec, arena, n2, n7) < 0)
+        return -1;
+
+    s->enc_mode = V42BIS_TRANSPARENT;
+    s->dec_mode = V42BIS_TRANSPARENT;
+    sm_init_fifo(&s->tx_fifo, s->tx_buf, V42BIS_FIFO_SIZE);
+    sm_init_fifo(&s->rx_fifo, s->rx_buf, V42BIS_FIFO_SIZE);
+    return 0;
+}
+
+/* output a codeword (LSB first), with the needed STEPUPs */
+static inline u8 *put_code(V42bisState *s, u8 *q, int cw)
+{
+    V42bisDict *d = &s->enc;
+
+    while (cw >= d->c3) {
+        s->enc_bits |= CW_STEPUP << s->enc_nbits;
+        s->enc_nbits += d->c2;
+        s->enc_out_bits += d->c2;
+        d->c2++;
+        d->c3 <<= 1;
+        while (s->enc_nbits >= 8) {
+            *q++ = s->enc_bits;
+            s->enc_bits >>= 8;
+            s->enc_nbits -= 8;
+        }
+    }
+    s->enc_bits |= cw << s->enc_nbits;
+    s->enc_nbits += d->c2;
+    s->enc_out_bits += d->c2;
+    while (s->enc_nbits >= 8) {
+        *q++ = s->enc_bits;
+        s->enc_bits >>= 8;
+        s->enc_nbits -= 8;
+    }
+    return q;
+}
+
+/* pad with zeros to the next octet boundary */
+static inline u8 *put_align(V42bisState *s, u8 *q)
+{
+    if (s->enc_nbits > 0) {
+        *q++ = s->enc_bits;
+        s->enc_out_bits += 8 - s->enc_nbits;
+    }
+    s->enc_bits = 0;
+    s->enc_nbits = 0;
+    return q;
+}
+
+/* compressibility test: choose the best mode */
+static u8 *enc_test(V42bisState *s, u8 *q)
+{
+    int in_bits;
+
+    in_bits = s->enc_in_count * 8;
+    if (s->enc_mode == V42BIS_COMPRESSED) {
+        if (s->enc_out_bits > in_bits) {
+            /* expansion: go to transparent mode */
+            if (s->enc.match)
+                q = put_code(s, q, s->enc.match);
+            q = put_code(s, q, CW_ETM);
+            q = put_align(s, q);
+            dict_reset_match(&s->enc);
+            s->enc_mode = V42BIS_TRANSPARENT;
+            s->nb_mode_changes++;
+        }
+    } else {
+        /* some hysteresis to avoid too many mode changes */
+        if (s->enc_est_bits < in_bits - in_bits / 8) {
+            *q++ = s->enc_esc;
+            *q++ = CMD_ECM;
+            dict_reset_match(&s->enc);
+            s->enc_mode = V42BIS_COMPRESSED;
+            s->nb_mode_changes++;
+        }
+    }
+    s->enc_in_count = 0;
+    s->enc_out_bits = 0;
+    s->enc_est_bits = 0;
+    return q;
+}
+
+/* compress 'len' bytes. 'out' must contain at least
+   V42BIS_ENCODE_MAX(len) bytes. Return the number of output bytes. */
+int v42bis_encode(V42bisState *s, u8 *out, const u8 *in, int len)
+{
+    V42bisDict *d = &s->enc;
+    u8 *q;
+    int i, ch, cw;
+
+    q = out;
+    for(i=0;i<len;i++) {
+        ch = in[i];
+        cw = dict_step(d, ch);
+        if (s->enc_mode == V42BIS_COMPRESSED) {
+            if (cw)
+                q = put_code(s, q, cw);
+        } else {
+            if (cw)
+                s->enc_est_bits += d->c2;
+            *q++ = ch;
+            if (ch == s->enc_esc) {
+                *q++ = CMD_EID;
+                s->enc_esc = (s->enc_esc + 51) & 0xff;
+            }
+        }
+        if (++s->enc_in_count == TEST_PERIOD)
+            q = enc_test(s, q);
+    }
+    return q - out;
+}
+
+/* send the pending data (end of the data to send). 'out' must contain
+   at least V42BIS_ENCODE_MAX(0) bytes. Return the number of output
+   bytes. */
+int v42bis_flush(V42bisState *s, u8 *out)
+{
+    u8 *q;
+
+    q = out;
+    if (s->enc_mode == V42BIS_COMPRESSED && s->enc.match) {
+        q = put_code(s, q, s->enc.match);
+        q = put_code(s, q, CW_FLUSH);
+        q = put_align(s, q);
+        dict_reset_match(&s->enc);
+        s->nb_flushes++;
+    }
+    return q - out;
+}
+
+/* output the string of codeword 'cw'. Return its first character */
+static inline u8 *dec_string(V42bisDict *d, u8 *q, int cw, int *first)
+{
+    V42bisNode *n;
+    int len, i;
+
+    n = &d->nodes[cw];
+    len = n->depth;
+    for(i=len-1;i>0;i--) {
+        q[i] = n->ch;
+        n = &d->nodes[n->parent];
+    }
+    q[0] = n->ch;
+    *first = n->ch;
+    return q + len;
+}
+
+/* decompress 'len' bytes. 'out' must contain at least
+   V42BIS_DECODE_MAX(s, len) bytes. Return the number of output
+   bytes. */
+int v42bis_decode(V42bisState *s, u8 *out, const u8 *in, int len)
+{
+    V42bisDict *d = &s->dec;
+    u8 *q;
+    int i, c, cw, first;
+
+    q = out;
+    i = 0;
+    while (i < len) {
+        if (s->dec_mode == V42BIS_TRANSPARENT) {
+            c = in[i++];
+            if (s->dec_esc_pending) {
+                s->dec_esc_pending = 0;
+                switch(c) {
+                case CMD_ECM:
+                    dict_reset_match(d);
+                    s->dec_prev = 0;
+                    s->dec_bits = 0;
+                    s->dec_nbits = 0;
+                    s->dec_mode = V42BIS_COMPRESSED;
+                    break;
+                case CMD_EID:
+                    c = s->dec_esc;
+                    s->dec_esc = (s->dec_esc + 51) & 0xff;
+                    *q++ = c;
+                    dict_step(d, c);
+                    break;
+                default:
+                    s->nb_errors++;
+                    break;
+                }
+            } else if (c == s->dec_esc) {
+                s->dec_esc_pending = 1;
+            } else {
+                *q++ = c;
+                dict_step(d, c);
+            }
+        } else {
+            while (s->dec_nbits < d->c2) {
+                if (i >= len)
+                    goto done;
+                s->dec_bits |= in[i++] << s->dec_nbits;
+                s->dec_nbits += 8;
+            }
+            cw = s->dec_bits & ((1 << d->c2) - 1);
+            s->dec_bits >>= d->c2;
+            s->dec_nbits -= d->c2;
+
+            switch(cw) {
+            case CW_ETM:
+                s->dec_mode = V42BIS_TRANSPARENT;
+                dict_reset_match(d);
+                /* fall thru */
+            case CW_FLUSH:
+                s->dec_bits = 0;
+                s->dec_nbits = 0;
+                s->dec_prev = 0;
+                break;
+            case CW_STEPUP:
+                d->c2++;
+                d->c3 <<= 1;
+                break;
+            default:
+                if (cw >= d->n2 || d->nodes[cw].depth == 0) {
+                    s->nb_errors++;
+                    break;
+                }
+                q = dec_string(d, q, cw, &first);
+                /* the encoder added the previous string + the first
+                   character of this one */
+                if (s->dec_prev && !dict_lookup(d, s->dec_prev, first))
+                    dict_add(d, s->dec_prev, first);
+                s->dec_prev = cw;
+                break;
+            }
+        }
+    }
+ done:
+    return q - out;
+}
+
+/* compress the data of 'tx_fifo' and decompress to 'rx_fifo'. The
+   compressed data is exchanged with LAPM with s->tx_fifo and
+   s->rx_fifo */
+#define PROCESS_CHUNK 16
+
+void v42bis_process(V42bisState *s, struct sm_fifo *rx_fifo,
+                    struct sm_fifo *tx_fifo)
+{
+    u8 buf[PROCESS_CHUNK];
+    u8 out[(PROCESS_CHUNK + 1) * V42BIS_MAX_N7];
+    int i, n, len;
+
+    /* compress */
+    while (sm_size(tx_fifo) > 0 &&
+           (s->tx_fifo.max_size - s->tx_fifo.size) >=
+           V42BIS_ENCODE_MAX(PROCESS_CHUNK)) {
+        n = sm_size(tx_fifo);
+        if (n > PROCESS_CHUNK)
+            n = PROCESS_CHUNK;
+        for(i=0;i<n;i++)
+            buf[i] = sm_get_bit(tx_fifo);
+        len = v42bis_encode(s, out, buf, n);
+        for(i=0;i<len;i++)
+            sm_put_bit(&s->tx_fifo, out[i]);
+    }
+    /* nothing more to send: flush the current string */
+    if (sm_size(tx_fifo) == 0 && sm_size(&s->tx_fifo) == 0) {
+        len = v42bis_flush(s, out);
+        for(i=0;i<len;i++)
+            sm_put_bit(&s->tx_fifo, out[i]);
+    }
+
+    /* decompress */
+    while (sm_size(&s->rx_fifo) > 0 &&
+           (rx_fifo->max_size - rx_fifo->size) >=
+           V42BIS_DECODE_MAX(s, PROCESS_CHUNK)) {
+        n = sm_size(&s->rx_fifo);
+        if (n > PROCESS_CHUNK)
+            n = PROCESS_CHUNK;
+        for(i=0;i<n;i++)
+            buf[i] = sm_get_bit(&s->rx_fifo);
+        len = v42bis_decode(s, out, buf, n);
+        for(i=0;i<len;i++)
+            sm_put_bit(rx_fifo, out[i]);
+    }
+}
+
+/* benchmark: compression ratio and speed on a few corpora */
+
+#define V42BIS_BENCH_SIZE  (256 * 1024)
+#define V42BIS_BENCH_LOOPS 8
+#define V42BIS_BENCH_CHUNK 64     /* block size of the streaming test */
+#define V34_RATE           33600  /* bit/s */
+
+static const char *bench_words[] = {
+    "the", "modem", "data", "of", "and", "to", "a", "in", "is", "line",
+    "carrier", "signal", "with", "for", "bit", "rate", "echo", "that",
+    "frame", "receiver", "transmitter", "phase", "on", "by", "this",
+    "symbol", "error", "are", "be", "as", "channel", "filter",
+};
+
+/* 'type' = 0: english like text, 1: binary records, 2: random, 3:
+   text and random blocks (mode changes) */
+static void bench_corpus(u8 *buf, int size, int type)
+{
+    int i, j, n, v;
+    const char *p;
+
+    switch(type) {
+    case 0:
+        i = 0;
+        n = 0;
+        while (i < size) {
+            /* zipf like distribution */
+            j = random() % 32;
+            j = (j * j) / 32;
+            p = bench_words[j];
+            while (*p && i < size)
+                buf[i++] = *p++;
+            if (i < size) {
+                if (++n == 12) {
+                    buf[i++] = '\n';
+                    n = 0;
+                } else {
+                    buf[i++] = ' ';
+                }
+            }
+        }
+        break;
+    case 1:
+        /* 16 byte records: index, small value, flags, zero padding */
+        memset(buf, 0, size);
+        for(i=0;i<size/16;i++) {
+            buf[16 * i] = i;
+            buf[16 * i + 1] = i >> 8;
+            buf[16 * i + 2] = i >> 16;
+            v = random() % 100;
+            buf[16 * i + 4] = v;
+            buf[16 * i + 6] = (random() % 4) == 0 ? 0x80 : 0x01;
+        }
+        break;
+    case 2:
+        for(i=0;i<size;i++)
+            buf[i] = random();
+        break;
+    default:
+        bench_corpus(buf, size, 0);
+        for(i=0;i<size;i+=32768) {
+            for(j=i;j<i+16384 && j<size;j++)
+                buf[j] = random();
+        }
+        break;
+    }
+}
+
+/* compress 'data' in blocks of 'chunk' bytes (with a flush after each
+   block if 'flush' is true). Return the compressed size. */
+static int bench_encode(V42bisState *s, u8 *out, const u8 *data,
+                        int size, int chunk, int flush)
+{
+    int i, n, len;
+
+    len = 0;
+    for(i=0;i<size;i+=n) {
+        n = size - i;
+        if (n > chunk)
+            n = chunk;
+        len += v42bis_encode(s, out + len, data + i, n);
+        if (flush)
+            len += v42bis_flush(s, out + len);
+    }
+    len += v42bis_flush(s, out + len);
+    return len;
+}
+
+/* decompress and return the number of bytes which differ from 'data' */
+static int bench_decode(V42bisState *s, u8 *out, const u8 *in, int len,
+                        const u8 *data, int size, int chunk)
+{
+    int i, n, out_len, err;
+
+    out_len = 0;
+    for(i=0;i<len;i+=n) {
+        n = len - i;
+        if (n > chunk)
+            n = chunk;
+        out_len += v42bis_decode(s, out + out_len, in + i, n);
+        if (out_len > size)
+            break;
+    }
+    err = abs(out_len - size);
+    if (out_len > size)
+        out_len = size;
+    for(i=0;i<out_len;i++) {
+        if (out[i] != data[i])
+            err++;
+    }
+    return err;
+}
+
+void v42bis_bench(void)
+{
+    static const char *corpus_names[4] = { "text", "binary", "random", "mixed" };
+    static const struct {
+        int n2, n7;
+    } params[] = {
+        { 512, 32 }, { 2048, 32 }, { 4096, 32 }, { 4096, 250 },
+    };
+    struct sm_arena arena;
+    V42bisState *s;
+    u8 *data, *comp, *out;
+    int i, k, p, len, err;
+    s64 t_enc, t_dec;
+    float nb_bytes, ratio, lapm_eff, rate;
+
+    s = malloc(sizeof(*s));
+    data = malloc(V42BIS_BENCH_SIZE);
+    comp = malloc(V42BIS_ENCODE_MAX(V42BIS_BENCH_SIZE) +
+                  (V42BIS_BENCH_SIZE / V42BIS_BENCH_CHUNK + 1) * 
+                  V42BIS_ENCODE_MAX(0));
+    out = malloc(V42BIS_BENCH_SIZE + (V42BIS_BENCH_CHUNK + 1) * V42BIS_MAX_N7);
+    if (!s || !data || !comp || !out ||
+        sm_arena_init(&arena, 256 * 1024) < 0) {
+        fprintf(stderr, "v42bis_bench: no memory\n");
+        exit(1);
+    }
+
+    /* LAPM framing overhead (flags, address, control, FCS16) with
+       N401=128, bit stuffing ignored */
+    lapm_eff = 128.0 / (128 + 6);
+
+    nb_bytes = (float)V42BIS_BENCH_SIZE * V42BIS_BENCH_LOOPS;
+    printf("v42bis: %d bytes, %d loops. Effective throughput over LAPM "
+           "at %d bit/s\n", 
+           V42BIS_BENCH_SIZE, V42BIS_BENCH_LOOPS, V34_RATE);
+    for(i=0;i<4;i++) {
+        bench_corpus(data, V42BIS_BENCH_SIZE, i);
+        for(p=0;p<sizeof(params)/sizeof(params[0]);p++) {
+            /* one block */
+            t_enc = bench_time();
+            for(k=0;k<V42BIS_BENCH_LOOPS;k++) {
+                sm_arena_reset(&arena);
+                v42bis_init(s, &arena, params[p].n2, params[p].n7);
+                len = bench_encode(s, comp, data, V42BIS_BENCH_SIZE,
+                                   V42BIS_BENCH_SIZE, 0);
+            }
+            t_enc = bench_time() - t_enc;
+
+            t_dec = bench_time();
+            for(k=0;k<V42BIS_BENCH_LOOPS;k++) {
+                sm_arena_reset(&arena);
+                v42bis_init(s, &arena, params[p].n2, params[p].n7);
+                err = bench_decode(s, out, comp, len, data,
+                                   V42BIS_BENCH_SIZE, V42BIS_BENCH_SIZE);
+            }
+            t_dec = bench_time() - t_dec;
+            ratio = (float)V42BIS_BENCH_SIZE / len;
+
+            /* interactive use: small blocks with flushes */
+            sm_arena_reset(&arena);
+            v42bis_init(s, &arena, params[p].n2, params[p].n7);
+            len = bench_encode(s, comp, data, V42BIS_BENCH_SIZE,
+                               V42BIS_BENCH_CHUNK, 1);
+            err += bench_decode(s, out, comp, len, data,
+                                V42BIS_BENCH_SIZE, V42BIS_BENCH_CHUNK);
+
+            rate = V34_RATE / 8.0 * lapm_eff;
+            printf("%-7s N2=%4d N7=%3d: ratio=%5.2f (%5.2f flushed) "
+                   "comp=%6.1f MB/s decomp=%6.1f MB/s "
+                   "%6.0f B/s modes=%d errors=%d\n",
+                   corpus_names[i], params[p].n2, params[p].n7,
+                   ratio, (float)V42BIS_BENCH_SIZE / len,
+                   nb_bytes / t_enc, nb_bytes / t_dec,
+                   rate * ratio, s->nb_mode_changes, err);
+        }
+    }
+    printf("(uncompressed: %.0f B/s)\n", V34_RATE / 8.0 * lapm_eff);
+
+    sm_arena_free(&arena);
+    free(out);
+    free(comp);
+    free(data);
+    free(s);
+}
@@ -0,0 +1,80 @@
+#ifndef V42BIS_H
+#define V42BIS_H
+
+/* V42bis data compression */
+
+#define V42BIS_MIN_N2  512
+#define V42BIS_MAX_N2  8192
+#define V42BIS_MIN_N7  6
+#define V42BIS_MAX_N7  250
+
+/* dictionary node. The codeword is the index of the node */
+typedef struct {
+    u16 parent;      /* codeword of the prefix string */
+    u16 hash_next;   /* next node with the same hash, 0 if none */
+    u16 nb_children;
+    u8 ch;           /* last character of the string */
+    u8 depth;        /* length of the string, 0 if unused */
+} V42bisNode;
+
+typedef struct {
+    V42bisNode *nodes;  /* n2 nodes */
+    u16 *hash;          /* hash_mask + 1 heads */
+    int hash_mask;
+    int n2, n7;
+    int c1;             /* next codeword to assign */
+    int c2;             /* codeword size in bits */
+    int c3;             /* codeword size threshold */
+    int match;          /* codeword of the string being matched, 0 if none */
+    int last_added;     /* codeword added by the last string, not matched */
+} V42bisDict;
+
+enum {
+    V42BIS_TRANSPARENT,
+    V42BIS_COMPRESSED,
+};
+
+#define V42BIS_FIFO_SIZE 1024
+
+typedef struct V42bisState {
+    /* encoder */
+    V42bisDict enc;
+    int enc_mode;
+    int enc_esc;        /* escape character */
+    u32 enc_bits;
+    int enc_nbits;
+    int enc_in_count;   /* compressibility test */
+    int enc_out_bits, enc_est_bits;
+
+    /* decoder */
+    V42bisDict dec;
+    int dec_mode;
+    int dec_esc;
+    int dec_esc_pending;
+    u32 dec_bits;
+    int dec_nbits;
+    int dec_prev;       /* previous decoded codeword, 0 if none */
+
+    /* statistics */
+    int nb_mode_changes, nb_flushes, nb_errors;
+
+    /* compressed data exchanged with LAPM */
+    struct sm_fifo tx_fifo, rx_fifo;
+    u8 tx_buf[V42BIS_FIFO_SIZE];
+    u8 rx_buf[V42BIS_FIFO_SIZE];
+} V42bisState;
+
+/* maximum output size of v42bis_encode() & v42bis_flush() */
+#define V42BIS_ENCODE_MAX(len) (2 * (len) + 8)
+/* maximum output size of v42bis_decode() */
+#define V42BIS_DECODE_MAX(s, len) (((len) + 1) * (s)->dec.n7)
+
+int v42bis_init(V42bisState *s, struct sm_arena *arena, int n2, int n7);
+int v42bis_encode(V42bisState *s, u8 *out, const u8 *in, int len);
+int v42bis_flush(V42bisState *s, u8 *out);
+int v42bis_decode(V42bisState *s, u8 *out, const u8 *in, int len);
+void v42bis_process(V42bisState *s, struct sm_fifo *rx_fifo,
+                    struct sm_fifo *tx_fifo);
+void v42bis_bench(void);
+
+#endif
@@ -90,7 +90,7 @@ static void V8_demod(V8_demod_state *s, const s16 *samples, unsigned int nb)
 static void ci_decode(V8State *s)
 {
     int data = s->rx_data[0];
-    if (data == 0x83) {
+    if (data == 0x83 && lm_debug) {
         printf("CI: data call\n");
     } 
 }
@@ -150,6 +150,9 @@ static void cm_decode(V8State *s)
                     } while ((c & 0x1c) == V8_EXT);
                 }
             }
+            /* protocols */
+            if (c == V8_DATA_LAPM)
+                s->decoded_modulations |= V8_PROT_LAPM;
             return;
         }
     }
@@ -173,16 +176,18 @@ static void put_bit(void *opaque, int bit)
         new_state = V8_CM_SYNC;
     data_init:
         /* debug */
-        if (s->data_state == V8_CI_SYNC) {
-            printf("CI: ");
-        } else if (s->data_state == V8_CM_SYNC) {
-            if (s->calling)
-                printf("JM: ");
-            else
-                printf("CM: ");
+        if (lm_debug) {
+            if (s->data_state == V8_CI_SYNC) {
+                printf("CI: ");
+            } else if (s->data_state == V8_CM_SYNC) {
+                if (s->calling)
+                    printf("JM: ");
+                else
+                    printf("CM: ");
+            }
+            for(i=0;i<s->rx_data_ptr;i++) printf(" %02x", s->rx_data[i]);
+            printf("\n");
         }
-        for(i=0;i<s->rx_data_ptr;i++) printf(" %02x", s->rx_data[i]);
-        printf("\n");
         
         /* decode previous sequence */
         switch(s->data_state) {
@@ -208,12 +213,14 @@ static void put_bit(void *opaque, int bit)
             int data;
             /* store the available data */
             data = (s->bit_buf >> 1) & 0xff;
-            printf("got data: %d %02x\n", s->data_state, data);
+            if (lm_debug)
+                printf("got data: %d %02x\n", s->data_state, data);
             /* CJ detection */
             if (data == 0) {
                 if (++s->data_zero_count == 3) {
                     s->got_cj = 1;
-                    printf("got CJ\n");
+                    if (lm_debug)
+                        printf("got CJ\n");
                 }
             } else {
                 s->data_zero_count = 0;
@@ -260,10 +267,14 @@ static void v8_put_byte(V8State *s, int data)
 }
 
 
-void V8_init(V8State *sm, int calling, int mod_mask)
+void V8_init(V8State *sm, int calling, int mod_mask,
+             const unsigned int *clock)
 {
     sm->debug_laststate = -1;
     sm->calling = calling;
+    sm_timer_init(&sm->v8_start_timer, clock);
+    sm_timer_init(&sm->v8_ci_timer, clock);
+    sm_timer_init(&sm->v8_connect_timer, clock);
     if (sm->calling) {
         sm->state = V8_WAIT_1SECOND;
         sm_set_timer(&sm->v8_start_timer, 1000);
@@ -303,8 +314,8 @@ static void cm_send(V8State *s, int mod_mask)
         val |= V8_MODN2_V21;
     v8_put_byte(s, val);
     
-    /* for now, no LAPM */
-    //v8_put_byte(s, V8_DATA_LAPM);
+    if (mod_mask & V8_PROT_LAPM)
+        v8_put_byte(s, V8_DATA_LAPM);
     
     /* We are not on celullar connection. What is that,
        anyway? GSM?  Don't send this - we don't what it is
@@ -362,8 +373,12 @@ int V8_process(V8State *s, s16 *output, s16 *input, int nb_samples)
     case V8_CI:
     case V8_CI_OFF:
     case V8_CI_SEND:
-        /* detect ANSam */
-        V8_demod(&s->v8_rx, input, nb_samples);
+        /* detect ANSam. The detector cannot trigger if all the
+           samples are below 2^8, so we skip the silences */
+        if (dsp_max_bits(input, nb_samples) > 8)
+            V8_demod(&s->v8_rx, input, nb_samples);
+        else
+            s->v8_rx.buf_ptr = 0;
         break;
         
     case V8_CM_WAIT:
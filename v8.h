@@ -101,7 +101,10 @@ typedef struct {
 #define V8_MOD_V23 (1 << 10) /* V23 duplex */
 #define V8_MOD_V21 (1 << 12) /* V21 duplex */
 
+#define V8_PROT_LAPM (1 << 14) /* V42 LAPM error correction */
+
 #define V8_MOD_HANGUP 0x8000 /* indicate hangup */
 
-void V8_init(V8State *sm, int calling, int mod_mask);
+void V8_init(V8State *sm, int calling, int mod_mask,
+             const unsigned int *clock);
 int V8_process(V8State *sm, s16 *output, s16 *input, int nb_samples);
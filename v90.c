@@ -519,16 +519,15 @@ void v90_decode_init(V90DecodeState *s)
     }
 }
 
-static u8 test_buf[1000];
+/* one bit per byte */
+#define CP_MAX_SIZE 1000
 
-/* send a CP frame (analog modem) */
-static void v90_send_CP(V90DecodeState *s, int is_CP, int ack)
+/* send a CP frame (analog modem) in 'buf' */
+static void v90_send_CP(V90DecodeState *s, u8 *buf, int is_CP, int ack)
 {
-    u8 *buf, *p;
+    u8 *p;
     int i, crc, drn;
 
-    buf = test_buf;
-
     p = buf;
     put_bits(&p, 17, 0x1ffff); /* frame sync */
 
@@ -671,14 +670,14 @@ static void v90_parse_CP(V90EncodeState *s, u8 *buf)
 }
 
 /* received & parse the CP packet */
-static void v90_receive_CP(V90EncodeState *s)
+static void v90_receive_CP(V90EncodeState *s, u8 *cp_buf)
 {
     u8 buf[1024], *p, *q;
     int b, i, frame_index, one_count, frame_count, nb_constellations;
     int crc1;
     u8 m_index[6];
 
-    p = test_buf;
+    p = cp_buf;
      
  wait_sync:
     one_count = 0;
@@ -753,6 +752,7 @@ void V90_test(void)
     V90DecodeState v90_dec;
     u8 data[5][48], data1[48];
     s16 samples[6];
+    u8 cp_buf[CP_MAX_SIZE];
 
     /* init modem state */
     memset(&v90_enc, 0, sizeof(v90_enc));
@@ -762,10 +762,10 @@ void V90_test(void)
     v90_decode_init(&v90_dec);
     
     /* send the CP sequence which contains the modulation parameters */
-    v90_send_CP(&v90_dec, 1, 0);
+    v90_send_CP(&v90_dec, cp_buf, 1, 0);
     
     /* "receive" it ! */
-    v90_receive_CP(&v90_enc);
+    v90_receive_CP(&v90_enc, cp_buf);
 
     /* number of data bits per mapping frame */
     n = v90_enc.S + v90_enc.K;
@@ -39,8 +39,8 @@ typedef struct V90EncodeState {
     const s16 *ucode_to_linear;    /* table to retrieve the linear values from ucodes */
 } V90EncodeState;
 
-const s16 v90_ulaw_ucode_to_linear[128];
-const s16 v90_alaw_ucode_to_linear[128];
+extern const s16 v90_ulaw_ucode_to_linear[128];
+extern const s16 v90_alaw_ucode_to_linear[128];
 
 typedef struct V90DecodeState {
     struct sm_state *sm;
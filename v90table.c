@@ -0,0 +1,49 @@
+/* THIS SOURCE CODE IS AUTOMATICALLY GENERATED - DO NOT MODIFY */
+/*
+ * V90 tables
+ * 
+ * Copyright (c) 1999 Fabrice Bellard.
+ *
+ * This code is released under the GNU General Public License version
+ * 2. Please read the file COPYING to know the exact terms of the
+ * license.
+ */
+#include "lm.h"
+#include "v90priv.h"
+
+const s16 v90_ulaw_ucode_to_linear[128]= {
+    0,    8,   16,   24,   32,   40,   48,   56,
+   64,   72,   80,   88,   96,  104,  112,  120,
+  132,  148,  164,  180,  196,  212,  228,  244,
+  260,  276,  292,  308,  324,  340,  356,  372,
+  396,  428,  460,  492,  524,  556,  588,  620,
+  652,  684,  716,  748,  780,  812,  844,  876,
+  924,  988, 1052, 1116, 1180, 1244, 1308, 1372,
+ 1436, 1500, 1564, 1628, 1692, 1756, 1820, 1884,
+ 1980, 2108, 2236, 2364, 2492, 2620, 2748, 2876,
+ 3004, 3132, 3260, 3388, 3516, 3644, 3772, 3900,
+ 4092, 4348, 4604, 4860, 5116, 5372, 5628, 5884,
+ 6140, 6396, 6652, 6908, 7164, 7420, 7676, 7932,
+ 8316, 8828, 9340, 9852,10364,10876,11388,11900,
+12412,12924,13436,13948,14460,14972,15484,15996,
+16764,17788,18812,19836,20860,21884,22908,23932,
+24956,25980,27004,28028,29052,30076,31100,32124,
+};
+const s16 v90_alaw_ucode_to_linear[128]= {
+    8,   24,   40,   56,   72,   88,  104,  120,
+  136,  152,  168,  184,  200,  216,  232,  248,
+  264,  280,  296,  312,  328,  344,  360,  376,
+  392,  408,  424,  440,  456,  472,  488,  504,
+  528,  560,  592,  624,  656,  688,  720,  752,
+  784,  816,  848,  880,  912,  944,  976, 1008,
+ 1056, 1120, 1184, 1248, 1312, 1376, 1440, 1504,
+ 1568, 1632, 1696, 1760, 1824, 1888, 1952, 2016,
+ 2112, 2240, 2368, 2496, 2624, 2752, 2880, 3008,
+ 3136, 3264, 3392, 3520, 3648, 3776, 3904, 4032,
+ 4224, 4480, 4736, 4992, 5248, 5504, 5760, 6016,
+ 6272, 6528, 6784, 7040, 7296, 7552, 7808, 8064,
+ 8448, 8960, 9472, 9984,10496,11008,11520,12032,
+12544,13056,13568,14080,14592,15104,15616,16128,
+16896,17920,18944,19968,20992,22016,23040,24064,
+25088,26112,27136,28160,29184,30208,31232,32256,
+};